@@ -59,7 +59,9 @@ namespace SPH {
 	void MeshBackground
 		::DeleteMeshDataMatrix()
 	{
+		if (mesh_background_data_ == NULL) return;
 		Delete2dArray(mesh_background_data_, number_of_grid_points_);
+		mesh_background_data_ = NULL;
 	}
 	//===================================================================//
 	void MeshBackground::InitializeLevelSetData(SPHBody &body)
@@ -246,6 +248,63 @@ namespace SPH {
 
 	}
 	//===================================================================//
+	void SparseMeshBackground::ComputeCurvatureFromLevelSet(SPHBody &body)
+	{
+		parallel_for(blocked_range<size_t>(0, band_data_.size()),
+			[&](const blocked_range<size_t>& r)
+			{
+			for (size_t m = r.begin(); m != r.end(); ++m)
+			{
+				band_data_[m].kappa_ = 0.0;
+				Vecu grid_index = getBandGridIndex(m);
+				size_t i = grid_index[0];
+				size_t j = grid_index[1];
+				if (i == 0 || j == 0 || i + 1 >= number_of_grid_points_[0] || j + 1 >= number_of_grid_points_[1])
+					continue;
+
+				Real phi = band_data_[m].phi_;
+				Real phi_xp = getGridData(Vecu(i + 1, j)).phi_;
+				Real phi_xm = getGridData(Vecu(i - 1, j)).phi_;
+				Real phi_yp = getGridData(Vecu(i, j + 1)).phi_;
+				Real phi_ym = getGridData(Vecu(i, j - 1)).phi_;
+
+				Real grad_x = 0.5 * (phi_xp - phi_xm) / grid_spacing_;
+				Real grad_y = 0.5 * (phi_yp - phi_ym) / grid_spacing_;
+				Real grad_xy = 0.25 * (getGridData(Vecu(i + 1, j + 1)).phi_ - getGridData(Vecu(i - 1, j + 1)).phi_
+					- getGridData(Vecu(i + 1, j - 1)).phi_ + getGridData(Vecu(i - 1, j - 1)).phi_)
+					/ grid_spacing_ / grid_spacing_;
+				Real grad_xx = (phi_xp - 2.0 * phi + phi_xm) / grid_spacing_ / grid_spacing_;
+				Real grad_yy = (phi_yp - 2.0 * phi + phi_ym) / grid_spacing_ / grid_spacing_;
+
+				Real grad_phi = grad_x * grad_x + grad_y * grad_y;
+				band_data_[m].kappa_ = (grad_xx * grad_y * grad_y - 2.0 * grad_x * grad_y * grad_xy +
+					grad_yy * grad_x * grad_x) / (grad_phi * sqrt(grad_phi) + 1.0e-15);
+			}
+		}, ap);
+		is_curvature_computed_ = true;
+	}
+	//===================================================================//
+	void SparseMeshBackground::WriteMeshToPltFile(ofstream &output_file)
+	{
+		Vecu number_of_operation = number_of_grid_points_;
+
+		output_file << "\n";
+		output_file << "title='View'" << "\n";
+		output_file << "variables= " << "x, " << "y, " << "phi, " << "n_x, " << "n_y, " << "kappa, " << "\n";
+		output_file << "zone i=" << number_of_operation[0] << "  j=" << number_of_operation[1] << "  k=" << 1
+			<< "  DATAPACKING=POINT  SOLUTIONTIME=" << 0 << "\n";
+
+		for (size_t j = 0; j != number_of_operation[1]; ++j)
+			for (size_t i = 0; i != number_of_operation[0]; ++i)
+			{
+				Vecd grid_position = GridPositionFromIndexes(Vecu(i, j));
+				LevelSetData& grid_data = getGridData(Vecu(i, j));
+				output_file << grid_position[0] << " " << grid_position[1] << " "
+					<< grid_data.phi_ << " " << grid_data.n_[0] << " " << grid_data.n_[1] << " "
+					<< grid_data.kappa_ << " \n";
+			}
+	}
+	//===================================================================//
 	void LevelSetDataPackage::AllocateMeshDataMatrix()
 	{
 		Allocate2dArray(phi_, number_of_grid_points_);
@@ -12,9 +12,9 @@
 
 namespace SPH {
 	//=================================================================================================//
-	CellList::CellList() : cell_location_(0)
+	CellList::CellList() : cell_location_(0), real_particle_count_(0)
 	{
-		particle_data_lists_.reserve(12);
+		/** No storage is reserved here, it is allocated only for the cells receiving particles. */
 	}
 	//=================================================================================================//
 	void BaseMeshCellLinkedList
@@ -24,9 +24,11 @@ namespace SPH {
 			[&](const blocked_range2d<size_t>& r) {
 				for (size_t i = r.rows().begin(); i != r.rows().end(); ++i)
 					for (size_t j = r.cols().begin(); j != r.cols().end(); ++j) {
-						cell_linked_lists[i][j].particle_data_lists_.clear();
-						cell_linked_lists[i][j].real_particle_count_ = 0;
-						cell_linked_lists[i][j].real_particle_indexes_.clear();
+						CellList& cell_list = cell_linked_lists[i][j];
+						if (cell_list.particle_indexes_.size() == 0 && cell_list.real_particle_count_ == 0) continue;
+						cell_list.clearParticles();
+						cell_list.real_particle_count_ = 0;
+						cell_list.real_particle_indexes_.clear();
 					}
 			}, ap);
 	}
@@ -50,11 +52,11 @@ namespace SPH {
 					for (size_t i = 0; i != number_of_operation[0]; ++i)
 						for (size_t j = 0; j != number_of_operation[1]; ++j) {
 							CellList& cell_list = cell_linked_lists[3 * i + l][3 * j + m];
-							size_t real_particles_in_cell = cell_list.particle_data_lists_.size();
+							size_t real_particles_in_cell = cell_list.particle_indexes_.size();
 							if (real_particles_in_cell != 0) {
 								cell_list.real_particle_count_ = real_particles_in_cell;
 								for (int s = 0; s != real_particles_in_cell; ++s)
-									cell_list.real_particle_indexes_.push_back(cell_list.particle_data_lists_[s].first);
+									cell_list.real_particle_indexes_.push_back(cell_list.particle_indexes_[s]);
 								split_cell_lists[num].push_back(&cell_linked_lists[3 * i + l][3 * j + m]);
 							}
 						}
@@ -62,6 +64,35 @@ namespace SPH {
 			}, ap);
 	}
 	//=================================================================================================//
+	void BaseMeshCellLinkedList::UpdateBlockSplitCellLists(BlockSplitCellLists& block_split_cell_lists,
+		Vecu& number_of_cells, matrix_cell cell_linked_lists)
+	{
+		Vecu number_of_tiles = (number_of_cells + Vecu(1)) / 2;
+		parallel_for(blocked_range<size_t>(0, block_split_cell_lists.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t num = r.begin(); num != r.end(); ++num) {
+					/** the color of a tile is given by the parity of its tile index. */
+					Vec2u color = transfer1DtoMeshIndex(Vec2u(2, 2), num);
+					Vecu number_of_color_tiles = (number_of_tiles + Vecu(1) - color) / 2;
+					SplitCellLists& tiles = block_split_cell_lists[num];
+					tiles.resize(number_of_color_tiles[0] * number_of_color_tiles[1]);
+					for (size_t i = 0; i != number_of_color_tiles[0]; ++i)
+						for (size_t j = 0; j != number_of_color_tiles[1]; ++j) {
+							CellLists& tile = tiles[transferMeshIndexTo1D(number_of_color_tiles, Vecu(i, j))];
+							tile.clear();
+							/** the cells in a tile are in the memory order of the cell linked lists */
+							Vecu lower_cell_index = (Vecu(2 * i, 2 * j) + color) * 2;
+							for (size_t l = lower_cell_index[0]; l != SMIN(lower_cell_index[0] + 2, number_of_cells[0]); ++l)
+								for (size_t m = lower_cell_index[1]; m != SMIN(lower_cell_index[1] + 2, number_of_cells[1]); ++m) {
+									CellList& cell_list = cell_linked_lists[l][m];
+									if (cell_list.real_particle_indexes_.size() != 0)
+										tile.push_back(&cell_list);
+								}
+						}
+				}
+			}, ap);
+	}
+	//=================================================================================================//
 	CellList* MeshCellLinkedList::getCellList(Vecu cell_index)
 	{
 		return &cell_linked_lists_[cell_index[0]][cell_index[1]];
@@ -70,10 +101,13 @@ namespace SPH {
 	void MeshCellLinkedList::AllocateMeshDataMatrix()
 	{
 		Allocate2dArray(cell_linked_lists_, number_of_cells_);
-		for (size_t i = 0; i != number_of_cells_[0]; ++i)
-			for (size_t j = 0; j != number_of_cells_[1]; ++j) {
-				cell_linked_lists_[i][j].setCellInformation(Vecu(i,j));
-			}
+		parallel_for(blocked_range2d<size_t>(0, number_of_cells_[0], 0, number_of_cells_[1]),
+			[&](const blocked_range2d<size_t>& r) {
+				for (size_t i = r.rows().begin(); i != r.rows().end(); ++i)
+					for (size_t j = r.cols().begin(); j != r.cols().end(); ++j) {
+						cell_linked_lists_[i][j].setCellInformation(Vecu(i, j));
+					}
+			}, ap);
 	}
 	//=================================================================================================//
 	void MeshCellLinkedList::DeleteMeshDataMatrix()
@@ -101,18 +135,19 @@ namespace SPH {
 					for (int l = SMAX(i - 1, 0); l <= SMIN(i + 1, int(number_of_cells_[0]) - 1); ++l)
 						for (int m = SMAX(j - 1, 0); m <= SMIN(j + 1, int(number_of_cells_[1]) - 1); ++m)
 						{
-							ConcurrentListDataVector& target_particles = cell_linked_lists_[l][m].particle_data_lists_;
-							for (size_t n = 0; n != target_particles.size(); ++n)
+							IndexVector& target_particle_indexes = cell_linked_lists_[l][m].particle_indexes_;
+							StdVec<Vecd>& target_particle_positions = cell_linked_lists_[l][m].particle_positions_;
+							for (size_t n = 0; n != target_particle_indexes.size(); ++n)
 							{
 								//displacement pointing from neighboring particle to origin particle
-								Vecd displacement = base_particle_data[num].pos_n_ - target_particles[n].second;
-								if (displacement.norm() <= cutoff_radius_ && num != target_particles[n].first)
+								Vecd displacement = base_particle_data[num].pos_n_ - target_particle_positions[n];
+								if (displacement.norm() <= cutoff_radius_ && num != target_particle_indexes[n])
 								{
 									std::get<1>(neighborhood) >= neighbor_list.size() ?
 										neighbor_list.emplace_back(new NeighborRelation(base_particle_data, *kernel_,
-											displacement, num, target_particles[n].first))
+											displacement, num, target_particle_indexes[n]))
 										: neighbor_list[std::get<1>(neighborhood)]->resetRelation(base_particle_data,
-											*kernel_, displacement, num, target_particles[n].first);
+											*kernel_, displacement, num, target_particle_indexes[n]);
 									std::get<1>(neighborhood)++;
 								}
 							}
@@ -174,20 +209,20 @@ namespace SPH {
 					for (int l = SMAX(i - search_range, 0); l <= SMIN(i + search_range, int(target_number_of_cells[0]) - 1); ++l)
 						for (int m = SMAX(j - search_range, 0); m <= SMIN(j + search_range, int(target_number_of_cells[1]) - 1); ++m)
 						{
-							ConcurrentListDataVector &target_particles
-								= target_cell_linked_lists[l][m].particle_data_lists_;
-							for (size_t n = 0; n < target_particles.size(); n++)
+							IndexVector& target_particle_indexes = target_cell_linked_lists[l][m].particle_indexes_;
+							StdVec<Vecd>& target_particle_positions = target_cell_linked_lists[l][m].particle_positions_;
+							for (size_t n = 0; n < target_particle_indexes.size(); n++)
 							{
 								//displacement pointing from neighboring particle to origin particle
 								Vecd displacement = base_particle_data[num].pos_n_
-									- target_particles[n].second;
+									- target_particle_positions[n];
 								if (displacement.norm() <= cutoff_radius)
 								{
 									std::get<1>(neighborhood) >= neighbor_list.size() ?
 										neighbor_list.emplace_back(new NeighborRelation(base_particle_data, current_kernel,
-											displacement, num, target_particles[n].first))
+											displacement, num, target_particle_indexes[n]))
 										: neighbor_list[std::get<1>(neighborhood)]->resetRelation(base_particle_data,
-											current_kernel, displacement, num, target_particles[n].first);
+											current_kernel, displacement, num, target_particle_indexes[n]);
 									std::get<1>(neighborhood)++;
 								}
 							}
@@ -205,8 +240,7 @@ namespace SPH {
 	void MultilevelMeshCellLinkedList
 		::InsertACellLinkedListEntryAtALevel(size_t particle_index, Vecd& position, Vecu& cell_index, size_t level)
 	{
-		cell_linked_lists_levels_[level][cell_index[0]][cell_index[1]].particle_data_lists_
-			.push_back(make_pair(particle_index, position));
+		cell_linked_lists_levels_[level][cell_index[0]][cell_index[1]].insertParticle(particle_index, position);
 	}
 	//=================================================================================================//
 	CellList* MultilevelMeshCellLinkedList::getCellList(Vecu cell_index)
@@ -232,24 +266,25 @@ namespace SPH {
 							CellList* cell_list = cell_lists[num];
 							int i = (int)cell_list->cell_location_[0];
 							int j = (int)cell_list->cell_location_[1];
-							ConcurrentListDataVector& particle_data_lists = cell_list->particle_data_lists_;
+							IndexVector& particle_indexes = cell_list->particle_indexes_;
+							StdVec<Vecd>& particle_positions = cell_list->particle_positions_;
 							for (size_t num = 0; num != cell_list->real_particle_count_; ++num) {
 
-								ListData& list_data = particle_data_lists[num];
-								size_t particle_index_here = list_data.first;
+								size_t particle_index_here = particle_indexes[num];
+								Vecd& particle_position_here = particle_positions[num];
 								Neighborhood& neighborhood_here = inner_configuration[particle_index_here];
 								NeighborList& neighbor_list_here = std::get<0>(neighborhood_here);
 								size_t previous_count_of_neigbors = std::get<2>(neighborhood_here);
 								Vecu number_of_cells = number_of_cells_levels_[level];
 								for (int l = SMAX(i - 1, 0); l <= SMIN(i + 1, int(number_of_cells[0]) - 1); ++l)
 									for (int m = SMAX(j - 1, 0); m <= SMIN(j + 1, int(number_of_cells[1]) - 1); ++m) {
-										ConcurrentListDataVector list_data_targets 
-											= cell_linked_lists[l][m].particle_data_lists_;
-										for (size_t n = 0; n != list_data_targets.size(); ++n)
+										IndexVector& target_particle_indexes = cell_linked_lists[l][m].particle_indexes_;
+										StdVec<Vecd>& target_particle_positions = cell_linked_lists[l][m].particle_positions_;
+										for (size_t n = 0; n != target_particle_indexes.size(); ++n)
 										{
-											size_t particle_index_there = list_data_targets[n].first;
+											size_t particle_index_there = target_particle_indexes[n];
 											//displacement pointing from neighboring particle to origin particle
-											Vecd displacement = list_data.second - list_data_targets[n].second;
+											Vecd displacement = particle_position_here - target_particle_positions[n];
 											if (displacement.norm() < cell_spacing) {
 												//neigbor particles for the original particle
 												size_t current_count_here = std::get<1>(neighborhood_here);
@@ -284,12 +319,46 @@ namespace SPH {
 		}
 	}
 	//=================================================================================================//
+	size_t MeshCellLinkedList::getAdjacentCellLists(Vecd& position, AdjacentCellLists& adjacent_cell_lists)
+	{
+		Vecu cell_location = GridIndexesFromPosition(position);
+		int i = (int)cell_location[0];
+		int j = (int)cell_location[1];
+
+		size_t number_of_adjacent_cells = 0;
+		for (int l = SMAX(i - 1, 0); l <= SMIN(i + 1, int(number_of_cells_[0]) - 1); ++l)
+			for (int m = SMAX(j - 1, 0); m <= SMIN(j + 1, int(number_of_cells_[1]) - 1); ++m)
+				adjacent_cell_lists[number_of_adjacent_cells++] = &cell_linked_lists_[l][m];
+		return number_of_adjacent_cells;
+	}
+	//=================================================================================================//
+	void MeshCellLinkedList::SearchNeighborsAroundPosition(Vecd& position,
+		PositionNeighborFunctor& position_neighbor_functor)
+	{
+		Vecu cell_location = GridIndexesFromPosition(position);
+		int i = (int)cell_location[0];
+		int j = (int)cell_location[1];
+
+		for (int l = SMAX(i - 1, 0); l <= SMIN(i + 1, int(number_of_cells_[0]) - 1); ++l)
+			for (int m = SMAX(j - 1, 0); m <= SMIN(j + 1, int(number_of_cells_[1]) - 1); ++m)
+			{
+				IndexVector& target_particle_indexes = cell_linked_lists_[l][m].particle_indexes_;
+				StdVec<Vecd>& target_particle_positions = cell_linked_lists_[l][m].particle_positions_;
+				for (size_t n = 0; n != target_particle_indexes.size(); ++n)
+				{
+					//displacement pointing from neighboring particle to the position
+					Vecd displacement = position - target_particle_positions[n];
+					if (displacement.norm() <= cutoff_radius_)
+						position_neighbor_functor(target_particle_indexes[n], displacement);
+				}
+			}
+	}
+	//=================================================================================================//
 	void MeshCellLinkedList
 		::InsertACellLinkedListEntry(size_t particle_index, Vecd particle_position)
 	{
 		Vecu cellpos = GridIndexesFromPosition(particle_position);
-		cell_linked_lists_[cellpos[0]][cellpos[1]].particle_data_lists_
-			.emplace_back(make_pair(particle_index, particle_position));
+		cell_linked_lists_[cellpos[0]][cellpos[1]].insertParticle(particle_index, particle_position);
 	}
 //=================================================================================================//
 }
@@ -26,18 +26,19 @@ namespace SPH {
 		for (int l = SMAX(i - 1, 0); l <= SMIN(i + 1, int(number_of_cells_[0]) - 1); ++l)
 			for (int m = SMAX(j - 1, 0); m <= SMIN(j + 1, int(number_of_cells_[1]) - 1); ++m)
 			{
-				ConcurrentListDataVector& target_particles = cell_linked_lists_[l][m].particle_data_lists_;
-				for (size_t n = 0; n != target_particles.size(); ++n)
+				IndexVector& target_particle_indexes = cell_linked_lists_[l][m].particle_indexes_;
+				StdVec<Vecd>& target_particle_positions = cell_linked_lists_[l][m].particle_positions_;
+				for (size_t n = 0; n != target_particle_indexes.size(); ++n)
 				{
 					//displacement pointing from neighboring particle to origin particle
-					Vecd displacement = base_particle_data_i.pos_n_ - target_particles[n].second;
-					if (displacement.norm() <= cell_spacing_ && index_particle_i != target_particles[n].first)
+					Vecd displacement = base_particle_data_i.pos_n_ - target_particle_positions[n];
+					if (displacement.norm() <= cell_spacing_ && index_particle_i != target_particle_indexes[n])
 					{
 						std::get<1>(neighborhood) >= neighbor_list.size() ?
 							neighbor_list.emplace_back(new NeighborRelationType(base_particle_data, *kernel_,
-								displacement, index_particle_i, target_particles[n].first))
+								displacement, index_particle_i, target_particle_indexes[n]))
 							: neighbor_list[std::get<1>(neighborhood)]->resetRelation(base_particle_data , *kernel_,
-								displacement, index_particle_i, target_particles[n].first);
+								displacement, index_particle_i, target_particle_indexes[n]);
 						std::get<1>(neighborhood)++;
 					}
 				}
@@ -55,11 +56,11 @@ namespace SPH {
 		int i = (int)cell_location[0];
 		int j = (int)cell_location[1];
 
-		ConcurrentListDataVector& particle_data_lists_i
-			= cell_list->particle_data_lists_;
-		for (size_t list_index_i = 0; list_index_i != particle_data_lists_i.size(); ++list_index_i)
+		IndexVector& particle_indexes_i = cell_list->particle_indexes_;
+		StdVec<Vecd>& particle_positions_i = cell_list->particle_positions_;
+		for (size_t list_index_i = 0; list_index_i != particle_indexes_i.size(); ++list_index_i)
 		{
-			size_t index_i = particle_data_lists_i[list_index_i].first;
+			size_t index_i = particle_indexes_i[list_index_i];
 			Real index_i_in_real = Real(index_i);
 			Real sigma = W0_;
 			Real index_mean = W0_ * index_i_in_real;
@@ -67,15 +68,16 @@ namespace SPH {
 				for (int m = SMAX(j - 1, 0); m <= SMIN(j + 1, int(number_of_cells_[1]) - 1); ++m)
 				{
 					CellList& target_cell_list = cell_linked_lists_[l][m];
-					ConcurrentListDataVector& target_particle_data_lists = target_cell_list.particle_data_lists_;
-					for (size_t list_index_j = 0; list_index_j != target_particle_data_lists.size(); ++list_index_j)
+					IndexVector& target_particle_indexes = target_cell_list.particle_indexes_;
+					StdVec<Vecd>& target_particle_positions = target_cell_list.particle_positions_;
+					for (size_t list_index_j = 0; list_index_j != target_particle_indexes.size(); ++list_index_j)
 					{
 						//displacement pointing from neighboring particle to origin particle
-						Vecd displacement = particle_data_lists_i[list_index_i].second
-							- target_particle_data_lists[list_index_j].second;
-						size_t index_j = target_particle_data_lists[list_index_j].first;
+						Vecd displacement = particle_positions_i[list_index_i]
+							- target_particle_positions[list_index_j];
+						size_t index_j = target_particle_indexes[list_index_j];
 						if (displacement.norm() <= cell_spacing_ &&
-							particle_data_lists_i[list_index_i].first != target_particle_data_lists[list_index_j].first)
+							particle_indexes_i[list_index_i] != target_particle_indexes[list_index_j])
 						{
 							Real index_j_in_real = Real(index_j);
 							Real W_ij = kernel_->W(displacement);
@@ -90,23 +92,24 @@ namespace SPH {
 				for (int m = SMAX(j - 1, 0); m <= SMIN(j + 1, int(number_of_cells_[1]) - 1); ++m)
 				{
 					CellList& cell_list_there = cell_linked_lists_[l][m];
-					ConcurrentListDataVector& particle_data_lists_there = cell_list_there.particle_data_lists_;
-					for (size_t list_index_there = 0; list_index_there != particle_data_lists_there.size(); ++list_index_there)
+					IndexVector& particle_indexes_there = cell_list_there.particle_indexes_;
+					StdVec<Vecd>& particle_positions_there = cell_list_there.particle_positions_;
+					for (size_t list_index_there = 0; list_index_there != particle_indexes_there.size(); ++list_index_there)
 					{
 						//displacement pointing from neighboring particle to origin particle
-						Vecd displacement_there = particle_data_lists_i[list_index_i].second
-							- particle_data_lists_there[list_index_there].second;
+						Vecd displacement_there = particle_positions_i[list_index_i]
+							- particle_positions_there[list_index_there];
 						if (displacement_there.norm() <= cell_spacing_ &&
-							particle_data_lists_i[list_index_i].first != particle_data_lists_there[list_index_there].first)
+							particle_indexes_i[list_index_i] != particle_indexes_there[list_index_there])
 						{
 							Real W_ij_there = kernel_->W(displacement_there);
 
 							size_t particle_index_here
-								= particle_data_lists_i[list_index_i].first;
+								= particle_indexes_i[list_index_i];
 							Real index_here_in_real = Real(particle_index_here);
 
 							size_t particle_index_there
-								= particle_data_lists_there[list_index_there].first;
+								= particle_indexes_there[list_index_there];
 							Real index_there_in_real = Real(particle_index_there);
 
 							Real index_mean_difference
@@ -119,8 +122,8 @@ namespace SPH {
 
 							if (index_sqr_difference < 0.0 && particles_->allowSwapping(particle_index_here, particle_index_there)) {
 								particles_->swapParticles(particle_index_here, particle_index_there);
-								std::swap(particle_data_lists_i[list_index_i].first,
-									particle_data_lists_there[list_index_there].first);
+								std::swap(particle_indexes_i[list_index_i],
+									particle_indexes_there[list_index_there]);
 								index_mean = new_index_mean;
 							}
 						}
@@ -32,19 +32,4 @@ namespace SPH {
 		body_.number_of_particles_ = number_of_particles;
 	}
 	//===============================================================//
-	Real ParticleGeneratorLattice::ComputeReferenceNumberDensity()
-	{
-		Real sigma(0);
-		Real cutoff_radius = body_.kernel_->GetCutOffRadius();
-		int search_range = int(cutoff_radius / body_.particle_spacing_) + 1;
-		for (int j = - search_range; j <= search_range; ++j)
-			for (int i = - search_range; i <= search_range; ++i)
-			{
-				Point particle_location(Real(i) * lattice_spacing_, Real(j) * lattice_spacing_);
-				if(particle_location.norm() < cutoff_radius)
-					sigma += body_.kernel_->W(particle_location);
-			}
-		return sigma;
-	}
-	//===============================================================//
 }
\ No newline at end of file
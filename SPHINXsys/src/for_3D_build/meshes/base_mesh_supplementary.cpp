@@ -59,7 +59,9 @@ namespace SPH {
 	void MeshBackground
 		::DeleteMeshDataMatrix()
 	{
+		if (mesh_background_data_ == NULL) return;
 		Delete3dArray(mesh_background_data_, number_of_grid_points_);
+		mesh_background_data_ = NULL;
 	}
 	//=================================================================================================//
 	void MeshBackground::InitializeLevelSetData(SPHBody &body)
@@ -254,6 +256,33 @@ namespace SPH {
 		}
 	}
 	//=================================================================================================//
+	void SparseMeshBackground::ComputeCurvatureFromLevelSet(SPHBody &body)
+	{
+		/** Not done in 3D yet, ProbeCurvature exits the program. */
+	}
+	//=================================================================================================//
+	void SparseMeshBackground::WriteMeshToPltFile(ofstream &output_file)
+	{
+		Vecu number_of_operation = number_of_grid_points_;
+
+		output_file << "\n";
+		output_file << "title='View'" << "\n";
+		output_file << "variables= " << "x, " << "y, " << "z, " << "phi, " << "n_x, " << "n_y, " << "n_z, "<< "\n";
+		output_file << "zone i=" << number_of_operation[0] << "  j=" << number_of_operation[1] << "  k=" << number_of_operation[2]
+			<< "  DATAPACKING=POINT  SOLUTIONTIME=" << 0 << "\n";
+
+		for (size_t k = 0; k != number_of_operation[2]; ++k)
+			for (size_t j = 0; j != number_of_operation[1]; ++j)
+				for (size_t i = 0; i != number_of_operation[0]; ++i)
+				{
+					Vecd grid_position = GridPositionFromIndexes(Vecu(i, j, k));
+					LevelSetData& grid_data = getGridData(Vecu(i, j, k));
+					output_file << grid_position[0] << " " << grid_position[1] << " " << grid_position[2] << " "
+						<< grid_data.phi_ << " " << grid_data.n_[0] << " " << grid_data.n_[1] << " "
+						<< grid_data.n_[2] << " \n";
+				}
+	}
+	//=================================================================================================//
 	void LevelSetDataPackage::AllocateMeshDataMatrix()
 	{
 		Allocate3dArray(phi_, number_of_grid_points_);
@@ -70,20 +70,20 @@ namespace SPH
 	{
 		//check lower bound
 		for (size_t i = 0; i != lower_bound_cells_.size(); ++i) {
-			ConcurrentListDataVector& list_data
-				= cell_linked_lists_[lower_bound_cells_[i][0]][lower_bound_cells_[i][1]][lower_bound_cells_[i][2]]
-				.particle_data_lists_;
-			for (size_t num = 0; num < list_data.size(); ++num)
-				CheckLowerBound(list_data[num].first, list_data[num].second, dt);
+			CellList& cell_list = cell_linked_lists_[lower_bound_cells_[i][0]][lower_bound_cells_[i][1]][lower_bound_cells_[i][2]];
+			IndexVector& particle_indexes = cell_list.particle_indexes_;
+			StdVec<Vecd>& particle_positions = cell_list.particle_positions_;
+			for (size_t num = 0; num < particle_indexes.size(); ++num)
+				CheckLowerBound(particle_indexes[num], particle_positions[num], dt);
 		}
 
 		//check upper bound
 		for (size_t i = 0; i != upper_bound_cells_.size(); ++i) {
-			ConcurrentListDataVector& list_data
-				= cell_linked_lists_[upper_bound_cells_[i][0]][upper_bound_cells_[i][1]][upper_bound_cells_[i][2]]
-				.particle_data_lists_;
-			for (size_t num = 0; num < list_data.size(); ++num)
-				CheckUpperBound(list_data[num].first, list_data[num].second, dt);
+			CellList& cell_list = cell_linked_lists_[upper_bound_cells_[i][0]][upper_bound_cells_[i][1]][upper_bound_cells_[i][2]];
+			IndexVector& particle_indexes = cell_list.particle_indexes_;
+			StdVec<Vecd>& particle_positions = cell_list.particle_positions_;
+			for (size_t num = 0; num < particle_indexes.size(); ++num)
+				CheckUpperBound(particle_indexes[num], particle_positions[num], dt);
 		}
 	}
 	//=================================================================================================//
@@ -93,11 +93,11 @@ namespace SPH
 		parallel_for(blocked_range<size_t>(0, lower_bound_cells_.size()),
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i < r.end(); ++i) {
-					ConcurrentListDataVector& list_data
-						= cell_linked_lists_[lower_bound_cells_[i][0]][lower_bound_cells_[i][1]][lower_bound_cells_[i][2]]
-						.particle_data_lists_;
-					for (size_t num = 0; num < list_data.size(); ++num)
-						CheckLowerBound(list_data[num].first, list_data[num].second, dt);
+					CellList& cell_list = cell_linked_lists_[lower_bound_cells_[i][0]][lower_bound_cells_[i][1]][lower_bound_cells_[i][2]];
+					IndexVector& particle_indexes = cell_list.particle_indexes_;
+					StdVec<Vecd>& particle_positions = cell_list.particle_positions_;
+					for (size_t num = 0; num < particle_indexes.size(); ++num)
+						CheckLowerBound(particle_indexes[num], particle_positions[num], dt);
 				}
 			}, ap);
 
@@ -105,11 +105,11 @@ namespace SPH
 		parallel_for(blocked_range<size_t>(0, upper_bound_cells_.size()),
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i < r.end(); ++i) {
-					ConcurrentListDataVector& list_data
-						= cell_linked_lists_[upper_bound_cells_[i][0]][upper_bound_cells_[i][1]][upper_bound_cells_[i][2]]
-						.particle_data_lists_;
-					for (size_t num = 0; num < list_data.size(); ++num)
-						CheckUpperBound(list_data[num].first, list_data[num].second, dt);
+					CellList& cell_list = cell_linked_lists_[upper_bound_cells_[i][0]][upper_bound_cells_[i][1]][upper_bound_cells_[i][2]];
+					IndexVector& particle_indexes = cell_list.particle_indexes_;
+					StdVec<Vecd>& particle_positions = cell_list.particle_positions_;
+					for (size_t num = 0; num < particle_indexes.size(); ++num)
+						CheckUpperBound(particle_indexes[num], particle_positions[num], dt);
 				}
 			}, ap);
 	}
@@ -177,11 +177,10 @@ namespace SPH
 		::exec(Real dt)
 	{
 		for (size_t i = 0; i != bound_cells_.size(); ++i) {
-			ConcurrentListDataVector& list_data
-				= cell_linked_lists_[bound_cells_[i][0]][bound_cells_[i][1]][bound_cells_[i][2]]
-				.particle_data_lists_;
-			for (size_t num = 0; num < list_data.size(); ++num)
-				checking_bound_(list_data[num].first, dt);
+			CellList& cell_list = cell_linked_lists_[bound_cells_[i][0]][bound_cells_[i][1]][bound_cells_[i][2]];
+			IndexVector& particle_indexes = cell_list.particle_indexes_;
+			for (size_t num = 0; num < particle_indexes.size(); ++num)
+				checking_bound_(particle_indexes[num], dt);
 		}
 	}
 	//=================================================================================================//
@@ -191,11 +190,10 @@ namespace SPH
 		parallel_for(blocked_range<size_t>(0, bound_cells_.size()),
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i < r.end(); ++i) {
-					ConcurrentListDataVector& list_data
-						= cell_linked_lists_[bound_cells_[i][0]][bound_cells_[i][1]][bound_cells_[i][2]]
-						.particle_data_lists_;
-					for (size_t num = 0; num < list_data.size(); ++num)
-						checking_bound_(list_data[num].first, dt);
+					CellList& cell_list = cell_linked_lists_[bound_cells_[i][0]][bound_cells_[i][1]][bound_cells_[i][2]];
+					IndexVector& particle_indexes = cell_list.particle_indexes_;
+					for (size_t num = 0; num < particle_indexes.size(); ++num)
+						checking_bound_(particle_indexes[num], dt);
 				}
 			}, ap);
 	}
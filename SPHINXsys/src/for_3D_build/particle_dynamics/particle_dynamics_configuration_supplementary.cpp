@@ -30,18 +30,19 @@ namespace SPH {
 			{
 				for (int q = SMAX(k - 1, 0); q <= SMIN(k + 1, int(number_of_cells_[2]) - 1); ++q)
 				{
-					ConcurrentListDataVector& target_particles = cell_linked_lists_[l][m][q].particle_data_lists_;
-					for (size_t n = 0; n != target_particles.size(); ++n)
+					IndexVector& target_particle_indexes = cell_linked_lists_[l][m][q].particle_indexes_;
+					StdVec<Vecd>& target_particle_positions = cell_linked_lists_[l][m][q].particle_positions_;
+					for (size_t n = 0; n != target_particle_indexes.size(); ++n)
 					{
 						//displacement pointing from neighboring particle to origin particle
-						Vecd displacement = base_particle_data_i.pos_n_ - target_particles[n].second;
-						if (displacement.norm() <= cell_spacing_ && index_particle_i != target_particles[n].first)
+						Vecd displacement = base_particle_data_i.pos_n_ - target_particle_positions[n];
+						if (displacement.norm() <= cell_spacing_ && index_particle_i != target_particle_indexes[n])
 						{
 							std::get<1>(neighborhood) >= neighbor_list.size() ?
 								neighbor_list.push_back(new NeighborRelationType(base_particle_data, *kernel_,
-									displacement, index_particle_i, target_particles[n].first))
+									displacement, index_particle_i, target_particle_indexes[n]))
 								: neighbor_list[std::get<1>(neighborhood)]->resetRelation(base_particle_data, *kernel_,
-									displacement, index_particle_i, target_particles[n].first);
+									displacement, index_particle_i, target_particle_indexes[n]);
 							std::get<1>(neighborhood)++;
 						}
 					}
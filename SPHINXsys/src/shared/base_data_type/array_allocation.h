@@ -2,19 +2,51 @@
 #define ARRAYALLOCATE_H
 
 #include "small_vectors.h"
+#include "large_data_containers.h"
 
 namespace SPH {
+	//-------------------------------------------------------------------------------------------------
+	//Allocate and deallocate contiguous data for multi-dimensional arrays.
+	//The data are allocated by the huge page allocator, and constructed in parallel,
+	//so that the pages are first touched by the threads which use them later.
+	//A local partitioner is used, as the allocation may be called inside parallel loops.
+	//-------------------------------------------------------------------------------------------------
+	template<class T>
+	T* AllocateContiguousData(size_t size)
+	{
+		if (size == 0) return nullptr;
+		T* data = HugePageAllocator<T>().allocate(size);
+		ParallelPartitioner allocation_partitioner;
+		parallel_for(blocked_range<size_t>(0, size),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t n = r.begin(); n != r.end(); ++n) new (data + n) T();
+			}, allocation_partitioner);
+		return data;
+	}
+
+	template<class T>
+	void DeleteContiguousData(T* data, size_t size)
+	{
+		if (size == 0) return;
+		ParallelPartitioner allocation_partitioner;
+		parallel_for(blocked_range<size_t>(0, size),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t n = r.begin(); n != r.end(); ++n) data[n].~T();
+			}, allocation_partitioner);
+		HugePageAllocator<T>().deallocate(data, size);
+	}
 	//-------------------------------------------------------------------------------------------------
 	//Allocate and deallocate 3d array
 	//-------------------------------------------------------------------------------------------------
 	template<class T>
 	void Allocate3dArray(T*** &matrix, Vec3u res)
 	{
+		T* data = AllocateContiguousData<T>(res[0] * res[1] * res[2]);
 		matrix = new T**[res[0]];
 		for (size_t i = 0; i < res[0]; i++) {
 			matrix[i] = new T*[res[1]];
 			for (size_t j = 0; j < res[1]; j++) {
-				matrix[i][j] = new T[res[2]];
+				matrix[i][j] = data + (i * res[1] + j) * res[2];
 			}
 		}
 	}
@@ -22,10 +54,9 @@ namespace SPH {
 	template<class T>
 	void Delete3dArray(T*** matrix, Vec3u res)
 	{
+		size_t size = res[0] * res[1] * res[2];
+		DeleteContiguousData(size == 0 ? nullptr : matrix[0][0], size);
 		for (size_t i = 0; i < res[0]; i++) {
-			for (size_t j = 0; j < res[1]; j++) {
-				delete[] matrix[i][j];
-			}
 			delete[] matrix[i];
 		}
 		delete[] matrix;
@@ -36,17 +67,17 @@ namespace SPH {
 	template<class T>
 	void Allocate2dArray(T** &matrix, Vec2u res)
 	{
+		T* data = AllocateContiguousData<T>(res[0] * res[1]);
 		matrix = new T*[res[0]];
 		for (size_t i = 0; i < res[0]; i++) {
-			matrix[i] = new T[res[1]];
+			matrix[i] = data + i * res[1];
 		}
 	}
 	template<class T>
 	void Delete2dArray(T** matrix, Vec2u res)
 	{
-		for (size_t i = 0; i < res[0]; i++) {
-			delete[] matrix[i];
-		}
+		size_t size = res[0] * res[1];
+		DeleteContiguousData(size == 0 ? nullptr : matrix[0], size);
 		delete[] matrix;
 	}
 
@@ -0,0 +1,118 @@
+/**
+ * @file 	huge_page_allocator.cpp
+ * @author	Xiangyu Hu and Chi Zhang
+ * @version	0.1
+ */
+
+#include "huge_page_allocator.h"
+//=================================================================================================//
+namespace SPH {
+	//=================================================================================================//
+	/** The part of a chunk not yet carved by a thread. */
+	struct ChunkRemainder
+	{
+		char* begin_;
+		char* end_;
+		size_t chunk_generation_;
+	};
+	static thread_local ChunkRemainder chunk_remainder = { NULL, NULL, 0 };
+	//=================================================================================================//
+	HugePagePool::HugePagePool()
+		: free_blocks_(new tbb::concurrent_queue<void*>[number_of_size_classes]),
+		number_of_used_blocks_(0), chunk_generation_(0) {}
+	//=================================================================================================//
+	HugePagePool& HugePagePool::pool()
+	{
+		static HugePagePool* huge_page_pool = new HugePagePool();
+		return *huge_page_pool;
+	}
+	//=================================================================================================//
+	bool HugePagePool::isUsed()
+	{
+		static const bool is_used = hugePageAllocation();
+		return is_used;
+	}
+	//=================================================================================================//
+	size_t HugePagePool::allocatedBytes(size_t bytes)
+	{
+		if (!isUsed() || bytes > largest_block_size || bytes == 0) return bytes;
+		return smallest_block_size << pool().sizeClass(bytes);
+	}
+	//=================================================================================================//
+	char* HugePagePool::allocateChunk()
+	{
+		char* chunk = HugePageAllocator<char>().allocate(huge_page_size);
+		std::lock_guard<std::mutex> lock(chunk_mutex_);
+		chunks_.push_back(chunk);
+		return chunk;
+	}
+	//=================================================================================================//
+	size_t HugePagePool::sizeClass(size_t bytes)
+	{
+		size_t size_class = 0;
+		for (size_t block_size = smallest_block_size; block_size < bytes; block_size *= 2) size_class++;
+		return size_class;
+	}
+	//=================================================================================================//
+	void* HugePagePool::allocate(size_t bytes)
+	{
+		if (!isUsed()) return ::operator new(bytes);
+		if (bytes > largest_block_size) return HugePageAllocator<char>().allocate(bytes);
+
+		number_of_used_blocks_++;
+		size_t size_class = sizeClass(bytes);
+		void* block = NULL;
+		if (free_blocks_[size_class].try_pop(block)) return block;
+
+		/** The remainder of a chunk which has been released is discarded. */
+		if (chunk_remainder.chunk_generation_ != chunk_generation_)
+		{
+			chunk_remainder.begin_ = NULL;
+			chunk_remainder.end_ = NULL;
+			chunk_remainder.chunk_generation_ = chunk_generation_;
+		}
+		/** The blocks are aligned by their sizes, which divide the chunk size. */
+		size_t block_size = smallest_block_size << size_class;
+		uintptr_t address = reinterpret_cast<uintptr_t>(chunk_remainder.begin_);
+		char* aligned_begin = chunk_remainder.begin_ + ((block_size - address % block_size) % block_size);
+		if (chunk_remainder.begin_ == NULL || aligned_begin + block_size > chunk_remainder.end_)
+		{
+			aligned_begin = allocateChunk();
+			chunk_remainder.end_ = aligned_begin + huge_page_size;
+		}
+		chunk_remainder.begin_ = aligned_begin + block_size;
+		return aligned_begin;
+	}
+	//=================================================================================================//
+	void HugePagePool::deallocate(void* block, size_t bytes)
+	{
+		if (block == NULL) return;
+		if (!isUsed())
+		{
+			::operator delete(block);
+			return;
+		}
+		if (bytes > largest_block_size)
+		{
+			HugePageAllocator<char>().deallocate(static_cast<char*>(block), bytes);
+			return;
+		}
+		free_blocks_[sizeClass(bytes)].push(block);
+		number_of_used_blocks_--;
+	}
+	//=================================================================================================//
+	void HugePagePool::releaseUnusedChunks()
+	{
+		std::lock_guard<std::mutex> lock(chunk_mutex_);
+		if (number_of_used_blocks_ != 0 || chunks_.empty()) return;
+
+		void* block = NULL;
+		for (size_t size_class = 0; size_class != number_of_size_classes; ++size_class)
+			while (free_blocks_[size_class].try_pop(block)) {};
+		for (size_t i = 0; i != chunks_.size(); ++i)
+			HugePageAllocator<char>().deallocate(chunks_[i], huge_page_size);
+		std::vector<char*>().swap(chunks_);
+		chunk_generation_++;
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,198 @@
+/**
+ * @file 	huge_page_allocator.h
+ * @brief 	Allocators for large particle, mesh and configuration arrays,
+ *			and for the many small neighbor lists and neighbor relations,
+ *			which request transparent huge pages on Linux.
+ * @details Large arrays are aligned to 2 MB pages and advised for huge pages
+ *			so that the TLB misses in random-access neighbor loops are reduced.
+ *			Small objects are carved from chunks of a huge page by a pool.
+ *			The huge pages are switched on at runtime, before particles and meshes are allocated.
+ *			Otherwise, or on other platforms, the allocator falls back to cache aligned allocation.
+ * @author	Xiangyu Hu and Chi Zhang
+ * @version	0.1
+ */
+#ifndef SPHINXSYS_HUGE_PAGE_ALLOCATOR_H
+#define SPHINXSYS_HUGE_PAGE_ALLOCATOR_H
+
+#include "tbb/cache_aligned_allocator.h"
+#include "tbb/concurrent_queue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace SPH {
+	/** Size and alignment of a transparent huge page. */
+	const size_t huge_page_size = 2 * 1024 * 1024;
+	/** Alignment for the arrays smaller than a huge page, avoiding false sharing. */
+	const size_t cache_line_alignment = 128;
+
+	/** Runtime switch of huge page allocation, false by default. */
+	inline std::atomic<bool>& hugePageAllocation()
+	{
+		static std::atomic<bool> huge_page_allocation(false);
+		return huge_page_allocation;
+	}
+	/** Switch huge page allocation on or off for the arrays allocated afterwards. */
+	inline void setHugePageAllocation(bool is_enabled) { hugePageAllocation() = is_enabled; }
+
+	/**
+	 * @class HugePageAllocator
+	 * @brief Standard allocator using transparent huge pages for large arrays.
+	 * On Linux, all memory is obtained by aligned allocation and released by free,
+	 * so that switching the huge pages at runtime does not affect the deallocation.
+	 */
+	template <typename T>
+	class HugePageAllocator
+	{
+	public:
+		typedef T value_type;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+		template <typename U> struct rebind { typedef HugePageAllocator<U> other; };
+
+		HugePageAllocator() {};
+		template <typename U> HugePageAllocator(const HugePageAllocator<U>&) {};
+
+		T* allocate(size_t n, const void* hint = 0)
+		{
+#ifdef __linux__
+			size_t bytes = n * sizeof(T);
+			bool use_huge_pages = hugePageAllocation() && bytes >= huge_page_size;
+			void* memory = NULL;
+			if (posix_memalign(&memory, use_huge_pages ? huge_page_size : cache_line_alignment,
+				bytes == 0 ? cache_line_alignment : bytes) != 0) throw std::bad_alloc();
+			/** Failing advice is not an error, the memory is then backed by normal pages. */
+			if (use_huge_pages) madvise(memory, bytes, MADV_HUGEPAGE);
+			return static_cast<T*>(memory);
+#else
+			return tbb::cache_aligned_allocator<T>().allocate(n, hint);
+#endif
+		};
+
+		void deallocate(T* p, size_t n)
+		{
+#ifdef __linux__
+			free(p);
+#else
+			tbb::cache_aligned_allocator<T>().deallocate(p, n);
+#endif
+		};
+
+		size_t max_size() const { return size_t(-1) / sizeof(T); };
+
+		template <typename U, typename... Args>
+		void construct(U* p, Args&&... args) { ::new((void*)p) U(std::forward<Args>(args)...); };
+		template <typename U>
+		void destroy(U* p) { p->~U(); };
+	};
+
+	template <typename T, typename U>
+	bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&) { return true; }
+	template <typename T, typename U>
+	bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&) { return false; }
+
+	/**
+	 * @class HugePagePool
+	 * @brief Pool for small objects, such as neighbor relations and neighbor lists,
+	 * which are carved from chunks of one huge page each, so that the objects
+	 * of neighboring particles share a few TLB entries.
+	 * The blocks are of sizes in powers of two, each thread carves from its own chunk,
+	 * and released blocks are kept in concurrent free lists for reuse.
+	 * Objects larger than the largest block are allocated by HugePageAllocator directly.
+	 * The pool is only used if the huge pages are switched on before its first allocation,
+	 * otherwise, the objects are allocated by the global operator new.
+	 * The chunks are returned to the system by releaseUnusedChunks() when all blocks are released.
+	 * The cell lists are not allocated from the pool, as their vectors are reused
+	 * with their capacities for all updates and are released with the mesh.
+	 * The pool object lives until the end of the process.
+	 */
+	class HugePagePool
+	{
+		std::mutex chunk_mutex_;
+		std::vector<char*> chunks_;
+		tbb::concurrent_queue<void*>* free_blocks_;
+		/** number of the blocks carved from the chunks and not released */
+		std::atomic<size_t> number_of_used_blocks_;
+		/** increased when the chunks are released, so that the chunk remainders of all threads are discarded */
+		std::atomic<size_t> chunk_generation_;
+
+		HugePagePool();
+		/** Get a new chunk of one huge page. */
+		char* allocateChunk();
+		/** Index of the size class of the blocks for a number of bytes. */
+		size_t sizeClass(size_t bytes);
+	public:
+		/** the smallest and largest block sizes */
+		static const size_t smallest_block_size = 32;
+		static const size_t largest_block_size = 4096;
+		static const size_t number_of_size_classes = 8;
+
+		/** The only pool of the process, which is never destroyed,
+		  * so that objects can be released after static destruction. */
+		static HugePagePool& pool();
+		/** Whether the pool is used, decided by the huge page switch at the first allocation. */
+		static bool isUsed();
+		/** Bytes actually allocated for a request, i.e. the block size if the pool is used. */
+		static size_t allocatedBytes(size_t bytes);
+
+		void* allocate(size_t bytes);
+		void deallocate(void* block, size_t bytes);
+		/** Return the chunks to the system if no block is in use, e.g. after a system is destroyed.
+		  * It should not be called concurrently with allocations. */
+		void releaseUnusedChunks();
+	};
+
+	/**
+	 * @class HugePagePoolAllocator
+	 * @brief Standard allocator for small containers, using the huge page pool.
+	 */
+	template <typename T>
+	class HugePagePoolAllocator
+	{
+	public:
+		typedef T value_type;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+		template <typename U> struct rebind { typedef HugePagePoolAllocator<U> other; };
+
+		HugePagePoolAllocator() {};
+		template <typename U> HugePagePoolAllocator(const HugePagePoolAllocator<U>&) {};
+
+		T* allocate(size_t n, const void* hint = 0)
+		{
+			return static_cast<T*>(HugePagePool::pool().allocate(n * sizeof(T)));
+		};
+		void deallocate(T* p, size_t n) { HugePagePool::pool().deallocate(p, n * sizeof(T)); };
+
+		size_t max_size() const { return size_t(-1) / sizeof(T); };
+
+		template <typename U, typename... Args>
+		void construct(U* p, Args&&... args) { ::new((void*)p) U(std::forward<Args>(args)...); };
+		template <typename U>
+		void destroy(U* p) { p->~U(); };
+	};
+
+	template <typename T, typename U>
+	bool operator==(const HugePagePoolAllocator<T>&, const HugePagePoolAllocator<U>&) { return true; }
+	template <typename T, typename U>
+	bool operator!=(const HugePagePoolAllocator<T>&, const HugePagePoolAllocator<U>&) { return false; }
+}
+
+#endif // SPHINXSYS_HUGE_PAGE_ALLOCATOR_H
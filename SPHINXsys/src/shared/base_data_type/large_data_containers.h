@@ -13,11 +13,88 @@
 #include "tbb/concurrent_unordered_set.h"
 #include "tbb/concurrent_vector.h"
 #include "tbb/cache_aligned_allocator.h"
+#include "tbb/task_arena.h"
 
-using namespace tbb;
-static tbb::affinity_partitioner ap;
+#include "huge_page_allocator.h"
 
 #include <array>
+#include <atomic>
+
+using namespace tbb;
+
+namespace SPH {
+	/** Partitioners for the parallel loops, which can be chosen at runtime. */
+	enum class PartitionerType { affinity, automatic, simple, static_partitioner };
+
+	/** Runtime choice of the partitioner, the affinity partitioner by default. */
+	inline std::atomic<PartitionerType>& partitionerType()
+	{
+		static std::atomic<PartitionerType> partitioner_type(PartitionerType::affinity);
+		return partitioner_type;
+	}
+	inline void setPartitionerType(PartitionerType partitioner_type) { partitionerType() = partitioner_type; }
+
+	/** Runtime switch for executing all parallel loops sequentially, false by default. */
+	inline std::atomic<bool>& serialExecution()
+	{
+		static std::atomic<bool> serial_execution(false);
+		return serial_execution;
+	}
+	inline void setSerialExecution(bool is_serial) { serialExecution() = is_serial; }
+
+	/**
+	 * @class ParallelPartitioner
+	 * @brief The partitioner handle passed to all parallel loops.
+	 * It dispatches a loop to the partitioner chosen at runtime, or executes it sequentially.
+	 * The affinity partitioner state is kept for the affinity between repeated loops.
+	 */
+	class ParallelPartitioner
+	{
+	public:
+		tbb::affinity_partitioner affinity_partitioner_;
+	};
+
+	/** Parallel for-loop with the runtime chosen partitioner. */
+	template <typename Range, typename Body>
+	void parallel_for(const Range& range, const Body& body, ParallelPartitioner& partitioner)
+	{
+		if (serialExecution()) { body(range); return; }
+		switch (partitionerType())
+		{
+		case PartitionerType::automatic:
+			tbb::parallel_for(range, body, tbb::auto_partitioner()); break;
+		case PartitionerType::simple:
+			tbb::parallel_for(range, body, tbb::simple_partitioner()); break;
+		case PartitionerType::static_partitioner:
+			tbb::parallel_for(range, body, tbb::static_partitioner()); break;
+		default:
+			tbb::parallel_for(range, body, partitioner.affinity_partitioner_);
+		}
+	}
+
+	/** Parallel reduce with the runtime chosen partitioner. */
+	template <typename Range, typename Value, typename RealBody, typename Reduction>
+	Value parallel_reduce(const Range& range, const Value& identity, const RealBody& real_body,
+		const Reduction& reduction, ParallelPartitioner& partitioner)
+	{
+		if (serialExecution()) return real_body(range, identity);
+		switch (partitionerType())
+		{
+		case PartitionerType::automatic:
+			return tbb::parallel_reduce(range, identity, real_body, reduction, tbb::auto_partitioner());
+		case PartitionerType::simple:
+			return tbb::parallel_reduce(range, identity, real_body, reduction, tbb::simple_partitioner());
+		case PartitionerType::static_partitioner:
+			return tbb::parallel_reduce(range, identity, real_body, reduction, tbb::static_partitioner());
+		default:
+			return tbb::parallel_reduce(range, identity, real_body, reduction, partitioner.affinity_partitioner_);
+		}
+	}
+}
+
+/** The partitioner keeps the affinity of the calling thread,
+  * so that concurrent SPH systems do not share its state. */
+static thread_local SPH::ParallelPartitioner ap;
 
 namespace SPH {
 
@@ -25,7 +102,7 @@ namespace SPH {
 	using LargeVec = tbb::concurrent_vector<T>;
 
 	template <typename T>
-	using StdLargeVec = std::vector<T, cache_aligned_allocator<T>>;
+	using StdLargeVec = std::vector<T, HugePageAllocator<T>>;
 
 	template <typename T>
 	using StdVec = std::vector<T>;
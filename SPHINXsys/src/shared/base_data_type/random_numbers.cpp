@@ -0,0 +1,78 @@
+/**
+ * @file 	random_numbers.cpp
+ * @author	Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "random_numbers.h"
+//=================================================================================================//
+namespace SPH {
+	//=================================================================================================//
+	void CounterBasedRandomNumbers::PhiloxRounds(uint32_t(&counter)[4], uint32_t key_0, uint32_t key_1)
+	{
+		const uint64_t multiplier_0 = 0xD2511F53, multiplier_1 = 0xCD9E8D57;
+		const uint32_t weyl_0 = 0x9E3779B9, weyl_1 = 0xBB67AE85;
+		for (int round = 0; round != 10; ++round)
+		{
+			uint64_t product_0 = multiplier_0 * counter[0];
+			uint64_t product_1 = multiplier_1 * counter[2];
+			uint32_t high_0 = uint32_t(product_0 >> 32), low_0 = uint32_t(product_0);
+			uint32_t high_1 = uint32_t(product_1 >> 32), low_1 = uint32_t(product_1);
+			counter[0] = high_1 ^ counter[1] ^ key_0;
+			counter[1] = low_1;
+			counter[2] = high_0 ^ counter[3] ^ key_1;
+			counter[3] = low_0;
+			key_0 += weyl_0;
+			key_1 += weyl_1;
+		}
+	}
+	//=================================================================================================//
+	void CounterBasedRandomNumbers::RandomIntegers(size_t particle_id, size_t step, uint32_t(&random_integers)[4])
+	{
+		uint64_t id = particle_id, counted_step = step, seed = random_seed_;
+		random_integers[0] = uint32_t(id);
+		random_integers[1] = uint32_t(id >> 32);
+		random_integers[2] = uint32_t(counted_step);
+		random_integers[3] = uint32_t(counted_step >> 32);
+		PhiloxRounds(random_integers, uint32_t(seed), uint32_t(seed >> 32));
+	}
+	//=================================================================================================//
+	void CounterBasedRandomNumbers::UniformRandomNumbers(size_t particle_id, size_t step, Real(&random_numbers)[4])
+	{
+		uint32_t random_integers[4];
+		RandomIntegers(particle_id, step, random_integers);
+		/** shifted by half an interval so that neither 0 nor 1 is obtained */
+		for (int i = 0; i != 4; ++i)
+			random_numbers[i] = (Real(random_integers[i]) + 0.5) / 4294967296.0;
+	}
+	//=================================================================================================//
+	Vecd CounterBasedRandomNumbers::UniformRandomVector(size_t particle_id, size_t step)
+	{
+		Real random_numbers[4];
+		UniformRandomNumbers(particle_id, step, random_numbers);
+		Vecd random_vector(0);
+		for (int i = 0; i != random_vector.size(); ++i)
+			random_vector[i] = 2.0 * random_numbers[i] - 1.0;
+		return random_vector;
+	}
+	//=================================================================================================//
+	Vecd CounterBasedRandomNumbers::GaussianRandomVector(size_t particle_id, size_t step)
+	{
+		Real random_numbers[4];
+		UniformRandomNumbers(particle_id, step, random_numbers);
+		/** Box-Muller transform, each pair of uniform numbers gives two normal numbers */
+		Real normal_numbers[4];
+		for (int i = 0; i != 2; ++i)
+		{
+			Real radius = sqrt(-2.0 * log(random_numbers[2 * i]));
+			Real angle = 2.0 * pi * random_numbers[2 * i + 1];
+			normal_numbers[2 * i] = radius * cos(angle);
+			normal_numbers[2 * i + 1] = radius * sin(angle);
+		}
+		Vecd random_vector(0);
+		for (int i = 0; i != random_vector.size(); ++i)
+			random_vector[i] = normal_numbers[i];
+		return random_vector;
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,49 @@
+/**
+ * @file 	random_numbers.h
+ * @brief 	Counter-based random numbers for stochastic particle dynamics.
+ * @details The random numbers are given by the Philox4x32-10 generator keyed by a seed,
+ *			and counted by a particle id and a step. As there is no sequential state
+ *			shared by the particles, they are generated in parallel identically
+ *			for any number of threads, and the state to be kept for restarting
+ *			is only the seed and the current step.
+ * @author	Xiangyu Hu
+ * @version	0.1
+ */
+#pragma once
+
+#include "base_data_package.h"
+
+#include <cstdint>
+
+namespace SPH
+{
+	/**
+	 * @class CounterBasedRandomNumbers
+	 * @brief Random numbers of a SPH system shared by all its particle dynamics.
+	 * A stochastic dynamics takes a new step in its setup,
+	 * and then generates the random numbers for each particle by its particle id and the step.
+	 */
+	class CounterBasedRandomNumbers
+	{
+		/** Philox4x32-10 rounds for the counter given by four 32-bit integers. */
+		void PhiloxRounds(uint32_t(&counter)[4], uint32_t key_0, uint32_t key_1);
+	public:
+		explicit CounterBasedRandomNumbers(size_t random_seed = 0)
+			: random_seed_(random_seed), random_step_(0) {};
+		virtual ~CounterBasedRandomNumbers() {};
+
+		/** seed of the random numbers, and the number of steps taken */
+		size_t random_seed_, random_step_;
+
+		/** Take a new step, called once in the setup of a stochastic dynamics. */
+		size_t TakeNewStep() { return random_step_++; };
+		/** Four independent 32-bit random integers of a particle at a step. */
+		void RandomIntegers(size_t particle_id, size_t step, uint32_t(&random_integers)[4]);
+		/** Four random numbers with uniform distribution in (0, 1). */
+		void UniformRandomNumbers(size_t particle_id, size_t step, Real(&random_numbers)[4]);
+		/** Random vector with each component uniformly distributed in (-1, 1). */
+		Vecd UniformRandomVector(size_t particle_id, size_t step);
+		/** Random vector with each component of standard normal distribution. */
+		Vecd GaussianRandomVector(size_t particle_id, size_t step);
+	};
+}
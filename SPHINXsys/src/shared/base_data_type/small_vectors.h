@@ -273,6 +273,7 @@ namespace SPH {
 	using Vec1d = SimTK::Vec1;
 	using Vec2d = SimTK::Vec2;
 	using Vec3d = SimTK::Vec3;
+	using Vec4d = SimTK::Vec4;
 
 	//small matrix with double float number
 	using Mat1d = SimTK::Mat11;
@@ -0,0 +1,386 @@
+/**
+ * @file 	voxel_shape.cpp
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "voxel_shape.h"
+
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace SPH
+{
+	//=================================================================================================//
+	VoxelImage::VoxelImage(string header_file)
+		: dimensions_(0), spacing_(1.0), origin_(0)
+	{
+		ifstream header(header_file.c_str());
+		if (!header.is_open())
+		{
+			std::cout << "\n Error: the voxel image header " << header_file << " is not found!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
+		int dimension = Vecd(0).size();
+		string element_type = "MET_UCHAR";
+		string data_file = "";
+		bool is_msb = false;
+		streamoff data_offset = 0;
+		string line;
+		while (std::getline(header, line))
+		{
+			size_t separator = line.find('=');
+			if (separator == string::npos) continue;
+			string key = line.substr(0, separator);
+			key.erase(key.find_last_not_of(" \t\r") + 1);
+			key.erase(0, key.find_first_not_of(" \t"));
+			istringstream values(line.substr(separator + 1));
+
+			if (key == "NDims")
+			{
+				int number_of_dimensions = 0;
+				values >> number_of_dimensions;
+				if (number_of_dimensions != dimension)
+				{
+					std::cout << "\n Error: the voxel image " << header_file << " has " << number_of_dimensions
+						<< " dimensions, while the build is " << dimension << "d!" << std::endl;
+					std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+					exit(1);
+				}
+			}
+			else if (key == "DimSize") for (int i = 0; i != dimension; ++i) values >> dimensions_[i];
+			else if (key == "ElementSpacing" || key == "ElementSize")
+				for (int i = 0; i != dimension; ++i) values >> spacing_[i];
+			else if (key == "Offset" || key == "Origin" || key == "Position")
+				for (int i = 0; i != dimension; ++i) values >> origin_[i];
+			else if (key == "ElementType") values >> element_type;
+			else if (key == "BinaryDataByteOrderMSB" || key == "ElementByteOrderMSB")
+			{
+				string is_true;
+				values >> is_true;
+				is_msb = (is_true == "True" || is_true == "true");
+			}
+			else if (key == "ElementDataFile")
+			{
+				/** The data file is the last entry of the header. */
+				values >> data_file;
+				if (data_file == "LOCAL")
+				{
+					data_file = header_file;
+					data_offset = header.tellg();
+				}
+				else
+				{
+					size_t directory_end = header_file.find_last_of("/\\");
+					if (directory_end != string::npos)
+						data_file = header_file.substr(0, directory_end + 1) + data_file;
+				}
+				break;
+			}
+		}
+		header.close();
+
+		if (data_file == "")
+		{
+			std::cout << "\n Error: no ElementDataFile is given in the voxel image header " << header_file << "!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		readRawData(data_file, element_type, is_msb, data_offset);
+	}
+	//=================================================================================================//
+	VoxelImage::VoxelImage(string raw_file, Vecu dimensions, Vecd spacing, Vecd origin)
+		: dimensions_(dimensions), spacing_(spacing), origin_(origin)
+	{
+		readRawData(raw_file, "MET_UCHAR", false, 0);
+	}
+	//=================================================================================================//
+	void VoxelImage::readRawData(string raw_file, string element_type, bool is_msb, streamoff data_offset)
+	{
+		/** A missing DimSize or ElementSpacing in the header would give an empty or degenerate image. */
+		for (int i = 0; i != Vecd(0).size(); ++i)
+			if (dimensions_[i] == 0 || !(spacing_[i] > 0.0))
+			{
+				std::cout << "\n Error: the voxel image of " << raw_file << " has the dimensions " << dimensions_
+					<< " and the spacing " << spacing_ << ", which should be positive!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+
+		size_t element_size = 0;
+		bool is_signed = false;
+		if (element_type == "MET_UCHAR") element_size = 1;
+		else if (element_type == "MET_CHAR") { element_size = 1; is_signed = true; }
+		else if (element_type == "MET_USHORT") element_size = 2;
+		else if (element_type == "MET_SHORT") { element_size = 2; is_signed = true; }
+		else if (element_type == "MET_UINT") element_size = 4;
+		else if (element_type == "MET_INT") { element_size = 4; is_signed = true; }
+		else
+		{
+			std::cout << "\n Error: the voxel element type " << element_type << " is not a label type!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
+		size_t number_of_voxels = 1;
+		for (int i = 0; i != Vecd(0).size(); ++i) number_of_voxels *= dimensions_[i];
+
+		ifstream raw_data(raw_file.c_str(), ios::binary);
+		if (!raw_data.is_open())
+		{
+			std::cout << "\n Error: the voxel data file " << raw_file << " is not found!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		raw_data.seekg(data_offset);
+		std::vector<unsigned char> bytes(number_of_voxels * element_size);
+		raw_data.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+		if (size_t(raw_data.gcount()) != bytes.size())
+		{
+			std::cout << "\n Error: the voxel data file " << raw_file << " has less than "
+				<< number_of_voxels << " voxels!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		raw_data.close();
+
+		labels_.resize(number_of_voxels);
+		std::atomic<bool> is_label_out_of_range(false);
+		parallel_for(blocked_range<size_t>(0, number_of_voxels),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					/** Assemble the bytes explicitly, so that the result is independent of the host byte order. */
+					unsigned long value = 0;
+					for (size_t b = 0; b != element_size; ++b)
+					{
+						size_t byte = is_msb ? b : element_size - 1 - b;
+						value = (value << 8) | bytes[i * element_size + byte];
+					}
+					bool is_negative = is_signed && (value >> (8 * element_size - 1)) != 0;
+					if (is_negative || value > 65535) is_label_out_of_range = true;
+					labels_[i] = (is_negative || value > 65535) ? 0 : uint16_t(value);
+				}
+			}, ap);
+
+		if (is_label_out_of_range)
+			std::cout << "\n Warning: labels out of the range [0, 65535] in " << raw_file
+				<< " are taken as background!" << std::endl;
+	}
+	//=================================================================================================//
+	size_t VoxelImage::transferVoxelIndexTo1D(Vecu voxel_index)
+	{
+		size_t index_1d = 0;
+		for (int i = Vecd(0).size() - 1; i >= 0; --i)
+			index_1d = index_1d * dimensions_[i] + voxel_index[i];
+		return index_1d;
+	}
+	//=================================================================================================//
+	Vecu VoxelImage::transfer1DtoVoxelIndex(size_t i)
+	{
+		Vecu voxel_index;
+		for (int k = 0; k != Vecd(0).size(); ++k)
+		{
+			voxel_index[k] = i % dimensions_[k];
+			i /= dimensions_[k];
+		}
+		return voxel_index;
+	}
+	//=================================================================================================//
+	Vecd VoxelImage::VoxelPositionFromIndex(Vecu voxel_index)
+	{
+		Vecd position;
+		for (int i = 0; i != Vecd(0).size(); ++i)
+			position[i] = origin_[i] + Real(voxel_index[i]) * spacing_[i];
+		return position;
+	}
+	//=================================================================================================//
+	bool VoxelImage::VoxelIndexFromPosition(Vecd& position, Vecu& voxel_index)
+	{
+		for (int i = 0; i != Vecd(0).size(); ++i)
+		{
+			Real index = floor((position[i] - origin_[i]) / spacing_[i] + 0.5);
+			if (index < 0.0 || index >= Real(dimensions_[i])) return false;
+			voxel_index[i] = size_t(index);
+		}
+		return true;
+	}
+	//=================================================================================================//
+	int VoxelImage::probeLabel(Vecd position)
+	{
+		Vecu voxel_index;
+		return VoxelIndexFromPosition(position, voxel_index) ? getLabel(voxel_index) : 0;
+	}
+	//=================================================================================================//
+	VoxelShape::VoxelShape(VoxelImage& voxel_image, std::set<int> labels, string shape_name)
+		: Shape(shape_name), voxel_image_(voxel_image), labels_(labels),
+		lower_bound_(0), upper_bound_(0)
+	{
+		Vecd spacing = voxel_image_.getSpacing();
+		Vecu dimensions = voxel_image_.getDimensions();
+		Real max_spacing = 0.0;
+		for (int i = 0; i != Vecd(0).size(); ++i) max_spacing = SMAX(max_spacing, spacing[i]);
+		/** Each cell contains a few surface points at most for a smooth surface. */
+		cell_spacing_ = 2.0 * max_spacing;
+		for (int i = 0; i != Vecd(0).size(); ++i)
+		{
+			cells_lower_bound_[i] = voxel_image_.getOrigin()[i] - spacing[i];
+			number_of_cells_[i] = int(ceil((Real(dimensions[i]) + 1.0) * spacing[i] / cell_spacing_)) + 1;
+		}
+		findSurfacePoints();
+	}
+	//=================================================================================================//
+	bool VoxelShape::isShapeVoxel(Veci voxel_index)
+	{
+		Vecu dimensions = voxel_image_.getDimensions();
+		for (int i = 0; i != Vecd(0).size(); ++i)
+			if (voxel_index[i] < 0 || voxel_index[i] >= int(dimensions[i])) return false;
+		return labels_.find(voxel_image_.getLabel(Vecu(voxel_index))) != labels_.end();
+	}
+	//=================================================================================================//
+	void VoxelShape::findSurfacePoints()
+	{
+		Vecd spacing = voxel_image_.getSpacing();
+		/** The points are found slice by slice of the last dimension in parallel,
+		  * and merged in the order of the slices, so that the order of the points
+		  * in the cells, which decides equally close points, is independent of the threads. */
+		size_t number_of_slices = voxel_image_.getDimensions()[Vecd(0).size() - 1];
+		size_t voxels_per_slice = voxel_image_.getNumberOfVoxels() / number_of_slices;
+		StdVec<StdVec<Vecd>> slice_surface_points(number_of_slices);
+		parallel_for(blocked_range<size_t>(0, number_of_slices),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t s = r.begin(); s != r.end(); ++s)
+				for (size_t i = s * voxels_per_slice; i != (s + 1) * voxels_per_slice; ++i)
+				{
+					Vecu voxel_index = voxel_image_.transfer1DtoVoxelIndex(i);
+					if (!isShapeVoxel(Veci(voxel_index))) continue;
+					Vecd voxel_position = voxel_image_.VoxelPositionFromIndex(voxel_index);
+					/** The center of a face to a voxel outside is a surface point. */
+					for (int k = 0; k != Vecd(0).size(); ++k)
+						for (int direction = -1; direction <= 1; direction += 2)
+						{
+							Veci neighbor_index(voxel_index);
+							neighbor_index[k] += direction;
+							if (!isShapeVoxel(neighbor_index))
+							{
+								Vecd face_center = voxel_position;
+								face_center[k] += 0.5 * Real(direction) * spacing[k];
+								slice_surface_points[s].push_back(face_center);
+							}
+						}
+				}
+			}, ap);
+
+		StdVec<Vecd> surface_points;
+		for (size_t s = 0; s != number_of_slices; ++s)
+			surface_points.insert(surface_points.end(),
+				slice_surface_points[s].begin(), slice_surface_points[s].end());
+		if (surface_points.size() == 0)
+		{
+			std::cout << "\n Error: the voxel shape " << name << " has no voxel with the given labels!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
+		lower_bound_ = surface_points[0];
+		upper_bound_ = surface_points[0];
+		for (size_t n = 0; n != surface_points.size(); ++n)
+		{
+			Vecd& point = surface_points[n];
+			for (int i = 0; i != Vecd(0).size(); ++i)
+			{
+				lower_bound_[i] = SMIN(lower_bound_[i], point[i]);
+				upper_bound_[i] = SMAX(upper_bound_[i], point[i]);
+			}
+			Veci cell_index = CellIndexFromPosition(point);
+			size_t cell_1d = 0;
+			for (int i = Vecd(0).size() - 1; i >= 0; --i)
+				cell_1d = cell_1d * number_of_cells_[i] + cell_index[i];
+			surface_cells_[cell_1d].push_back(point);
+		}
+	}
+	//=================================================================================================//
+	Veci VoxelShape::CellIndexFromPosition(Vecd& position)
+	{
+		Veci cell_index;
+		for (int i = 0; i != Vecd(0).size(); ++i)
+			cell_index[i] = int(floor((position[i] - cells_lower_bound_[i]) / cell_spacing_));
+		return cell_index;
+	}
+	//=================================================================================================//
+	bool VoxelShape::contain(Vecd pnt, bool BOUNDARY_INCLUDED)
+	{
+		return labels_.find(voxel_image_.probeLabel(pnt)) != labels_.end();
+	}
+	//=================================================================================================//
+	Vecd VoxelShape::closestpointonface(Vecd input_pnt)
+	{
+		int dimension = Vecd(0).size();
+		/** Start from the nearest cell, which is inside of the cell range. */
+		Veci center_cell = CellIndexFromPosition(input_pnt);
+		int max_range = 0;
+		for (int i = 0; i != dimension; ++i)
+		{
+			center_cell[i] = SMIN(SMAX(center_cell[i], 0), number_of_cells_[i] - 1);
+			max_range = SMAX(max_range, number_of_cells_[i]);
+		}
+
+		Vecd closest_pnt = input_pnt;
+		Real min_distance = std::numeric_limits<Real>::max();
+		/** Search the cells ring by ring. Points beyond the ring r are
+		  * at least r cell spacings away, which gives the stop criterion. */
+		for (int r = 0; r <= max_range; ++r)
+		{
+			Veci offset(-r);
+			while (true)
+			{
+				bool is_on_ring = false;
+				bool is_in_range = true;
+				Veci cell_index;
+				size_t cell_1d = 0;
+				for (int i = dimension - 1; i >= 0; --i)
+				{
+					if (ABS(offset[i]) == r) is_on_ring = true;
+					cell_index[i] = center_cell[i] + offset[i];
+					if (cell_index[i] < 0 || cell_index[i] >= number_of_cells_[i]) is_in_range = false;
+					cell_1d = cell_1d * number_of_cells_[i] + cell_index[i];
+				}
+				if (is_on_ring && is_in_range)
+				{
+					auto cell = surface_cells_.find(cell_1d);
+					if (cell != surface_cells_.end())
+						for (const Vecd& point : cell->second)
+						{
+							Real distance = (point - input_pnt).norm();
+							if (distance < min_distance)
+							{
+								min_distance = distance;
+								closest_pnt = point;
+							}
+						}
+				}
+				/** Next offset in the cube of the ring. */
+				int k = 0;
+				for (; k != dimension; ++k)
+				{
+					if (offset[k] < r) { offset[k]++; break; }
+					offset[k] = -r;
+				}
+				if (k == dimension) break;
+			}
+			if (min_distance <= Real(r) * cell_spacing_) break;
+		}
+		return closest_pnt;
+	}
+	//=================================================================================================//
+	void VoxelShape::shapebound(Vecd &lower_bound, Vecd &upper_bound)
+	{
+		lower_bound = lower_bound_;
+		upper_bound = upper_bound_;
+	}
+	//=================================================================================================//
+}
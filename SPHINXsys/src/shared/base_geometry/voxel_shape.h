@@ -0,0 +1,101 @@
+/**
+ * @file 	voxel_shape.h
+ * @brief 	Shapes given by the labels of a segmented image, such as those from medical images.
+ * @details The labelled voxel image is read from a MetaImage header (.mhd) with its raw data file,
+ *			or from a raw data file of 8-bit labels directly. A voxel shape is the union
+ *			of the voxels with the given labels. Its surface is represented by the centers of
+ *			the faces between the voxels inside and outside of the shape, which are sorted
+ *			into hashed cells for closest point queries, so that no surface mesh is required.
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+#pragma once
+
+#include "base_geometry.h"
+#include "sph_data_conainers.h"
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+
+namespace SPH
+{
+	/**
+	 * @class VoxelImage
+	 * @brief Labelled voxel image on a uniform grid. The first index runs fastest in the data.
+	 * The origin is the center of the first voxel, as the offset in MetaImage.
+	 */
+	class VoxelImage
+	{
+	protected:
+		/** number of voxels by dimension */
+		Vecu dimensions_;
+		/** voxel size by dimension */
+		Vecd spacing_;
+		/** center of the first voxel */
+		Vecd origin_;
+		/** voxel labels, 0 is usually the background */
+		StdLargeVec<uint16_t> labels_;
+
+		/** read raw data with the given MetaImage element type from a byte offset in the file */
+		void readRawData(string raw_file, string element_type, bool is_msb, streamoff data_offset);
+	public:
+		/** Constructor from a MetaImage header file. */
+		explicit VoxelImage(string header_file);
+		/** Constructor from a raw data file of 8-bit labels. */
+		VoxelImage(string raw_file, Vecu dimensions, Vecd spacing, Vecd origin);
+		virtual ~VoxelImage() {};
+
+		Vecu getDimensions() { return dimensions_; };
+		Vecd getSpacing() { return spacing_; };
+		Vecd getOrigin() { return origin_; };
+		size_t getNumberOfVoxels() { return labels_.size(); };
+
+		/** convert voxel index to 1d index. */
+		size_t transferVoxelIndexTo1D(Vecu voxel_index);
+		/** convert 1d index to voxel index. */
+		Vecu transfer1DtoVoxelIndex(size_t i);
+		/** center position of a voxel. */
+		Vecd VoxelPositionFromIndex(Vecu voxel_index);
+		/** find the voxel containing a position, false if out of the image. */
+		bool VoxelIndexFromPosition(Vecd& position, Vecu& voxel_index);
+		/** label of a voxel. */
+		int getLabel(Vecu voxel_index) { return labels_[transferVoxelIndexTo1D(voxel_index)]; };
+		/** label at a position, 0 if out of the image. */
+		int probeLabel(Vecd position);
+	};
+
+	/**
+	 * @class VoxelShape
+	 * @brief Shape given by the voxels with a set of labels in a voxel image.
+	 * All queries are read-only, so that they can be called concurrently.
+	 */
+	class VoxelShape : public Shape
+	{
+	protected:
+		VoxelImage& voxel_image_;
+		/** labels of the voxels in the shape */
+		std::set<int> labels_;
+		/** bounds of the voxels in the shape */
+		Vecd lower_bound_, upper_bound_;
+		/** hashed cells of surface points */
+		Real cell_spacing_;
+		Vecd cells_lower_bound_;
+		Veci number_of_cells_;
+		std::unordered_map<size_t, StdVec<Vecd>> surface_cells_;
+
+		/** whether a voxel, which may be out of the image, is in the shape. */
+		bool isShapeVoxel(Veci voxel_index);
+		/** find the surface points and sort them into cells. */
+		void findSurfacePoints();
+		/** cell index of a position, which may be out of the cell range. */
+		Veci CellIndexFromPosition(Vecd& position);
+	public:
+		VoxelShape(VoxelImage& voxel_image, std::set<int> labels, string shape_name = "VoxelShape");
+		virtual ~VoxelShape() {};
+
+		virtual bool contain(Vecd pnt, bool BOUNDARY_INCLUDED = true) override;
+		virtual Vecd closestpointonface(Vecd input_pnt) override;
+		virtual void shapebound(Vecd &lower_bound, Vecd &upper_bound) override;
+	};
+}
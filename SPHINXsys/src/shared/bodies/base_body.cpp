@@ -13,18 +13,22 @@
 #include "base_particles.h"
 #include "all_kernels.h"
 #include "mesh_cell_linked_list.h"
+#include "neighbor_relation.h"
+#include "voxel_shape.h"
 //=================================================================================================//
 namespace SPH
 {
 	//=================================================================================================//
 	SPHBody::SPHBody(SPHSystem &sph_system, string body_name,
 		int refinement_level, Real smoothinglength_ratio, ParticlesGeneratorOps op)
-	: sph_system_(sph_system), body_region_(body_name), body_name_(body_name), 
+	: sph_system_(sph_system), body_region_(body_name), body_shape_(NULL), body_name_(body_name), 
 		refinement_level_(refinement_level), particle_generator_op_(op),
 		body_lower_bound_(0), body_upper_bound_(0), prescribed_body_bounds_(false),
-		mesh_background_(NULL)
+		mesh_background_(NULL), is_mesh_background_owned_(false), use_block_split_cell_lists_(false),
+		use_cell_pair_inner_interaction_(false)
 	{	
 		sph_system_.AddBody(this);
+		number_of_cell_list_updates_ = 0;
 
 		particle_spacing_ 	= RefinementLevelToParticleSpacing();
 		smoothinglength_ = particle_spacing_ * smoothinglength_ratio;
@@ -37,6 +41,28 @@ namespace SPH
 		split_cell_lists_.resize(number_of_split_cell_lists);
 	}
 	//=================================================================================================//
+	SPHBody::~SPHBody()
+	{
+		releaseConfiguration(inner_configuration_);
+		for (size_t k = 0; k != contact_configuration_.size(); ++k)
+			releaseConfiguration(contact_configuration_[k]);
+	}
+	//=================================================================================================//
+	BaseNeighborRelation* SPHBody::createInnerNeighborRelation()
+	{
+		return base_mesh_cell_linked_list_->createInnerNeighborRelation();
+	}
+	//=================================================================================================//
+	void SPHBody::releaseConfiguration(ParticleConfiguration& configuration)
+	{
+		for (size_t i = 0; i != configuration.size(); ++i)
+		{
+			NeighborList& neighbor_list = std::get<0>(configuration[i]);
+			for (size_t n = 0; n != neighbor_list.size(); ++n) delete neighbor_list[n];
+			NeighborList().swap(neighbor_list);
+		}
+	}
+	//=================================================================================================//
 	Real SPHBody::RefinementLevelToParticleSpacing()
 	{
 		return sph_system_.particle_spacing_ref_	
@@ -65,12 +91,12 @@ namespace SPH
 		indexes_contact_particles_.resize(contact_map_.second.size());
 
 		inner_configuration_.resize(number_of_particles_, 
-			make_tuple<NeighborList, size_t, size_t>(NeighborList(0), 0, 0));
+			make_tuple<NeighborList, ParticleIndex, ParticleIndex>(NeighborList(0), 0, 0));
 
 		contact_configuration_.resize(contact_map_.second.size());
 		for (size_t k = 0; k != contact_map_.second.size(); ++k) {
 			contact_configuration_[k].resize(number_of_particles_,
-				make_tuple<NeighborList, size_t, size_t>(NeighborList(0), 0, 0));
+				make_tuple<NeighborList, ParticleIndex, ParticleIndex>(NeighborList(0), 0, 0));
 		}
 	}
 	//=================================================================================================//
@@ -79,11 +105,11 @@ namespace SPH
 		size_t updated_size = number_of_particles_ + body_buffer_particles;
 
 		inner_configuration_.resize(updated_size,
-			make_tuple<NeighborList, size_t, size_t>(NeighborList(0), 0, 0));
+			make_tuple<NeighborList, ParticleIndex, ParticleIndex>(NeighborList(0), 0, 0));
 
 		for (size_t k = 0; k != contact_map_.second.size(); ++k) {
 			contact_configuration_[k].resize(updated_size,
-				make_tuple<NeighborList, size_t, size_t>(NeighborList(0), 0, 0));
+				make_tuple<NeighborList, ParticleIndex, ParticleIndex>(NeighborList(0), 0, 0));
 		}
 	}
 	//=================================================================================================//
@@ -92,32 +118,140 @@ namespace SPH
 		base_mesh_cell_linked_list_->UpdateContactConfiguration();
 	}
 	//=================================================================================================//
+	void SPHBody::collectConfigurationMemoryUsage(string configuration_name,
+		ParticleConfiguration& configuration, MemoryUsageList& memory_usages)
+	{
+		size_t number_of_neighbors = 0, number_of_relations = 0, bytes_of_relations = 0;
+		for (size_t i = 0; i != configuration.size(); ++i)
+		{
+			NeighborList& neighbor_list = std::get<0>(configuration[i]);
+			number_of_neighbors += std::get<2>(configuration[i]);
+			number_of_relations += neighbor_list.size();
+			/** The relations and the list storage are counted by the blocks allocated for them. */
+			for (size_t n = 0; n != neighbor_list.size(); ++n)
+				bytes_of_relations += neighbor_list[n]->allocatedBytes();
+			if (neighbor_list.capacity() != 0)
+				bytes_of_relations += HugePagePool::allocatedBytes(neighbor_list.capacity() * sizeof(BaseNeighborRelation*));
+		}
+		memory_usages.push_back(vectorMemoryUsage(configuration_name + " neighborhoods", configuration));
+		/** The relations kept for reuse beyond the current neighbors are counted as capacity. */
+		memory_usages.push_back(MemoryUsage(configuration_name + " neighbor relations",
+			number_of_neighbors, number_of_relations, bytes_of_relations));
+	}
+	//=================================================================================================//
+	void SPHBody::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		base_particles_->collectMemoryUsage(memory_usages);
+
+		collectConfigurationMemoryUsage("inner", inner_configuration_, memory_usages);
+		for (size_t k = 0; k != contact_configuration_.size(); ++k)
+			collectConfigurationMemoryUsage("contact to " + contact_map_.second[k]->GetBodyName(),
+				contact_configuration_[k], memory_usages);
+
+		size_t number_of_contact_particles = 0, capacity_of_contact_particles = 0;
+		for (size_t k = 0; k != indexes_contact_particles_.size(); ++k)
+		{
+			number_of_contact_particles += indexes_contact_particles_[k].size();
+			capacity_of_contact_particles += indexes_contact_particles_[k].capacity();
+		}
+		memory_usages.push_back(MemoryUsage("contact particle lists", number_of_contact_particles,
+			capacity_of_contact_particles, capacity_of_contact_particles * sizeof(ParticleIndex)));
+
+		size_t number_of_split_cells = 0, capacity_of_split_cells = 0;
+		for (size_t s = 0; s != split_cell_lists_.size(); ++s)
+		{
+			number_of_split_cells += split_cell_lists_[s].size();
+			capacity_of_split_cells += split_cell_lists_[s].capacity();
+		}
+		memory_usages.push_back(MemoryUsage("split cell lists", number_of_split_cells,
+			capacity_of_split_cells, capacity_of_split_cells * sizeof(CellList*)));
+
+		if (use_block_split_cell_lists_)
+		{
+			size_t number_of_block_split_cells = 0, capacity_of_block_split_cells = 0;
+			for (size_t s = 0; s != block_split_cell_lists_.size(); ++s)
+				for (size_t t = 0; t != block_split_cell_lists_[s].size(); ++t)
+				{
+					number_of_block_split_cells += block_split_cell_lists_[s][t].size();
+					capacity_of_block_split_cells += block_split_cell_lists_[s][t].capacity();
+				}
+			memory_usages.push_back(MemoryUsage("block split cell lists", number_of_block_split_cells,
+				capacity_of_block_split_cells, capacity_of_block_split_cells * sizeof(CellList*)));
+		}
+
+		base_mesh_cell_linked_list_->collectMemoryUsage(memory_usages);
+		if (mesh_background_ != NULL) mesh_background_->collectMemoryUsage(memory_usages);
+	}
+	//=================================================================================================//
+	void SPHBody::setBlockSplitting()
+	{
+		use_block_split_cell_lists_ = true;
+		block_split_cell_lists_.resize(powern(2, Vecd(0).size()));
+		/** Otherwise, they are built with the first update of the cell linked lists. */
+		if (number_of_cell_list_updates_ != 0) base_mesh_cell_linked_list_->BuildBlockSplitCellLists();
+	}
+	//=================================================================================================//
 	void SPHBody::addBackgroundMesh(Real mesh_size_ratio)
 	{
 		Vecd body_lower_bound, body_upper_bound;
 		BodyBounds(body_lower_bound, body_upper_bound);
+		/** A mesh may have been added already, e.g. by the Poisson-disk particle generator. */
+		if (is_mesh_background_owned_) delete mesh_background_;
 		/** Background mesh has much higher resolution. */
 		mesh_background_
 			= new MeshBackground(body_lower_bound,
 				body_upper_bound, mesh_size_ratio * particle_spacing_, 4);
+		is_mesh_background_owned_ = true;
 		mesh_background_->AllocateMeshDataMatrix();
 		mesh_background_->InitializeLevelSetData(*this);
 		mesh_background_->ComputeCurvatureFromLevelSet(*this);
 	}
 	//=================================================================================================//
+	void SPHBody::addSparseBackgroundMesh(Real mesh_size_ratio, size_t block_size)
+	{
+		Vecd body_lower_bound, body_upper_bound;
+		BodyBounds(body_lower_bound, body_upper_bound);
+		if (is_mesh_background_owned_) delete mesh_background_;
+		mesh_background_
+			= new SparseMeshBackground(body_lower_bound,
+				body_upper_bound, mesh_size_ratio * particle_spacing_, 4, block_size);
+		is_mesh_background_owned_ = true;
+		mesh_background_->InitializeLevelSetData(*this);
+		mesh_background_->ComputeCurvatureFromLevelSet(*this);
+	}
+	//=================================================================================================//
+	void SPHBody::useSharedBackgroundMesh(MeshBackground* mesh_background)
+	{
+		if (is_mesh_background_owned_) delete mesh_background_;
+		mesh_background_ = mesh_background;
+		is_mesh_background_owned_ = false;
+	}
+	//=================================================================================================//
 	bool SPHBody::BodyContain(Vecd pnt)
 	{
+		if (body_shape_ != NULL) return body_shape_->contain(pnt);
 		return body_region_.contain(pnt);
 	}
 	//=================================================================================================//
 	void SPHBody::ClosestPointOnBodySurface(Vecd input_pnt, Vecd& closest_pnt, Real& phi)
 	{
+		if (body_shape_ != NULL)
+		{
+			closest_pnt = body_shape_->closestpointonface(input_pnt);
+			Real distance = (closest_pnt - input_pnt).norm();
+			phi = body_shape_->contain(input_pnt) ? distance : -distance;
+			return;
+		}
 		body_region_.closestpointonface(input_pnt, closest_pnt, phi);
 	}
 	//=================================================================================================//
 	void SPHBody::BodyBounds(Vecd& lower_bound, Vecd& upper_bound)
 	{
-		if(!prescribed_body_bounds_) 
+		if (!prescribed_body_bounds_ && body_shape_ != NULL)
+		{
+			body_shape_->shapebound(lower_bound, upper_bound);
+		}
+		else if(!prescribed_body_bounds_) 
 		{
 			body_region_.regionbound(lower_bound, upper_bound);
 		}
@@ -154,6 +288,116 @@ namespace SPH
 		base_particles_->ReadParticleFromXmlForRestart(filefullpath);
 	}
 	//=================================================================================================//
+	void SPHBody::writeConfigurationToBinary(ofstream& output_file, ParticleConfiguration& configuration)
+	{
+		for (size_t i = 0; i != number_of_particles_; ++i)
+		{
+			Neighborhood& neighborhood = configuration[i];
+			NeighborList& neighbor_list = std::get<0>(neighborhood);
+			size_t count_of_neighbors = std::get<2>(neighborhood);
+			output_file.write(reinterpret_cast<const char*>(&count_of_neighbors), sizeof(size_t));
+			for (size_t n = 0; n != count_of_neighbors; ++n)
+			{
+				BaseNeighborRelation* neighboring_particle = neighbor_list[n];
+				output_file.write(reinterpret_cast<const char*>(&neighboring_particle->j_), sizeof(ParticleIndex));
+				output_file.write(reinterpret_cast<const char*>(&neighboring_particle->W_ij_), sizeof(Real));
+				output_file.write(reinterpret_cast<const char*>(&neighboring_particle->dW_ij_), sizeof(Real));
+				output_file.write(reinterpret_cast<const char*>(&neighboring_particle->e_ij_), sizeof(Vecd));
+				output_file.write(reinterpret_cast<const char*>(&neighboring_particle->r_ij_), sizeof(Real));
+			}
+		}
+	}
+	//=================================================================================================//
+	void SPHBody::readConfigurationFromBinary(ifstream& input_file, ParticleConfiguration& configuration,
+		bool is_inner_configuration)
+	{
+		if (configuration.size() < number_of_particles_) configuration.resize(number_of_particles_);
+		for (size_t i = 0; i != number_of_particles_; ++i)
+		{
+			Neighborhood& neighborhood = configuration[i];
+			NeighborList& neighbor_list = std::get<0>(neighborhood);
+			size_t count_of_neighbors = 0;
+			input_file.read(reinterpret_cast<char*>(&count_of_neighbors), sizeof(size_t));
+			for (size_t n = 0; n != count_of_neighbors; ++n)
+			{
+				if (n >= neighbor_list.size()) neighbor_list.emplace_back(is_inner_configuration ?
+					createInnerNeighborRelation() : new NeighborRelation());
+				BaseNeighborRelation* neighboring_particle = neighbor_list[n];
+				input_file.read(reinterpret_cast<char*>(&neighboring_particle->j_), sizeof(ParticleIndex));
+				input_file.read(reinterpret_cast<char*>(&neighboring_particle->W_ij_), sizeof(Real));
+				input_file.read(reinterpret_cast<char*>(&neighboring_particle->dW_ij_), sizeof(Real));
+				input_file.read(reinterpret_cast<char*>(&neighboring_particle->e_ij_), sizeof(Vecd));
+				input_file.read(reinterpret_cast<char*>(&neighboring_particle->r_ij_), sizeof(Real));
+			}
+			std::get<1>(neighborhood) = 0;
+			std::get<2>(neighborhood) = count_of_neighbors;
+		}
+	}
+	//=================================================================================================//
+	void SPHBody::WriteReferenceConfigurationToBinary(std::string &filefullpath)
+	{
+		std::ofstream output_file(filefullpath.c_str(), ios::out | ios::binary | ios::trunc);
+		writeBinaryFileHeader(output_file);
+		output_file.write(reinterpret_cast<const char*>(&number_of_particles_), sizeof(size_t));
+		size_t number_of_contact_bodies = contact_configuration_.size();
+		output_file.write(reinterpret_cast<const char*>(&number_of_contact_bodies), sizeof(size_t));
+
+		writeConfigurationToBinary(output_file, inner_configuration_);
+		for (size_t k = 0; k != number_of_contact_bodies; ++k)
+		{
+			ContactParticleList& contact_particles = indexes_contact_particles_[k];
+			size_t number_of_contact_particles = contact_particles.size();
+			output_file.write(reinterpret_cast<const char*>(&number_of_contact_particles), sizeof(size_t));
+			for (size_t i = 0; i != number_of_contact_particles; ++i)
+				output_file.write(reinterpret_cast<const char*>(&contact_particles[i]), sizeof(ParticleIndex));
+			writeConfigurationToBinary(output_file, contact_configuration_[k]);
+		}
+
+		base_particles_->WriteReferenceStatesToBinary(output_file);
+		output_file.close();
+	}
+	//=================================================================================================//
+	void SPHBody::ReadReferenceConfigurationFromBinary(std::string &filefullpath)
+	{
+		std::ifstream input_file(filefullpath.c_str(), ios::in | ios::binary);
+		checkBinaryFileHeader(input_file, filefullpath);
+		size_t number_of_particles = 0, number_of_contact_bodies = 0;
+		input_file.read(reinterpret_cast<char*>(&number_of_particles), sizeof(size_t));
+		input_file.read(reinterpret_cast<char*>(&number_of_contact_bodies), sizeof(size_t));
+		if (number_of_particles != number_of_particles_ || number_of_contact_bodies != contact_configuration_.size())
+		{
+			std::cout << "\n Error: the reference configuration file:" << filefullpath 
+				<< " does not match the body " << body_name_ << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
+		readConfigurationFromBinary(input_file, inner_configuration_, true);
+		for (size_t k = 0; k != number_of_contact_bodies; ++k)
+		{
+			ContactParticleList& contact_particles = indexes_contact_particles_[k];
+			contact_particles.clear();
+			size_t number_of_contact_particles = 0;
+			input_file.read(reinterpret_cast<char*>(&number_of_contact_particles), sizeof(size_t));
+			for (size_t i = 0; i != number_of_contact_particles; ++i)
+			{
+				ParticleIndex particle_index = 0;
+				input_file.read(reinterpret_cast<char*>(&particle_index), sizeof(ParticleIndex));
+				contact_particles.push_back(particle_index);
+			}
+			readConfigurationFromBinary(input_file, contact_configuration_[k], false);
+		}
+
+		base_particles_->ReadReferenceStatesFromBinary(input_file);
+		if (!input_file)
+		{
+			std::cout << "\n Error: the reference configuration file:" << filefullpath << " is incomplete" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		input_file.close();
+	}
+	//=================================================================================================//
 	void SPHBody::WriteToXmlForReloadParticle(std::string &filefullpath)
 	{
 		base_particles_->WriteToXmlForReloadParticle(filefullpath);
@@ -185,6 +429,7 @@ namespace SPH
 	//=================================================================================================//
 	void RealBody::BuildInnerConfiguration()
 	{
+		if (use_cell_pair_inner_interaction_) return;
 		base_mesh_cell_linked_list_->UpdateInnerConfiguration(inner_configuration_);
 	}
 	//=================================================================================================//
@@ -195,6 +440,7 @@ namespace SPH
 	//=================================================================================================//
 	void RealBody::UpdateInnerConfiguration()
 	{
+		if (use_cell_pair_inner_interaction_) return;
 		base_mesh_cell_linked_list_->UpdateInnerConfiguration(inner_configuration_);
 	}
 	//=================================================================================================//
@@ -252,6 +498,15 @@ namespace SPH
 		return this;
 	}
 	//=================================================================================================//
+	TracerBody::TracerBody(SPHSystem &system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: FictitiousBody(system, body_name, refinement_level, 1.3, op) {}
+	//=================================================================================================//
+	TracerBody* TracerBody::PointToThisObject()
+	{
+		return this;
+	}
+	//=================================================================================================//
 	void BodyPartByParticle::tagAParticle(size_t particle_index)
 	{
 		BaseParticleData& base_particle_data_i
@@ -271,12 +526,32 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	BodyPartByVoxelLabels::BodyPartByVoxelLabels(SPHBody* body, string body_part_name,
+		VoxelImage& voxel_image, std::set<int> labels)
+		: BodyPartByParticle(body, body_part_name), voxel_image_(voxel_image), labels_(labels)
+	{
+		TagBodyPartParticles();
+	}
+	//=================================================================================================//
+	void BodyPartByVoxelLabels::TagBodyPartParticles()
+	{
+		BaseParticles* base_particles = body_->base_particles_;
+		for (size_t i = 0; i < body_->number_of_particles_; ++i)
+		{
+			BaseParticleData& base_particle_data_i
+				= base_particles->base_particle_data_[i];
+			if (labels_.find(voxel_image_.probeLabel(base_particle_data_i.pos_n_)) != labels_.end())
+				tagAParticle(i);
+		}
+	}
+	//=================================================================================================//
 	BodySurface::BodySurface(SPHBody* body)
 		: BodyPartByParticle(body, "Surface")
 	{
 		if (body->mesh_background_ == NULL)
 		{
-			std::cout << "\n BodySurface::BodySurface: Background mesh is required. Exit the program! \n";
+			std::cout << "\n BodySurface::BodySurface: Background mesh is required. "
+				<< "Use BodySurfaceFromParticles for bodies without geometry. Exit the program! \n";
 			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
 			exit(0);
 		}
@@ -297,6 +572,112 @@ namespace SPH
 		std::cout << "Number of surface particles : " << body_part_particles_.size() << std::endl;
 	}
 	//=================================================================================================//
+	BodySurfaceFromParticles::BodySurfaceFromParticles(SPHBody* body, 
+		Real gradient_sum_fraction, Real cone_cosine)
+		: BodyPartByParticle(body, "SurfaceFromParticles"), 
+		gradient_sum_fraction_(gradient_sum_fraction), cone_cosine_(cone_cosine)
+	{
+		if (body->inner_configuration_.size() < body->number_of_particles_)
+		{
+			std::cout << "\n Error: BodySurfaceFromParticles: the inner configuration of the body " 
+				<< body->GetBodyName() << " is not built!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		TagBodyPartParticles();
+	}
+	//=================================================================================================//
+	Real BodySurfaceFromParticles::computeLatticeSurfaceGradientSum()
+	{
+		int dimension = Vecd(0).size();
+		Real spacing = body_->particle_spacing_;
+		int range = int(body_->kernel_->GetCutOffRadius() / spacing) + 1;
+		Vecu lattice_size(size_t(2 * range + 1));
+		size_t number_of_lattice_points = powern(2 * range + 1, dimension);
+		/** The lattice points in the lower half space, including the row of the particle itself. */
+		Vecd gradient_sum(0);
+		for (size_t n = 0; n != number_of_lattice_points; ++n)
+		{
+			Vecu lattice_index = body_->base_mesh_cell_linked_list_->transfer1DtoMeshIndex(lattice_size, n);
+			Vecd offset(0);
+			for (int k = 0; k != dimension; ++k)
+				offset[k] = (Real(lattice_index[k]) - Real(range)) * spacing;
+			if (offset[dimension - 1] > 0.0 || offset.norm() < 1.0e-6 * spacing) continue;
+			Vecd displacement = -offset;
+			Real distance = displacement.norm();
+			if (distance > body_->kernel_->GetCutOffRadius()) continue;
+			gradient_sum += powern(spacing, dimension) * body_->kernel_->dW(displacement) * displacement / distance;
+		}
+		return gradient_sum.norm();
+	}
+	//=================================================================================================//
+	void BodySurfaceFromParticles::TagBodyPartParticles()
+	{
+		size_t number_of_particles = body_->number_of_particles_;
+		StdLargeVec<BaseParticleData>& base_particle_data = body_->base_particles_->base_particle_data_;
+		ParticleConfiguration& inner_configuration = body_->inner_configuration_;
+		Real threshold = gradient_sum_fraction_ * computeLatticeSurfaceGradientSum();
+
+		StdLargeVec<Vecd> normals(number_of_particles, Vecd(0));
+		StdLargeVec<int> is_surface(number_of_particles, 0);
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					Neighborhood& neighborhood = inner_configuration[i];
+					NeighborList& neighbors = std::get<0>(neighborhood);
+					Vecd gradient_sum(0);
+					for (size_t n = 0; n != std::get<2>(neighborhood); ++n)
+					{
+						BaseNeighborRelation* neighboring_particle = neighbors[n];
+						gradient_sum += base_particle_data[neighboring_particle->j_].Vol_ 
+							* neighboring_particle->dW_ij_ * neighboring_particle->e_ij_;
+					}
+					if (gradient_sum.norm() < threshold) continue;
+
+					Vecd normal = -gradient_sum / gradient_sum.norm();
+					/** e_ij points from j to i, so the neighbor j is along the normal if -e_ij is. */
+					bool is_empty_cone = true;
+					for (size_t n = 0; n != std::get<2>(neighborhood); ++n)
+						if (-dot(neighbors[n]->e_ij_, normal) > cone_cosine_) is_empty_cone = false;
+
+					if (is_empty_cone)
+					{
+						is_surface[i] = 1;
+						normals[i] = normal;
+					}
+				}
+			}, ap);
+
+		/** Tagged sequentially to keep the particle order. */
+		for (size_t i = 0; i != number_of_particles; ++i)
+			if (is_surface[i] == 1)
+			{
+				tagAParticle(i);
+				surface_normals_.push_back(normals[i]);
+			}
+		std::cout << "Number of surface particles from particles: " << body_part_particles_.size() << std::endl;
+	}
+	//=================================================================================================//
+	void BodyPartByCell::collectBodyPartParticles()
+	{
+		body_part_particles_.clear();
+		for (size_t i = 0; i != body_part_cells_.size(); ++i)
+		{
+			IndexVector& particle_indexes = body_part_cells_[i]->particle_indexes_;
+			for (size_t num = 0; num < particle_indexes.size(); ++num)
+				body_part_particles_.push_back(particle_indexes[num]);
+		}
+		cached_cell_list_update_ = body_->number_of_cell_list_updates_;
+	}
+	//=================================================================================================//
+	IndexVector& BodyPartByCell::getBodyPartParticles()
+	{
+		if (cached_cell_list_update_ != body_->number_of_cell_list_updates_) 
+			collectBodyPartParticles();
+		return body_part_particles_;
+	}
+	//=================================================================================================//
 	NearBodySurface::NearBodySurface(SPHBody* body)
 		: BodyPartByCell(body, "NearBodySurface")
 	{
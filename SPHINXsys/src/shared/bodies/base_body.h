@@ -18,6 +18,8 @@
 #include "sph_data_conainers.h"
 #include "neighbor_relation.h"
 #include "geometry.h"
+#include <limits>
+#include <set>
 #include <string>
 using namespace std;
 
@@ -31,14 +33,19 @@ namespace SPH
 	class Kernel;
 	class BaseMeshCellLinkedList;
 	class MeshBackground;
+	class VoxelImage;
 
 	/**
 	 * @class ParticlesGeneratorOps
 	 * @brief Serval manners are provied for particles generator.
 	 * @details lattice : Generate partice from lattcie grid.
 	 *			direct  : Input particle position and volume directly.
+	 *			voxel   : Generate particles in parallel from lattice grid within the body shape,
+	 *					  e.g. a voxel shape from a segmented image.
+	 *			poisson_disk : Sample blue-noise particles in the level set of the body,
+	 *					  which needs much less relaxation than the lattice.
 	 */
-	enum class ParticlesGeneratorOps {lattice, direct};
+	enum class ParticlesGeneratorOps {lattice, direct, voxel, poisson_disk};
 	/**
 	 * @class SPHBody
 	 * @brief SPHBody is a base body with basic data and functions.
@@ -54,6 +61,9 @@ namespace SPH
 		/** the reagion describe the geometry of the body.
 		 * static member, so the geoemtry head file is included. */
 		Region body_region_;
+		/** the shape replacing the region for the geometry of the body, e.g. a voxel shape.
+		 * Not owned by the body. */
+		Shape* body_shape_;
 		/** smoothing length. */
 		Real smoothinglength_;
 		/** Computational domain bounds of the body for boundry conditions. */
@@ -63,10 +73,21 @@ namespace SPH
 		/** Computing particle spacing from refinement level. */
 		Real RefinementLevelToParticleSpacing();
 
+		/** Collect the memory usage of a particle configuration. */
+		void collectConfigurationMemoryUsage(string configuration_name,
+			ParticleConfiguration& configuration, MemoryUsageList& memory_usages);
 		/** Generate a kernel. */
 		Kernel* GenerateAKernel(Real smoothing_lenght);
 		/** Change kernel function specific for this body. */
 		void ReplaceKernelFunction(Kernel* kernel);
+		/** Write a configuration in binary format. */
+		void writeConfigurationToBinary(ofstream& output_file, ParticleConfiguration& configuration);
+		/** Read a configuration in binary format, reusing the neighbor relations already there.
+		  * The new relations are of the type of the inner configuration, or plain ones for contact configurations. */
+		void readConfigurationFromBinary(ifstream& input_file, ParticleConfiguration& configuration,
+			bool is_inner_configuration);
+		/** Delete the neighbor relations of a configuration. */
+		void releaseConfiguration(ParticleConfiguration& configuration);
 	public:
 		//----------------------------------------------------------------------
 		//Global variables
@@ -77,7 +98,9 @@ namespace SPH
 		size_t number_of_particles_;				/**< Number of real particles of the body. */
 		BaseParticles* base_particles_;				/**< Base particles of this body. */
 		BaseMeshCellLinkedList* base_mesh_cell_linked_list_; /**< Cell linked mesh of this body. */
+		size_t number_of_cell_list_updates_;		/**< Times the cell linked lists, own or shared, have been rebuilt or appended by ghost entries. */
 		MeshBackground* mesh_background_;			/**< Background mesh.*/
+		bool is_mesh_background_owned_;				/**< Whether the background mesh is deleted by this body. */
 		ParticlesGeneratorOps particle_generator_op_;	/**< Particle generator manner */
 		PositionsAndVolumes body_input_points_volumes_; /**< For direct generate particles. */
 
@@ -88,9 +111,20 @@ namespace SPH
 		 * they have no interaction because they are too far.
 		 */
 		SplitCellLists split_cell_lists_;
+		/**
+		 * @brief The cells are grouped in tiles of 2 cells in each direction for block split algorithms.
+		 * Only 4 (2D) or 8 (3D) colors are required, and the tiles with the same color
+		 * are separated by a tile so that they can be computed in parallel.
+		 */
+		BlockSplitCellLists block_split_cell_lists_;
+		/** If true, the split algorithms of this body iterate the tiles of the block split cell lists. */
+		bool use_block_split_cell_lists_;
 
 		/** inner configuration for the neighbor relations. */
 		ParticleConfiguration inner_configuration_;
+		/** If true, the inner configuration is not built and the inner interactions
+		  * are computed by cell pairs with the neighbors searched on the fly. */
+		bool use_cell_pair_inner_interaction_;
 
 		/**
 		 * @brief Contact configurations
@@ -115,12 +149,17 @@ namespace SPH
 		 */
 		explicit SPHBody(SPHSystem &sph_system, string body_name, 
 			int refinement_level, Real smoothinglength_ratio, ParticlesGeneratorOps op);
-		virtual ~SPHBody() {};
+		/** The neighbor relations in the configurations are released. */
+		virtual ~SPHBody();
 
 		/** Get the name of this body for out file name. */
 		string GetBodyName();
+		/** Get the SPH system this body belongs to. */
+		SPHSystem& getSPHSystem() { return sph_system_; };
 		/** Get the name of this body for out file name. */
 		Region& getBodyReagion() { return body_region_; };
+		/** Use a shape, such as a voxel shape from a segmented image, as the geometry of this body. */
+		void setBodyShape(Shape* body_shape) { body_shape_ = body_shape; };
 		/** Set up the contact map. */
 		void SetContactMap(SPHBodyContactMap& contact_map);
 		/** Set up the contact map. */
@@ -129,6 +168,18 @@ namespace SPH
 		virtual void AllocateMeoemryCellLinkedList() {};
 		/** add the back ground mesh particle mesh interaction. */
 		virtual void addBackgroundMesh(Real mesh_size_ratio = 0.5);
+		/** add the back ground mesh with level set data only in the narrow band around the body surface,
+		  * for large and thin bodies. */
+		virtual void addSparseBackgroundMesh(Real mesh_size_ratio = 0.5, size_t block_size = 8);
+		/** use a background mesh owned by others, e.g. shared by the members of an ensemble. */
+		void useSharedBackgroundMesh(MeshBackground* mesh_background);
+		/** Switch to the neighbor-list-free mode for inner interactions.
+		  * Only the cell pair inner dynamics are valid for this body then, and the dynamics
+		  * using the inner configuration exit with an error if constructed after switching. */
+		void setCellPairInnerInteraction() { use_cell_pair_inner_interaction_ = true; };
+		/** Switch to the block split cell lists for the split algorithms of this body.
+		  * They are built immediately if the cell linked lists have been updated already. */
+		void setBlockSplitting();
 		/** Allocate memories for configuration. */
 		void AllocateMemoriesForConfiguration();
 		/** Allocate extra configuration memories for body buffer particles. */
@@ -145,6 +196,8 @@ namespace SPH
 		virtual void UpdateContactConfiguration() = 0;
 		/** Update interactiong configuration. */
 		virtual void UpdateInteractionConfiguration(SPHBodyVector interacting_bodies) = 0;
+		/** Collect the memory usage of particles, configurations, cell lists and level set. */
+		void collectMemoryUsage(MemoryUsageList& memory_usages);
 
 		/** Check wether a point within the geometry of this body.
 		 * @returns TRUE if a point within body's region otherwise FALSE. 
@@ -178,7 +231,19 @@ namespace SPH
 		virtual void WriteToXmlForReloadParticle(std::string &filefullpath);
 		/** Reload particle position and volume from XML files. */
 		virtual void ReadFromXmlForReloadParticle(std::string &filefullpath);
+
+		/** Output the inner and contact configurations and the reference particle states, 
+		  * such as correction matrices, in binary file. Only valid for restarting bodies 
+		  * in total Lagrangian formulation, whose configurations are fixed. */
+		void WriteReferenceConfigurationToBinary(std::string &filefullpath);
+		/** Read the reference configurations and particle states from binary file, 
+		  * instead of building and correcting them again. */
+		void ReadReferenceConfigurationFromBinary(std::string &filefullpath);
 		
+		/** Create an empty neighbor relation of the type in the inner configuration of this body,
+		  * e.g. with variable smoothing length for a multi-level mesh cell linked list. */
+		BaseNeighborRelation* createInnerNeighborRelation();
+
 		/** The pointer to derived class object. */
 		virtual SPHBody* PointToThisObject();
 	};
@@ -244,6 +309,28 @@ namespace SPH
 		virtual FictitiousBody* PointToThisObject() override;
 	};
 
+	/**
+	 * @class TracerBody
+	 * @brief Passive tracers advected by a host fluid body.
+	 * The tracer body is not included in the body topology. It has neither cell linked list
+	 * nor configuration, as the host velocity is interpolated through the host cell linked list.
+	 */
+	class TracerBody : public FictitiousBody
+	{
+	public:
+		/** Constructor of TracerBody. */
+		TracerBody(SPHSystem &system, string body_name, int refinement_level, ParticlesGeneratorOps op);
+		virtual ~TracerBody() {};
+
+		/** Update contact configuration. */
+		virtual void UpdateContactConfiguration() override {};
+		/** Update interaction configuration, e.g., both ineer and contact. */
+		virtual void UpdateInteractionConfiguration(SPHBodyVector interacting_bodies) override {};
+
+		/** The pointer to derived class object. */
+		virtual TracerBody* PointToThisObject() override;
+	};
+
 	/**
 	 * @class BodyPart
 	 * @brief An auxillariy class for SPHBody to indicate a part of the body.
@@ -283,6 +370,24 @@ namespace SPH
 		virtual ~BodyPartByParticle() {};
 	};
 
+	/**
+	 * @class BodyPartByVoxelLabels
+	 * @brief A body part with the particles in the voxels of given labels,
+	 * e.g. a tissue region in a segmented medical image.
+	 */
+	class BodyPartByVoxelLabels : public BodyPartByParticle
+	{
+	protected:
+		VoxelImage& voxel_image_;
+		std::set<int> labels_;
+
+		virtual void TagBodyPartParticles() override;
+	public:
+		BodyPartByVoxelLabels(SPHBody* body, string body_part_name,
+			VoxelImage& voxel_image, std::set<int> labels);
+		virtual ~BodyPartByVoxelLabels() {};
+	};
+
 	/**
 	 * @class BodySurface
 	 * @brief A auxillariy class for Body to
@@ -297,6 +402,36 @@ namespace SPH
 		virtual~BodySurface() {};
 	};
 
+	/**
+	 * @class BodySurfaceFromParticles
+	 * @brief A auxillariy class for Body to indicate the surface particles 
+	 * and their outer normals from the inner configuration only, without geometry or level set, 
+	 * e.g. for bodies with reloaded or remapped particles. 
+	 * @details The kernel gradient sum of a particle vanishes inside the body. 
+	 * A particle is a surface candidate if the magnitude of the sum is larger than a fraction 
+	 * of that at a flat lattice surface, and the normal is the opposite direction of the sum.
+	 * The candidate is a surface particle if no neighbor is found in the cone along its normal,
+	 * i.e. the half space outside is empty. The inner configuration should be built before.
+	 */
+	class BodySurfaceFromParticles : public BodyPartByParticle
+	{
+	protected:
+		/** fraction of the kernel gradient sum at a flat lattice surface for surface candidates */
+		Real gradient_sum_fraction_;
+		/** cosine of the half angle of the cone along the normal */
+		Real cone_cosine_;
+		/** the kernel gradient sum at a flat lattice surface */
+		Real computeLatticeSurfaceGradientSum();
+		virtual void TagBodyPartParticles() override;
+	public:
+		/** Outer normal directions of the surface particles, in the same order. */
+		StdVec<Vecd> surface_normals_;
+
+		explicit BodySurfaceFromParticles(SPHBody* body, 
+			Real gradient_sum_fraction = 0.25, Real cone_cosine = 0.7);
+		virtual~BodySurfaceFromParticles() {};
+	};
+
 	/**
 	 * @class BodyPartByCell
 	 * @brief An auxillariy class for SPHBody to
@@ -305,14 +440,27 @@ namespace SPH
 	class BodyPartByCell : public BodyPart
 	{
 	protected:
+		/** Particles in the tagged cells, cached from the cell linked lists. */
+		IndexVector body_part_particles_;
+		/** The cell list update the cached particles are collected from. */
+		size_t cached_cell_list_update_;
+
 		virtual void TagBodyPartCells();
+		/** Collect the particles in the tagged cells. */
+		void collectBodyPartParticles();
 	public:
 		/** Collection of cells to indicate the body part. */
 		CellLists body_part_cells_;
 
 		BodyPartByCell(SPHBody *body, string body_part_name)
-			: BodyPart(body, body_part_name) {};
+			: BodyPart(body, body_part_name), 
+			cached_cell_list_update_(std::numeric_limits<size_t>::max()) {};
 		virtual ~BodyPartByCell() {};
+
+		/** The particles in the body part, which are only recollected when 
+		  * the cell linked lists of the body have been updated since last time. 
+		  * For a body in total Lagrangian formulation, they are collected only once. */
+		IndexVector& getBodyPartParticles();
 	};
 
 	/**
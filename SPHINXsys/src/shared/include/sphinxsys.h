@@ -8,9 +8,13 @@ capabilities. **/
 #include "all_kernels.h"
 #include "all_particles.h"
 #include "geometry.h"
+#include "voxel_shape.h"
 #include "all_meshes.h"
 #include "all_types_of_bodies.h"
 #include "sph_system.h"
+#include "mesh_system.h"
+#include "sph_system_ensemble.h"
+#include "sph_system_snapshot.h"
 #include "all_materials.h"
 #include "all_physical_dynamics.h"
 #include "all_simbody.h"
@@ -11,6 +11,36 @@
 
 namespace SPH 
 {
+	/** Version of the binary files, to be increased when their format is changed. */
+	const uint32_t binary_file_version = 1;
+	/** Byte order mark, which is read as another value on a platform with another byte order. */
+	const uint32_t binary_file_byte_order = 0x01020304;
+	//=============================================================================================//
+	static StdVec<uint32_t> binaryFileHeader()
+	{
+		return { binary_file_version, binary_file_byte_order, uint32_t(sizeof(size_t)),
+			uint32_t(sizeof(Real)), uint32_t(sizeof(ParticleIndex)), uint32_t(sizeof(Vecd)) };
+	}
+	//=============================================================================================//
+	void writeBinaryFileHeader(std::ofstream& output_file)
+	{
+		StdVec<uint32_t> header = binaryFileHeader();
+		output_file.write(reinterpret_cast<const char*>(header.data()), header.size() * sizeof(uint32_t));
+	}
+	//=============================================================================================//
+	void checkBinaryFileHeader(std::ifstream& input_file, const std::string& filefullpath)
+	{
+		StdVec<uint32_t> expected_header = binaryFileHeader();
+		StdVec<uint32_t> header(expected_header.size(), 0);
+		input_file.read(reinterpret_cast<char*>(header.data()), header.size() * sizeof(uint32_t));
+		if (!input_file || header != expected_header)
+		{
+			std::cout << "\n Error: the binary file:" << filefullpath
+				<< " is of another version, or written with another byte order or data sizes" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+	}
 	//=============================================================================================//
 	In_Output::In_Output(SPHSystem &sph_system)
 		: sph_system_(sph_system)
@@ -123,7 +153,7 @@ namespace SPH
 
 		if (out_of_bound_) {
 			WriteBodyStatesToVtu::WriteToFile(time);
-			cout << "\n Velocity is out of bound at physical time " << GlobalStaticVariables::physical_time_
+			cout << "\n Velocity is out of bound at physical time " << in_output_.sph_system_.physical_time_
 				 <<"\n The body states have been outputted and the simulation terminates here. \n";
 		}
 	}
@@ -148,6 +178,19 @@ namespace SPH
 		body_->mesh_background_->WriteMeshToPltFile(out_file);
 		out_file.close();
 	}
+	//=============================================================================================//
+	void WriteMeshSystemToPlt::WriteToFile(Real time)
+	{
+		int Itime = int(time*1.0e4);
+		std::string filefullpath = in_output_.output_folder_ + "/" + mesh_system_name_ + "_" + std::to_string(Itime) + ".plt";
+		if (fs::exists(filefullpath))
+		{
+			fs::remove(filefullpath);
+		}
+		std::ofstream out_file(filefullpath.c_str(), ios::trunc);
+		mesh_system_.WriteMeshToPltFile(out_file);
+		out_file.close();
+	}
 //=================================================================================================//
 	WriteTotalMechanicalEnergy
 		::WriteTotalMechanicalEnergy(In_Output &in_output, FluidBody* water_block, Gravity* gravity)
@@ -341,7 +384,10 @@ namespace SPH
 			fs::remove(overall_filefullpath);
 		}
 		std::ofstream out_file(overall_filefullpath.c_str(), ios::app);
-		out_file << fixed << setprecision(9) << GlobalStaticVariables::physical_time_ << "   \n";
+		out_file << fixed << setprecision(9) << in_output_.sph_system_.physical_time_ << "   \n";
+		/** the state of the random numbers */
+		CounterBasedRandomNumbers& random_numbers = in_output_.sph_system_.random_numbers_;
+		out_file << random_numbers.random_seed_ << "   " << random_numbers.random_step_ << "   \n";
 		out_file.close();
 
 		for (size_t i = 0; i < bodies_.size(); ++i)
@@ -369,6 +415,14 @@ namespace SPH
 		Real restart_time;
 		std::ifstream in_file(overall_filefullpath.c_str());
 		in_file >> restart_time;
+		/** the state of the random numbers, not available in the files written by earlier versions */
+		size_t random_seed, random_step;
+		if (in_file >> random_seed >> random_step)
+		{
+			CounterBasedRandomNumbers& random_numbers = in_output_.sph_system_.random_numbers_;
+			random_numbers.random_seed_ = random_seed;
+			random_numbers.random_step_ = random_step;
+		}
 		in_file.close();
 
 		return restart_time;
@@ -391,6 +445,110 @@ namespace SPH
 		}
 	}
 	//=============================================================================================//
+	ReferenceConfigurationIO::ReferenceConfigurationIO(In_Output& in_output, SPHBodyVector bodies)
+	{
+		for (SPHBody* body : bodies)
+		{
+			file_paths_.push_back(in_output.restart_folder_ + "/SPHBody_" + body->GetBodyName() + "_ref.bin");
+		}
+	}
+	//=============================================================================================//
+	WriteReferenceConfiguration::WriteReferenceConfiguration(In_Output& in_output, SPHBodyVector bodies)
+		: ReferenceConfigurationIO(in_output, bodies), WriteBodyStates(in_output, bodies)
+	{
+		if (!fs::exists(in_output.restart_folder_))
+		{
+			fs::create_directory(in_output.restart_folder_);
+		}
+	}
+	//=============================================================================================//
+	void WriteReferenceConfiguration::WriteToFile(Real time)
+	{
+		for (size_t i = 0; i < bodies_.size(); ++i)
+		{
+			bodies_[i]->WriteReferenceConfigurationToBinary(file_paths_[i]);
+		}
+	}
+	//=============================================================================================//
+	bool ReadReferenceConfiguration::CheckReferenceConfigurationFiles()
+	{
+		for (size_t i = 0; i < bodies_.size(); ++i)
+		{
+			if (!fs::exists(file_paths_[i])) return false;
+		}
+		return true;
+	}
+	//=============================================================================================//
+	void ReadReferenceConfiguration::ReadFromFile(size_t iteration_step)
+	{
+		std::cout << "\n Reading reference configurations from files." << std::endl;
+		for (size_t i = 0; i < bodies_.size(); ++i)
+		{
+			std::string filefullpath = file_paths_[i];
+
+			if (!fs::exists(filefullpath))
+			{
+				std::cout << "\n Error: the input file:" << filefullpath << " is not exists" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+
+			bodies_[i]->ReadReferenceConfigurationFromBinary(filefullpath);
+		}
+	}
+	//=============================================================================================//
+	TransferOperatorIO::TransferOperatorIO(In_Output& in_output,
+		StdVec<observer_dynamics::TransferOperator*> transfer_operators)
+		: transfer_operators_(transfer_operators)
+	{
+		for (observer_dynamics::TransferOperator* transfer_operator : transfer_operators)
+		{
+			std::string file_path = in_output.restart_folder_ + "/TransferOperator_"
+				+ transfer_operator->getObserverBody()->GetBodyName() + "_from";
+			for (SPHBody* target_body : transfer_operator->getTargetBodies())
+				file_path += "_" + target_body->GetBodyName();
+			file_paths_.push_back(file_path + ".bin");
+		}
+	}
+	//=============================================================================================//
+	void WriteTransferOperators::WriteToFile()
+	{
+		for (size_t i = 0; i < transfer_operators_.size(); ++i)
+		{
+			std::ofstream output_file(file_paths_[i].c_str(), ios::binary | ios::trunc);
+			writeBinaryFileHeader(output_file);
+			transfer_operators_[i]->WriteToBinary(output_file);
+			output_file.close();
+		}
+	}
+	//=============================================================================================//
+	bool ReadTransferOperators::CheckTransferOperatorFiles()
+	{
+		for (size_t i = 0; i < transfer_operators_.size(); ++i)
+		{
+			if (!fs::exists(file_paths_[i])) return false;
+		}
+		return true;
+	}
+	//=============================================================================================//
+	void ReadTransferOperators::ReadFromFile()
+	{
+		std::cout << "\n Reading transfer operators from files." << std::endl;
+		for (size_t i = 0; i < transfer_operators_.size(); ++i)
+		{
+			if (!fs::exists(file_paths_[i]))
+			{
+				std::cout << "\n Error: the input file:" << file_paths_[i] << " is not exists" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+			std::ifstream input_file(file_paths_[i].c_str(), ios::binary);
+			checkBinaryFileHeader(input_file, file_paths_[i]);
+			transfer_operators_[i]->ReadFromBinary(input_file);
+			input_file.close();
+		}
+	}
+	//=============================================================================================//
 	WriteSimBodyPinAngleAndAngleRate
 		::WriteSimBodyPinAngleAndAngleRate(In_Output& in_output, StdVec<SimTK::MobilizedBody::Pin *> mobodies, SimTK::RungeKuttaMersonIntegrator &integ)
 		: WriteSimBodyStates<SimTK::MobilizedBody::Pin>(in_output, mobodies), integ_(integ)
@@ -27,6 +27,11 @@ namespace fs = std::experimental::filesystem;
 #endif
 
 namespace SPH {
+	/** Write the header of a binary file, with the format version and the byte order and sizes of the data. */
+	void writeBinaryFileHeader(std::ofstream& output_file);
+	/** Check the header of a binary file, exit if it is of another version or written on another platform. */
+	void checkBinaryFileHeader(std::ifstream& input_file, const std::string& filefullpath);
+
 	/**
 	 * @class In_Output
 	 * @brief The base class which defines folders for output, 
@@ -212,6 +217,24 @@ namespace SPH {
 		virtual void WriteToFile(Real time = 0.0) override;
 	};
 
+	/**
+	 * @class WriteMeshSystemToPlt
+	 * @brief  write the far-field flow of a mesh system
+	 */
+	class WriteMeshSystemToPlt
+	{
+	protected:
+		In_Output& in_output_;
+		MeshSystem& mesh_system_;
+		std::string mesh_system_name_;
+	public:
+		WriteMeshSystemToPlt(In_Output& in_output, MeshSystem& mesh_system, std::string mesh_system_name = "MeshSystem")
+			: in_output_(in_output), mesh_system_(mesh_system), mesh_system_name_(mesh_system_name) {};
+		virtual ~WriteMeshSystemToPlt() {};
+
+		virtual void WriteToFile(Real time);
+	};
+
 	/**
 	 * @class WriteObservedFluidPressure
 	 * @brief write files for observed fluid pressure
@@ -472,6 +495,97 @@ namespace SPH {
 		virtual void ReadFromFile(size_t iteration_step = 0) override;
 	};
 
+	/**
+	 * @class ReferenceConfigurationIO
+	 * @brief For write and read the reference configurations in binary format.
+	 * The files are kept in the restart folder, as they are required for restarting
+	 * bodies in total Lagrangian formulation without building the configurations again.
+	 */
+	class ReferenceConfigurationIO
+	{
+	protected:
+		StdVec<std::string> file_paths_;
+
+	public:
+		ReferenceConfigurationIO(In_Output& in_output, SPHBodyVector bodies);
+		virtual ~ReferenceConfigurationIO() {};
+	};
+
+	/**
+	 * @class WriteReferenceConfiguration
+	 * @brief Write the reference configurations, usually once after they are built and corrected.
+	 */
+	class WriteReferenceConfiguration : public ReferenceConfigurationIO, public WriteBodyStates
+	{
+	public:
+		WriteReferenceConfiguration(In_Output& in_output, SPHBodyVector bodies);
+		virtual ~WriteReferenceConfiguration() {};
+
+		virtual void WriteToFile(Real time = 0.0) override;
+	};
+
+	/**
+	 * @class ReadReferenceConfiguration
+	 * @brief Read the reference configurations, after the cell linked lists are initialized.
+	 */
+	class ReadReferenceConfiguration : public ReferenceConfigurationIO, public ReadBodyStates
+	{
+	public:
+		ReadReferenceConfiguration(In_Output& in_output, SPHBodyVector bodies)
+			: ReferenceConfigurationIO(in_output, bodies), ReadBodyStates(in_output, bodies) {};
+		virtual ~ReadReferenceConfiguration() {};
+
+		/** Whether the files of all bodies are available. */
+		bool CheckReferenceConfigurationFiles();
+		virtual void ReadFromFile(size_t iteration_step = 0) override;
+	};
+
+	/**
+	 * @class TransferOperatorIO
+	 * @brief For write and read the weights of transfer operators in binary format,
+	 * which are kept in the restart folder with the reference configurations.
+	 */
+	class TransferOperatorIO
+	{
+	protected:
+		StdVec<observer_dynamics::TransferOperator*> transfer_operators_;
+		StdVec<std::string> file_paths_;
+
+	public:
+		TransferOperatorIO(In_Output& in_output, StdVec<observer_dynamics::TransferOperator*> transfer_operators);
+		virtual ~TransferOperatorIO() {};
+	};
+
+	/**
+	 * @class WriteTransferOperators
+	 * @brief Write the weights of transfer operators, usually once after they are built.
+	 */
+	class WriteTransferOperators : public TransferOperatorIO
+	{
+	public:
+		WriteTransferOperators(In_Output& in_output, StdVec<observer_dynamics::TransferOperator*> transfer_operators)
+			: TransferOperatorIO(in_output, transfer_operators) {};
+		virtual ~WriteTransferOperators() {};
+
+		void WriteToFile();
+	};
+
+	/**
+	 * @class ReadTransferOperators
+	 * @brief Read the weights of transfer operators instead of building them.
+	 */
+	class ReadTransferOperators : public TransferOperatorIO
+	{
+	public:
+		ReadTransferOperators(In_Output& in_output, StdVec<observer_dynamics::TransferOperator*> transfer_operators)
+			: TransferOperatorIO(in_output, transfer_operators) {};
+		virtual ~ReadTransferOperators() {};
+
+		/** Whether the files of all transfer operators are available. */
+		bool CheckTransferOperatorFiles();
+		void ReadFromFile();
+	};
+
 	/**
 	 * @class WriteSimBodyPinAngleAndAngleRate
 	* @brief Write total force acting a solid body.
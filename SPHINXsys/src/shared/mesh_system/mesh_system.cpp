@@ -0,0 +1,334 @@
+/**
+ * @file 	mesh_system.cpp
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "mesh_system.h"
+#include "base_body.h"
+#include "fluid_particles.h"
+#include "mesh_cell_linked_list.h"
+
+#include <limits>
+
+namespace SPH
+{
+	//=================================================================================================//
+	MeshSystem::MeshSystem(Vecd lower_bound, Vecd upper_bound, Real mesh_spacing,
+		WeaklyCompressibleFluid* material, Vecd far_field_velocity)
+		: Mesh(lower_bound, upper_bound, mesh_spacing, 1), material_(material), physical_time_(0.0),
+		far_field_rho_(material->GetReferenceDensity()), far_field_velocity_(far_field_velocity),
+		particle_region_lower_bound_(0), particle_region_upper_bound_(0), overlap_width_(0.0)
+	{
+		AllocateMeshDataMatrix();
+		InitializeFarField();
+	}
+	//=================================================================================================//
+	size_t MeshSystem::getNumberOfTotalCells()
+	{
+		size_t number_of_cells = 1;
+		for (int n = 0; n != Vecd(0).size(); ++n) number_of_cells *= number_of_cells_[n];
+		return number_of_cells;
+	}
+	//=================================================================================================//
+	void MeshSystem::AllocateMeshDataMatrix()
+	{
+		cell_data_.resize(getNumberOfTotalCells());
+	}
+	//=================================================================================================//
+	void MeshSystem::DeleteMeshDataMatrix()
+	{
+		StdLargeVec<EulerianCellData>().swap(cell_data_);
+	}
+	//=================================================================================================//
+	bool MeshSystem::isFarFieldCell(Vecu cell_index)
+	{
+		for (int n = 0; n != Vecd(0).size(); ++n)
+			if (cell_index[n] == 0 || cell_index[n] == number_of_cells_[n] - 1) return true;
+		return false;
+	}
+	//=================================================================================================//
+	Real MeshSystem::getDistanceToParticleRegionBorder(Vecd& position)
+	{
+		Real distance = std::numeric_limits<Real>::max();
+		for (int n = 0; n != Vecd(0).size(); ++n)
+			distance = SMIN(distance, position[n] - particle_region_lower_bound_[n],
+				particle_region_upper_bound_[n] - position[n]);
+		return distance;
+	}
+	//=================================================================================================//
+	void MeshSystem::setParticleRegion(Vecd lower_bound, Vecd upper_bound, Real overlap_width)
+	{
+		if (overlap_width <= cell_spacing_)
+		{
+			std::cout << "\n Error: the overlap zone is required to be wider than the grid spacing of the mesh system!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		particle_region_lower_bound_ = lower_bound;
+		particle_region_upper_bound_ = upper_bound;
+		overlap_width_ = overlap_width;
+
+		parallel_for(blocked_range<size_t>(0, cell_data_.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					Vecu cell_index = transfer1DtoMeshIndex(number_of_cells_, i);
+					Vecd cell_position = CellPositionFromIndexes(cell_index);
+					cell_data_[i].is_covered_ = !isFarFieldCell(cell_index)
+						&& getDistanceToParticleRegionBorder(cell_position) > overlap_width_;
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	bool MeshSystem::isInParticleRegion(Vecd& position)
+	{
+		return getDistanceToParticleRegionBorder(position) >= 0.0;
+	}
+	//=================================================================================================//
+	bool MeshSystem::isInOverlapZone(Vecd& position)
+	{
+		return getDistanceToParticleRegionBorder(position) <= overlap_width_;
+	}
+	//=================================================================================================//
+	Real MeshSystem::getOverlapWeight(Vecd& position)
+	{
+		Real weight = 1.0 - getDistanceToParticleRegionBorder(position) / overlap_width_;
+		return SMIN(SMAX(weight, 0.0), 1.0);
+	}
+	//=================================================================================================//
+	void MeshSystem::InitializeFarField()
+	{
+		Real far_field_pressure = material_->GetPressure(far_field_rho_);
+		parallel_for(blocked_range<size_t>(0, cell_data_.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					cell_data_[i].rho_ = far_field_rho_;
+					cell_data_[i].p_ = far_field_pressure;
+					cell_data_[i].vel_ = far_field_velocity_;
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	Real MeshSystem::GetTimeStepSize()
+	{
+		Real max_signal_speed = parallel_reduce(blocked_range<size_t>(0, cell_data_.size()),
+			Real(0), [&](const blocked_range<size_t>& r, Real temp)->Real {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					EulerianCellData& cell_data_i = cell_data_[i];
+					temp = SMAX(temp, cell_data_i.vel_.norm()
+						+ material_->GetSoundSpeed(cell_data_i.p_, cell_data_i.rho_));
+				}
+				return temp;
+			},
+			[](Real x, Real y)->Real { return SMAX(x, y); }, ap);
+
+		/** the CFL number is for the sum of the fluxes in all directions */
+		return 0.4 * cell_spacing_ / Real(Vecd(0).size()) / (max_signal_speed + 1.0e-15);
+	}
+	//=================================================================================================//
+	void MeshSystem::getRusanovFlux(EulerianCellData& left, EulerianCellData& right, int axis,
+		Real& mass_flux, Vecd& momentum_flux)
+	{
+		Real u_l = left.vel_[axis];
+		Real u_r = right.vel_[axis];
+		Vecd unit_direction(0);
+		unit_direction[axis] = 1.0;
+
+		Real max_wave_speed = SMAX(fabs(u_l) + material_->GetSoundSpeed(left.p_, left.rho_),
+			fabs(u_r) + material_->GetSoundSpeed(right.p_, right.rho_));
+		mass_flux = 0.5 * (left.rho_ * u_l + right.rho_ * u_r)
+			- 0.5 * max_wave_speed * (right.rho_ - left.rho_);
+		momentum_flux = 0.5 * (left.rho_ * left.vel_ * u_l + right.rho_ * right.vel_ * u_r
+			+ (left.p_ + right.p_) * unit_direction)
+			- 0.5 * max_wave_speed * (right.rho_ * right.vel_ - left.rho_ * left.vel_);
+	}
+	//=================================================================================================//
+	void MeshSystem::ComputeChangeRate(size_t cell_index_1d)
+	{
+		EulerianCellData& cell_data_i = cell_data_[cell_index_1d];
+		cell_data_i.drho_dt_ = 0.0;
+		cell_data_i.dmom_dt_ = Vecd(0);
+		Vecu cell_index = transfer1DtoMeshIndex(number_of_cells_, cell_index_1d);
+		if (cell_data_i.is_covered_ || isFarFieldCell(cell_index)) return;
+
+		for (int axis = 0; axis != Vecd(0).size(); ++axis)
+		{
+			Vecu left_index = cell_index;
+			left_index[axis] -= 1;
+			Vecu right_index = cell_index;
+			right_index[axis] += 1;
+			EulerianCellData& left = cell_data_[transferMeshIndexTo1D(number_of_cells_, left_index)];
+			EulerianCellData& right = cell_data_[transferMeshIndexTo1D(number_of_cells_, right_index)];
+
+			Real mass_flux_left, mass_flux_right;
+			Vecd momentum_flux_left, momentum_flux_right;
+			getRusanovFlux(left, cell_data_i, axis, mass_flux_left, momentum_flux_left);
+			getRusanovFlux(cell_data_i, right, axis, mass_flux_right, momentum_flux_right);
+			cell_data_i.drho_dt_ -= (mass_flux_right - mass_flux_left) / cell_spacing_;
+			cell_data_i.dmom_dt_ -= (momentum_flux_right - momentum_flux_left) / cell_spacing_;
+		}
+	}
+	//=================================================================================================//
+	void MeshSystem::UpdateCell(size_t cell_index_1d, Real dt)
+	{
+		EulerianCellData& cell_data_i = cell_data_[cell_index_1d];
+		if (cell_data_i.is_covered_ || isFarFieldCell(transfer1DtoMeshIndex(number_of_cells_, cell_index_1d))) return;
+
+		Vecd momentum = cell_data_i.rho_ * cell_data_i.vel_ + cell_data_i.dmom_dt_ * dt;
+		cell_data_i.rho_ += cell_data_i.drho_dt_ * dt;
+		cell_data_i.vel_ = momentum / cell_data_i.rho_;
+		cell_data_i.p_ = material_->GetPressure(cell_data_i.rho_);
+	}
+	//=================================================================================================//
+	void MeshSystem::AdvanceTimeStep(Real dt)
+	{
+		parallel_for(blocked_range<size_t>(0, cell_data_.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) ComputeChangeRate(i);
+			}, ap);
+		parallel_for(blocked_range<size_t>(0, cell_data_.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) UpdateCell(i, dt);
+			}, ap);
+	}
+	//=================================================================================================//
+	void MeshSystem::IntegrateToTime(Real end_time)
+	{
+		while (physical_time_ < end_time)
+		{
+			Real dt = SMIN(GetTimeStepSize(), end_time - physical_time_);
+			AdvanceTimeStep(dt);
+			physical_time_ += dt;
+		}
+	}
+	//=================================================================================================//
+	void MeshSystem::UpdateCoveredCellsFromParticles(SPHBody* fluid_body)
+	{
+		FluidParticles* fluid_particles
+			= dynamic_cast<FluidParticles*>(fluid_body->base_particles_->PointToThisObject());
+		if (fluid_particles == NULL)
+		{
+			std::cout << "\n Error: the body " << fluid_body->GetBodyName()
+				<< " coupled with the mesh system is not a fluid body!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		BaseMeshCellLinkedList* mesh_cell_linked_list = fluid_body->base_mesh_cell_linked_list_;
+
+		parallel_for(blocked_range<size_t>(0, cell_data_.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					EulerianCellData& cell_data_i = cell_data_[i];
+					if (!cell_data_i.is_covered_) continue;
+
+					Vecd cell_position = CellPositionFromIndexes(transfer1DtoMeshIndex(number_of_cells_, i));
+					Vecd cell_lower_bound = cell_position - Vecd(0.5 * cell_spacing_);
+					Vecd cell_upper_bound = cell_position + Vecd(0.5 * cell_spacing_);
+					/** the particles are found from the cells of the body overlapping with this cell */
+					Vecu lower_index = mesh_cell_linked_list->CellIndexesFromPosition(cell_lower_bound);
+					Vecu upper_index = mesh_cell_linked_list->CellIndexesFromPosition(cell_upper_bound);
+					Vecu search_range = upper_index - lower_index + Vecu(1);
+					size_t number_of_search_cells = 1;
+					for (int n = 0; n != Vecd(0).size(); ++n) number_of_search_cells *= search_range[n];
+
+					Real volume = 0.0, mass = 0.0;
+					Vecd momentum(0);
+					for (size_t s = 0; s != number_of_search_cells; ++s)
+					{
+						CellList* cell_list = mesh_cell_linked_list
+							->getCellList(lower_index + transfer1DtoMeshIndex(search_range, s));
+						IndexVector& particle_indexes = cell_list->particle_indexes_;
+						StdVec<Vecd>& particle_positions = cell_list->particle_positions_;
+						for (size_t k = 0; k != particle_indexes.size(); ++k)
+						{
+							Vecd& position = particle_positions[k];
+							bool is_in_cell = true;
+							for (int n = 0; n != Vecd(0).size(); ++n)
+								if (position[n] < cell_lower_bound[n] || position[n] >= cell_upper_bound[n]) is_in_cell = false;
+							if (!is_in_cell) continue;
+
+							size_t index_particle_j = particle_indexes[k];
+							BaseParticleData& base_particle_data_j = fluid_particles->base_particle_data_[index_particle_j];
+							FluidParticleData& fluid_data_j = fluid_particles->fluid_particle_data_[index_particle_j];
+							volume += base_particle_data_j.Vol_;
+							mass += base_particle_data_j.Vol_ * fluid_data_j.rho_n_;
+							momentum += base_particle_data_j.Vol_ * fluid_data_j.rho_n_ * base_particle_data_j.vel_n_;
+						}
+					}
+					/** a covered cell without fluid particles, e.g. inside a structure, keeps its values */
+					if (volume > 0.0)
+					{
+						cell_data_i.rho_ = mass / volume;
+						cell_data_i.vel_ = momentum / mass;
+						cell_data_i.p_ = material_->GetPressure(cell_data_i.rho_);
+					}
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	void MeshSystem::InterpolateState(Vecd& position, Real& rho, Vecd& velocity)
+	{
+		/** the lower cell and the weights of the upper cells in each direction */
+		Vecd relative_position = (position - mesh_lower_bound_) / cell_spacing_ - Vecd(0.5);
+		Vecu lower_index(0);
+		Vecd weight(0);
+		for (int n = 0; n != Vecd(0).size(); ++n)
+		{
+			int index = clamp((int)floor(relative_position[n]), 0, int(number_of_cells_[n]) - 2);
+			lower_index[n] = size_t(index);
+			weight[n] = SMIN(SMAX(relative_position[n] - Real(index), 0.0), 1.0);
+		}
+
+		rho = 0.0;
+		velocity = Vecd(0);
+		size_t number_of_corners = powern(2, Vecd(0).size());
+		for (size_t c = 0; c != number_of_corners; ++c)
+		{
+			Vecu corner = transfer1DtoMeshIndex(Vecu(2), c);
+			Real corner_weight = 1.0;
+			for (int n = 0; n != Vecd(0).size(); ++n)
+				corner_weight *= corner[n] == 0 ? 1.0 - weight[n] : weight[n];
+			EulerianCellData& cell_data = cell_data_[transferMeshIndexTo1D(number_of_cells_, lower_index + corner)];
+			rho += corner_weight * cell_data.rho_;
+			velocity += corner_weight * cell_data.vel_;
+		}
+	}
+	//=================================================================================================//
+	void MeshSystem::WriteMeshToPltFile(ofstream& output_file)
+	{
+		int dimension = Vecd(0).size();
+		const char* coordinate_names[3] = { "x", "y", "z" };
+		const char* velocity_names[3] = { "u", "v", "w" };
+
+		output_file << "\n";
+		output_file << "title='View'" << "\n";
+		output_file << "variables= ";
+		for (int n = 0; n != dimension; ++n) output_file << coordinate_names[n] << ", ";
+		output_file << "rho, p, ";
+		for (int n = 0; n != dimension; ++n) output_file << velocity_names[n] << ", ";
+		output_file << "covered" << "\n";
+		output_file << "zone i=" << number_of_cells_[0] << "  j=" << number_of_cells_[1]
+			<< "  k=" << (dimension == 3 ? number_of_cells_[dimension - 1] : 1)
+			<< "  DATAPACKING=POINT  SOLUTIONTIME=" << physical_time_ << "\n";
+
+		/** the first index runs fastest */
+		size_t number_of_total_cells = getNumberOfTotalCells();
+		for (size_t num = 0; num != number_of_total_cells; ++num)
+		{
+			Vecu cell_index(0);
+			size_t left_over = num;
+			for (int n = 0; n != dimension; ++n)
+			{
+				cell_index[n] = left_over % number_of_cells_[n];
+				left_over /= number_of_cells_[n];
+			}
+			Vecd cell_position = CellPositionFromIndexes(cell_index);
+			EulerianCellData& cell_data = cell_data_[transferMeshIndexTo1D(number_of_cells_, cell_index)];
+			for (int n = 0; n != dimension; ++n) output_file << cell_position[n] << " ";
+			output_file << cell_data.rho_ << " " << cell_data.p_ << " ";
+			for (int n = 0; n != dimension; ++n) output_file << cell_data.vel_[n] << " ";
+			output_file << int(cell_data.is_covered_) << "\n";
+		}
+	}
+	//=================================================================================================//
+}
@@ -1,65 +1,120 @@
+/**
+ * @file 	mesh_system.h
+ * @brief 	The mesh system is the Eulerian counterpart of the SPH system.
+ * @details The weakly compressible flow in the far field is solved on a uniform Cartesian grid
+ *			by an explicit finite volume method with Rusanov fluxes. A fluid body is represented
+ *			by particles only in a near-field particle region. The cells well inside the region,
+ *			i.e. not in the overlap zone along the border of the region, get their values
+ *			from the particles, and the particles in the overlap zone are relaxed to the values
+ *			interpolated from the grid. The outermost layer of cells keeps the far-field state.
+ *			The grid is advanced with its own time step size to the time of the particles
+ *			after each advection step of the fluid body. The particles enter the region
+ *			from a buffer at an inflow face and are removed once they have left the region,
+ *			see the far-field conditions in fluid_dynamics.h.
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
 #pragma once
 
-#include "base_data_package.h"
-#include "all_kernels.h"
-#include "all_types_of_bodies.h"
-#include "particle_generator.h"
-#include "sph_system.h"
-//#include "output.h"
+#include "base_mesh.h"
+#include "weakly_compressible_fluid.h"
 
 namespace SPH
 {
+	class SPHBody;
 
-	class SPHSystem;
-
-	/*
-	Mesh system also managing objects in the system level
-	It is dual system respected SPH system
-	Here a base class is defined for 2d and 3d 
-	which will defined as dervied classes
-	*/
-
-	class MeshSystem
+	/**
+	 * @class EulerianCellData
+	 * @brief The flow state in a cell of the mesh system.
+	 */
+	class EulerianCellData
 	{
-		//creat a object for output
-		virtual void create_output() = 0;
-		//delete the object for output field data
-		virtual void destroy_output() = 0;
-		//domain bounds
-		Vecd lower_bound_, upper_bound_;
-		//reference mesh spacing
-		Real mesh_spacing_;
-
 	public:
+		EulerianCellData() : rho_(1.0), p_(0.0), vel_(0),
+			drho_dt_(0.0), dmom_dt_(0), is_covered_(false) {};
+		virtual ~EulerianCellData() {};
 
-		//SPHSystem constructor
-		MeshSystem();
-		virtual ~MeshSystem();
+		/** density, pressure and velocity */
+		Real rho_, p_;
+		Vecd vel_;
+		/** change rates of the mass and momentum densities */
+		Real drho_dt_;
+		Vecd dmom_dt_;
+		/** the cell is covered by the particles and gets its values from them */
+		bool is_covered_;
+	};
 
-		//whether a domain added
-		bool is_domain_added_;
-		//Initialize TBB
-		task_scheduler_init *tbb_init_;
+	/**
+	 * @class MeshSystem
+	 * @brief The mesh system solving the far-field flow,
+	 * and exchanging the flow states with a fluid body in the overlap zone.
+	 */
+	class MeshSystem : public Mesh
+	{
+	protected:
+		WeaklyCompressibleFluid* material_;
+		/** the time to which the grid has been advanced */
+		Real physical_time_;
+		/** the far-field state, also the initial state */
+		Real far_field_rho_;
+		Vecd far_field_velocity_;
+		/** cell data stored by the 1d cell index */
+		StdLargeVec<EulerianCellData> cell_data_;
+		/** the particle region and the width of the overlap zone inside its border */
+		Vecd particle_region_lower_bound_, particle_region_upper_bound_;
+		Real overlap_width_;
 
-		//the bodies in the SPH system
-		StdVec<SPHBody* > bodies_;
-		//the real bodies
-		StdVec<SPHBody* > real_bodies_;
-		//the ghost bodies
-		StdVec<SPHBody* > ghost_bodies_;
+		size_t getNumberOfTotalCells();
+		/** the outermost layer of cells keeps the far-field state */
+		bool isFarFieldCell(Vecu cell_index);
+		/** signed distance to the border of the particle region, positive inside */
+		Real getDistanceToParticleRegionBorder(Vecd& position);
+		/** Rusanov fluxes of mass and momentum across the face from the left to the right cell along an axis */
+		void getRusanovFlux(EulerianCellData& left, EulerianCellData& right, int axis,
+			Real& mass_flux, Vecd& momentum_flux);
+		/** change rates of the mass and momentum densities of a cell */
+		void ComputeChangeRate(size_t cell_index_1d);
+		/** update the state of a cell */
+		void UpdateCell(size_t cell_index_1d, Real dt);
+	public:
+		/** The mesh covers the domain, and the grid spacing is usually several particle spacings. */
+		MeshSystem(Vecd lower_bound, Vecd upper_bound, Real mesh_spacing,
+			WeaklyCompressibleFluid* material, Vecd far_field_velocity);
+		virtual ~MeshSystem() {};
 
-		//output object
-		Output* output_;
+		/** Set the particle region and the width of the overlap zone,
+		  * which is larger than a cell spacing so that the covered cells are surrounded by overlap cells. */
+		void setParticleRegion(Vecd lower_bound, Vecd upper_bound, Real overlap_width);
+		/** whether a position is in the particle region */
+		bool isInParticleRegion(Vecd& position);
+		/** whether a position is in the overlap zone */
+		bool isInOverlapZone(Vecd& position);
+		/** weight of the grid state in the overlap zone, 
+		  * from 1 at the border of the particle region to 0 at the inner edge of the zone */
+		Real getOverlapWeight(Vecd& position);
+		/** set all cells to the far-field state */
+		void InitializeFarField();
+		/** time step size by the CFL condition */
+		Real GetTimeStepSize();
+		/** advance the cells not covered by particles */
+		void AdvanceTimeStep(Real dt);
+		/** Advance the grid to the time of the particles by the time step size of the grid,
+		  * which is usually larger than the acoustic one of the particles as the grid spacing is larger.
+		  * Called after each advection step of the fluid body, before the states are exchanged. */
+		void IntegrateToTime(Real end_time);
+		Real getPhysicalTime() { return physical_time_; };
+		/** Update the covered cells with the averaged states of the particles of a fluid body.
+		  * The cell linked list of the body is required to be updated. */
+		void UpdateCoveredCellsFromParticles(SPHBody* fluid_body);
+		/** interpolate the density and velocity from the cell centers */
+		void InterpolateState(Vecd& position, Real& rho, Vecd& velocity);
 
-		//public functions to build up the system
-		//add the domain, which managing the geometric information 
-		//add a SPH body in the system
-		void AddBody(SPHBody* body);
-		//add a particle configuartion to the system 
-		void AddNNPS(NNPS* nnps = nullptr, bool Eulerian = true);
-		//write a output file at a given time
-		void OutputFile(Real _time);
-		//initialize the system
-		void InitializeSystem();
+		/** allcate memories for mesh data */
+		virtual void AllocateMeshDataMatrix() override;
+		/** delete memories for mesh data */
+		virtual void DeleteMeshDataMatrix() override;
+		/** output mesh data for visuallization */
+		virtual void WriteMeshToVtuFile(ofstream& output_file) override {};
+		virtual void WriteMeshToPltFile(ofstream& output_file) override;
 	};
-}
\ No newline at end of file
+}
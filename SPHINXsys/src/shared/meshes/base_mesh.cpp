@@ -129,11 +129,178 @@ namespace SPH {
 	MeshBackground
 		::MeshBackground(Vecd lower_bound, Vecd upper_bound, 
 			Real grid_spacing, size_t buffer_size)
-		: Mesh(lower_bound, upper_bound, grid_spacing, buffer_size)
+		: Mesh(lower_bound, upper_bound, grid_spacing, buffer_size),
+		mesh_background_data_(NULL)
 	{
 		number_of_grid_points_ = getNumberOfGridPoints(number_of_cells_);
 	}
 	//=================================================================================================//
+	void MeshBackground::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		size_t number_of_grid_points = 1;
+		for (int n = 0; n != Vecd(0).size(); ++n)
+			number_of_grid_points *= number_of_grid_points_[n];
+		memory_usages.push_back(MemoryUsage("level set data", number_of_grid_points,
+			number_of_grid_points, number_of_grid_points * sizeof(LevelSetData)));
+	}
+	//=================================================================================================//
+	SparseMeshBackground
+		::SparseMeshBackground(Vecd lower_bound, Vecd upper_bound,
+			Real grid_spacing, size_t buffer_size, size_t block_size)
+		: MeshBackground(lower_bound, upper_bound, grid_spacing, buffer_size),
+		block_size_(block_size), block_data_size_(1), number_of_blocks_(0),
+		is_curvature_computed_(false)
+	{
+		band_width_ = Real(block_size_) * grid_spacing_;
+		for (int n = 0; n != Vecd(0).size(); ++n)
+		{
+			number_of_blocks_[n] = (number_of_grid_points_[n] + block_size_ - 1) / block_size_;
+			block_data_size_ *= block_size_;
+		}
+		positive_far_field_ = LevelSetData(band_width_, Vecd(0));
+		negative_far_field_ = LevelSetData(-band_width_, Vecd(0));
+	}
+	//=================================================================================================//
+	void SparseMeshBackground::DeleteMeshDataMatrix()
+	{
+		band_block_index_.clear();
+		StdVec<Vecu>().swap(band_blocks_);
+		StdLargeVec<LevelSetData>().swap(band_data_);
+		std::vector<bool>().swap(is_inner_block_);
+		is_curvature_computed_ = false;
+	}
+	//=================================================================================================//
+	void SparseMeshBackground::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		memory_usages.push_back(vectorMemoryUsage("level set band data", band_data_));
+		memory_usages.push_back(vectorMemoryUsage("level set band blocks", band_blocks_));
+		size_t hash_bytes = band_block_index_.bucket_count() * sizeof(void*)
+			+ band_block_index_.size() * (sizeof(std::pair<const size_t, size_t>) + sizeof(void*));
+		memory_usages.push_back(MemoryUsage("level set block index",
+			band_block_index_.size(), band_block_index_.bucket_count(), hash_bytes));
+		memory_usages.push_back(MemoryUsage("level set block signs",
+			is_inner_block_.size(), is_inner_block_.capacity(), is_inner_block_.capacity() / 8));
+	}
+	//=================================================================================================//
+	LevelSetData& SparseMeshBackground::getGridData(Vecu grid_index)
+	{
+		Vecu block_index(0), local_index(0);
+		for (int n = 0; n != Vecd(0).size(); ++n)
+		{
+			block_index[n] = grid_index[n] / block_size_;
+			local_index[n] = grid_index[n] - block_index[n] * block_size_;
+		}
+		size_t block_index_1D = transferMeshIndexTo1D(number_of_blocks_, block_index);
+		auto band_block = band_block_index_.find(block_index_1D);
+		if (band_block == band_block_index_.end())
+			return is_inner_block_[block_index_1D] ? positive_far_field_ : negative_far_field_;
+		return band_data_[band_block->second + transferMeshIndexTo1D(Vecu(block_size_), local_index)];
+	}
+	//=================================================================================================//
+	Vecu SparseMeshBackground::getBandGridIndex(size_t band_data_index)
+	{
+		size_t block_number = band_data_index / block_data_size_;
+		return band_blocks_[block_number] * block_size_
+			+ transfer1DtoMeshIndex(Vecu(block_size_), band_data_index - block_number * block_data_size_);
+	}
+	//=================================================================================================//
+	template<typename DataType, DataType LevelSetData::* MemPtr>
+	DataType SparseMeshBackground::probeBandData(Vecd& position)
+	{
+		Vecu grid_index = GridIndexesFromPosition(position);
+		Vecd grid_position = GridPositionFromIndexes(grid_index);
+		Vecd alpha = (position - grid_position) / grid_spacing_;
+		int dimension = alpha.size();
+
+		DataType probed_data = DataType(0);
+		for (int corner = 0; corner != (1 << dimension); ++corner)
+		{
+			Vecu corner_index = grid_index;
+			Real weight = 1.0;
+			for (int n = 0; n != dimension; ++n)
+			{
+				if ((corner >> n) & 1)
+				{
+					corner_index[n] = SMIN(grid_index[n] + 1, number_of_grid_points_[n] - 1);
+					weight *= alpha[n];
+				}
+				else weight *= 1.0 - alpha[n];
+			}
+			probed_data += getGridData(corner_index).*MemPtr * weight;
+		}
+		return probed_data;
+	}
+	//=================================================================================================//
+	void SparseMeshBackground::InitializeLevelSetData(SPHBody &body)
+	{
+		DeleteMeshDataMatrix();
+		size_t total_number_of_blocks = 1;
+		for (int n = 0; n != Vecd(0).size(); ++n)
+			total_number_of_blocks *= number_of_blocks_[n];
+
+		/** The level set is a distance function, therefore, a block with its center
+		  * farther than the band width plus its half diagonal is out of the band. */
+		Real block_half_diagonal = 0.5 * Real(block_size_ - 1) * grid_spacing_
+			* sqrt(Real(Vecd(0).size()));
+		StdVec<Real> block_center_phi(total_number_of_blocks);
+		parallel_for(blocked_range<size_t>(0, total_number_of_blocks),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t l = r.begin(); l != r.end(); ++l)
+				{
+					Vecu block_index = transfer1DtoMeshIndex(number_of_blocks_, l);
+					Vecd block_center = GridPositionFromIndexes(block_index * block_size_)
+						+ Vecd(0.5 * Real(block_size_ - 1) * grid_spacing_);
+					Vecd closet_pnt_on_face(0);
+					body.ClosestPointOnBodySurface(block_center, closet_pnt_on_face, block_center_phi[l]);
+				}
+			}, ap);
+
+		is_inner_block_.resize(total_number_of_blocks);
+		for (size_t l = 0; l != total_number_of_blocks; ++l)
+		{
+			is_inner_block_[l] = block_center_phi[l] > 0.0;
+			if (fabs(block_center_phi[l]) < band_width_ + block_half_diagonal)
+			{
+				band_block_index_[l] = band_blocks_.size() * block_data_size_;
+				band_blocks_.push_back(transfer1DtoMeshIndex(number_of_blocks_, l));
+			}
+		}
+
+		band_data_.resize(band_blocks_.size() * block_data_size_);
+		parallel_for(blocked_range<size_t>(0, band_data_.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t m = r.begin(); m != r.end(); ++m)
+				{
+					Vecd grid_position = GridPositionFromIndexes(getBandGridIndex(m));
+					Vecd closet_pnt_on_face(0);
+					Real phi_from_surface = 0.0;
+					body.ClosestPointOnBodySurface(grid_position, closet_pnt_on_face, phi_from_surface);
+					band_data_[m] = LevelSetData(phi_from_surface, closet_pnt_on_face - grid_position);
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	Vecd SparseMeshBackground::ProbeNormalDirection(Vecd Point)
+	{
+		return probeBandData<Vecd, &LevelSetData::n_>(Point);
+	}
+	//=================================================================================================//
+	Real SparseMeshBackground::ProbeLevelSet(Vecd Point)
+	{
+		return probeBandData<Real, &LevelSetData::phi_>(Point);
+	}
+	//=================================================================================================//
+	Real SparseMeshBackground::ProbeCurvature(Vecd Point)
+	{
+		if (!is_curvature_computed_)
+		{
+			std::cout << "\n Error: the curvature of the sparse mesh is not computed in 3D!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		return probeBandData<Real, &LevelSetData::kappa_>(Point);
+	}
+	//=================================================================================================//
 	void BaseDataPackage
 		::initializePackageGoemetry(Vecd& pkg_lower_bound, Real data_spacing)
 	{
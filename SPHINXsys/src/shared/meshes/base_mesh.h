@@ -17,6 +17,7 @@
 #include "my_memory_pool.h"
 #include <fstream>
 #include <algorithm>
+#include <unordered_map>
 
 #include <functional>
 using namespace std::placeholders;
@@ -80,8 +81,7 @@ namespace SPH
 			},
 			[&](ReturnType x, ReturnType y)->ReturnType {
 				return reduce_operation(x, y);
-			}
-			);
+			}, ap);
 	};
 
 	/**
@@ -216,7 +216,7 @@ namespace SPH
 	 */
 	class MeshBackground : public Mesh
 	{
-		/** base mesh data */
+		/** base mesh data, NULL if not allocated */
 		MeshDataMatrix<LevelSetData> mesh_background_data_;
 	public:
 		MeshBackground(Vecd lower_bound, Vecd upper_bound, 
@@ -227,15 +227,17 @@ namespace SPH
 		virtual void AllocateMeshDataMatrix() override;
 		/** delete memories for mesh data */
 		virtual void DeleteMeshDataMatrix() override;
+		/** Collect the memory usage of the level set data. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages);
 
 		/** initialize level set and displacement to surface
 		  * for body region geometry */
-		void InitializeLevelSetData(SPHBody &body);
-		void ComputeCurvatureFromLevelSet(SPHBody &body);
+		virtual void InitializeLevelSetData(SPHBody &body);
+		virtual void ComputeCurvatureFromLevelSet(SPHBody &body);
 		/** probe the mesh data */
-		Vecd ProbeNormalDirection(Vecd Point);
-		Real ProbeLevelSet(Vecd Point);
-		Real ProbeCurvature(Vecd Point);
+		virtual Vecd ProbeNormalDirection(Vecd Point);
+		virtual Real ProbeLevelSet(Vecd Point);
+		virtual Real ProbeCurvature(Vecd Point);
 
 		/** output mesh data for Paraview visuallization */
 		virtual void WriteMeshToVtuFile(ofstream &output_file) override;
@@ -243,6 +245,70 @@ namespace SPH
 		virtual void WriteMeshToPltFile(ofstream &output_file) override;
 	};
 
+	/**
+	 * @class SparseMeshBackground
+	 * @brief Background mesh with the level set data only in a narrow band
+	 * around the body surface, for large and thin geometries.
+	 * @details The grid points are grouped into blocks. Only the blocks
+	 * intersecting the narrow band are allocated, and they are found
+	 * from a hashed block index. For the other blocks, only the sign of the level set is kept.
+	 * There, the level set is given by the band width and the normal direction is zero,
+	 * as the far-field packages of the level set.
+	 */
+	class SparseMeshBackground : public MeshBackground
+	{
+	protected:
+		/** number of grid points in a block by dimension */
+		size_t block_size_;
+		/** number of grid points in a block */
+		size_t block_data_size_;
+		/** half width of the narrow band, equal to the block size in grid spacing */
+		Real band_width_;
+		/** number of blocks by dimension */
+		Vecu number_of_blocks_;
+		/** hashed block index, from the 1D block index to the offset of the block data */
+		std::unordered_map<size_t, size_t> band_block_index_;
+		/** block indexes of the allocated blocks, in the order of their data */
+		StdVec<Vecu> band_blocks_;
+		/** level set data of all allocated blocks */
+		StdLargeVec<LevelSetData> band_data_;
+		/** whether the blocks are inside of the body */
+		std::vector<bool> is_inner_block_;
+		/** the data out of the narrow band */
+		LevelSetData positive_far_field_, negative_far_field_;
+		/** whether the curvature is computed, which is not done in 3D yet */
+		bool is_curvature_computed_;
+
+		/** get the data at a grid point, from the band or the far field */
+		LevelSetData& getGridData(Vecu grid_index);
+		/** get the grid index of a data in the band */
+		Vecu getBandGridIndex(size_t band_data_index);
+		/** multi-linear interpolation of a member of the level set data */
+		template<typename DataType, DataType LevelSetData::* MemPtr>
+		DataType probeBandData(Vecd& position);
+	public:
+		SparseMeshBackground(Vecd lower_bound, Vecd upper_bound,
+			Real grid_spacing, size_t buffer_size = 0, size_t block_size = 8);
+		virtual ~SparseMeshBackground() {};
+
+		/** the blocks are allocated when the level set is initialized */
+		virtual void AllocateMeshDataMatrix() override {};
+		virtual void DeleteMeshDataMatrix() override;
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override;
+		/** get the number of blocks in the narrow band */
+		size_t getNumberOfBandBlocks() { return band_block_index_.size(); };
+
+		/** the body surface is only computed for the block centers
+		  * and the grid points in the narrow band blocks */
+		virtual void InitializeLevelSetData(SPHBody &body) override;
+		virtual void ComputeCurvatureFromLevelSet(SPHBody &body) override;
+		virtual Vecd ProbeNormalDirection(Vecd Point) override;
+		virtual Real ProbeLevelSet(Vecd Point) override;
+		virtual Real ProbeCurvature(Vecd Point) override;
+
+		virtual void WriteMeshToPltFile(ofstream &output_file) override;
+	};
+
 	/**
 	 * @class BaseDataPackage
 	 * @brief Abstract base class for a data package 
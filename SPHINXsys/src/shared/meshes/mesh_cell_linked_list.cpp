@@ -8,9 +8,23 @@
 #include "base_kernel.h"
 #include "base_body.h"
 #include "base_particles.h"
+#include "neighbor_relation.h"
 
 
 namespace SPH {
+	//=================================================================================================//
+	void CellList::insertParticle(size_t particle_index, const Vecd& particle_position)
+	{
+		tbb::spin_mutex::scoped_lock lock(insertion_mutex_);
+		particle_indexes_.push_back(particle_index);
+		particle_positions_.push_back(particle_position);
+	}
+	//=================================================================================================//
+	void CellList::clearParticles()
+	{
+		particle_indexes_.clear();
+		particle_positions_.clear();
+	}
 	//=================================================================================================//
 	BaseMeshCellLinkedList
 		::BaseMeshCellLinkedList(SPHBody* body, Vecd lower_bound, Vecd upper_bound,
@@ -77,6 +91,15 @@ namespace SPH {
 		UpdateContactConfiguration();
 	}
 	//=================================================================================================//
+	void BaseMeshCellLinkedList::SearchNeighborsAroundPosition(Vecd& position,
+		PositionNeighborFunctor& position_neighbor_functor)
+	{
+		std::cout << "\n Error: searching around a position is not supported by the cell linked list of the body "
+			<< body_->GetBodyName() << "!" << std::endl;
+		std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+		exit(1);
+	}
+	//=================================================================================================//
 	MeshCellLinkedList::MeshCellLinkedList(SPHBody* body, Vecd lower_bound,
 		Vecd upper_bound, Real cell_spacing, size_t buffer_size)
 		: BaseMeshCellLinkedList(body, lower_bound, upper_bound, cell_spacing, buffer_size),
@@ -100,6 +123,43 @@ namespace SPH {
 				}
 			}, ap);
 		UpdateSplitCellLists(body_->split_cell_lists_, number_of_cells_, cell_linked_lists_);
+		if (body_->use_block_split_cell_lists_) BuildBlockSplitCellLists();
+		body_->number_of_cell_list_updates_++;
+	}
+	//=================================================================================================//
+	BaseNeighborRelation* MeshCellLinkedList::createInnerNeighborRelation()
+	{
+		return new NeighborRelation();
+	}
+	//=================================================================================================//
+	void MeshCellLinkedList::BuildBlockSplitCellLists()
+	{
+		UpdateBlockSplitCellLists(body_->block_split_cell_lists_, number_of_cells_, cell_linked_lists_);
+	}
+	//=================================================================================================//
+	void MeshCellLinkedList::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		size_t number_of_cells = 1;
+		for (int n = 0; n != Vecd(0).size(); ++n) number_of_cells *= number_of_cells_[n];
+
+		size_t number_of_entries = 0, capacity_of_entries = 0, bytes_of_entries = 0;
+		size_t number_of_indexes = 0, capacity_of_indexes = 0;
+		for (size_t num = 0; num != number_of_cells; ++num)
+		{
+			CellList* cell_list = getCellList(transfer1DtoMeshIndex(number_of_cells_, num));
+			number_of_entries += cell_list->particle_indexes_.size();
+			capacity_of_entries += cell_list->particle_indexes_.capacity();
+			bytes_of_entries += cell_list->particle_indexes_.capacity() * sizeof(ParticleIndex)
+				+ cell_list->particle_positions_.capacity() * sizeof(Vecd);
+			number_of_indexes += cell_list->real_particle_indexes_.size();
+			capacity_of_indexes += cell_list->real_particle_indexes_.capacity();
+		}
+		memory_usages.push_back(MemoryUsage("cells", number_of_cells,
+			number_of_cells, number_of_cells * sizeof(CellList)));
+		memory_usages.push_back(MemoryUsage("cell list entries", number_of_entries,
+			capacity_of_entries, bytes_of_entries));
+		memory_usages.push_back(MemoryUsage("cell list indexes", number_of_indexes,
+			capacity_of_indexes, capacity_of_indexes * sizeof(ParticleIndex)));
 	}
 	//=================================================================================================//
 	MultilevelMeshCellLinkedList
@@ -200,6 +260,13 @@ namespace SPH {
 		}
 	}
 	//=================================================================================================//
+	void MultilevelMeshCellLinkedList::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		for (size_t l = 0; l != total_levels_; ++l) {
+			mesh_cell_linked_list_levels_[l]->collectMemoryUsage(memory_usages);
+		}
+	}
+	//=================================================================================================//
 	void MultilevelMeshCellLinkedList::UpdateCellLists()
 	{
 		for (size_t level = 0; level != total_levels_; ++level) {
@@ -228,6 +295,236 @@ namespace SPH {
 		}
 		UpdateSplitCellLists(body_->split_cell_lists_, 
 			number_of_cells_levels_[0], cell_linked_lists_levels_[0]);
+		if (body_->use_block_split_cell_lists_) BuildBlockSplitCellLists();
+		body_->number_of_cell_list_updates_++;
+	}
+	//=================================================================================================//
+	BaseNeighborRelation* MultilevelMeshCellLinkedList::createInnerNeighborRelation()
+	{
+		return new NeighborRelationWithVariableSmoothingLength();
+	}
+	//=================================================================================================//
+	void MultilevelMeshCellLinkedList::BuildBlockSplitCellLists()
+	{
+		UpdateBlockSplitCellLists(body_->block_split_cell_lists_,
+			number_of_cells_levels_[0], cell_linked_lists_levels_[0]);
+	}
+	//=================================================================================================//
+	SharedMeshCellLinkedList::SharedMeshCellLinkedList(SPHBodyVector bodies,
+		Vecd lower_bound, Vecd upper_bound, size_t buffer_size)
+		: Mesh(lower_bound, upper_bound, getLargestCutOffRadius(bodies), buffer_size),
+		bodies_(bodies)
+	{
+		pair_kernels_.resize(bodies_.size(), StdVec<Kernel*>(bodies_.size()));
+		for (size_t i = 0; i != bodies_.size(); ++i)
+			for (size_t j = 0; j != bodies_.size(); ++j)
+			{
+				Kernel* kernel_i = bodies_[i]->kernel_;
+				Kernel* kernel_j = bodies_[j]->kernel_;
+				pair_kernels_[i][j] = kernel_i->GetSmoothingLength() >= kernel_j->GetSmoothingLength()
+					? kernel_i : kernel_j;
+			}
+
+		size_t number_of_adjacent_cells = powern(3, Vecd(0).size());
+		for (size_t n = 0; n != number_of_adjacent_cells; ++n)
+			adjacent_cell_offsets_.push_back(transfer1DtoMeshIndex(Vecu(3), n));
+
+		/** the contact configuration indexes are from the contact maps, which are set already. */
+		contact_configuration_indexes_.resize(bodies_.size(), StdVec<int>(bodies_.size(), -1));
+		other_contact_bodies_.resize(bodies_.size());
+		for (size_t i = 0; i != bodies_.size(); ++i)
+		{
+			SPHBodyVector& contact_bodies = bodies_[i]->contact_map_.second;
+			for (size_t k = 0; k != contact_bodies.size(); ++k)
+			{
+				size_t contact_body_index = getBodyIndex(contact_bodies[k]);
+				if (contact_body_index != bodies_.size())
+				{
+					contact_configuration_indexes_[i][contact_body_index] = int(k);
+				}
+				else
+				{
+					other_contact_bodies_[i].push_back(contact_bodies[k]);
+				}
+			}
+		}
+		AllocateMeshDataMatrix();
+	}
+	//=================================================================================================//
+	Real SharedMeshCellLinkedList::getLargestCutOffRadius(SPHBodyVector& bodies)
+	{
+		Real largest_cutoff_radius = 0.0;
+		for (auto& body : bodies)
+			largest_cutoff_radius = SMAX(largest_cutoff_radius, body->kernel_->GetCutOffRadius());
+		return largest_cutoff_radius;
+	}
+	//=================================================================================================//
+	size_t SharedMeshCellLinkedList::getBodyIndex(SPHBody* body)
+	{
+		for (size_t i = 0; i != bodies_.size(); ++i)
+			if (bodies_[i] == body) return i;
+		return bodies_.size();
+	}
+	//=================================================================================================//
+	void SharedMeshCellLinkedList::AllocateMeshDataMatrix()
+	{
+		size_t number_of_cells = 1;
+		for (int n = 0; n != Vecd(0).size(); ++n) number_of_cells *= number_of_cells_[n];
+		cell_lists_.resize(number_of_cells);
+	}
+	//=================================================================================================//
+	void SharedMeshCellLinkedList::DeleteMeshDataMatrix()
+	{
+		StdLargeVec<ConcurrentVector<SharedListData>>().swap(cell_lists_);
+	}
+	//=================================================================================================//
+	void SharedMeshCellLinkedList::ClearCellLists()
+	{
+		parallel_for(blocked_range<size_t>(0, cell_lists_.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t num = r.begin(); num != r.end(); ++num)
+					if (cell_lists_[num].size() != 0) cell_lists_[num].clear();
+			}, ap);
+	}
+	//=================================================================================================//
+	void SharedMeshCellLinkedList::UpdateCellLists()
+	{
+		ClearCellLists();
+		for (size_t body_index = 0; body_index != bodies_.size(); ++body_index)
+		{
+			StdLargeVec<BaseParticleData>& base_particle_data 
+				= bodies_[body_index]->base_particles_->base_particle_data_;
+			parallel_for(blocked_range<size_t>(0, bodies_[body_index]->number_of_particles_),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t i = r.begin(); i != r.end(); ++i) {
+						Vecu cell_index = CellIndexesFromPosition(base_particle_data[i].pos_n_);
+						cell_lists_[transferMeshIndexTo1D(number_of_cells_, cell_index)]
+							.emplace_back(make_tuple(uint32_t(body_index), ParticleIndex(i), base_particle_data[i].pos_n_));
+					}
+				}, ap);
+			bodies_[body_index]->number_of_cell_list_updates_++;
+		}
+	}
+	//=================================================================================================//
+	void SharedMeshCellLinkedList::UpdateBodyConfigurations(size_t body_index)
+	{
+		SPHBody* body = bodies_[body_index];
+		StdLargeVec<BaseParticleData>& base_particle_data = body->base_particles_->base_particle_data_;
+		StdVec<Kernel*>& pair_kernels = pair_kernels_[body_index];
+		StdVec<Real> pair_cutoff_radii;
+		for (auto& kernel : pair_kernels) pair_cutoff_radii.push_back(kernel->GetCutOffRadius());
+		ParticleConfiguration& inner_configuration = body->inner_configuration_;
+		ContatcParticleConfiguration& contact_configuration = body->contact_configuration_;
+		ContactParticles& indexes_contact_particles = body->indexes_contact_particles_;
+		StdVec<int>& contact_configuration_index = contact_configuration_indexes_[body_index];
+		/** the inner configuration is only built for real bodies as by their own cell linked lists */
+		bool is_inner_built = dynamic_cast<RealBody*>(body) != NULL && !body->use_cell_pair_inner_interaction_;
+
+		for (size_t k = 0; k != contact_configuration_index.size(); ++k)
+			if (contact_configuration_index[k] >= 0) indexes_contact_particles[contact_configuration_index[k]].clear();
+
+		parallel_for(blocked_range<size_t>(0, body->number_of_particles_),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t num = r.begin(); num != r.end(); ++num)
+				{
+					Vecd& position_i = base_particle_data[num].pos_n_;
+					Vecu cell_index = CellIndexesFromPosition(position_i);
+					for (auto& offset : adjacent_cell_offsets_)
+					{
+						Vecu target_cell_index(0);
+						bool is_in_mesh = true;
+						for (int n = 0; n != Vecd(0).size(); ++n)
+						{
+							int index = int(cell_index[n]) + int(offset[n]) - 1;
+							if (index < 0 || index >= int(number_of_cells_[n])) is_in_mesh = false;
+							target_cell_index[n] = size_t(SMAX(index, 0));
+						}
+						if (!is_in_mesh) continue;
+
+						ConcurrentVector<SharedListData>& target_particles
+							= cell_lists_[transferMeshIndexTo1D(number_of_cells_, target_cell_index)];
+						for (size_t n = 0; n != target_particles.size(); ++n)
+						{
+							size_t target_body_index = std::get<0>(target_particles[n]);
+							size_t index_particle_j = std::get<1>(target_particles[n]);
+							//displacement pointing from neighboring particle to origin particle
+							Vecd displacement = position_i - std::get<2>(target_particles[n]);
+							if (displacement.norm() > pair_cutoff_radii[target_body_index]) continue;
+
+							/** the inner relations are of the type given by the body's own cell linked list,
+							  * e.g. with variable smoothing length, the contact relations are always plain ones */
+							Neighborhood* neighborhood = NULL;
+							bool is_inner_relation = target_body_index == body_index;
+							if (is_inner_relation)
+							{
+								if (is_inner_built && index_particle_j != num)
+									neighborhood = &inner_configuration[num];
+							}
+							else if (contact_configuration_index[target_body_index] >= 0)
+							{
+								neighborhood = &contact_configuration[contact_configuration_index[target_body_index]][num];
+							}
+							if (neighborhood == NULL) continue;
+
+							Kernel& kernel = *pair_kernels[target_body_index];
+							NeighborList& neighbor_list = std::get<0>(*neighborhood);
+							if (std::get<1>(*neighborhood) >= neighbor_list.size())
+								neighbor_list.push_back(is_inner_relation ? 
+									body->createInnerNeighborRelation() : new NeighborRelation());
+							neighbor_list[std::get<1>(*neighborhood)]->resetRelation(base_particle_data,
+								kernel, displacement, num, index_particle_j);
+							std::get<1>(*neighborhood)++;
+						}
+					}
+
+					if (is_inner_built)
+					{
+						Neighborhood& neighborhood = inner_configuration[num];
+						std::get<2>(neighborhood) = std::get<1>(neighborhood);
+						std::get<1>(neighborhood) = 0;
+					}
+					for (size_t k = 0; k != contact_configuration_index.size(); ++k)
+					{
+						int contact_body_num = contact_configuration_index[k];
+						if (contact_body_num < 0) continue;
+						Neighborhood& neighborhood = contact_configuration[contact_body_num][num];
+						size_t current_count_of_neighbors = std::get<1>(neighborhood);
+						std::get<2>(neighborhood) = current_count_of_neighbors;
+						std::get<1>(neighborhood) = 0;
+						if (current_count_of_neighbors != 0)
+							indexes_contact_particles[contact_body_num].push_back(num);
+					}
+				}
+			}, ap);
+
+		/** the contact bodies out of the group are searched by their own cell linked lists */
+		if (other_contact_bodies_[body_index].size() != 0)
+			body->UpdateInteractionConfiguration(other_contact_bodies_[body_index]);
+	}
+	//=================================================================================================//
+	void SharedMeshCellLinkedList::UpdateConfigurations()
+	{
+		/** A local partitioner, as the threads keep using their own for the loops inside. */
+		ParallelPartitioner body_partitioner;
+		parallel_for(blocked_range<size_t>(0, bodies_.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					this_task_arena::isolate([&]() { UpdateBodyConfigurations(i); });
+			}, body_partitioner);
+	}
+	//=================================================================================================//
+	void SharedMeshCellLinkedList::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		size_t number_of_entries = 0, capacity_of_entries = 0;
+		for (auto& cell_list : cell_lists_)
+		{
+			number_of_entries += cell_list.size();
+			capacity_of_entries += cell_list.capacity();
+		}
+		memory_usages.push_back(MemoryUsage("shared cells", cell_lists_.size(), cell_lists_.capacity(),
+			cell_lists_.capacity() * sizeof(ConcurrentVector<SharedListData>)));
+		memory_usages.push_back(MemoryUsage("shared cell list entries", number_of_entries,
+			capacity_of_entries, capacity_of_entries * sizeof(SharedListData)));
 	}
 	//=================================================================================================//
 }
\ No newline at end of file
@@ -26,9 +26,10 @@ namespace SPH {
 	class CellList
 	{
 	public:
-		/** the saved lists currently using concurrent vectors
-		 * due to writting conflicts when building the lists */
-		ConcurrentListDataVector particle_data_lists_;
+		/** the indexes and positions of the particles in the cell are saved in separated vectors,
+		 * so that a 32-bit particle index is not padded to the alignment of the position. */
+		IndexVector particle_indexes_;
+		StdVec<Vecd> particle_positions_;
 		/** the index vector for itreate particles in a split scheme. */
 		IndexVector real_particle_indexes_;
 		Vecu cell_location_;
@@ -41,8 +42,20 @@ namespace SPH {
 		void setCellInformation(Vecu cell_location) {
 			cell_location_ = cell_location;
 		};
+		/** Insert a particle, locked due to writting conflicts when building the lists. */
+		void insertParticle(size_t particle_index, const Vecd& particle_position);
+		/** Clear the particles in the cell, the capacities are kept. */
+		void clearParticles();
+	protected:
+		tbb::spin_mutex insertion_mutex_;
 	};
 
+	/** The cell lists adjacent to a cell, including the cell itself, at most 3 to the power of the dimension. */
+	typedef std::array<CellList*, 27> AdjacentCellLists;
+	/** Functor for a particle found around a position, with the particle index
+	  * and the displacement pointing from the particle to the position. */
+	typedef std::function<void(size_t, Vecd&)> PositionNeighborFunctor;
+
 	/**
 	 * @class BaseMeshCellLinkedList
 	 * @brief Abstract class for mesh cell linked list.
@@ -67,6 +80,10 @@ namespace SPH {
 		/** update split particle list in this mesh */
 		void UpdateSplitCellLists(SplitCellLists& split_cell_lists,
 			Vecu& number_of_cells, matrix_cell cell_linked_lists);
+		/** update the tiles of the block split cell lists in this mesh,
+		  * after the particle indexes of the cells have been collected by the split cell lists */
+		void UpdateBlockSplitCellLists(BlockSplitCellLists& block_split_cell_lists,
+			Vecu& number_of_cells, matrix_cell cell_linked_lists);
 	public:
 		/** The buffer size 2 used to expand computational domian for particle searching. */
 		BaseMeshCellLinkedList(SPHBody* body, Vecd lower_bound, Vecd upper_bound, 
@@ -95,6 +112,8 @@ namespace SPH {
 
 		/** update the cell lists */
 		virtual void UpdateCellLists() = 0;
+		/** build the block split cell lists of the body from the updated cell lists */
+		virtual void BuildBlockSplitCellLists() = 0;
 
 		/** build reference inner configurtion */
 		virtual void BuildInnerConfiguration(ParticleConfiguration& inner_configuration);
@@ -110,6 +129,16 @@ namespace SPH {
 
 		/** Insert a cell-linked_list entry. */
 		virtual void InsertACellLinkedListEntry(size_t particle_index, Vecd particle_position) = 0;
+		/** Create an empty neighbor relation of the type in the inner configuration,
+		  * which is set later by resetting or reading it. */
+		virtual BaseNeighborRelation* createInnerNeighborRelation() = 0;
+
+		/** Search the particles of this body within the cut-off radius of a position,
+		  * which is not necessarily a particle of this body, and apply the functor for each of them. */
+		virtual void SearchNeighborsAroundPosition(Vecd& position,
+			PositionNeighborFunctor& position_neighbor_functor);
+		/** Collect the memory usage of the cell lists. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) = 0;
 	};
 
 	/**
@@ -147,11 +176,13 @@ namespace SPH {
 
 		/** update the cell lists */
 		virtual void UpdateCellLists() override;
+		virtual void BuildBlockSplitCellLists() override;
 
 		/** update inner configuration */
 		virtual void UpdateInnerConfiguration(ParticleConfiguration& inner_configuration) override;
 		/** update interaction configuration */
 		virtual void UpdateInteractionConfiguration(SPHBodyVector interacting_bodies) override;
+		virtual BaseNeighborRelation* createInnerNeighborRelation() override;
 
 		/** output mesh data for visuallization */
 		virtual void WriteMeshToVtuFile(ofstream &output_file) override {};
@@ -159,6 +190,19 @@ namespace SPH {
 
 		/** Insert a cell-linked_list entry. */
 		void InsertACellLinkedListEntry(size_t particle_index, Vecd particle_position) override;
+
+		/** Get the cell lists adjacent to the cell of a position and return the number of them. */
+		size_t getAdjacentCellLists(Vecd& position, AdjacentCellLists& adjacent_cell_lists);
+		/** Search the inner neighbors of a particle directly from the adjacent cells
+		  * and apply the functor for each of them, without storing neighbor relations.
+		  * The functor is a template parameter, so that it is inlined in the search loop. */
+		template<class CellPairFunctorType>
+		void searchInnerNeighborsByCells(size_t index_particle_i, const CellPairFunctorType& cell_pair_functor);
+		/** Search the particles of this body around a position. */
+		virtual void SearchNeighborsAroundPosition(Vecd& position,
+			PositionNeighborFunctor& position_neighbor_functor) override;
+		/** Collect the memory usage of the cell lists. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override;
 	};
 
 	/**
@@ -208,10 +252,86 @@ namespace SPH {
 
 		/** update the cell lists */
 		virtual void UpdateCellLists() override;
+		virtual void BuildBlockSplitCellLists() override;
 		/** update inner configuration */
 		virtual void UpdateInnerConfiguration(ParticleConfiguration& inner_configuration) override;
+		/** The inner relations are with variable smoothing length. */
+		virtual BaseNeighborRelation* createInnerNeighborRelation() override;
 
 		/** Insert a cell-linked_list entry to the preojected particle list. */
 		void InsertACellLinkedListEntry(size_t particle_index, Vecd particle_position) override;
+		/** Collect the memory usage of the cell lists of all levels. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override;
+	};
+
+	/** Shared cell list entry: index of the body in the shared list, particle index and position.
+	  * The body index is of 32 bits, so that it is packed with a 32-bit particle index. */
+	using SharedListData = tuple<uint32_t, ParticleIndex, Vecd>;
+#ifdef _32BIT_PARTICLE_INDEX_
+	static_assert(sizeof(SharedListData) == 2 * sizeof(uint32_t) + sizeof(Vecd),
+		"The body and particle indexes of a shared cell list entry should be packed.");
+#endif
+
+	/**
+	  * @class SharedMeshCellLinkedList
+	  * @brief A cell linked list shared by a group of bodies.
+	  * Each entry is tagged with the body it belongs to, so that the inner and
+	  * all contact configurations of a body, for the contact bodies in the group,
+	  * are built in a single traversal of the adjacent cells.
+	  * @details The gain is in the configuration update: with per-body cell linked lists,
+	  * each particle visits its adjacent cells once for the inner configuration and
+	  * once more for each contact body, computing the cell index and loading
+	  * the cell lists again each time. Here, the cells are visited once for all.
+	  * The cell spacing is the largest cut-off radius of the bodies, so that the adjacent
+	  * cells cover all neighbors, while a pair of bodies uses the kernel with the larger
+	  * smoothing length, as the contact search with per-body cell linked lists.
+	  * Therefore, the group is best of bodies with similar cut-off radii, otherwise
+	  * the bodies with smaller ones search more particles than necessary.
+	  * The cell linked lists of the bodies themselves are still used
+	  * for the split cell lists and the body parts by cells.
+	  */
+	class SharedMeshCellLinkedList : public Mesh
+	{
+	protected:
+		SPHBodyVector bodies_;
+		/** for each body, the kernel used with each body in the group */
+		StdVec<StdVec<Kernel*>> pair_kernels_;
+		/** cell lists stored by the 1d cell index */
+		StdLargeVec<ConcurrentVector<SharedListData>> cell_lists_;
+		/** offsets of the adjacent cells, including the cell itself */
+		StdVec<Vecu> adjacent_cell_offsets_;
+		/** for each body, the contact configuration index of each body in the group, -1 if not in contact */
+		StdVec<StdVec<int>> contact_configuration_indexes_;
+		/** for each body, the contact bodies not in the group */
+		StdVec<SPHBodyVector> other_contact_bodies_;
+
+		/** the largest cut-off radius of the bodies, which is the cell spacing */
+		static Real getLargestCutOffRadius(SPHBodyVector& bodies);
+		/** index of a body in the group, the number of bodies if not in the group */
+		size_t getBodyIndex(SPHBody* body);
+		/** clear the cell lists with entries */
+		void ClearCellLists();
+		/** update the inner and contact configurations of a body */
+		void UpdateBodyConfigurations(size_t body_index);
+	public:
+		/** The contact maps of the bodies are set already. */
+		SharedMeshCellLinkedList(SPHBodyVector bodies, Vecd lower_bound, Vecd upper_bound, size_t buffer_size = 2);
+		virtual ~SharedMeshCellLinkedList() {};
+
+		bool hasBody(SPHBody* body) { return getBodyIndex(body) != bodies_.size(); };
+		/** allcate memories for mesh data */
+		virtual void AllocateMeshDataMatrix() override;
+		/** delete memories for mesh data */
+		virtual void DeleteMeshDataMatrix() override;
+		/** update the cell lists with the particles of all bodies */
+		void UpdateCellLists();
+		/** update the inner and contact configurations of all bodies */
+		void UpdateConfigurations();
+
+		/** output mesh data for visuallization */
+		virtual void WriteMeshToVtuFile(ofstream& output_file) override {};
+		virtual void WriteMeshToPltFile(ofstream& output_file) override {};
+		/** Collect the memory usage of the shared cell lists. */
+		void collectMemoryUsage(MemoryUsageList& memory_usages);
 	};
 }
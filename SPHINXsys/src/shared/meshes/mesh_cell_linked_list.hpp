@@ -0,0 +1,47 @@
+/**
+* @file 	mesh_cell_linked_list.hpp
+* @brief 	This is the implementation of the template functions of mesh cell linked list.
+* @author	Luhui Han, Chi ZHang and Xiangyu Hu
+* @version	0.1
+*/
+#pragma once
+
+#include "mesh_cell_linked_list.h"
+#include "base_particles.h"
+#include "base_kernel.h"
+#include "neighbor_relation.h"
+//=================================================================================================//
+namespace SPH {
+	//=================================================================================================//
+	template<class CellPairFunctorType>
+	void MeshCellLinkedList::searchInnerNeighborsByCells(size_t index_particle_i,
+		const CellPairFunctorType& cell_pair_functor)
+	{
+		StdLargeVec<BaseParticleData>& base_particle_data = base_particles_->base_particle_data_;
+		Vecd& position_i = base_particle_data[index_particle_i].pos_n_;
+		/** The squared distances are compared, so that the square root is only taken for the neighbors. */
+		Real cutoff_radius_sqr = cutoff_radius_ * cutoff_radius_;
+		/** The relation is reused for all neighbors and is not stored. */
+		NeighborRelation neighbor_relation;
+
+		AdjacentCellLists adjacent_cell_lists;
+		size_t number_of_adjacent_cells = getAdjacentCellLists(position_i, adjacent_cell_lists);
+		for (size_t c = 0; c != number_of_adjacent_cells; ++c)
+		{
+			IndexVector& target_particle_indexes = adjacent_cell_lists[c]->particle_indexes_;
+			StdVec<Vecd>& target_particle_positions = adjacent_cell_lists[c]->particle_positions_;
+			for (size_t n = 0; n != target_particle_indexes.size(); ++n)
+			{
+				//displacement pointing from neighboring particle to origin particle
+				Vecd displacement = position_i - target_particle_positions[n];
+				if (displacement.normSqr() <= cutoff_radius_sqr && index_particle_i != target_particle_indexes[n])
+				{
+					neighbor_relation.resetRelation(base_particle_data, *kernel_,
+						displacement, index_particle_i, target_particle_indexes[n]);
+					cell_pair_functor(neighbor_relation);
+				}
+			}
+		}
+	}
+	//=================================================================================================//
+}
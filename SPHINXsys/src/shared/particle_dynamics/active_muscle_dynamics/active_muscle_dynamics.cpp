@@ -54,5 +54,158 @@ namespace SPH
 			active_muscle_data_i.active_stress_= getStress(base_particle_data_i.pos_0_);
 		}
 		//=================================================================================================//
+		ElectroMechanicsSubCycling::
+			ElectroMechanicsSubCycling(SolidBody* body, Dynamics<void>* body_part_constraint)
+			: ParticleDynamicsWithInnerConfigurations<SolidBody, ActiveMuscleParticles, ActiveMuscle>(body),
+			get_time_step_size_(body), body_part_constraint_(body_part_constraint),
+			number_of_sub_steps_(0), sub_step_size_(0.0), deformation_increment_factor_(0.5),
+			functor_prepare_active_stress_ramp_(std::bind(&ElectroMechanicsSubCycling::PrepareActiveStressRamp, this, _1, _2)),
+			functor_sub_step_initialization_(std::bind(&ElectroMechanicsSubCycling::SubStepInitialization, this, _1, _2)),
+			functor_first_half_interaction_(std::bind(&ElectroMechanicsSubCycling::FirstHalfInteraction, this, _1, _2)),
+			functor_second_half_interaction_(std::bind(&ElectroMechanicsSubCycling::SecondHalfInteraction, this, _1, _2)),
+			functor_finalization_(std::bind(&ElectroMechanicsSubCycling::Finalization, this, _1, _2))
+		{
+			numerical_viscosity_ = material_->getNumericalViscosity(body_->kernel_->GetSmoothingLength());
+		}
+		//=================================================================================================//
+		void ElectroMechanicsSubCycling::SetupDynamics(Real dt)
+		{
+			/** the stable estimate is obtained once for the whole physiology time step */
+			Real dt_s = get_time_step_size_.parallel_exec();
+			number_of_sub_steps_ = SMAX(size_t(ceil(dt / dt_s)), size_t(1));
+			sub_step_size_ = dt / Real(number_of_sub_steps_);
+
+			size_t number_of_particles = body_->number_of_particles_;
+			if (previous_active_contraction_stress_.size() != number_of_particles)
+			{
+				/** starts from the current active stress, also the one read from a restart file */
+				previous_active_contraction_stress_.resize(number_of_particles, 0.0);
+				active_contraction_stress_increment_.resize(number_of_particles, 0.0);
+				for (size_t i = 0; i != number_of_particles; ++i)
+					previous_active_contraction_stress_[i] = particles_->active_muscle_data_[i].active_contraction_stress_;
+			}
+		}
+		//=================================================================================================//
+		void ElectroMechanicsSubCycling::PrepareActiveStressRamp(size_t index_particle_i, Real dt)
+		{
+			ActiveMuscleData &active_muscle_data_i = particles_->active_muscle_data_[index_particle_i];
+
+			active_contraction_stress_increment_[index_particle_i]
+				= (active_muscle_data_i.active_contraction_stress_ - previous_active_contraction_stress_[index_particle_i])
+				/ Real(number_of_sub_steps_);
+			active_muscle_data_i.active_contraction_stress_ = previous_active_contraction_stress_[index_particle_i];
+		}
+		//=================================================================================================//
+		void ElectroMechanicsSubCycling::SubStepInitialization(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			ElasticSolidParticleData &elastic_data_i = particles_->elastic_body_data_[index_particle_i];
+			ActiveMuscleData &active_muscle_data_i = particles_->active_muscle_data_[index_particle_i];
+
+			/** completes the deformation of the former sub-step if there is one */
+			elastic_data_i.F_ += elastic_data_i.dF_dt_ * dt * deformation_increment_factor_;
+			elastic_data_i.rho_n_ = elastic_data_i.rho_0_ / det(elastic_data_i.F_);
+			active_muscle_data_i.active_contraction_stress_ += active_contraction_stress_increment_[index_particle_i];
+			elastic_data_i.stress_ = material_->ConstitutiveRelation(elastic_data_i.F_, index_particle_i)
+				+ material_->DampingStress(elastic_data_i.F_, elastic_data_i.dF_dt_, numerical_viscosity_, index_particle_i);
+			base_particle_data_i.pos_n_ += base_particle_data_i.vel_n_ * dt * 0.5;
+		}
+		//=================================================================================================//
+		void ElectroMechanicsSubCycling::FirstHalfInteraction(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			SolidParticleData &solid_data_i = particles_->solid_body_data_[index_particle_i];
+			ElasticSolidParticleData &elastic_data_i = particles_->elastic_body_data_[index_particle_i];
+
+			Vecd acceleration = base_particle_data_i.dvel_dt_others_
+				+ solid_data_i.force_from_fluid_ / elastic_data_i.mass_;
+
+			Neighborhood& inner_neighborhood = (*inner_configuration_)[index_particle_i];
+			NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
+			for (size_t n = 0; n != std::get<2>(inner_neighborhood); ++n)
+			{
+				BaseNeighborRelation* neighboring_particle = inner_neighors[n];
+				size_t index_particle_j = neighboring_particle->j_;
+				BaseParticleData &base_particle_data_j = particles_->base_particle_data_[index_particle_j];
+				SolidParticleData &solid_data_j = particles_->solid_body_data_[index_particle_j];
+				ElasticSolidParticleData &elastic_data_j = particles_->elastic_body_data_[index_particle_j];
+
+				acceleration += (elastic_data_i.stress_ * solid_data_i.B_
+					+ elastic_data_j.stress_ * solid_data_j.B_)
+					* neighboring_particle->dW_ij_ * neighboring_particle->e_ij_
+					* base_particle_data_j.Vol_ / elastic_data_i.rho_0_;
+			}
+			base_particle_data_i.dvel_dt_ = acceleration;
+			/** the velocity is not used by the interaction, so that it is updated in the same loop */
+			base_particle_data_i.vel_n_ += acceleration * dt;
+		}
+		//=================================================================================================//
+		void ElectroMechanicsSubCycling::SecondHalfInteraction(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			SolidParticleData &solid_data_i = particles_->solid_body_data_[index_particle_i];
+			ElasticSolidParticleData &elastic_data_i = particles_->elastic_body_data_[index_particle_i];
+
+			/** the position is not used by the interaction, so that it is updated in the same loop */
+			base_particle_data_i.pos_n_ += base_particle_data_i.vel_n_ * dt * 0.5;
+
+			Matd deformation_gradient_change_rate(0);
+			Neighborhood& inner_neighborhood = (*inner_configuration_)[index_particle_i];
+			NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
+			for (size_t n = 0; n != std::get<2>(inner_neighborhood); ++n)
+			{
+				BaseNeighborRelation* neighboring_particle = inner_neighors[n];
+				size_t index_particle_j = neighboring_particle->j_;
+				BaseParticleData &base_particle_data_j = particles_->base_particle_data_[index_particle_j];
+
+				Vecd gradw_ij = neighboring_particle->dW_ij_ * neighboring_particle->e_ij_;
+				deformation_gradient_change_rate
+					-= base_particle_data_j.Vol_
+					* SimTK::outer((base_particle_data_i.vel_n_ - base_particle_data_j.vel_n_), gradw_ij);
+			}
+			elastic_data_i.dF_dt_ = deformation_gradient_change_rate * solid_data_i.B_;
+		}
+		//=================================================================================================//
+		void ElectroMechanicsSubCycling::Finalization(size_t index_particle_i, Real dt)
+		{
+			ElasticSolidParticleData &elastic_data_i = particles_->elastic_body_data_[index_particle_i];
+			ActiveMuscleData &active_muscle_data_i = particles_->active_muscle_data_[index_particle_i];
+
+			elastic_data_i.F_ += elastic_data_i.dF_dt_ * dt * 0.5;
+			previous_active_contraction_stress_[index_particle_i] = active_muscle_data_i.active_contraction_stress_;
+		}
+		//=================================================================================================//
+		void ElectroMechanicsSubCycling::exec(Real dt)
+		{
+			SetupDynamics(dt);
+			size_t number_of_particles = body_->number_of_particles_;
+			InnerIterator(number_of_particles, functor_prepare_active_stress_ramp_, dt);
+			for (size_t k = 0; k != number_of_sub_steps_; ++k)
+			{
+				deformation_increment_factor_ = k == 0 ? 0.5 : 1.0;
+				InnerIterator(number_of_particles, functor_sub_step_initialization_, sub_step_size_);
+				InnerIterator(number_of_particles, functor_first_half_interaction_, sub_step_size_);
+				if (body_part_constraint_ != NULL) body_part_constraint_->exec(sub_step_size_);
+				InnerIterator(number_of_particles, functor_second_half_interaction_, sub_step_size_);
+			}
+			InnerIterator(number_of_particles, functor_finalization_, sub_step_size_);
+		}
+		//=================================================================================================//
+		void ElectroMechanicsSubCycling::parallel_exec(Real dt)
+		{
+			SetupDynamics(dt);
+			size_t number_of_particles = body_->number_of_particles_;
+			InnerIterator_parallel(number_of_particles, functor_prepare_active_stress_ramp_, dt);
+			for (size_t k = 0; k != number_of_sub_steps_; ++k)
+			{
+				deformation_increment_factor_ = k == 0 ? 0.5 : 1.0;
+				InnerIterator_parallel(number_of_particles, functor_sub_step_initialization_, sub_step_size_);
+				InnerIterator_parallel(number_of_particles, functor_first_half_interaction_, sub_step_size_);
+				if (body_part_constraint_ != NULL) body_part_constraint_->parallel_exec(sub_step_size_);
+				InnerIterator_parallel(number_of_particles, functor_second_half_interaction_, sub_step_size_);
+			}
+			InnerIterator_parallel(number_of_particles, functor_finalization_, sub_step_size_);
+		}
+		//=================================================================================================//
     }
 }
@@ -17,6 +17,7 @@
 #include "base_kernel.h"
 #include "solid_body.h"
 #include "solid_particles.h"
+#include "solid_dynamics.h"
 
 namespace SPH
 {
@@ -74,5 +75,48 @@ namespace SPH
 				: ConstraintByParticle<SolidBody, ActiveMuscleParticles, SolidBodyPartForSimbody>(body, body_part) {};
 			virtual ~ImposingStress() {};
 		};
+
+		/**@class ElectroMechanicsSubCycling
+		 * @brief Mechanics sub-cycling within a time step of electrophysiology.
+		 * The number of sub-steps is given once by the acoustic time step size at the beginning
+		 * of the physiology time step, and the active contraction stress, just transferred
+		 * from the physiology body, is ramped linearly from its previous value over the sub-steps.
+		 * The two halves of the stress relaxation are fused into three particle loops per sub-step,
+		 * so that no reduction is required within the sub-cycling.
+		 */
+		class ElectroMechanicsSubCycling
+			: public ParticleDynamicsWithInnerConfigurations<SolidBody, ActiveMuscleParticles, ActiveMuscle>
+		{
+		protected:
+			Real numerical_viscosity_;
+			solid_dynamics::GetAcousticTimeStepSize get_time_step_size_;
+			/** constraint applied after the velocity update, NULL if the body is not constrained */
+			Dynamics<void>* body_part_constraint_;
+			size_t number_of_sub_steps_;
+			Real sub_step_size_;
+			/** 0.5 for the first sub-step, 1.0 when the former sub-step is completed in the same loop */
+			Real deformation_increment_factor_;
+			/** active contraction stress at the end of the previous physiology time step */
+			StdLargeVec<Real> previous_active_contraction_stress_;
+			StdLargeVec<Real> active_contraction_stress_increment_;
+
+			virtual void SetupDynamics(Real dt = 0.0) override;
+			void PrepareActiveStressRamp(size_t index_particle_i, Real dt = 0.0);
+			void SubStepInitialization(size_t index_particle_i, Real dt = 0.0);
+			void FirstHalfInteraction(size_t index_particle_i, Real dt = 0.0);
+			void SecondHalfInteraction(size_t index_particle_i, Real dt = 0.0);
+			void Finalization(size_t index_particle_i, Real dt = 0.0);
+			InnerFunctor functor_prepare_active_stress_ramp_, functor_sub_step_initialization_,
+				functor_first_half_interaction_, functor_second_half_interaction_, functor_finalization_;
+		public:
+			ElectroMechanicsSubCycling(SolidBody* body, Dynamics<void>* body_part_constraint = NULL);
+			virtual ~ElectroMechanicsSubCycling() {};
+
+			size_t getNumberOfSubSteps() { return number_of_sub_steps_; };
+			Real getSubStepSize() { return sub_step_size_; };
+			/** advance the mechanics by the physiology time step dt */
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+		};
     }
 }
\ No newline at end of file
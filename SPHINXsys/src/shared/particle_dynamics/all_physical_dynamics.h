@@ -8,10 +8,12 @@ particle dynamics capabilities. **/
 #include "general_dynamics.h"
 #include "fluid_dynamics.h"
 #include "solid_dynamics.h"
+#include "thin_structure_dynamics.h"
 #include "observer_dynamics.h"
 #include "relax_dynamics.h"
 #include "electro_physiology.h"
 #include "active_muscle_dynamics.h"
 #include "particle_dynamics_diffusion_reaction.h"
+#include "solution_remapping.h"
 
 
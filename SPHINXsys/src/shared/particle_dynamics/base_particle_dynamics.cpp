@@ -8,7 +8,6 @@
 //=============================================================================================//
 namespace SPH
 {
-	Real GlobalStaticVariables::physical_time_ = 0.0;
 	//=============================================================================================//
 	void InnerIterator(size_t number_of_particles, InnerFunctor &inner_functor, Real dt)
 	{
@@ -25,6 +24,22 @@ namespace SPH
 			}
 		}, ap);
 	}
+	//=============================================================================================//
+	void InnerIteratorByParticles(IndexVector& particle_indexes, InnerFunctor &inner_functor, Real dt)
+	{
+		for (size_t l = 0; l < particle_indexes.size(); ++l)
+			inner_functor(particle_indexes[l], dt);
+	}
+	//=============================================================================================//
+	void InnerIteratorByParticles_parallel(IndexVector& particle_indexes, InnerFunctor &inner_functor, Real dt)
+	{
+		parallel_for(blocked_range<size_t>(0, particle_indexes.size()),
+			[&](const blocked_range<size_t>& r) {
+			for (size_t l = r.begin(); l < r.end(); ++l) {
+				inner_functor(particle_indexes[l], dt);
+			}
+		}, ap);
+	}
 	//=================================================================================================//
 	void ContactIterator(InteractingParticles& indexes_interacting_particles,
 		ContactFunctor &contact_functor, Real dt)
@@ -196,5 +211,48 @@ namespace SPH
 		}
 	}
 	//=============================================================================================//
+	void InnerIteratorBlockSplitting(BlockSplitCellLists& block_split_cell_lists,
+		InnerFunctor& inner_functor, Real dt)
+	{
+		for (size_t k = 0; k != block_split_cell_lists.size(); ++k) {
+			SplitCellLists& tiles = block_split_cell_lists[k];
+			for (size_t t = 0; t != tiles.size(); ++t)
+			{
+				CellLists& cell_lists = tiles[t];
+				for (size_t l = 0; l != cell_lists.size(); ++l)
+				{
+					IndexVector& particle_indexes
+						= cell_lists[l]->real_particle_indexes_;
+					for (size_t i = 0; i != particle_indexes.size(); ++i)
+					{
+						inner_functor(particle_indexes[i], dt);
+					}
+				}
+			}
+		}
+	}
+	//=============================================================================================//
+	void InnerIteratorBlockSplitting_parallel(BlockSplitCellLists& block_split_cell_lists,
+		InnerFunctor& inner_functor, Real dt)
+	{
+		for (size_t k = 0; k != block_split_cell_lists.size(); ++k) {
+			SplitCellLists& tiles = block_split_cell_lists[k];
+			parallel_for(blocked_range<size_t>(0, tiles.size()),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t t = r.begin(); t < r.end(); ++t) {
+						CellLists& cell_lists = tiles[t];
+						for (size_t l = 0; l < cell_lists.size(); ++l) {
+							IndexVector& particle_indexes
+								= cell_lists[l]->real_particle_indexes_;
+							for (size_t i = 0; i < particle_indexes.size(); ++i)
+							{
+								inner_functor(particle_indexes[i], dt);
+							}
+						}
+					}
+				}, ap);
+		}
+	}
+	//=============================================================================================//
 }
 //=============================================================================================//
\ No newline at end of file
@@ -8,6 +8,7 @@
 #pragma once
 #include "base_data_package.h"
 #include "sph_data_conainers.h"
+#include "sph_system.h"
 #include "all_particles.h"
 #include "all_materials.h"
 #include "neighbor_relation.h"
@@ -32,6 +33,10 @@ namespace SPH
 	void InnerIterator(size_t number_of_particles, InnerFunctor &inner_functor, Real dt = 0.0);
 	/** Iterators for inner functors. parallel computing. */
 	void InnerIterator_parallel(size_t number_of_particles, InnerFunctor &inner_functor, Real dt = 0.0);
+	/** Iterators for inner functors on given particles only. sequential computing. */
+	void InnerIteratorByParticles(IndexVector& particle_indexes, InnerFunctor &inner_functor, Real dt = 0.0);
+	/** Iterators for inner functors on given particles only. parallel computing. */
+	void InnerIteratorByParticles_parallel(IndexVector& particle_indexes, InnerFunctor &inner_functor, Real dt = 0.0);
 	/** Iterators for contact functors. sequential computing. */
 	void ContactIterator(InteractingParticles& indexes_interacting_particles,
 		ContactFunctor &contact_functor, Real dt = 0.0);
@@ -69,6 +74,14 @@ namespace SPH
 	/** Iterators for inner functors with splitting. parallel computing. */
 	void InnerIteratorSplittingSweeping_parallel(SplitCellLists& split_cell_lists,
 		InnerFunctor& inner_functor, Real dt = 0.0);
+	/** Iterators for inner functors with block splitting,
+	  * the cells in each tile are computed one by one. sequential computing. */
+	void InnerIteratorBlockSplitting(BlockSplitCellLists& block_split_cell_lists,
+		InnerFunctor& inner_functor, Real dt = 0.0);
+	/** Iterators for inner functors with block splitting,
+	  * the tiles with the same color are computed in parallel. parallel computing. */
+	void InnerIteratorBlockSplitting_parallel(BlockSplitCellLists& block_split_cell_lists,
+		InnerFunctor& inner_functor, Real dt = 0.0);
 
 
 	/** A Functor for Summation */
@@ -97,20 +110,6 @@ namespace SPH
 		};
 	};
 
-	/**
-	 * @class GlobalStaticVariables
-	 * @brief A place to put all global variables
-	 */
-	class GlobalStaticVariables
-	{
-	public:
-		explicit GlobalStaticVariables() {};
-		virtual ~GlobalStaticVariables() {};
-
-		/** the physical time is global value for all dynamics */
-		static Real physical_time_;
-	};
-
 	/**
 	* @class Dynamics
 	* @brief The base class for all dynamics
@@ -118,13 +117,13 @@ namespace SPH
 	* for particle dynamics. An specific implementation should be realized.
 	*/
 	template <class ReturnType>
-	class Dynamics : public GlobalStaticVariables
+	class Dynamics
 	{
 	protected:
 		virtual void SetupDynamics(Real dt = 0.0) = 0;
 	public:
 		/** Constructor */
-		explicit Dynamics() : GlobalStaticVariables() {};
+		explicit Dynamics() {};
 		virtual ~Dynamics() {};
 
 		/** The only two functions can be called from outside
@@ -152,6 +151,10 @@ namespace SPH
 		MaterialType *material_;
 		/** Split cell lists*/
 		SplitCellLists& split_cell_lists_;
+		/** Block split cell lists, used instead of the split cell lists if switched on by the body */
+		BlockSplitCellLists& block_split_cell_lists_;
+		/** the random numbers of the SPH system for stochastic dynamics */
+		CounterBasedRandomNumbers& random_numbers_;
 
 
 		/** the function for set global parameters for the particle dynamics */
@@ -161,7 +164,9 @@ namespace SPH
 		explicit ParticleDynamics(BodyType* body) : Dynamics<ReturnType>(), body_(body), 
 			particles_(dynamic_cast<ParticlesType*>(body->base_particles_->PointToThisObject())),
 			material_(dynamic_cast<MaterialType*>(body->base_particles_->base_material_->PointToThisObject())),
-			split_cell_lists_(body->split_cell_lists_){};
+			split_cell_lists_(body->split_cell_lists_),
+			block_split_cell_lists_(body->block_split_cell_lists_),
+			random_numbers_(body->getSPHSystem().random_numbers_) {};
 		virtual ~ParticleDynamics() {};
 	};
 
@@ -177,8 +182,12 @@ namespace SPH
 	protected:
 		/** inner confifuration of the designated body */
 		ParticleConfiguration* inner_configuration_;
+		/** exit if the inner configuration is not built for the body, 
+		  * i.e. the body is in the neighbor-list-free cell pair mode. */
+		void checkInnerConfiguration(BodyType* body);
 	public:
-		explicit ParticleDynamicsWithInnerConfigurations(BodyType* body);
+		/** The inner configuration is checked if it is used by the dynamics. */
+		explicit ParticleDynamicsWithInnerConfigurations(BodyType* body, bool is_inner_configuration_used = true);
 		virtual ~ParticleDynamicsWithInnerConfigurations() {};
 	};
 
@@ -297,7 +306,9 @@ namespace SPH
 		explicit ParticleDynamicsComplexSplitting(BodyType* body, StdVec<InteractingBodyType*> interacting_bodies)
 			: ParticleDynamicsWithContactConfigurations<BodyType, ParticlesType, MaterialType,
 			InteractingBodyType, InteractingParticlesType, InteractingMaterialType>(body, interacting_bodies),
-			functor_particle_interaction_(std::bind(&ParticleDynamicsComplexSplitting::ParticleInteraction, this, _1, _2)) {};
+			functor_particle_interaction_(std::bind(&ParticleDynamicsComplexSplitting::ParticleInteraction, this, _1, _2)) {
+			this->checkInnerConfiguration(body);
+		};
 		virtual ~ParticleDynamicsComplexSplitting() {};
 
 		virtual void exec(Real dt = 0.0) override;
@@ -12,9 +12,24 @@ namespace SPH {
 //=================================================================================================//
 	template <class BodyType, class ParticlesType, class MaterialType>
 	ParticleDynamicsWithInnerConfigurations<BodyType, ParticlesType, MaterialType>
-		::ParticleDynamicsWithInnerConfigurations(BodyType* body) 
+		::ParticleDynamicsWithInnerConfigurations(BodyType* body, bool is_inner_configuration_used)
 		: ParticleDynamics<void, BodyType, ParticlesType, MaterialType>(body) {
 		inner_configuration_ = &body->inner_configuration_;
+		if (is_inner_configuration_used) checkInnerConfiguration(body);
+	}
+//=================================================================================================//
+	template <class BodyType, class ParticlesType, class MaterialType>
+	void ParticleDynamicsWithInnerConfigurations<BodyType, ParticlesType, MaterialType>
+		::checkInnerConfiguration(BodyType* body)
+	{
+		if (body->use_cell_pair_inner_interaction_)
+		{
+			std::cout << "\n Error: the body " << body->GetBodyName() 
+				<< " has no inner configuration in the cell pair interaction mode," 
+				<< " only the cell pair inner dynamics can be used!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
 	}
 //=================================================================================================//
 	template <class BodyType, class ParticlesType, class MaterialType,
@@ -22,7 +37,8 @@ namespace SPH {
 	ParticleDynamicsWithContactConfigurations<BodyType, ParticlesType, MaterialType,
 		InteractingBodyType, InteractingParticlesType, InteractingMaterialType>
 		::ParticleDynamicsWithContactConfigurations(BodyType *body, StdVec<InteractingBodyType*> interacting_bodies)
-		: ParticleDynamicsWithInnerConfigurations<BodyType, ParticlesType, MaterialType>(body), interacting_bodies_(interacting_bodies) {
+		: ParticleDynamicsWithInnerConfigurations<BodyType, ParticlesType, MaterialType>(body, false), 
+		interacting_bodies_(interacting_bodies) {
 		/** contact configuration data from the body*/
 		SPHBodyVector contact_bodies = body->contact_map_.second;
 		ContactParticles& indexes_contact_particles = body->indexes_contact_particles_;
@@ -75,8 +91,7 @@ namespace SPH {
 		},
 			[&](ReturnType x, ReturnType y)->ReturnType {
 			return reduce_operation(x, y);
-		}
-		);
+		}, ap);
 	}
 	//=================================================================================================//
 	template <class BodyType, class ParticlesType, class MaterialType>
@@ -114,14 +129,20 @@ namespace SPH {
 	void ParticleDynamicsInnerSplitting<BodyType, ParticlesType, MaterialType>::exec(Real dt)
 	{
 		this->SetupDynamics(dt);
-		InnerIteratorSplitting(this->split_cell_lists_, functor_inner_interaction_, dt);
+		if (this->body_->use_block_split_cell_lists_)
+			InnerIteratorBlockSplitting(this->block_split_cell_lists_, functor_inner_interaction_, dt);
+		else
+			InnerIteratorSplitting(this->split_cell_lists_, functor_inner_interaction_, dt);
 	}
 //=================================================================================================//
 	template <class BodyType, class ParticlesType, class MaterialType>
 	void ParticleDynamicsInnerSplitting<BodyType, ParticlesType, MaterialType>::parallel_exec(Real dt)
 	{
 		this->SetupDynamics(dt);
-		InnerIteratorSplitting_parallel(this->split_cell_lists_, functor_inner_interaction_, dt);
+		if (this->body_->use_block_split_cell_lists_)
+			InnerIteratorBlockSplitting_parallel(this->block_split_cell_lists_, functor_inner_interaction_, dt);
+		else
+			InnerIteratorSplitting_parallel(this->split_cell_lists_, functor_inner_interaction_, dt);
 	}
 	//=============================================================================================//
 	template <class BodyType, class ParticlesType, class MaterialType,
@@ -131,7 +152,10 @@ namespace SPH {
 		::exec(Real dt)
 	{
 		this->SetupDynamics(dt);
-		InnerIteratorSplitting(this->split_cell_lists_, functor_particle_interaction_, dt);
+		if (this->body_->use_block_split_cell_lists_)
+			InnerIteratorBlockSplitting(this->block_split_cell_lists_, functor_particle_interaction_, dt);
+		else
+			InnerIteratorSplitting(this->split_cell_lists_, functor_particle_interaction_, dt);
 	}
 	//=============================================================================================//
 	template <class BodyType, class ParticlesType, class MaterialType,
@@ -141,7 +165,10 @@ namespace SPH {
 		::parallel_exec(Real dt)
 	{
 		this->SetupDynamics(dt);
-		InnerIteratorSplitting_parallel(this->split_cell_lists_, functor_particle_interaction_, dt);
+		if (this->body_->use_block_split_cell_lists_)
+			InnerIteratorBlockSplitting_parallel(this->block_split_cell_lists_, functor_particle_interaction_, dt);
+		else
+			InnerIteratorSplitting_parallel(this->split_cell_lists_, functor_particle_interaction_, dt);
 	}
 }
 //=================================================================================================//
@@ -26,6 +26,7 @@ namespace SPH
 		typedef DiffusionBase<SolidBody, SolidParticles, Solid> ElectroPhysiologyBase;
 		typedef DiffusionReactionSimple<SolidBody, SolidParticles, Solid> ElectroPhysiologySimple;
 		typedef DiffusionInner<SolidBody, SolidParticles, Solid> ElectroPhysiologyInner;
+		typedef DiffusionReactionConstraint<SolidBody, SolidParticles, BodyPartByParticle, Solid> ElectroPhysiologyConstraint;
 		/**
 		 * @class ElectroPhysiologyInitialCondition
 		 * @brief  set initial condition for a muscle body
@@ -99,5 +100,23 @@ namespace SPH
 			ApplyStimulusCurrents(SolidBody *body) : ElectroPhysiologySimple(body) {}
 			virtual ~ApplyStimulusCurrents() {};
 		};
+		/**
+		 * @class ApplyStimulusCurrentsToBodyPart
+		 * @brief Apply stimulus currents only to the particles of a body part,
+		 * which are tagged once, instead of checking the positions of all particles at every step.
+		 * The stimulus is to be defined in applications.
+		*/
+		class ApplyStimulusCurrentsToBodyPart : public ElectroPhysiologyConstraint
+		{
+		protected:
+			size_t voltage_;
+		public:
+			ApplyStimulusCurrentsToBodyPart(SolidBody *body, BodyPartByParticle *body_part)
+				: ElectroPhysiologyConstraint(body, body_part) 
+			{
+				voltage_ = material_->getSpeciesIndexMap()["Voltage"];
+			};
+			virtual ~ApplyStimulusCurrentsToBodyPart() {};
+		};
     }
 }
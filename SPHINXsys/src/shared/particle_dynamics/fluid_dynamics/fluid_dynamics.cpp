@@ -26,6 +26,8 @@ namespace SPH
 			NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
 			for (size_t n = 0; n != std::get<2>(inner_neighborhood); ++n)
 			{
+				if (n + neighbor_prefetch_distance < std::get<2>(inner_neighborhood))
+					prefetchForRead(inner_neighors[n + neighbor_prefetch_distance]);
 				BaseNeighborRelation* neighboring_particle = inner_neighors[n];
 
 				sigma += neighboring_particle->W_ij_;
@@ -68,6 +70,19 @@ namespace SPH
 			base_particle_data_i.Vol_ = fluid_data_i.mass_ / fluid_data_i.rho_n_;
 		}
 		//=================================================================================================//
+		void DensityBySummationCellPairInner::InnerInteraction(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData& base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			FluidParticleData& fluid_data_i = particles_->fluid_particle_data_[index_particle_i];
+
+			Real sigma = W0_;
+			mesh_cell_linked_list_->searchInnerNeighborsByCells(index_particle_i,
+				[&](BaseNeighborRelation& neighbor_relation) { sigma += neighbor_relation.W_ij_; });
+
+			fluid_data_i.rho_n_ = sigma * fluid_data_i.rho_0_ / base_particle_data_i.sigma_0_;
+			base_particle_data_i.Vol_ = fluid_data_i.mass_ / fluid_data_i.rho_n_;
+		}
+		//=================================================================================================//
 		void DivergenceCorrection::ComplexInteraction(size_t index_particle_i, Real dt)
 		{
 			FluidParticleData &fluid_data_i = particles_->fluid_particle_data_[index_particle_i];
@@ -172,7 +187,7 @@ namespace SPH
 					Real vel_difference =  0.0 * (base_particle_data_i.vel_n_ - solid_data_j.vel_ave_).norm()
 						* neighboring_particle->r_ij_;
 					acceleration += 2.0*SMAX(mu_, rho_i * vel_difference) * vel_derivative 
-						* neighboring_particle->dW_ij_ * base_particle_data_j.Vol_ / rho_i;
+						* neighboring_particle->dW_ij_ * base_particle_data_j.Vol_ * solid_data_j.fluid_force_scaling_ / rho_i;
 				}
 			}
 
@@ -228,7 +243,7 @@ namespace SPH
 				Real vel_difference = 0.0*(base_particle_data_i.vel_n_ - solid_data_j.vel_ave_).norm() * r_ij;
 				Real eta_ij = 8.0 * SMAX(mu_, fluid_data_i.rho_n_*vel_difference) * v_r_ij / 
 					(r_ij * r_ij + 0.01 * smoothing_length_);
-				acceleration += eta_ij * base_particle_data_j.Vol_ / fluid_data_i.rho_n_
+				acceleration += eta_ij * base_particle_data_j.Vol_ * solid_data_j.fluid_force_scaling_ / fluid_data_i.rho_n_
 					* neighboring_particle->dW_ij_ * e_ij;
 				}
 			}
@@ -426,23 +441,23 @@ namespace SPH
 			Vecd vel_i = base_particle_data_i.vel_n_;
 
 			Vecd acceleration = base_particle_data_i.dvel_dt_others_;
-			Neighborhood& inner_neighborhood = (*inner_configuration_)[index_particle_i];
-			NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
-			for (size_t n = 0; n != std::get<2>(inner_neighborhood); ++n)
+			/** The neighbor data is gathered into contiguous buffers first. */
+			NeighborGather& gather = threadLocalNeighborGather();
+			gather.gatherRelations((*inner_configuration_)[index_particle_i]);
+			gather.gatherField(particles_->base_particle_data_, &BaseParticleData::vel_n_, gather.vectors_[0]);
+			gather.gatherField(particles_->base_particle_data_, &BaseParticleData::Vol_, gather.scalars_[0]);
+			gather.gatherField(particles_->fluid_particle_data_, &FluidParticleData::p_, gather.scalars_[1]);
+			gather.gatherField(particles_->fluid_particle_data_, &FluidParticleData::rho_n_, gather.scalars_[2]);
+			for (size_t n = 0; n != gather.number_of_neighbors_; ++n)
 			{
-				BaseNeighborRelation* neighboring_particle = inner_neighors[n];
-				size_t index_particle_j = neighboring_particle->j_;
-				Real dW_ij = neighboring_particle->dW_ij_;
-				Vecd& e_ij = neighboring_particle->e_ij_;
-				Real r_ij = neighboring_particle->r_ij_;
-				BaseParticleData& base_particle_data_j = particles_->base_particle_data_[index_particle_j];
-				FluidParticleData& fluid_data_j = particles_->fluid_particle_data_[index_particle_j];
+				Real dW_ij = gather.dW_ij_[n];
+				Vecd& e_ij = gather.e_ij_[n];
 
 				/** Solving Riemann problem or not. */
 				Real p_star = getPStar(e_ij, vel_i, p_i, rho_i,
-					base_particle_data_j.vel_n_, fluid_data_j.p_, fluid_data_j.rho_n_);
+					gather.vectors_[0][n], gather.scalars_[1][n], gather.scalars_[2][n]);
 			
-				acceleration -= 2.0 * p_star * base_particle_data_j.Vol_* dW_ij * e_ij / rho_i;
+				acceleration -= 2.0 * p_star * gather.scalars_[0][n] * dW_ij * e_ij / rho_i;
 			}
 
 			/** Contact interaction. */
@@ -472,15 +487,16 @@ namespace SPH
 						= dot((dvel_dt_others_i - solid_data_j.dvel_dt_ave_), -e_ij);
 					Real p_star = p_i + 0.5 * rho_i * r_ij * SMAX(0.0, face_wall_external_acceleration);
 
-					/** penalty method to prevent particle running into boundary */
+					/** penalty method to prevent particle running into boundary,
+					  * on both sides of the wall, as for a shell in fluid. */
 					Real projection = dot(e_ij, n_j);
-					Real delta = 2.0 * projection * r_ij * particle_spacing_j1;
+					Real delta = 2.0 * fabs(projection) * r_ij * particle_spacing_j1;
 					Real beta = delta < 1.0 ? (1.0 - delta) * (1.0 - delta) * particle_spacing_ratio2 : 0.0;
 					Real penalty = beta * projection * fabs(p_star);
 
 					//pressure force
 					acceleration -= 2.0 * (p_star * e_ij + penalty * n_j)
-						* base_particle_data_j.Vol_ * dW_ij / rho_i;
+						* base_particle_data_j.Vol_ * solid_data_j.fluid_force_scaling_ * dW_ij / rho_i;
 				}
 			}
 			base_particle_data_i.dvel_dt_ = acceleration;
@@ -524,22 +540,23 @@ namespace SPH
 
 			Real density_change_rate = 0.0;
 			Vecd vel_star(0);
-			Neighborhood& inner_neighborhood = (*inner_configuration_)[index_particle_i];
-			NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
-			for (size_t n = 0; n != std::get<2>(inner_neighborhood); ++n)
+			/** The neighbor data is gathered into contiguous buffers first. */
+			NeighborGather& gather = threadLocalNeighborGather();
+			gather.gatherRelations((*inner_configuration_)[index_particle_i]);
+			gather.gatherField(particles_->base_particle_data_, &BaseParticleData::vel_n_, gather.vectors_[0]);
+			gather.gatherField(particles_->base_particle_data_, &BaseParticleData::Vol_, gather.scalars_[0]);
+			gather.gatherField(particles_->fluid_particle_data_, &FluidParticleData::p_, gather.scalars_[1]);
+			gather.gatherField(particles_->fluid_particle_data_, &FluidParticleData::rho_n_, gather.scalars_[2]);
+			for (size_t n = 0; n != gather.number_of_neighbors_; ++n)
 			{
-				BaseNeighborRelation* neighboring_particle = inner_neighors[n];
-				size_t index_particle_j = neighboring_particle->j_;
-				Vecd& e_ij = neighboring_particle->e_ij_;
-				Real dW_ij = neighboring_particle->dW_ij_;
-				BaseParticleData& base_particle_data_j = particles_->base_particle_data_[index_particle_j];
-				FluidParticleData& fluid_data_j = particles_->fluid_particle_data_[index_particle_j];
+				Vecd& e_ij = gather.e_ij_[n];
+				Real dW_ij = gather.dW_ij_[n];
 
 				/** Solving Riemann problem or not. */
 				vel_star = getVStar(e_ij, vel_i, p_i, rho_i,
-					base_particle_data_j.vel_n_, fluid_data_j.p_, fluid_data_j.rho_n_);
+					gather.vectors_[0][n], gather.scalars_[1][n], gather.scalars_[2][n]);
 
-				density_change_rate += 2.0 * rho_i * base_particle_data_j.Vol_
+				density_change_rate += 2.0 * rho_i * gather.scalars_[0][n]
 					* dot(vel_i - vel_star, e_ij) * dW_ij;
 			}
 
@@ -745,6 +762,25 @@ namespace SPH
 				+ constrain_strength_*GetInflowVelocity(base_particle_data_i.pos_n_, base_particle_data_i.vel_n_);
 		}
 		//=================================================================================================//
+		void FarFieldOverlapCondition::Update(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData& base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			FluidParticleData& fluid_particle_data_i = particles_->fluid_particle_data_[index_particle_i];
+
+			if (mesh_system_.isInOverlapZone(base_particle_data_i.pos_n_))
+			{
+				Real far_field_rho;
+				Vecd far_field_velocity;
+				mesh_system_.InterpolateState(base_particle_data_i.pos_n_, far_field_rho, far_field_velocity);
+				base_particle_data_i.vel_n_ = base_particle_data_i.vel_n_ * (1.0 - constrain_strength_)
+					+ constrain_strength_ * far_field_velocity;
+				Real weight = mesh_system_.getOverlapWeight(base_particle_data_i.pos_n_);
+				fluid_particle_data_i.rho_n_ = fluid_particle_data_i.rho_n_ * (1.0 - weight)
+					+ weight * far_field_rho;
+				fluid_particle_data_i.p_ = material_->GetPressure(fluid_particle_data_i.rho_n_);
+			}
+		}
+		//=================================================================================================//
 		void EmitterInflowCondition
 			::ConstraintAParticle(size_t index_particle_i, Real dt)
 		{
@@ -795,6 +831,8 @@ namespace SPH
 				}
 				/** Buffer Particle state copied from real particle. */
 				particles_->CopyFromAnotherParticle(body_->number_of_particles_, index_particle_i);
+				/** The realized particle is not in the body part. */
+				particles_->base_particle_data_[body_->number_of_particles_].is_sortable_ = true;
 				/** Realize the buffer particle by increas�ng the number of real particle in the body.  */
 				body_->number_of_particles_ += 1;
 				/** Periodic bounding. */
@@ -817,12 +855,69 @@ namespace SPH
 				}
 				/** Buffer Particle state copied from real particle. */
 				particles_->CopyFromAnotherParticle(body_->number_of_particles_, index_particle_i);
+				/** The realized particle is not in the body part. */
+				particles_->base_particle_data_[body_->number_of_particles_].is_sortable_ = true;
 				/** Realize the buffer particle by increas�ng the number of real particle in the body.  */
 				body_->number_of_particles_ += 1;
 				base_particle_data_i.pos_n_[axis_] += periodic_translation_[axis_];
 			}
 		}
 		//=================================================================================================//
+		void FarFieldBufferCondition::ConstraintAParticle(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData& base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			FluidParticleData& fluid_particle_data_i = particles_->fluid_particle_data_[index_particle_i];
+
+			mesh_system_.InterpolateState(base_particle_data_i.pos_n_,
+				fluid_particle_data_i.rho_n_, base_particle_data_i.vel_n_);
+			fluid_particle_data_i.p_ = material_->GetPressure(fluid_particle_data_i.rho_n_);
+		}
+		//=================================================================================================//
+		FarFieldBufferInjecting::FarFieldBufferInjecting(FluidBody* body, BodyPartByParticle* body_part,
+			size_t body_buffer_size, int axis_direction, bool positive)
+			: EmitterInflowInjecting(body, body_part, body_buffer_size, axis_direction, positive)
+		{
+			/** The k-th smallest index is not less than k, and the particle at k is not a buffer particle. */
+			std::sort(constrained_particles_.begin(), constrained_particles_.end());
+			StdLargeVec<BaseParticleData>& base_particle_data = particles_->base_particle_data_;
+			for (size_t k = 0; k != constrained_particles_.size(); ++k)
+			{
+				size_t index_particle_i = constrained_particles_[k];
+				if (index_particle_i == k) continue;
+				particles_->swapParticles(k, index_particle_i);
+				base_particle_data[k].particle_id_ = k;
+				base_particle_data[index_particle_i].particle_id_ = index_particle_i;
+				constrained_particles_[k] = k;
+			}
+		}
+		//=================================================================================================//
+		void FarFieldOutflowRemoving::exec(Real dt)
+		{
+			StdLargeVec<BaseParticleData>& base_particle_data = particles_->base_particle_data_;
+			size_t index_particle_i = 0;
+			while (index_particle_i < body_->number_of_particles_)
+			{
+				BaseParticleData& base_particle_data_i = base_particle_data[index_particle_i];
+				if (!base_particle_data_i.is_sortable_ || mesh_system_.isInParticleRegion(base_particle_data_i.pos_n_))
+				{
+					index_particle_i++;
+					continue;
+				}
+
+				size_t last_particle_index = body_->number_of_particles_ - 1;
+				if (!base_particle_data[last_particle_index].is_sortable_)
+				{
+					std::cout << "\n Error: the last particle of the body " << body_->GetBodyName()
+						<< " is in a body part and can not be moved for removing a particle!" << std::endl;
+					std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+					exit(1);
+				}
+				/** The particle at this index is checked again after the replacement. */
+				particles_->CopyFromAnotherParticle(index_particle_i, last_particle_index);
+				body_->number_of_particles_ -= 1;
+			}
+		}
+		//=================================================================================================//
 	    void ImplicitComputingViscousAcceleration::Initialization(size_t index_particle_i, Real dt)
 		{
 			BaseParticleData& base_particle_data_i = particles_->base_particle_data_[index_particle_i];
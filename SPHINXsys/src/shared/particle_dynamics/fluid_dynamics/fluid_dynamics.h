@@ -12,6 +12,7 @@
 #include "all_particle_dynamics.h"
 #include "weakly_compressible_fluid.h"
 #include "base_kernel.h"
+#include "mesh_system.h"
 
 namespace SPH
 {
@@ -23,6 +24,9 @@ namespace SPH
 		typedef ParticleDynamicsInner<FluidBody, FluidParticles, WeaklyCompressibleFluid>  
 			WeaklyCompressibleFluidDynamicsInner;
 
+		typedef ParticleDynamicsCellPairInner<FluidBody, FluidParticles, WeaklyCompressibleFluid>
+			WeaklyCompressibleFluidDynamicsCellPairInner;
+
 		typedef ParticleDynamicsComplex<FluidBody, FluidParticles,
 			WeaklyCompressibleFluid, SolidBody, SolidParticles> WeaklyCompressibleFluidDynamicsComplex;
 
@@ -95,6 +99,24 @@ namespace SPH
 			virtual ~DensityBySummationFreeSurface() {};
 		};
 
+		/**
+		* @class DensityBySummationCellPairInner
+		* @brief  computing density by summation for a fluid body
+		* in the neighbor-list-free mode, only inner interaction is considered.
+		*/
+		class DensityBySummationCellPairInner : public WeaklyCompressibleFluidDynamicsCellPairInner
+		{
+		protected:
+			Real W0_;
+			virtual void InnerInteraction(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			DensityBySummationCellPairInner(FluidBody *body)
+				: WeaklyCompressibleFluidDynamicsCellPairInner(body) {
+				W0_ = body->kernel_->W(Vecd(0));
+			};
+			virtual ~DensityBySummationCellPairInner() {};
+		};
+
 		/**
 		 * @class DivergenceCorrection
 		 * @brief  obtained divergence correction factor for each fluid particle
@@ -384,6 +406,31 @@ namespace SPH
 			virtual ~InflowBoundaryCondition() {};
 		};
 
+		/**
+		 * @class FarFieldOverlapCondition
+		 * @brief The particles in the overlap zone of a mesh system are relaxed 
+		 * to the density and velocity interpolated from the far-field grid.
+		 * @details It is applied after the density summation. As the summation recomputes
+		 * the density every advection step, the density is not relaxed over several steps,
+		 * but blended with that of the grid by the overlap weight, 
+		 * so that the pressure follows the grid towards the border of the particle region.
+		 * The velocity, which is integrated over the steps, is relaxed.
+		 */
+		class FarFieldOverlapCondition : public WeaklyCompressibleFluidDynamicsSimple
+		{
+		protected:
+			MeshSystem& mesh_system_;
+			/** dedault value is 0.1 suggests reaching the far-field velocity in about 10 time steps */
+			Real constrain_strength_;
+
+			virtual void Update(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			FarFieldOverlapCondition(FluidBody* body, MeshSystem& mesh_system)
+				: WeaklyCompressibleFluidDynamicsSimple(body), mesh_system_(mesh_system),
+				constrain_strength_(0.1) {};
+			virtual ~FarFieldOverlapCondition() {};
+		};
+
 		/**
 		 * @class EmitterInflowCondition
 		 * @brief Inflow boundary condition.
@@ -445,6 +492,62 @@ namespace SPH
 			/** This class is only implemented in sequential due to memory conflicts. */
 			virtual void parallel_exec(Real dt = 0.0) override { exec(); };
 		};
+
+		/**
+		 * @class FarFieldBufferCondition
+		 * @brief The buffer particles at an inflow face of the particle region of a mesh system
+		 * take the density and velocity interpolated from the far-field grid,
+		 * so that the particles inside the face have the full kernel support.
+		 */
+		class FarFieldBufferCondition : public WeaklyCompressibleFluidConstraintByParticle
+		{
+		protected:
+			MeshSystem& mesh_system_;
+
+			virtual void ConstraintAParticle(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			FarFieldBufferCondition(FluidBody* body, BodyPartByParticle* body_part, MeshSystem& mesh_system)
+				: WeaklyCompressibleFluidConstraintByParticle(body, body_part), mesh_system_(mesh_system) {};
+			virtual ~FarFieldBufferCondition() {};
+		};
+
+		/**
+		 * @class FarFieldBufferInjecting
+		 * @brief Inject particles from the buffer at an inflow face of the particle region of a mesh system.
+		 * The buffer particles are moved to the front of the particles when constructed,
+		 * i.e. before the cell linked lists are built, so that they are never moved
+		 * by FarFieldOutflowRemoving. No other body part by particles is allowed for the body.
+		 */
+		class FarFieldBufferInjecting : public EmitterInflowInjecting
+		{
+		public:
+			FarFieldBufferInjecting(FluidBody* body, BodyPartByParticle* body_part,
+				size_t body_buffer_size, int axis_direction, bool positive);
+			virtual ~FarFieldBufferInjecting() {};
+		};
+
+		/**
+		 * @class FarFieldOutflowRemoving
+		 * @brief Remove the particles which have left the particle region of a mesh system,
+		 * where the flow is given by the far-field grid. A removed particle is replaced by
+		 * the last real particle, and the buffer particles are kept.
+		 */
+		class FarFieldOutflowRemoving
+			: public ParticleDynamics<void, FluidBody, FluidParticles, WeaklyCompressibleFluid>
+		{
+		protected:
+			MeshSystem& mesh_system_;
+		public:
+			FarFieldOutflowRemoving(FluidBody* body, MeshSystem& mesh_system)
+				: ParticleDynamics<void, FluidBody, FluidParticles, WeaklyCompressibleFluid>(body),
+				mesh_system_(mesh_system) {};
+			virtual ~FarFieldOutflowRemoving() {};
+
+			virtual void exec(Real dt = 0.0) override;
+			/** This class is only implemented in sequential due to memory conflicts. */
+			virtual void parallel_exec(Real dt = 0.0) override { exec(); };
+		};
+
 		/**
 		 * @class ImplicitComputingViscousAcceleration
 		 * @brief  compute the viscous acceleration with implicit algorithm with splitting cell method.
@@ -31,6 +31,12 @@ namespace SPH {
 		: ParticleDynamicsSimple<SPHBody, BaseParticles>(body)
 	{
 		particle_spacing_ = body->particle_spacing_;
+		random_step_ = 0;
+	}
+//=================================================================================================//
+	void RandomizePartilePosition::SetupDynamics(Real dt)
+	{
+		random_step_ = random_numbers_.TakeNewStep();
 	}
 //=================================================================================================//
 	void RandomizePartilePosition::Update(size_t index_particle_i, Real dt)
@@ -38,10 +44,8 @@ namespace SPH {
 		BaseParticleData &base_particle_data_i
 			= particles_->base_particle_data_[index_particle_i];
 
-		for (int i = 0; i < base_particle_data_i.pos_n_.size(); ++i)
-		{
-			base_particle_data_i.pos_n_[i] += dt * (((double)rand() / (RAND_MAX)) - 0.5) * 2.0 * particle_spacing_;
-		}
+		base_particle_data_i.pos_n_ += dt * particle_spacing_
+			* random_numbers_.UniformRandomVector(base_particle_data_i.particle_id_, random_step_);
 	}
 //=================================================================================================//
 	BoundingBodyDomain
@@ -117,6 +121,13 @@ namespace SPH {
 		}
 	}
 	//=================================================================================================//
+	void PeriodicConditionInAxisDirection::exec(Real dt)
+	{
+		PeriodicBoundingInAxisDirection::exec(dt);
+		/** The ghost entries change the cell linked lists. */
+		body_->number_of_cell_list_updates_++;
+	}
+	//=================================================================================================//
 	MirrorBoundaryConditionInAxisDirection::Bounding
 		::Bounding(CellVector& bound_cells, SPHBody* body, int axis_direction, bool positive)
 		: BoundingInAxisDirection(body, axis_direction),
@@ -200,6 +211,14 @@ namespace SPH {
 		}
 	}
 	//=================================================================================================//
+	void MirrorBoundaryConditionInAxisDirection
+		::CreatingGhostParticles::exec(Real dt)
+	{
+		Bounding::exec(dt);
+		/** The ghost particles are inserted into the cell linked lists. */
+		body_->number_of_cell_list_updates_++;
+	}
+	//=================================================================================================//
 	void MirrorBoundaryConditionInAxisDirection::UpdatingGhostStates
 		::updateForLowerBound(size_t index_particle_i, Real dt)
 	{
@@ -31,12 +31,16 @@ namespace SPH
 
 	/**
 	* @class RandomizePartilePosition
-	* @brief Randomize the initial particle position
+	* @brief Randomize the initial particle position.
+	* The random numbers are given by the particle id and the step of this dynamics,
+	* so that the results are the same for sequential and parallel computing.
 	*/
 	class RandomizePartilePosition : public ParticleDynamicsSimple<SPHBody, BaseParticles>
 	{
 	protected:
 		Real particle_spacing_;
+		size_t random_step_;
+		virtual void SetupDynamics(Real dt = 0.0) override;
 		virtual void Update(size_t index_particle_i, Real dt = 0.0) override;
 	public:
 		RandomizePartilePosition(SPHBody* body);
@@ -121,6 +125,7 @@ namespace SPH
 			: PeriodicBoundingInAxisDirection(body, axis_direction) {};
 		virtual ~PeriodicConditionInAxisDirection() {};
 
+		virtual void exec(Real dt = 0.0) override;
 		/** This class is only implemented in sequential due to memory conflicts. */
 		virtual void parallel_exec(Real dt = 0.0) override { exec(); };
 	};
@@ -162,6 +167,7 @@ namespace SPH
 			CreatingGhostParticles(IndexVector& ghost_particles, CellVector& bound_cells, 
 				SPHBody* body, int axis_direction, bool positive);
 			virtual ~CreatingGhostParticles() {};
+			virtual void exec(Real dt = 0.0) override;
 			/** This class is only implemented in sequential due to memory conflicts. */
 			virtual void parallel_exec(Real dt = 0.0) override { exec(); };
 		};
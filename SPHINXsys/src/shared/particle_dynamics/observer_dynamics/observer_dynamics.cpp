@@ -15,10 +15,8 @@ namespace SPH
 	namespace observer_dynamics
 	{
 		//=================================================================================================//
-		void CorrectKenelWeightsForInterpolation::ComplexInteraction(size_t index_particle_i, Real dt)
+		Vecd CorrectKenelWeightsForInterpolation::ComputeWeightCorrection(size_t index_particle_i)
 		{
-			BaseParticleData& base_particle_data_i = particles_->base_particle_data_[index_particle_i];
-
 			Vecd weight_correction(0.0);
 			Matd local_configuration(0.0);
 			/** Compute the first order consistent kernel weights */
@@ -40,7 +38,12 @@ namespace SPH
 			}
 
 			/** correction matrix for interacting configuration */
-			Matd B_ = GeneralizedInverse(local_configuration);
+			return GeneralizedInverse(local_configuration) * weight_correction;
+		}
+		//=================================================================================================//
+		void CorrectKenelWeightsForInterpolation::ComplexInteraction(size_t index_particle_i, Real dt)
+		{
+			Vecd normalized_weight_correction = ComputeWeightCorrection(index_particle_i);
 
 			/** Add the kernel weight correction to W_ij_ of neighboring particles. */
 			for (size_t k = 0; k < current_interacting_configuration_.size(); ++k)
@@ -48,16 +51,155 @@ namespace SPH
 				Neighborhood& contact_neighborhood = (*current_interacting_configuration_[k])[index_particle_i];
 				NeighborList& contact_neighors = std::get<0>(contact_neighborhood);
 				for (size_t n = 0; n != std::get<2>(contact_neighborhood); ++n)
+				{
+					BaseNeighborRelation* neighboring_particle = contact_neighors[n];
+					neighboring_particle->W_ij_ 
+						-= dot(normalized_weight_correction, neighboring_particle->e_ij_) * neighboring_particle->dW_ij_;
+				}
+			}
+		}
+		//=================================================================================================//
+		TransferOperator::TransferOperator(SPHBody* observer, StdVec<SPHBody*> target_bodies, bool kernel_correction)
+			: CorrectKenelWeightsForInterpolation(observer, target_bodies),
+			kernel_correction_(kernel_correction)
+		{
+			row_offsets_.resize(target_bodies.size());
+			columns_.resize(target_bodies.size());
+			weights_.resize(target_bodies.size());
+		}
+		//=================================================================================================//
+		void TransferOperator::SetupDynamics(Real dt)
+		{
+			size_t number_of_particles = body_->number_of_particles_;
+			for (size_t k = 0; k < current_interacting_configuration_.size(); ++k)
+			{
+				ParticleConfiguration& contact_configuration = *current_interacting_configuration_[k];
+				row_offsets_[k].resize(number_of_particles + 1);
+				row_offsets_[k][0] = 0;
+				for (size_t i = 0; i != number_of_particles; ++i)
+					row_offsets_[k][i + 1] = row_offsets_[k][i] + std::get<2>(contact_configuration[i]);
+				columns_[k].resize(row_offsets_[k][number_of_particles]);
+				weights_[k].resize(row_offsets_[k][number_of_particles]);
+			}
+		}
+		//=================================================================================================//
+		void TransferOperator::ComplexInteraction(size_t index_particle_i, Real dt)
+		{
+			Vecd normalized_weight_correction(0.0);
+			if (kernel_correction_) normalized_weight_correction = ComputeWeightCorrection(index_particle_i);
+
+			Real ttl_weight(0);
+			for (size_t k = 0; k < current_interacting_configuration_.size(); ++k)
+			{
+				Neighborhood& contact_neighborhood = (*current_interacting_configuration_[k])[index_particle_i];
+				NeighborList& contact_neighors = std::get<0>(contact_neighborhood);
+				size_t row_offset = row_offsets_[k][index_particle_i];
+				for (size_t n = 0; n != std::get<2>(contact_neighborhood); ++n)
 				{
 					BaseNeighborRelation* neighboring_particle = contact_neighors[n];
 					size_t index_particle_j = neighboring_particle->j_;
 					BaseParticleData& base_particle_data_j = (*interacting_particles_[k]).base_particle_data_[index_particle_j];
 
-					Vecd normalized_weight_correction = B_ * weight_correction;
-					neighboring_particle->W_ij_ 
-						-= dot(normalized_weight_correction, neighboring_particle->e_ij_) * neighboring_particle->dW_ij_;
+					Real W_ij = neighboring_particle->W_ij_
+						- dot(normalized_weight_correction, neighboring_particle->e_ij_) * neighboring_particle->dW_ij_;
+					Real weight_j = W_ij * base_particle_data_j.Vol_;
+					columns_[k][row_offset + n] = index_particle_j;
+					weights_[k][row_offset + n] = weight_j;
+					ttl_weight += weight_j;
 				}
 			}
+
+			/** The weights are not normalized if they sum to zero, which would give nan values. */
+			Real inverse_ttl_weight = ttl_weight > 0.0 ? 1.0 / ttl_weight : 0.0;
+			for (size_t k = 0; k < current_interacting_configuration_.size(); ++k)
+				for (size_t m = row_offsets_[k][index_particle_i]; m != row_offsets_[k][index_particle_i + 1]; ++m)
+					weights_[k][m] *= inverse_ttl_weight;
+		}
+		//=================================================================================================//
+		void TransferOperator::WriteToBinary(ofstream& output_file)
+		{
+			size_t number_of_particles = body_->number_of_particles_;
+			size_t number_of_target_bodies = row_offsets_.size();
+			output_file.write(reinterpret_cast<const char*>(&number_of_particles), sizeof(size_t));
+			output_file.write(reinterpret_cast<const char*>(&number_of_target_bodies), sizeof(size_t));
+			for (size_t k = 0; k != number_of_target_bodies; ++k)
+			{
+				size_t number_of_weights = weights_[k].size();
+				output_file.write(reinterpret_cast<const char*>(&number_of_weights), sizeof(size_t));
+				output_file.write(reinterpret_cast<const char*>(row_offsets_[k].data()), (number_of_particles + 1) * sizeof(size_t));
+				output_file.write(reinterpret_cast<const char*>(columns_[k].data()), number_of_weights * sizeof(ParticleIndex));
+				output_file.write(reinterpret_cast<const char*>(weights_[k].data()), number_of_weights * sizeof(Real));
+			}
+		}
+		//=================================================================================================//
+		void TransferOperator::ReadFromBinary(ifstream& input_file)
+		{
+			size_t number_of_particles = 0;
+			size_t number_of_target_bodies = 0;
+			input_file.read(reinterpret_cast<char*>(&number_of_particles), sizeof(size_t));
+			input_file.read(reinterpret_cast<char*>(&number_of_target_bodies), sizeof(size_t));
+			if (number_of_particles != body_->number_of_particles_ || number_of_target_bodies != row_offsets_.size())
+			{
+				std::cout << "\n Error: the transfer operator file does not match the observer body "
+					<< body_->GetBodyName() << "!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+			for (size_t k = 0; k != number_of_target_bodies; ++k)
+			{
+				size_t number_of_weights = 0;
+				input_file.read(reinterpret_cast<char*>(&number_of_weights), sizeof(size_t));
+				row_offsets_[k].resize(number_of_particles + 1);
+				columns_[k].resize(number_of_weights);
+				weights_[k].resize(number_of_weights);
+				input_file.read(reinterpret_cast<char*>(row_offsets_[k].data()), (number_of_particles + 1) * sizeof(size_t));
+				input_file.read(reinterpret_cast<char*>(columns_[k].data()), number_of_weights * sizeof(ParticleIndex));
+				input_file.read(reinterpret_cast<char*>(weights_[k].data()), number_of_weights * sizeof(Real));
+			}
+		}
+		//=================================================================================================//
+		AdvectingTracers::AdvectingTracers(TracerBody* tracer_body, SPHBody* host_body)
+			: ParticleDynamicsSimple<TracerBody, TracerParticles>(tracer_body),
+			host_base_particle_data_(host_body->base_particles_->base_particle_data_),
+			host_mesh_cell_linked_list_(host_body->base_mesh_cell_linked_list_),
+			host_kernel_(host_body->kernel_) {}
+		//=================================================================================================//
+		Real AdvectingTracers::InterpolateHostVelocity(Vecd& position, Vecd& velocity)
+		{
+			Vecd weighted_velocity(0);
+			Real ttl_weight(0);
+			PositionNeighborFunctor summation = [&](size_t index_particle_j, Vecd& displacement) {
+				BaseParticleData& base_particle_data_j = host_base_particle_data_[index_particle_j];
+				Real weight_j = host_kernel_->W(displacement) * base_particle_data_j.Vol_;
+				weighted_velocity += weight_j * base_particle_data_j.vel_n_;
+				ttl_weight += weight_j;
+			};
+			host_mesh_cell_linked_list_->SearchNeighborsAroundPosition(position, summation);
+
+			if (ttl_weight > 0.0) velocity = weighted_velocity / ttl_weight;
+			return ttl_weight;
+		}
+		//=================================================================================================//
+		void AdvectingTracers::Update(size_t index_particle_i, Real dt)
+		{
+			TracerParticleData& tracer_particle_data_i = particles_->tracer_particle_data_[index_particle_i];
+
+			Vecd velocity(0);
+			tracer_particle_data_i.is_in_host_
+				= InterpolateHostVelocity(tracer_particle_data_i.pos_, velocity) > 0.0;
+			if (!tracer_particle_data_i.is_in_host_)
+			{
+				tracer_particle_data_i.vel_ = Vecd(0);
+				return;
+			}
+
+			/** the velocity at the midpoint, or at the start if the midpoint is out of the host */
+			Vecd midpoint = tracer_particle_data_i.pos_ + 0.5 * dt * velocity;
+			InterpolateHostVelocity(midpoint, velocity);
+
+			tracer_particle_data_i.vel_ = velocity;
+			tracer_particle_data_i.pos_ += dt * velocity;
+			tracer_particle_data_i.residence_time_ += dt;
 		}
 		//=================================================================================================//
 	}
@@ -235,11 +235,157 @@ namespace SPH
 			public ParticleDynamicsComplex<SPHBody, BaseParticles, BaseMaterial, SPHBody, BaseParticles, BaseMaterial>
 		{
 		protected:
+			/** The first order correction of the kernel weights, to be projected on the directions to neighbors. */
+			Vecd ComputeWeightCorrection(size_t index_particle_i);
 			virtual void ComplexInteraction(size_t index_particle_i, Real dt = 0.0) override;
 		public:
 			CorrectKenelWeightsForInterpolation(SPHBody *body, StdVec<SPHBody*> interacting_bodies)
 				: ParticleDynamicsComplex<SPHBody, BaseParticles, BaseMaterial, SPHBody, BaseParticles, BaseMaterial>(body, interacting_bodies) {};
 			virtual ~CorrectKenelWeightsForInterpolation() {};
 		};
+
+		/**
+		* @class TransferOperator
+		* @brief Interpolation weights from target bodies to an observer body,
+		* computed once and saved as sparse matrices in compressed row storage,
+		* one for each target body.
+		* @details For bodies in total Lagrangian formulation, the contact configurations
+		* and so the interpolation weights do not change. The first order kernel correction,
+		* as in CorrectKenelWeightsForInterpolation, and the normalization are folded
+		* into the weights. Therefore, the contact configurations should not be corrected before.
+		* The operator is built by exec or parallel_exec, usually once before the main loop,
+		* and applied by TransferringAQuantity or TransferringADiffusionReactionQuantity.
+		* A row whose weights sum to zero, e.g. without neighbors, gives zero weights.
+		*/
+		class TransferOperator : public CorrectKenelWeightsForInterpolation
+		{
+		protected:
+			/** If true, the first order kernel correction is folded into the weights. */
+			bool kernel_correction_;
+			/** Set the row offsets from the numbers of contact neighbors. */
+			virtual void SetupDynamics(Real dt = 0.0) override;
+			/** Compute the weights of a row. */
+			virtual void ComplexInteraction(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			TransferOperator(SPHBody* observer, StdVec<SPHBody*> target_bodies, bool kernel_correction = true);
+			virtual ~TransferOperator() {};
+
+			/** Offsets of the rows for each target body, the last one is the number of weights. */
+			StdVec<StdLargeVec<size_t>> row_offsets_;
+			/** Target particle indexes of the weights for each target body. */
+			StdVec<StdLargeVec<ParticleIndex>> columns_;
+			/** Normalized weights for each target body. */
+			StdVec<StdLargeVec<Real>> weights_;
+
+			SPHBody* getObserverBody() { return body_; };
+			StdVec<SPHBody*>& getTargetBodies() { return interacting_bodies_; };
+			/** Write the weights in binary format, so that they are not built again on restart. */
+			void WriteToBinary(ofstream& output_file);
+			/** Read the weights in binary format, exit if they are not for the current particles. */
+			void ReadFromBinary(ifstream& input_file);
+		};
+
+		/**
+		 * @class TransferringAQuantity
+		 * @brief Interpolating a quantity from target bodies by applying a transfer operator.
+		 */
+		template <class DataType, class ObserverParticlesType, class ObserverDataType, class TargetParticlesType, class TargetDataType,
+			StdLargeVec<ObserverDataType> ObserverParticlesType:: * ObrsvrDataMemPtr, StdLargeVec<TargetDataType> TargetParticlesType:: * TrgtDataMemPtr,
+			DataType ObserverDataType:: * ObrsvrMemPtr, DataType TargetDataType:: * TrgtMemPtr>
+			class TransferringAQuantity : public ParticleDynamicsSimple<SPHBody, ObserverParticlesType>
+		{
+		protected:
+			TransferOperator& transfer_operator_;
+			StdVec<TargetParticlesType*> target_particles_;
+
+			virtual void Update(size_t index_particle_i, Real dt = 0.0) override
+			{
+				DataType observed_quantity(0);
+				for (size_t k = 0; k != target_particles_.size(); ++k)
+				{
+					StdLargeVec<TargetDataType>& target_data = target_particles_[k]->*TrgtDataMemPtr;
+					StdLargeVec<ParticleIndex>& columns = transfer_operator_.columns_[k];
+					StdLargeVec<Real>& weights = transfer_operator_.weights_[k];
+					for (size_t m = transfer_operator_.row_offsets_[k][index_particle_i];
+						m != transfer_operator_.row_offsets_[k][index_particle_i + 1]; ++m)
+						observed_quantity += weights[m] * target_data[columns[m]].*TrgtMemPtr;
+				}
+				(this->particles_->*ObrsvrDataMemPtr)[index_particle_i].*ObrsvrMemPtr = observed_quantity;
+			};
+		public:
+			explicit TransferringAQuantity(TransferOperator& transfer_operator)
+				: ParticleDynamicsSimple<SPHBody, ObserverParticlesType>(transfer_operator.getObserverBody()),
+				transfer_operator_(transfer_operator)
+			{
+				for (auto& target_body : transfer_operator.getTargetBodies())
+					target_particles_.push_back(dynamic_cast<TargetParticlesType*>(target_body->base_particles_->PointToThisObject()));
+			};
+			virtual ~TransferringAQuantity() {};
+		};
+
+		/**
+		 * @class TransferringADiffusionReactionQuantity
+		 * @brief Interpolating a diffusion-reaction species from target bodies by applying a transfer operator.
+		 */
+		template <class ObserverParticlesType, class ObserverDataType, class DiffusionReactionParticlesType,
+			StdLargeVec<ObserverDataType> ObserverParticlesType:: * ObrsvrDataMemPtr, Real ObserverDataType:: * ObrsvrMemPtr>
+			class TransferringADiffusionReactionQuantity : public ParticleDynamicsSimple<SPHBody, ObserverParticlesType>
+		{
+		protected:
+			TransferOperator& transfer_operator_;
+			StdVec<DiffusionReactionParticlesType*> target_particles_;
+			/** Index of the species. */
+			size_t species_index_;
+
+			virtual void Update(size_t index_particle_i, Real dt = 0.0) override
+			{
+				Real observed_quantity(0);
+				for (size_t k = 0; k != target_particles_.size(); ++k)
+				{
+					StdLargeVec<DiffusionReactionData>& target_data = target_particles_[k]->diffusion_reaction_data_;
+					StdLargeVec<ParticleIndex>& columns = transfer_operator_.columns_[k];
+					StdLargeVec<Real>& weights = transfer_operator_.weights_[k];
+					for (size_t m = transfer_operator_.row_offsets_[k][index_particle_i];
+						m != transfer_operator_.row_offsets_[k][index_particle_i + 1]; ++m)
+						observed_quantity += weights[m] * target_data[columns[m]].species_n_[species_index_];
+				}
+				(this->particles_->*ObrsvrDataMemPtr)[index_particle_i].*ObrsvrMemPtr = observed_quantity;
+			};
+		public:
+			explicit TransferringADiffusionReactionQuantity(string species_name, TransferOperator& transfer_operator)
+				: ParticleDynamicsSimple<SPHBody, ObserverParticlesType>(transfer_operator.getObserverBody()),
+				transfer_operator_(transfer_operator)
+			{
+				for (auto& target_body : transfer_operator.getTargetBodies())
+					target_particles_.push_back(dynamic_cast<DiffusionReactionParticlesType*>(target_body->base_particles_->PointToThisObject()));
+				species_index_ = target_particles_[0]->getSpeciesIndexMap()[species_name];
+			};
+			virtual ~TransferringADiffusionReactionQuantity() {};
+		};
+
+		/**
+		* @class AdvectingTracers
+		* @brief Advect passive tracers by the velocity interpolated from a host fluid body,
+		* one-way coupled, i.e. the host does not feel the tracers.
+		* @details The host particles around a tracer are searched directly from the host
+		* cell linked list, which is required to be updated, so that the tracers need neither
+		* cell linked list nor configuration. The velocity is normalized by the Shepard weights and
+		* the tracers are advanced by the midpoint rule. A tracer without host particles around stays
+		* still, and only the time in the host fluid is counted for the residence time.
+		*/
+		class AdvectingTracers : public ParticleDynamicsSimple<TracerBody, TracerParticles>
+		{
+		protected:
+			StdLargeVec<BaseParticleData>& host_base_particle_data_;
+			BaseMeshCellLinkedList* host_mesh_cell_linked_list_;
+			Kernel* host_kernel_;
+
+			/** interpolate the host velocity at a position, and return the total weight */
+			Real InterpolateHostVelocity(Vecd& position, Vecd& velocity);
+			virtual void Update(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			AdvectingTracers(TracerBody* tracer_body, SPHBody* host_body);
+			virtual ~AdvectingTracers() {};
+		};
 	}
-}
\ No newline at end of file
+}
@@ -119,6 +119,33 @@ namespace SPH
 		virtual void parallel_exec(Real dt = 0.0);
 	};
 
+	/**
+	* @class ParticleDynamicsCellPairInner
+	* @brief This is the class for inner interactions without the inner configuration.
+	* The neighbors are searched from the adjacent cells of the cell linked list
+	* and the kernel values are computed on the fly for each pair.
+	* Only the dynamics using W_ij, dW_ij and e_ij of the neighbors are suitable,
+	* and the body is set by SPHBody::setCellPairInnerInteraction().
+	* The derived dynamics searches the neighbors in its inner interaction by
+	* MeshCellLinkedList::searchInnerNeighborsByCells() with a lambda for the pair interaction,
+	* which is inlined in the search loop, as there is no indirect call for each pair.
+	*/
+	template <class BodyType, class ParticlesType = BaseParticles, class MaterialType = BaseMaterial>
+	class ParticleDynamicsCellPairInner : public ParticleDynamics<void, BodyType, ParticlesType, MaterialType>
+	{
+	protected:
+		MeshCellLinkedList* mesh_cell_linked_list_;
+		/** search the neighbors and interact with them. */
+		virtual void InnerInteraction(size_t index_particle_i, Real dt = 0.0) = 0;
+		InnerFunctor functor_inner_interaction_;
+	public:
+		explicit ParticleDynamicsCellPairInner(BodyType* body);
+		virtual ~ParticleDynamicsCellPairInner() {};
+
+		virtual void exec(Real dt = 0.0) override;
+		virtual void parallel_exec(Real dt = 0.0) override;
+	};
+
 	/**
 	 * @class ParticleDynamicsContact
 	 * @brief This is the class for contact interactions
@@ -207,6 +234,9 @@ namespace SPH
 	
 		virtual void exec(Real dt = 0.0) override;
 		virtual void parallel_exec(Real dt = 0.0) override;
+		/** Only the given particles are updated, the others are taken at their current states. */
+		void exec_by_particles(IndexVector& particle_indexes, Real dt = 0.0);
+		void parallel_exec_by_particles(IndexVector& particle_indexes, Real dt = 0.0);
 	};
 
 	/**
@@ -6,6 +6,7 @@
 */
 #pragma once
 #include "particle_dynamics_algorithms.h"
+#include "mesh_cell_linked_list.hpp"
 //=================================================================================================//
 namespace SPH {
 	//=================================================================================================//
@@ -119,6 +120,39 @@ namespace SPH {
 		InnerIterator_parallel(number_of_particles, this->functor_update_, dt);
 	}
 	//=================================================================================================//
+	template <class BodyType, class ParticlesType, class MaterialType>
+	ParticleDynamicsCellPairInner<BodyType, ParticlesType, MaterialType>
+	::ParticleDynamicsCellPairInner(BodyType* body)
+	: ParticleDynamics<void, BodyType, ParticlesType, MaterialType>(body),
+		mesh_cell_linked_list_(dynamic_cast<MeshCellLinkedList*>(body->base_mesh_cell_linked_list_)),
+		functor_inner_interaction_(std::bind(&ParticleDynamicsCellPairInner::InnerInteraction, this, _1, _2)) 
+	{
+		if (mesh_cell_linked_list_ == NULL)
+		{
+			std::cout << "\n Error: cell pair interaction is not supported by the cell linked list of the body "
+				<< body->GetBodyName() << "!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+	}
+	//=================================================================================================//
+	template <class BodyType, class ParticlesType, class MaterialType>
+	void ParticleDynamicsCellPairInner<BodyType, ParticlesType, MaterialType>
+		::exec(Real dt)
+	{
+		size_t number_of_particles = this->body_->number_of_particles_;
+		this->SetupDynamics(dt);
+		InnerIterator(number_of_particles, functor_inner_interaction_, dt);
+	}
+	//=================================================================================================//
+	template <class BodyType, class ParticlesType, class MaterialType>
+	void ParticleDynamicsCellPairInner<BodyType, ParticlesType, MaterialType>
+		::parallel_exec(Real dt)
+	{
+		size_t number_of_particles = this->body_->number_of_particles_;
+		this->SetupDynamics(dt);
+		InnerIterator_parallel(number_of_particles, functor_inner_interaction_, dt);
+	}	//=================================================================================================//
 	template <class BodyType, class ParticlesType, class MaterialType,
 		class InteractingBodyType, class InteractingParticlesType, class InteractingMaterialType>
 	void ParticleDynamicsContact<BodyType, ParticlesType, MaterialType,
@@ -147,7 +181,9 @@ namespace SPH {
 	: ParticleDynamicsWithContactConfigurations<BodyType, ParticlesType, MaterialType,
 			InteractingBodyType, InteractingParticlesType, InteractingMaterialType>(body, interacting_bodies),
 		functor_complex_interaction_(std::bind(&ParticleDynamicsComplex::ComplexInteraction, this, _1, _2)) 
-	{}
+	{
+		this->checkInnerConfiguration(body);
+	}
 	//=================================================================================================//
 	template <class BodyType, class ParticlesType, class MaterialType,
 		class InteractingBodyType, class InteractingParticlesType, class InteractingMaterialType>
@@ -240,6 +276,30 @@ namespace SPH {
 		InnerIterator_parallel(number_of_particles, this->functor_complex_interaction_, dt);
 		InnerIterator_parallel(number_of_particles, this->functor_update_, dt);
 	}
+	//=================================================================================================//
+	template <class BodyType, class ParticlesType, class MaterialType,
+		class InteractingBodyType, class InteractingParticlesType, class InteractingMaterialType>
+	void ParticleDynamicsComplex1Level<BodyType, ParticlesType, MaterialType,
+		InteractingBodyType, InteractingParticlesType, InteractingMaterialType>
+		::exec_by_particles(IndexVector& particle_indexes, Real dt)
+	{
+		this->SetupDynamics(dt);
+		InnerIteratorByParticles(particle_indexes, functor_initialization_, dt);
+		InnerIteratorByParticles(particle_indexes, this->functor_complex_interaction_, dt);
+		InnerIteratorByParticles(particle_indexes, this->functor_update_, dt);
+	}
+	//=================================================================================================//
+	template <class BodyType, class ParticlesType, class MaterialType,
+		class InteractingBodyType, class InteractingParticlesType, class InteractingMaterialType>
+	void ParticleDynamicsComplex1Level<BodyType, ParticlesType, MaterialType,
+		InteractingBodyType, InteractingParticlesType, InteractingMaterialType>
+		::parallel_exec_by_particles(IndexVector& particle_indexes, Real dt)
+	{
+		this->SetupDynamics(dt);
+		InnerIteratorByParticles_parallel(particle_indexes, functor_initialization_, dt);
+		InnerIteratorByParticles_parallel(particle_indexes, this->functor_complex_interaction_, dt);
+		InnerIteratorByParticles_parallel(particle_indexes, this->functor_update_, dt);
+	}
 	//===================================================================//
 	template <class BodyType, class ParticlesType, class MaterialType,
 		class InteractingBodyType, class InteractingParticlesType, class InteractingMaterialType>
@@ -258,7 +318,10 @@ namespace SPH {
 		this->SetupDynamics(dt);
 		size_t number_of_particles = this->body_->number_of_particles_;
 		InnerIterator(number_of_particles, this->functor_initialization_, dt);
-		InnerIteratorSplitting(this->split_cell_lists_, this->functor_complex_interaction_, dt);
+		if (this->body_->use_block_split_cell_lists_)
+			InnerIteratorBlockSplitting(this->block_split_cell_lists_, this->functor_complex_interaction_, dt);
+		else
+			InnerIteratorSplitting(this->split_cell_lists_, this->functor_complex_interaction_, dt);
 		InnerIterator(number_of_particles, this->functor_update_, dt);
 	}
 	//===============================================================//
@@ -271,7 +334,10 @@ namespace SPH {
 		this->SetupDynamics(dt);
 		size_t number_of_particles = this->body_->number_of_particles_;
 		InnerIterator_parallel(number_of_particles, this->functor_initialization_, dt);
-		InnerIteratorSplitting_parallel(this->split_cell_lists_, this->functor_complex_interaction_, dt);
+		if (this->body_->use_block_split_cell_lists_)
+			InnerIteratorBlockSplitting_parallel(this->block_split_cell_lists_, this->functor_complex_interaction_, dt);
+		else
+			InnerIteratorSplitting_parallel(this->split_cell_lists_, this->functor_complex_interaction_, dt);
 		InnerIterator_parallel(number_of_particles, this->functor_update_, dt);
 	}
 	//===============================================================//
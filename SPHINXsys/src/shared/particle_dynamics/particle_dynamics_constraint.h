@@ -42,7 +42,9 @@ namespace SPH {
 	/** 
 	 * @class ConstraintByCell
 	 * @brief Imposing Eulerian constrain to a body.
-	 * The constrained particles are the cells tagged.
+	 * The constrained particles are those in the cells tagged.
+	 * Their indexes are cached by the body part and only 
+	 * recollected after the cell linked lists are updated.
 	 */
 	template <class BodyType, class ParticlesType, class BodyPartByCellType, class MaterialType = BaseMaterial>
 	class ConstraintByCell : public ParticleDynamicsByCells<BodyType, ParticlesType, MaterialType >
@@ -72,8 +72,7 @@ namespace SPH {
 		},
 			[this](ReturnType x, ReturnType y)->ReturnType {
 			return reduce_operation_(x, y);
-		}
-		);
+		}, ap);
 
 		return OutputResult(temp);
 	}	
@@ -84,11 +83,10 @@ namespace SPH {
 	{
 		PrepareConstraint();
 
-		for (size_t i = 0; i != constrained_cells_.size(); ++i) {
-			ConcurrentListDataVector& list_data
-				= constrained_cells_[i]->particle_data_lists_;
-			for (size_t num = 0; num < list_data.size(); ++num)
-				ConstraintAParticle(list_data[num].first, dt);
+		IndexVector& constrained_particles = body_part_->getBodyPartParticles();
+		for (size_t i = 0; i < constrained_particles.size(); ++i)
+		{
+			ConstraintAParticle(constrained_particles[i], dt);
 		}
 	}
 	//===============================================================//
@@ -98,13 +96,11 @@ namespace SPH {
 	{
 		PrepareConstraint();
 
-		parallel_for(blocked_range<size_t>(0, constrained_cells_.size()),
+		IndexVector& constrained_particles = body_part_->getBodyPartParticles();
+		parallel_for(blocked_range<size_t>(0, constrained_particles.size()),
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i < r.end(); ++i) {
-					ConcurrentListDataVector& list_data
-						= constrained_cells_[i]->particle_data_lists_;
-					for (size_t num = 0; num < list_data.size(); ++num)
-						ConstraintAParticle(list_data[num].first, dt);
+					ConstraintAParticle(constrained_particles[i], dt);
 				}
 			}, ap);
 	}
@@ -5,6 +5,7 @@
  */
 
 #include "solid_dynamics.h"
+#include "sph_system.h"
 
 using namespace SimTK;
 //=================================================================================================//
@@ -146,7 +147,7 @@ namespace SPH
 				}
 			}
 
-			solid_data_i.viscous_force_from_fluid_ += force;
+			solid_data_i.viscous_force_from_fluid_ += force * solid_data_i.fluid_force_scaling_;
 		}
 		//=================================================================================================//
 		void FluidAngularConservativeViscousForceOnSolid::ComplexInteraction(size_t index_particle_i, Real dt)
@@ -183,7 +184,7 @@ namespace SPH
 				}
 			}
 
-			solid_data_i.viscous_force_from_fluid_ += force;
+			solid_data_i.viscous_force_from_fluid_ += force * solid_data_i.fluid_force_scaling_;
 		}
 		//=================================================================================================//
 		TotalViscousForceOnSolid
@@ -236,12 +237,14 @@ namespace SPH
 					Vecd e_ij = neighboring_particle->e_ij_;
 					Real face_wall_external_acceleration
 						= dot((base_particle_data_j.dvel_dt_others_ - solid_data_i.dvel_dt_ave_), e_ij);
-					Real p_star = fluid_data_j.p_ + 0.5 * fluid_data_j.rho_n_
+					Real p_star = getInterfacePressure(k, e_ij, solid_data_i.vel_ave_,
+						fluid_data_j.p_, fluid_data_j.rho_n_, base_particle_data_j.vel_n_) + 0.5 * fluid_data_j.rho_n_
 						* neighboring_particle->r_ij_ * SMAX(0.0, face_wall_external_acceleration);
 
-					/** penalty correction to prevent particle running into boundary */
+					/** penalty correction to prevent particle running into boundary,
+					  * on both sides of the wall, as for a shell in fluid. */
 					Real projection = dot(-e_ij, n_i);
-					Real delta = 2.0 * projection * neighboring_particle->r_ij_ * particle_spacing_i1;
+					Real delta = 2.0 * fabs(projection) * neighboring_particle->r_ij_ * particle_spacing_i1;
 					Real beta = delta < 1.0 ? (1.0 - delta) * (1.0 - delta) * particle_spacing_ratio2 : 0.0;
 					Real penalty = beta * projection * fabs(p_star);
 
@@ -251,7 +254,248 @@ namespace SPH
 				}
 			}
 			
-			solid_data_i.force_from_fluid_ += force;
+			solid_data_i.force_from_fluid_ += force * solid_data_i.fluid_force_scaling_;
+		}
+		//=================================================================================================//
+		Real FluidPressureForceOnSolidRiemann::getInterfacePressure(size_t interacting_body_index,
+			Vecd& e_ij, Vecd& vel_ave_i, Real p_j, Real rho_j, Vecd& vel_j)
+		{
+			/** linear acoustic Riemann problem between the fluid and its mirror moving with the interface */
+			Real impedance_j = rho_j * interacting_material_[interacting_body_index]->GetSoundSpeed(p_j, rho_j);
+			return p_j + impedance_j * dot(vel_j - vel_ave_i, e_ij);
+		}
+		//=================================================================================================//
+		StrongFSICouplingByAitkenRelaxation::StrongFSICouplingByAitkenRelaxation(SolidBody* body,
+			StdVec<FluidBody*> interacting_bodies, Real tolerance, size_t max_sub_iterations, Real initial_relaxation_factor)
+			: ParticleDynamicsWithContactConfigurations<SolidBody, ElasticSolidParticles, ElasticSolid,
+			FluidBody, FluidParticles, WeaklyCompressibleFluid>(body, interacting_bodies),
+			tolerance_(tolerance), max_sub_iterations_(max_sub_iterations), sub_iteration_(0),
+			initial_relaxation_factor_(initial_relaxation_factor), relaxation_factor_(initial_relaxation_factor),
+			relative_residual_(0.0), is_converged_(false),
+			functor_residual_(std::bind(&StrongFSICouplingByAitkenRelaxation::ComputeResidual, this, _1, _2)),
+			functor_relaxation_(std::bind(&StrongFSICouplingByAitkenRelaxation::RelaxInterfaceVelocity, this, _1, _2)),
+			functor_setting_interface_velocity_(std::bind(&StrongFSICouplingByAitkenRelaxation::SetInterfaceVelocity, this, _1, _2))
+		{
+			recorded_particles_ = particles_->duplicateParticles();
+			size_t number_of_interacting_bodies = interacting_particles_.size();
+			interface_neighborhoods_.resize(number_of_interacting_bodies);
+			interface_halos_.resize(number_of_interacting_bodies);
+			interface_neighborhoods_with_halos_.resize(number_of_interacting_bodies);
+			recorded_base_particle_data_.resize(number_of_interacting_bodies);
+			recorded_fluid_particle_data_.resize(number_of_interacting_bodies);
+			recorded_halo_base_particle_data_.resize(number_of_interacting_bodies);
+			recorded_halo_fluid_particle_data_.resize(number_of_interacting_bodies);
+		}
+		//=================================================================================================//
+		StrongFSICouplingByAitkenRelaxation::~StrongFSICouplingByAitkenRelaxation()
+		{
+			delete recorded_particles_;
+		}
+		//=================================================================================================//
+		bool StrongFSICouplingByAitkenRelaxation::isInterfaceParticle(size_t index_particle_i)
+		{
+			for (size_t k = 0; k < current_interacting_configuration_.size(); ++k)
+				if (std::get<2>((*current_interacting_configuration_[k])[index_particle_i]) != 0) return true;
+			return false;
+		}
+		//=================================================================================================//
+		void StrongFSICouplingByAitkenRelaxation::BuildInterfaceNeighborhoods()
+		{
+			/** add the inner neighbors of the given fluid particles, excluding ghost particles,
+			  * e.g. of periodic boundaries, which are not updated by the fluid dynamics */
+			auto addInnerNeighbors = [](ParticleConfiguration& fluid_inner_configuration,
+				size_t number_of_fluid_particles, IndexVector& particle_indexes, IndexVector& neighbors) {
+				for (size_t l = 0; l != particle_indexes.size(); ++l)
+				{
+					Neighborhood& inner_neighborhood = fluid_inner_configuration[particle_indexes[l]];
+					NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
+					for (size_t m = 0; m != std::get<2>(inner_neighborhood); ++m)
+						if (inner_neighors[m]->j_ < number_of_fluid_particles)
+							neighbors.push_back(inner_neighors[m]->j_);
+				}
+				std::sort(neighbors.begin(), neighbors.end());
+				neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+			};
+
+			for (size_t k = 0; k != interacting_bodies_.size(); ++k)
+			{
+				size_t number_of_fluid_particles = interacting_bodies_[k]->number_of_particles_;
+				ParticleConfiguration& fluid_inner_configuration = interacting_bodies_[k]->inner_configuration_;
+				IndexVector contact_neighbors;
+				for (size_t i = 0; i != body_->number_of_particles_; ++i)
+				{
+					Neighborhood& contact_neighborhood = (*current_interacting_configuration_[k])[i];
+					NeighborList& contact_neighors = std::get<0>(contact_neighborhood);
+					for (size_t n = 0; n != std::get<2>(contact_neighborhood); ++n)
+						if (contact_neighors[n]->j_ < number_of_fluid_particles)
+							contact_neighbors.push_back(contact_neighors[n]->j_);
+				}
+				std::sort(contact_neighbors.begin(), contact_neighbors.end());
+				contact_neighbors.erase(std::unique(contact_neighbors.begin(),
+					contact_neighbors.end()), contact_neighbors.end());
+
+				/** the interface neighborhood is the contact neighbors and their inner neighbors,
+				  * and the two layers of inner neighbors around it, which it reads directly or 
+				  * through the first layer in the pressure relaxation, are the halo */
+				IndexVector& interface_neighborhood = interface_neighborhoods_[k];
+				IndexVector& interface_neighborhood_with_halo = interface_neighborhoods_with_halos_[k];
+				interface_neighborhood = contact_neighbors;
+				addInnerNeighbors(fluid_inner_configuration, number_of_fluid_particles, 
+					contact_neighbors, interface_neighborhood);
+				interface_neighborhood_with_halo = interface_neighborhood;
+				addInnerNeighbors(fluid_inner_configuration, number_of_fluid_particles, 
+					interface_neighborhood, interface_neighborhood_with_halo);
+				IndexVector first_layer_with_neighborhood = interface_neighborhood_with_halo;
+				addInnerNeighbors(fluid_inner_configuration, number_of_fluid_particles,
+					first_layer_with_neighborhood, interface_neighborhood_with_halo);
+
+				IndexVector& interface_halo = interface_halos_[k];
+				interface_halo.clear();
+				std::set_difference(interface_neighborhood_with_halo.begin(), interface_neighborhood_with_halo.end(),
+					interface_neighborhood.begin(), interface_neighborhood.end(), std::back_inserter(interface_halo));
+			}
+		}
+		//=================================================================================================//
+		void StrongFSICouplingByAitkenRelaxation::InitializeSubIterations()
+		{
+			recorded_particles_->copyParticleStates(particles_);
+			BuildInterfaceNeighborhoods();
+			for (size_t k = 0; k != interacting_particles_.size(); ++k)
+			{
+				IndexVector& interface_neighborhood_with_halo = interface_neighborhoods_with_halos_[k];
+				recorded_base_particle_data_[k].resize(interface_neighborhood_with_halo.size());
+				recorded_fluid_particle_data_[k].resize(interface_neighborhood_with_halo.size());
+				for (size_t l = 0; l != interface_neighborhood_with_halo.size(); ++l)
+				{
+					recorded_base_particle_data_[k][l]
+						= interacting_particles_[k]->base_particle_data_[interface_neighborhood_with_halo[l]];
+					recorded_fluid_particle_data_[k][l]
+						= interacting_particles_[k]->fluid_particle_data_[interface_neighborhood_with_halo[l]];
+				}
+			}
+
+			size_t number_of_particles = body_->number_of_particles_;
+			interface_velocity_.resize(number_of_particles);
+			residual_.resize(number_of_particles);
+			previous_residual_.resize(number_of_particles);
+			for (size_t i = 0; i != number_of_particles; ++i)
+			{
+				interface_velocity_[i] = particles_->solid_body_data_[i].vel_ave_;
+				residual_[i] = Vecd(0);
+				previous_residual_[i] = Vecd(0);
+			}
+
+			sub_iteration_ = 0;
+			relaxation_factor_ = initial_relaxation_factor_;
+			relative_residual_ = 0.0;
+			is_converged_ = false;
+		}
+		//=================================================================================================//
+		void StrongFSICouplingByAitkenRelaxation::RecordInterfaceHalos()
+		{
+			for (size_t k = 0; k != interacting_particles_.size(); ++k)
+			{
+				IndexVector& interface_halo = interface_halos_[k];
+				recorded_halo_base_particle_data_[k].resize(interface_halo.size());
+				recorded_halo_fluid_particle_data_[k].resize(interface_halo.size());
+				for (size_t l = 0; l != interface_halo.size(); ++l)
+				{
+					recorded_halo_base_particle_data_[k][l]
+						= interacting_particles_[k]->base_particle_data_[interface_halo[l]];
+					recorded_halo_fluid_particle_data_[k][l]
+						= interacting_particles_[k]->fluid_particle_data_[interface_halo[l]];
+				}
+			}
+		}
+		//=================================================================================================//
+		void StrongFSICouplingByAitkenRelaxation::RestoreInterfaceHalos()
+		{
+			for (size_t k = 0; k != interacting_particles_.size(); ++k)
+			{
+				IndexVector& interface_halo = interface_halos_[k];
+				for (size_t l = 0; l != interface_halo.size(); ++l)
+				{
+					interacting_particles_[k]->base_particle_data_[interface_halo[l]]
+						= recorded_halo_base_particle_data_[k][l];
+					interacting_particles_[k]->fluid_particle_data_[interface_halo[l]]
+						= recorded_halo_fluid_particle_data_[k][l];
+				}
+			}
+		}
+		//=================================================================================================//
+		void StrongFSICouplingByAitkenRelaxation::PrepareSubIteration()
+		{
+			if (sub_iteration_ != 0)
+			{
+				particles_->copyParticleStates(recorded_particles_);
+				for (size_t k = 0; k != interacting_particles_.size(); ++k)
+				{
+					IndexVector& interface_neighborhood_with_halo = interface_neighborhoods_with_halos_[k];
+					for (size_t l = 0; l != interface_neighborhood_with_halo.size(); ++l)
+					{
+						interacting_particles_[k]->base_particle_data_[interface_neighborhood_with_halo[l]]
+							= recorded_base_particle_data_[k][l];
+						interacting_particles_[k]->fluid_particle_data_[interface_neighborhood_with_halo[l]]
+							= recorded_fluid_particle_data_[k][l];
+					}
+				}
+			}
+			InnerIterator_parallel(body_->number_of_particles_, functor_setting_interface_velocity_);
+		}
+		//=================================================================================================//
+		void StrongFSICouplingByAitkenRelaxation::SetInterfaceVelocity(size_t index_particle_i, Real dt)
+		{
+			particles_->solid_body_data_[index_particle_i].vel_ave_ = interface_velocity_[index_particle_i];
+		}
+		//=================================================================================================//
+		Vec4d StrongFSICouplingByAitkenRelaxation::ComputeResidual(size_t index_particle_i, Real dt)
+		{
+			if (!isInterfaceParticle(index_particle_i)) return Vec4d(0);
+
+			Vecd& vel_ave_i = particles_->solid_body_data_[index_particle_i].vel_ave_;
+			Vecd residual_i = vel_ave_i - interface_velocity_[index_particle_i];
+			residual_[index_particle_i] = residual_i;
+			Vecd residual_change_i = residual_i - previous_residual_[index_particle_i];
+			return Vec4d(dot(residual_i, residual_i), dot(previous_residual_[index_particle_i], residual_change_i),
+				dot(residual_change_i, residual_change_i), dot(vel_ave_i, vel_ave_i));
+		}
+		//=================================================================================================//
+		void StrongFSICouplingByAitkenRelaxation::UpdateRelaxationFactor(Vec4d residual_sums)
+		{
+			sub_iteration_++;
+			relative_residual_ = sqrt(residual_sums[0]) / (sqrt(residual_sums[3]) + 1.0e-15);
+			is_converged_ = relative_residual_ <= tolerance_ || sub_iteration_ >= max_sub_iterations_;
+
+			/** Aitken's dynamic relaxation factor from the residuals of two successive sub-iterations,
+			  * bounded as an under-relaxation. */
+			if (!is_converged_ && sub_iteration_ > 1 && residual_sums[2] > 0.0)
+				relaxation_factor_ = clamp(-relaxation_factor_ * residual_sums[1] / residual_sums[2], 0.01, 1.0);
+		}
+		//=================================================================================================//
+		void StrongFSICouplingByAitkenRelaxation::RelaxInterfaceVelocity(size_t index_particle_i, Real dt)
+		{
+			interface_velocity_[index_particle_i] += relaxation_factor_ * residual_[index_particle_i];
+			previous_residual_[index_particle_i] = residual_[index_particle_i];
+		}
+		//=================================================================================================//
+		void StrongFSICouplingByAitkenRelaxation::exec(Real dt)
+		{
+			size_t number_of_particles = body_->number_of_particles_;
+			ReduceSum<Vec4d> reduce_sum;
+			UpdateRelaxationFactor(ReduceIterator(number_of_particles, Vec4d(0), functor_residual_, reduce_sum, dt));
+			if (!is_converged_) InnerIterator(number_of_particles, functor_relaxation_, dt);
+			if (sub_iteration_ == 1) RecordInterfaceHalos();
+			else RestoreInterfaceHalos();
+		}
+		//=================================================================================================//
+		void StrongFSICouplingByAitkenRelaxation::parallel_exec(Real dt)
+		{
+			size_t number_of_particles = body_->number_of_particles_;
+			ReduceSum<Vec4d> reduce_sum;
+			UpdateRelaxationFactor(ReduceIterator_parallel(number_of_particles, Vec4d(0), functor_residual_, reduce_sum, dt));
+			if (!is_converged_) InnerIterator_parallel(number_of_particles, functor_relaxation_, dt);
+			if (sub_iteration_ == 1) RecordInterfaceHalos();
+			else RestoreInterfaceHalos();
 		}
 		//=================================================================================================//
 		GetAcousticTimeStepSize::GetAcousticTimeStepSize(SolidBody* body)
@@ -444,21 +688,21 @@ namespace SPH
 		Vecd ConstrainSolidBodyRegionSinusoidalMotion::GetDisplacement(Vecd &pos)
 		{	
 			Vecd disp(0.0);
-			disp[1] = h_m_ * sin(2.0 * pi * f_ * GlobalStaticVariables::physical_time_ + Real((id_ -1)) * phi_);
+			disp[1] = h_m_ * sin(2.0 * pi * f_ * body_->getSPHSystem().physical_time_ + Real((id_ -1)) * phi_);
 			return disp;
 		}
 		//=================================================================================================//
 		Vecd ConstrainSolidBodyRegionSinusoidalMotion::GetVelocity(Vecd &pos)
 		{
 			Vecd disp(0.0);
-			disp[1] = h_m_ * 2.0 * pi * f_ * cos(2.0 * pi * f_ * GlobalStaticVariables::physical_time_ + Real((id_ -1)) * phi_);
+			disp[1] = h_m_ * 2.0 * pi * f_ * cos(2.0 * pi * f_ * body_->getSPHSystem().physical_time_ + Real((id_ -1)) * phi_);
 			return disp;
 		}
 		//=================================================================================================//
 		Vecd ConstrainSolidBodyRegionSinusoidalMotion::GetAcceleration(Vecd &pos)
 		{
 			Vecd disp(0.0);
-			disp[1] = -h_m_ * 2.0 * pi * f_ * 2.0 * pi * f_ * cos(2.0 * pi * f_ * GlobalStaticVariables::physical_time_ + Real((id_ -1)) * phi_);
+			disp[1] = -h_m_ * 2.0 * pi * f_ * 2.0 * pi * f_ * cos(2.0 * pi * f_ * body_->getSPHSystem().physical_time_ + Real((id_ -1)) * phi_);
 			return disp;
 		}
 		//=================================================================================================//
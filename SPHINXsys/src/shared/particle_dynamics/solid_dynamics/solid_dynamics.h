@@ -215,12 +215,117 @@ namespace SPH
 		{
 		protected:
 			virtual void ComplexInteraction(size_t index_particle_i, Real dt = 0.0) override;
+			/** the fluid pressure acting on the solid interface */
+			virtual Real getInterfacePressure(size_t interacting_body_index, Vecd& e_ij,
+				Vecd& vel_ave_i, Real p_j, Real rho_j, Vecd& vel_j) { return p_j; };
 		public:
 			FluidPressureForceOnSolid(SolidBody *body, StdVec<FluidBody*> interacting_bodies)
 				: FSIDynamicsComplex(body, interacting_bodies) {};
 			virtual ~FluidPressureForceOnSolid() {};
 		};
 
+		/**
+		* @class FluidPressureForceOnSolidRiemann
+		* @brief Computing the pressure force from the fluid with the acoustic Riemann
+		* pressure between the fluid and the solid interface moving with its average velocity.
+		* Therefore, the force depends on the interface velocity, as required by 
+		* the sub-iterations of StrongFSICouplingByAitkenRelaxation.
+		*/
+		class FluidPressureForceOnSolidRiemann : public FluidPressureForceOnSolid
+		{
+		protected:
+			virtual Real getInterfacePressure(size_t interacting_body_index, Vecd& e_ij,
+				Vecd& vel_ave_i, Real p_j, Real rho_j, Vecd& vel_j) override;
+		public:
+			FluidPressureForceOnSolidRiemann(SolidBody* body, StdVec<FluidBody*> interacting_bodies)
+				: FluidPressureForceOnSolid(body, interacting_bodies) {};
+			virtual ~FluidPressureForceOnSolidRiemann() {};
+		};
+
+		/**
+		* @class StrongFSICouplingByAitkenRelaxation
+		* @brief Sub-iterated strong coupling between an elastic body and fluid bodies
+		* within a fluid acoustic time step, for light and flexible structures
+		* for which the explicit coupling is unstable due to the added-mass effect.
+		* @details The interface velocity, i.e. the average velocity seen by the fluid,
+		* is relaxed by the Aitken method. A sub-iteration consists of PrepareSubIteration,
+		* the fluid pressure relaxation with FluidPressureForceOnSolidRiemann, so that the fluid load
+		* depends on the interface velocity, the solid sub-steps between InitializeDisplacement 
+		* and UpdateAverageVelocity, and then exec or parallel_exec, and is repeated until isConverged. 
+		* The first sub-iteration is the same as the explicit coupling.
+		* Only the fluid particles in the interface neighborhood, i.e. the contact neighbors of the solid
+		* and their inner neighbors, depend on the interface velocity. In the repeated sub-iterations,
+		* the first half of the pressure relaxation is carried out for the interface neighborhood
+		* and its halo of two layers of inner neighbors, given by getInterfaceNeighborhoodWithHalo,
+		* and the second half for the interface neighborhood only, by exec_by_particles or 
+		* parallel_exec_by_particles. So the interface neighborhood takes the states of its halo 
+		* at the right stages. The solid particles, the interface neighborhood and the halo are restored 
+		* to their states at the beginning of the time step by PrepareSubIteration, and the halo, 
+		* which does not depend on the interface velocity, is then restored to its states after the first 
+		* sub-iteration by exec or parallel_exec.
+		*/
+		class StrongFSICouplingByAitkenRelaxation
+			: public ParticleDynamicsWithContactConfigurations<SolidBody, ElasticSolidParticles, ElasticSolid,
+			FluidBody, FluidParticles, WeaklyCompressibleFluid>
+		{
+		protected:
+			/** relative tolerance on the interface velocity and the maximum number of sub-iterations */
+			Real tolerance_;
+			size_t max_sub_iterations_, sub_iteration_;
+			Real initial_relaxation_factor_, relaxation_factor_;
+			Real relative_residual_;
+			bool is_converged_;
+			/** particle states recorded at the beginning of the sub-iterations */
+			BaseParticles* recorded_particles_;
+			/** fluid particles in the interface neighborhood, its halo and both together */
+			StdVec<IndexVector> interface_neighborhoods_, interface_halos_, interface_neighborhoods_with_halos_;
+			/** states of the interface neighborhood with halo at the beginning of the time step,
+			  * and states of the halo after the first sub-iteration */
+			StdVec<StdLargeVec<BaseParticleData>> recorded_base_particle_data_, recorded_halo_base_particle_data_;
+			StdVec<StdLargeVec<FluidParticleData>> recorded_fluid_particle_data_, recorded_halo_fluid_particle_data_;
+			/** the interface velocity seen by the fluid, and the residuals
+			  * of the current and the previous sub-iterations */
+			StdLargeVec<Vecd> interface_velocity_, residual_, previous_residual_;
+			/** sums of squared residual, Aitken numerator and denominator, and squared velocity */
+			ReduceFunctor<Vec4d> functor_residual_;
+			InnerFunctor functor_relaxation_, functor_setting_interface_velocity_;
+
+			bool isInterfaceParticle(size_t index_particle_i);
+			/** build the interface neighborhood of the fluid bodies and its halo from the current configurations */
+			void BuildInterfaceNeighborhoods();
+			/** record or restore the states of the halo after the first sub-iteration */
+			void RecordInterfaceHalos();
+			void RestoreInterfaceHalos();
+			Vec4d ComputeResidual(size_t index_particle_i, Real dt = 0.0);
+			void RelaxInterfaceVelocity(size_t index_particle_i, Real dt = 0.0);
+			void SetInterfaceVelocity(size_t index_particle_i, Real dt = 0.0);
+			/** update the relaxation factor and check the convergence by the sums of the residuals */
+			void UpdateRelaxationFactor(Vec4d residual_sums);
+		public:
+			StrongFSICouplingByAitkenRelaxation(SolidBody* body, StdVec<FluidBody*> interacting_bodies,
+				Real tolerance = 1.0e-3, size_t max_sub_iterations = 10, Real initial_relaxation_factor = 0.5);
+			virtual ~StrongFSICouplingByAitkenRelaxation();
+
+			/** record the particle states at the beginning of a fluid acoustic time step */
+			void InitializeSubIterations();
+			/** restore the recorded states for a repeated sub-iteration, and set the interface velocity */
+			void PrepareSubIteration();
+			/** relax the interface velocity after the solid sub-steps of a sub-iteration,
+			  * and restore the halo after the repeated sub-iterations */
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+
+			bool isConverged() { return is_converged_; };
+			IndexVector& getInterfaceNeighborhood(size_t interacting_body_index) {
+				return interface_neighborhoods_[interacting_body_index];
+			};
+			IndexVector& getInterfaceNeighborhoodWithHalo(size_t interacting_body_index) {
+				return interface_neighborhoods_with_halos_[interacting_body_index];
+			};
+			size_t getNumberOfSubIterations() { return sub_iteration_; };
+			Real getRelativeResidual() { return relative_residual_; };
+		};
+
 		/**
 		* @class TotalViscousForceOnSolid
 		* @brief Computing the total viscous force from fluid
@@ -0,0 +1,288 @@
+/**
+ * @file 	thin_structure_dynamics.cpp
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "thin_structure_dynamics.h"
+
+using namespace SimTK;
+//=================================================================================================//
+namespace SPH
+{
+	//=================================================================================================//
+	namespace thin_structure_dynamics
+	{
+		//=================================================================================================//
+		void ShellCorrectConfiguration::InnerInteraction(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			SolidParticleData &solid_data_i = particles_->solid_body_data_[index_particle_i];
+
+			Real sigma = body_->kernel_->W(Vecd(0)) * base_particle_data_i.Vol_;
+			Matd local_configuration(0.0);
+			Neighborhood& inner_neighborhood = (*inner_configuration_)[index_particle_i];
+			NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
+			for (size_t n = 0; n != std::get<2>(inner_neighborhood); ++n)
+			{
+				BaseNeighborRelation* neighboring_particle = inner_neighors[n];
+				size_t index_particle_j = neighboring_particle->j_;
+				BaseParticleData &base_particle_data_j = particles_->base_particle_data_[index_particle_j];
+
+				Vecd gradw_ij = neighboring_particle->dW_ij_ * neighboring_particle->e_ij_;
+				Vecd r_ji = - neighboring_particle->r_ij_ * neighboring_particle->e_ij_;
+				local_configuration += base_particle_data_j.Vol_ * SimTK::outer(r_ji, gradw_ij);
+				sigma += neighboring_particle->W_ij_ * base_particle_data_j.Vol_;
+			}
+
+			/** the normal direction is added, in which the configuration is singular otherwise. */
+			local_configuration += SimTK::outer(solid_data_i.n_0_, solid_data_i.n_0_);
+			solid_data_i.B_ = inverse(local_configuration);
+			/** A wall with full kernel support has the kernel summation of a half on the wall side,
+			  * while the single layer has sigma only. */
+			solid_data_i.fluid_force_scaling_ = 0.5 / sigma;
+		}
+		//=================================================================================================//
+		void ShellDeformationGradientTensor::InnerInteraction(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			SolidParticleData &solid_data_i = particles_->solid_body_data_[index_particle_i];
+			ElasticSolidParticleData &elastic_data_i = particles_->elastic_body_data_[index_particle_i];
+			ShellParticleData &shell_data_i = particles_->shell_data_[index_particle_i];
+
+			Matd deformation(0.0);
+			Matd pseudo_normal_gradient(0.0);
+			Neighborhood& inner_neighborhood = (*inner_configuration_)[index_particle_i];
+			NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
+			for (size_t n = 0; n != std::get<2>(inner_neighborhood); ++n)
+			{
+				BaseNeighborRelation* neighboring_particle = inner_neighors[n];
+				size_t index_particle_j = neighboring_particle->j_;
+				BaseParticleData &base_particle_data_j = particles_->base_particle_data_[index_particle_j];
+				SolidParticleData &solid_data_j = particles_->solid_body_data_[index_particle_j];
+
+				Vecd gradw_ij = neighboring_particle->dW_ij_ * neighboring_particle->e_ij_;
+				deformation -= base_particle_data_j.Vol_
+					*SimTK::outer((base_particle_data_i.pos_n_ - base_particle_data_j.pos_n_), gradw_ij);
+				pseudo_normal_gradient -= base_particle_data_j.Vol_
+					*SimTK::outer((solid_data_i.n_ - solid_data_j.n_), gradw_ij);
+			}
+
+			elastic_data_i.F_ = deformation * solid_data_i.B_ + SimTK::outer(solid_data_i.n_, solid_data_i.n_0_);
+			shell_data_i.F_bending_ = pseudo_normal_gradient * solid_data_i.B_;
+		}
+		//=================================================================================================//
+		ShellAcousticTimeStepSize::ShellAcousticTimeStepSize(SolidBody* body)
+			: ShellDynamicsMinimum(body)
+		{
+			smoothing_length_ = body->kernel_->GetSmoothingLength();
+			//time setep size due to linear viscosity
+			initial_reference_ = material_->getViscousTimeStepSize(smoothing_length_);
+		}
+		//=================================================================================================//
+		Real ShellAcousticTimeStepSize::ReduceFunction(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			ShellParticleData &shell_data_i = particles_->shell_data_[index_particle_i];
+
+			Real sound_speed = material_->getReferenceSoundSpeed();
+			return 0.6 * SMIN(sqrt(smoothing_length_ / (base_particle_data_i.dvel_dt_.norm() + 1.0e-15)),
+				smoothing_length_ / (sound_speed + base_particle_data_i.vel_n_.norm()),
+				sqrt(1.0 / (shell_data_i.dn_dt2_.norm() + 1.0e-15)));
+		}
+		//=================================================================================================//
+		ShellStressRelaxationFirstHalf::ShellStressRelaxationFirstHalf(SolidBody *body)
+			: ShellDynamicsInner1Level(body)
+		{
+			numerical_viscosity_ = material_->getNumericalViscosity(body_->kernel_->GetSmoothingLength());
+			/** two-point Gauss quadrature through the thickness */
+			gauss_point_[0] = -0.5 / sqrt(3.0);
+			gauss_point_[1] = 0.5 / sqrt(3.0);
+			gauss_weight_[0] = 0.5;
+			gauss_weight_[1] = 0.5;
+		}
+		//=================================================================================================//
+		Matd ShellStressRelaxationFirstHalf::PlaneStress(Matd F, Matd& dF_dt, Vecd& n_0, Vecd& n, size_t index_particle_i)
+		{
+			/** The through-thickness normal stress is zeroed by secant iterations on the normal stretch. */
+			Matd stress = material_->ConstitutiveRelation(F, index_particle_i)
+				+ material_->DampingStress(F, dF_dt, numerical_viscosity_, index_particle_i);
+			Real normal_stress = dot(n, stress * n_0);
+			Real stretch = 1.0;
+			Real previous_stretch = 1.0;
+			Real previous_normal_stress = normal_stress;
+			Real trial_stretch = 1.0 + 1.0e-3;
+			for (size_t k = 0; k != 3; ++k)
+			{
+				Matd F_stretched = F + (trial_stretch - 1.0) * SimTK::outer(n, n_0);
+				stress = material_->ConstitutiveRelation(F_stretched, index_particle_i)
+					+ material_->DampingStress(F_stretched, dF_dt, numerical_viscosity_, index_particle_i);
+				normal_stress = dot(n, stress * n_0);
+				stretch = trial_stretch;
+
+				Real slope = (normal_stress - previous_normal_stress) / (stretch - previous_stretch);
+				if (fabs(slope) < 1.0e-15) break;
+				previous_stretch = stretch;
+				previous_normal_stress = normal_stress;
+				trial_stretch = SMIN(SMAX(stretch - normal_stress / slope, 0.5), 2.0);
+			}
+			return stress;
+		}
+		//=================================================================================================//
+		void ShellStressRelaxationFirstHalf::Initialization(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			SolidParticleData &solid_data_i = particles_->solid_body_data_[index_particle_i];
+			ElasticSolidParticleData &elastic_data_i = particles_->elastic_body_data_[index_particle_i];
+			ShellParticleData &shell_data_i = particles_->shell_data_[index_particle_i];
+
+			elastic_data_i.F_ += elastic_data_i.dF_dt_ * dt * 0.5;
+			shell_data_i.F_bending_ += shell_data_i.dF_bending_dt_ * dt * 0.5;
+			elastic_data_i.rho_n_ = elastic_data_i.rho_0_ / det(elastic_data_i.F_);
+			base_particle_data_i.pos_n_ += base_particle_data_i.vel_n_ * dt * 0.5;
+			solid_data_i.n_ += shell_data_i.dn_dt_ * dt * 0.5;
+			solid_data_i.n_ /= solid_data_i.n_.norm() + 1.0e-15;
+
+			/** membrane and bending resultants by integration through the thickness */
+			Real thickness = shell_data_i.thickness_;
+			Matd membrane_resultant(0), moment_resultant(0);
+			for (size_t k = 0; k != 2; ++k)
+			{
+				Real position_in_thickness = gauss_point_[k] * thickness;
+				Matd F = elastic_data_i.F_ + position_in_thickness * shell_data_i.F_bending_;
+				Matd dF_dt = elastic_data_i.dF_dt_ + position_in_thickness * shell_data_i.dF_bending_dt_;
+				Matd stress = PlaneStress(F, dF_dt, solid_data_i.n_0_, solid_data_i.n_, index_particle_i);
+				membrane_resultant += gauss_weight_[k] * thickness * stress;
+				moment_resultant += gauss_weight_[k] * thickness * position_in_thickness * stress;
+			}
+			/** the stress is the mean through the thickness */
+			elastic_data_i.stress_ = membrane_resultant / thickness;
+			shell_data_i.moment_ = moment_resultant;
+		}
+		//=================================================================================================//
+		void ShellStressRelaxationFirstHalf::InnerInteraction(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			SolidParticleData &solid_data_i = particles_->solid_body_data_[index_particle_i];
+			ElasticSolidParticleData &elastic_data_i = particles_->elastic_body_data_[index_particle_i];
+			ShellParticleData &shell_data_i = particles_->shell_data_[index_particle_i];
+
+			Real thickness_i = shell_data_i.thickness_;
+			//including gravity and force from fluid
+			Vecd acceleration = base_particle_data_i.dvel_dt_others_
+				+ solid_data_i.force_from_fluid_ / elastic_data_i.mass_;
+			/** the transverse shear, i.e. the membrane resultant on the initial normal, acts on the pseudo-normal */
+			Vecd moment_force = - elastic_data_i.stress_ * thickness_i * solid_data_i.n_0_;
+
+			Neighborhood& inner_neighborhood = (*inner_configuration_)[index_particle_i];
+			NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
+			for (size_t n = 0; n != std::get<2>(inner_neighborhood); ++n)
+			{
+				BaseNeighborRelation* neighboring_particle = inner_neighors[n];
+				size_t index_particle_j = neighboring_particle->j_;
+				BaseParticleData &base_particle_data_j = particles_->base_particle_data_[index_particle_j];
+				SolidParticleData &solid_data_j = particles_->solid_body_data_[index_particle_j];
+				ElasticSolidParticleData &elastic_data_j = particles_->elastic_body_data_[index_particle_j];
+				ShellParticleData &shell_data_j = particles_->shell_data_[index_particle_j];
+
+				Vecd gradw_ij = neighboring_particle->dW_ij_ * neighboring_particle->e_ij_;
+				acceleration += (elastic_data_i.stress_ * thickness_i * solid_data_i.B_
+					+ elastic_data_j.stress_ * shell_data_j.thickness_ * solid_data_j.B_)
+					* gradw_ij * base_particle_data_j.Vol_ / (elastic_data_i.rho_0_ * thickness_i);
+				moment_force += (shell_data_i.moment_ * solid_data_i.B_ + shell_data_j.moment_ * solid_data_j.B_)
+					* gradw_ij * base_particle_data_j.Vol_;
+			}
+			base_particle_data_i.dvel_dt_ = acceleration;
+
+			/** rotary inertia scaled up to the particle spacing */
+			Real particle_spacing = body_->particle_spacing_;
+			Real rotary_inertia = elastic_data_i.rho_0_ * thickness_i
+				* SMAX(thickness_i * thickness_i / 12.0, particle_spacing * particle_spacing);
+			Vecd pseudo_normal_acceleration = moment_force / rotary_inertia;
+			/** only the change perpendicular to the pseudo-normal keeps its length */
+			shell_data_i.dn_dt2_ = pseudo_normal_acceleration
+				- dot(pseudo_normal_acceleration, solid_data_i.n_) * solid_data_i.n_;
+		}
+		//=================================================================================================//
+		void ShellStressRelaxationFirstHalf::Update(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			SolidParticleData &solid_data_i = particles_->solid_body_data_[index_particle_i];
+			ShellParticleData &shell_data_i = particles_->shell_data_[index_particle_i];
+
+			base_particle_data_i.vel_n_ += base_particle_data_i.dvel_dt_ * dt;
+			shell_data_i.dn_dt_ += shell_data_i.dn_dt2_ * dt;
+			shell_data_i.dn_dt_ -= dot(shell_data_i.dn_dt_, solid_data_i.n_) * solid_data_i.n_;
+		}
+		//=================================================================================================//
+		void ShellStressRelaxationSecondHalf::Initialization(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			SolidParticleData &solid_data_i = particles_->solid_body_data_[index_particle_i];
+			ShellParticleData &shell_data_i = particles_->shell_data_[index_particle_i];
+
+			base_particle_data_i.pos_n_ += base_particle_data_i.vel_n_ * dt * 0.5;
+			solid_data_i.n_ += shell_data_i.dn_dt_ * dt * 0.5;
+			solid_data_i.n_ /= solid_data_i.n_.norm() + 1.0e-15;
+		}
+		//=================================================================================================//
+		void ShellStressRelaxationSecondHalf::InnerInteraction(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			SolidParticleData &solid_data_i = particles_->solid_body_data_[index_particle_i];
+			ElasticSolidParticleData &elastic_data_i = particles_->elastic_body_data_[index_particle_i];
+			ShellParticleData &shell_data_i = particles_->shell_data_[index_particle_i];
+
+			Matd deformation_gradient_change_rate(0);
+			Matd pseudo_normal_gradient_change_rate(0);
+			Neighborhood& inner_neighborhood = (*inner_configuration_)[index_particle_i];
+			NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
+			for (size_t n = 0; n != std::get<2>(inner_neighborhood); ++n)
+			{
+				BaseNeighborRelation* neighboring_particle = inner_neighors[n];
+				size_t index_particle_j = neighboring_particle->j_;
+				BaseParticleData &base_particle_data_j = particles_->base_particle_data_[index_particle_j];
+				ShellParticleData &shell_data_j = particles_->shell_data_[index_particle_j];
+
+				Vecd gradw_ij = neighboring_particle->dW_ij_ * neighboring_particle->e_ij_;
+				deformation_gradient_change_rate
+					-= base_particle_data_j.Vol_
+					*SimTK::outer((base_particle_data_i.vel_n_ - base_particle_data_j.vel_n_), gradw_ij);
+				pseudo_normal_gradient_change_rate
+					-= base_particle_data_j.Vol_
+					*SimTK::outer((shell_data_i.dn_dt_ - shell_data_j.dn_dt_), gradw_ij);
+			}
+			elastic_data_i.dF_dt_ = deformation_gradient_change_rate * solid_data_i.B_
+				+ SimTK::outer(shell_data_i.dn_dt_, solid_data_i.n_0_);
+			shell_data_i.dF_bending_dt_ = pseudo_normal_gradient_change_rate * solid_data_i.B_;
+		}
+		//=================================================================================================//
+		void ShellStressRelaxationSecondHalf::Update(size_t index_particle_i, Real dt)
+		{
+			ElasticSolidParticleData &elastic_data_i = particles_->elastic_body_data_[index_particle_i];
+			ShellParticleData &shell_data_i = particles_->shell_data_[index_particle_i];
+
+			elastic_data_i.F_ += elastic_data_i.dF_dt_ * dt * 0.5;
+			shell_data_i.F_bending_ += shell_data_i.dF_bending_dt_ * dt * 0.5;
+		}
+		//=================================================================================================//
+		void ConstrainShellBodyRegion::ConstraintAParticle(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			SolidParticleData &solid_data_i = particles_->solid_body_data_[index_particle_i];
+			ShellParticleData &shell_data_i = particles_->shell_data_[index_particle_i];
+
+			base_particle_data_i.pos_n_ = base_particle_data_i.pos_0_;
+			base_particle_data_i.vel_n_ = Vecd(0);
+			base_particle_data_i.dvel_dt_ = Vecd(0);
+			solid_data_i.n_ = solid_data_i.n_0_;
+			shell_data_i.dn_dt_ = Vecd(0);
+			shell_data_i.dn_dt2_ = Vecd(0);
+			/** the average values are prescirbed also. */
+			solid_data_i.vel_ave_ = Vecd(0);
+			solid_data_i.dvel_dt_ave_ = Vecd(0);
+		}
+		//=================================================================================================//
+	}
+	//=================================================================================================//
+}
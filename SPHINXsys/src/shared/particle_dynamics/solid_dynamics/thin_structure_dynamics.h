@@ -0,0 +1,149 @@
+/**
+ * @file 	thin_structure_dynamics.h
+ * @brief 	Here, we define the algorithm classes for thin structure dynamics,
+ *			in which a shell is represented by a single layer of particles.
+ * @details The shell is a Reissner-Mindlin one given by the mid-surface particles and their
+ *			pseudo-normals. The deformation gradient of a point through the thickness is that of the
+ *			mid-surface plus the through-thickness coordinate times the gradient of the pseudo-normal.
+ *			The stress is integrated through the thickness by two-point Gauss quadrature
+ *			under the plane-stress condition, giving the membrane and bending resultants,
+ *			which drive the mid-surface velocity and the pseudo-normal.
+ *			The rotary inertia is scaled up to the particle spacing, as common for explicit shells,
+ *			so that the time step is limited by the particle spacing rather than by the thickness.
+ *			The force from fluid is included in the acceleration, and the single layer of shell particles
+ *			is coupled with fluid through the existing contact dynamics, in which the fluid-solid interaction
+ *			on a shell particle is scaled to that of a wall with full kernel support.
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+#pragma once
+
+#include "solid_dynamics.h"
+#include "shell_particles.h"
+
+namespace SPH
+{
+	namespace thin_structure_dynamics
+	{
+		typedef ParticleDynamicsSimple<SolidBody, ShellParticles, ElasticSolid> ShellDynamicsSimple;
+
+		typedef ParticleDynamicsReduce<Real, ReduceMin, SolidBody, ShellParticles, ElasticSolid> ShellDynamicsMinimum;
+
+		typedef ParticleDynamicsInner<SolidBody, ShellParticles, ElasticSolid> ShellDynamicsInner;
+
+		typedef ParticleDynamicsInner1Level<SolidBody, ShellParticles, ElasticSolid> ShellDynamicsInner1Level;
+
+		/**
+		 * @class ShellDynamicsInitialCondition
+		 * @brief  set initial condition, such as the normal direction and the thickness, for a shell.
+		 * This is a abstract class to be override for case specific initial conditions.
+		 */
+		class ShellDynamicsInitialCondition : public ShellDynamicsSimple
+		{
+		public:
+			ShellDynamicsInitialCondition(SolidBody *body)
+				: ShellDynamicsSimple(body) {};
+			virtual ~ShellDynamicsInitialCondition() {};
+		};
+
+		/**
+		* @class ShellCorrectConfiguration
+		* @brief obtain the corrected initial configuration in strong form for the mid-surface.
+		* The configuration is regularized by the initial normal direction,
+		* in which the single layer of particles gives no information.
+		* The scaling of the fluid force is obtained also, so that the layer is a fluid wall with full kernel support.
+		*/
+		class ShellCorrectConfiguration : public ShellDynamicsInner
+		{
+		protected:
+			virtual void InnerInteraction(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			ShellCorrectConfiguration(SolidBody *body) : ShellDynamicsInner(body) {};
+			virtual ~ShellCorrectConfiguration() {};
+		};
+
+		/**
+		* @class ShellDeformationGradientTensor
+		* @brief computing the deformation gradient tensor of the mid-surface
+		* and the gradient of the pseudo-normal by summation
+		*/
+		class ShellDeformationGradientTensor : public ShellDynamicsInner
+		{
+		protected:
+			virtual void InnerInteraction(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			ShellDeformationGradientTensor(SolidBody *body) : ShellDynamicsInner(body) {};
+			virtual ~ShellDeformationGradientTensor() {};
+		};
+
+		/**
+		* @class ShellAcousticTimeStepSize
+		* @brief Computing the acoustic time step size of a shell,
+		* which depends on the particle spacing but not on the thickness.
+		*/
+		class ShellAcousticTimeStepSize : public ShellDynamicsMinimum
+		{
+		protected:
+			Real smoothing_length_;
+			Real ReduceFunction(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			explicit ShellAcousticTimeStepSize(SolidBody* body);
+			virtual ~ShellAcousticTimeStepSize() {};
+		};
+
+		/**
+		* @class ShellStressRelaxationFirstHalf
+		* @brief computing stress relaxation process of a shell by verlet time stepping
+		* This is the first step
+		*/
+		class ShellStressRelaxationFirstHalf : public ShellDynamicsInner1Level
+		{
+		protected:
+			Real numerical_viscosity_;
+			/** Through-thickness Gauss points and weights as the fractions of thickness. */
+			Real gauss_point_[2], gauss_weight_[2];
+
+			/** Plane-stress first Piola-Kirchhoff stress for the given deformation gradient,
+			  * obtained by adjusting the through-thickness stretch. */
+			Matd PlaneStress(Matd F, Matd& dF_dt, Vecd& n_0, Vecd& n, size_t index_particle_i);
+			virtual void Initialization(size_t index_particle_i, Real dt = 0.0) override;
+			virtual void InnerInteraction(size_t index_particle_i, Real dt = 0.0) override;
+			virtual void Update(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			ShellStressRelaxationFirstHalf(SolidBody *body);
+			virtual ~ShellStressRelaxationFirstHalf() {};
+			void setupDampingStressFactor(Real alpha = 1.0) { numerical_viscosity_ *= alpha; }
+		};
+
+		/**
+		* @class ShellStressRelaxationSecondHalf
+		* @brief computing stress relaxation process of a shell by verlet time stepping
+		* This is the second step
+		*/
+		class ShellStressRelaxationSecondHalf : public ShellDynamicsInner1Level
+		{
+		protected:
+			virtual void Initialization(size_t index_particle_i, Real dt = 0.0) override;
+			virtual void InnerInteraction(size_t index_particle_i, Real dt = 0.0) override;
+			virtual void Update(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			ShellStressRelaxationSecondHalf(SolidBody *body) : ShellDynamicsInner1Level(body) {};
+			virtual ~ShellStressRelaxationSecondHalf() {};
+		};
+
+		/**@class ConstrainShellBodyRegion
+		 * @brief Constrain the position and the pseudo-normal of a shell body part,
+		 * i.e. a clamped boundary.
+		 */
+		class ConstrainShellBodyRegion
+			: public ConstraintByParticle<SolidBody, ShellParticles, BodyPartByParticle>
+		{
+		protected:
+			virtual void ConstraintAParticle(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			ConstrainShellBodyRegion(SolidBody *body, BodyPartByParticle *body_part)
+				: ConstraintByParticle<SolidBody, ShellParticles, BodyPartByParticle>(body, body_part) {};
+			virtual ~ConstrainShellBodyRegion() {};
+		};
+	}
+}
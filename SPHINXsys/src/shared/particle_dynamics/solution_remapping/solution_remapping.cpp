@@ -0,0 +1,170 @@
+/**
+ * @file 	solution_remapping.cpp
+ * @author	Xiangyu Hu and Chi Zhang
+ * @version	0.1
+ */
+
+#include "solution_remapping.h"
+
+namespace SPH
+{
+	//=================================================================================================//
+	namespace solution_remapping
+	{
+		//=================================================================================================//
+		RemapFluidStates::RemapFluidStates(FluidBody* fine_body, FluidBody* coarse_body)
+			: FluidRemapping(fine_body),
+			coarse_particles_(dynamic_cast<FluidParticles*>(coarse_body->base_particles_->PointToThisObject())),
+			coarse_mesh_cell_linked_list_(coarse_body->base_mesh_cell_linked_list_),
+			coarse_kernel_(coarse_body->kernel_)
+		{
+			weight_threshold_ = 0.1;
+		}
+		//=================================================================================================//
+		void RemapFluidStates::Update(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData& base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			FluidParticleData& fluid_data_i = particles_->fluid_particle_data_[index_particle_i];
+
+			Vecd remapped_velocity(0);
+			Real remapped_density(0), ttl_weight(0);
+			StdLargeVec<BaseParticleData>& coarse_base_particle_data = coarse_particles_->base_particle_data_;
+			StdLargeVec<FluidParticleData>& coarse_fluid_data = coarse_particles_->fluid_particle_data_;
+			PositionNeighborFunctor summation = [&](size_t index_particle_j, Vecd& displacement) {
+				Real weight_j = coarse_kernel_->W(displacement) * coarse_base_particle_data[index_particle_j].Vol_;
+				remapped_velocity += weight_j * coarse_base_particle_data[index_particle_j].vel_n_;
+				remapped_density += weight_j * coarse_fluid_data[index_particle_j].rho_n_;
+				ttl_weight += weight_j;
+			};
+			coarse_mesh_cell_linked_list_->SearchNeighborsAroundPosition(base_particle_data_i.pos_n_, summation);
+
+			if (ttl_weight > weight_threshold_)
+			{
+				base_particle_data_i.vel_n_ = remapped_velocity / ttl_weight;
+				fluid_data_i.rho_n_ = remapped_density / ttl_weight;
+				fluid_data_i.p_ = material_->GetPressure(fluid_data_i.rho_n_);
+				fluid_data_i.mass_ = fluid_data_i.rho_n_ * base_particle_data_i.Vol_;
+			}
+		}
+		//=================================================================================================//
+		RemapElasticSolidStates::RemapElasticSolidStates(SolidBody* fine_body, SolidBody* coarse_body)
+			: ElasticSolidRemapping(fine_body), coarse_body_(coarse_body),
+			coarse_particles_(dynamic_cast<ElasticSolidParticles*>(coarse_body->base_particles_->PointToThisObject())),
+			coarse_mesh_cell_linked_list_(coarse_body->base_mesh_cell_linked_list_),
+			coarse_kernel_(coarse_body->kernel_)
+		{
+			weight_threshold_ = 0.1;
+		}
+		//=================================================================================================//
+		void RemapElasticSolidStates::moveCoarseBodyToReferenceConfiguration()
+		{
+			size_t number_of_coarse_particles = coarse_body_->number_of_particles_;
+			coarse_current_positions_.resize(number_of_coarse_particles);
+			for (size_t i = 0; i != number_of_coarse_particles; ++i)
+			{
+				BaseParticleData& base_particle_data_i = coarse_particles_->base_particle_data_[i];
+				coarse_current_positions_[i] = base_particle_data_i.pos_n_;
+				base_particle_data_i.pos_n_ = base_particle_data_i.pos_0_;
+			}
+			coarse_body_->UpdateCellLinkedList();
+		}
+		//=================================================================================================//
+		void RemapElasticSolidStates::moveCoarseBodyToCurrentConfiguration()
+		{
+			for (size_t i = 0; i != coarse_body_->number_of_particles_; ++i)
+				coarse_particles_->base_particle_data_[i].pos_n_ = coarse_current_positions_[i];
+			coarse_body_->UpdateCellLinkedList();
+			body_->UpdateCellLinkedList();
+			body_->UpdateContactConfiguration();
+		}
+		//=================================================================================================//
+		void RemapElasticSolidStates::Update(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData& base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			ElasticSolidParticleData& elastic_data_i = particles_->elastic_body_data_[index_particle_i];
+
+			Vecd remapped_displacement(0), remapped_velocity(0);
+			Matd remapped_deformation(0);
+			Real ttl_weight(0);
+			PositionNeighborFunctor summation = [&](size_t index_particle_j, Vecd& displacement) {
+				BaseParticleData& base_particle_data_j = coarse_particles_->base_particle_data_[index_particle_j];
+				Real weight_j = coarse_kernel_->W(displacement) * base_particle_data_j.Vol_0_;
+				remapped_displacement += weight_j * (coarse_current_positions_[index_particle_j] - base_particle_data_j.pos_0_);
+				remapped_velocity += weight_j * base_particle_data_j.vel_n_;
+				remapped_deformation += weight_j * coarse_particles_->elastic_body_data_[index_particle_j].F_;
+				ttl_weight += weight_j;
+			};
+			coarse_mesh_cell_linked_list_->SearchNeighborsAroundPosition(base_particle_data_i.pos_0_, summation);
+
+			if (ttl_weight > weight_threshold_)
+			{
+				base_particle_data_i.pos_n_ = base_particle_data_i.pos_0_ + remapped_displacement / ttl_weight;
+				base_particle_data_i.vel_n_ = remapped_velocity / ttl_weight;
+				elastic_data_i.F_ = remapped_deformation / ttl_weight;
+				elastic_data_i.dF_dt_ = Matd(0);
+				elastic_data_i.rho_n_ = elastic_data_i.rho_0_ / det(elastic_data_i.F_);
+			}
+		}
+		//=================================================================================================//
+		void RemapElasticSolidStates::exec(Real dt)
+		{
+			moveCoarseBodyToReferenceConfiguration();
+			ElasticSolidRemapping::exec(dt);
+			moveCoarseBodyToCurrentConfiguration();
+		}
+		//=================================================================================================//
+		void RemapElasticSolidStates::parallel_exec(Real dt)
+		{
+			moveCoarseBodyToReferenceConfiguration();
+			ElasticSolidRemapping::parallel_exec(dt);
+			moveCoarseBodyToCurrentConfiguration();
+		}
+		//=================================================================================================//
+		RelaxRemappedFluidStates::RelaxRemappedFluidStates(FluidBody* fine_body, Real relaxation_factor)
+			: FluidRemappingRelaxation(fine_body), relaxation_factor_(relaxation_factor)
+		{
+			averaged_velocity_.resize(fine_body->number_of_particles_, Vecd(0));
+			averaged_density_.resize(fine_body->number_of_particles_, 0.0);
+		}
+		//=================================================================================================//
+		void RelaxRemappedFluidStates::InnerInteraction(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData& base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			FluidParticleData& fluid_data_i = particles_->fluid_particle_data_[index_particle_i];
+
+			/** the particle itself is included in the average. */
+			Real weight_i = body_->kernel_->W(Vecd(0)) * base_particle_data_i.Vol_;
+			Vecd velocity = weight_i * base_particle_data_i.vel_n_;
+			Real density = weight_i * fluid_data_i.rho_n_;
+			Real ttl_weight = weight_i;
+			Neighborhood& inner_neighborhood = (*inner_configuration_)[index_particle_i];
+			NeighborList& inner_neighors = std::get<0>(inner_neighborhood);
+			for (size_t n = 0; n != std::get<2>(inner_neighborhood); ++n)
+			{
+				BaseNeighborRelation* neighboring_particle = inner_neighors[n];
+				size_t index_particle_j = neighboring_particle->j_;
+				BaseParticleData& base_particle_data_j = particles_->base_particle_data_[index_particle_j];
+
+				Real weight_j = neighboring_particle->W_ij_ * base_particle_data_j.Vol_;
+				velocity += weight_j * base_particle_data_j.vel_n_;
+				density += weight_j * particles_->fluid_particle_data_[index_particle_j].rho_n_;
+				ttl_weight += weight_j;
+			}
+			averaged_velocity_[index_particle_i] = velocity / ttl_weight;
+			averaged_density_[index_particle_i] = density / ttl_weight;
+		}
+		//=================================================================================================//
+		void RelaxRemappedFluidStates::Update(size_t index_particle_i, Real dt)
+		{
+			BaseParticleData& base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+			FluidParticleData& fluid_data_i = particles_->fluid_particle_data_[index_particle_i];
+
+			base_particle_data_i.vel_n_ += relaxation_factor_ * (averaged_velocity_[index_particle_i] - base_particle_data_i.vel_n_);
+			fluid_data_i.rho_n_ += relaxation_factor_ * (averaged_density_[index_particle_i] - fluid_data_i.rho_n_);
+			fluid_data_i.p_ = material_->GetPressure(fluid_data_i.rho_n_);
+			fluid_data_i.mass_ = fluid_data_i.rho_n_ * base_particle_data_i.Vol_;
+		}
+		//=================================================================================================//
+	}
+}
+//=================================================================================================//
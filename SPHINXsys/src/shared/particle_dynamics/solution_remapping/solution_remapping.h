@@ -0,0 +1,108 @@
+/**
+ * @file 	solution_remapping.h
+ * @brief 	Here, we define the algorithm classes for remapping a developed solution
+ *			from a coarse body onto a body with freshly generated fine particles.
+ * @details The coarse body is not in the topology of the fine body, and its states are
+ *			usually read from the restart files of a coarse run. The fine particle states are
+ *			obtained by normalized kernel-weighted interpolation with the coarse kernel
+ *			from the coarse particles found by the cell linked list of the coarse body,
+ *			which is required to be updated, so that the coarse data is not undersampled.
+ *			A short relaxation is followed to smooth the interpolated states on the fine particles.
+ * @author	Xiangyu Hu and Chi Zhang
+ * @version	0.1
+ */
+
+#pragma once
+
+#include "all_particle_dynamics.h"
+#include "weakly_compressible_fluid.h"
+#include "elastic_solid.h"
+
+namespace SPH
+{
+	namespace solution_remapping
+	{
+		typedef ParticleDynamicsSimple<FluidBody, FluidParticles, WeaklyCompressibleFluid> FluidRemapping;
+
+		typedef ParticleDynamicsSimple<SolidBody, ElasticSolidParticles, ElasticSolid> ElasticSolidRemapping;
+
+		typedef ParticleDynamicsInnerWithUpdate<FluidBody, FluidParticles, WeaklyCompressibleFluid>
+			FluidRemappingRelaxation;
+
+		/**
+		* @class RemapFluidStates
+		* @brief Interpolate the velocity and density of a coarse fluid body
+		* onto the current positions of the fine fluid particles.
+		* The pressure is obtained from the remapped density by the equation of state,
+		* and the mass of fine particles is updated according to the remapped density.
+		* Fine particles without coarse neighbors keep their states.
+		*/
+		class RemapFluidStates : public FluidRemapping
+		{
+		protected:
+			FluidParticles* coarse_particles_;
+			BaseMeshCellLinkedList* coarse_mesh_cell_linked_list_;
+			Kernel* coarse_kernel_;
+			/** The fine particles with too small total weight (the kernel sum is about one in the bulk) are not remapped. */
+			Real weight_threshold_;
+			virtual void Update(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			RemapFluidStates(FluidBody* fine_body, FluidBody* coarse_body);
+			virtual ~RemapFluidStates() {};
+		};
+
+		/**
+		* @class RemapElasticSolidStates
+		* @brief Interpolate the displacement, velocity and deformation tensor of a coarse
+		* elastic solid body onto fine particles. The interpolation is carried out
+		* in the reference configuration, therefore, the fine particles should be at their
+		* generated positions. After remapping, the coarse body is moved back to
+		* the current configuration, and the cell linked list and the contact configuration
+		* of the fine body are updated for its remapped positions.
+		*/
+		class RemapElasticSolidStates : public ElasticSolidRemapping
+		{
+		protected:
+			SolidBody* coarse_body_;
+			ElasticSolidParticles* coarse_particles_;
+			BaseMeshCellLinkedList* coarse_mesh_cell_linked_list_;
+			Kernel* coarse_kernel_;
+			/** The current positions of the coarse particles. */
+			StdLargeVec<Vecd> coarse_current_positions_;
+			Real weight_threshold_;
+
+			/** Set the coarse particles in the reference configuration. */
+			void moveCoarseBodyToReferenceConfiguration();
+			/** Set the coarse particles back in the current configuration. */
+			void moveCoarseBodyToCurrentConfiguration();
+			virtual void Update(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			RemapElasticSolidStates(SolidBody* fine_body, SolidBody* coarse_body);
+			virtual ~RemapElasticSolidStates() {};
+
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+		};
+
+		/**
+		* @class RelaxRemappedFluidStates
+		* @brief A relaxation step which blends the remapped velocity and density
+		* with their kernel-weighted averages and updates the pressure from the equation of state.
+		* A few steps are usually sufficient to remove the interpolation noise.
+		*/
+		class RelaxRemappedFluidStates : public FluidRemappingRelaxation
+		{
+		protected:
+			/** relaxation factor within (0, 1]. */
+			Real relaxation_factor_;
+			StdLargeVec<Vecd> averaged_velocity_;
+			StdLargeVec<Real> averaged_density_;
+
+			virtual void InnerInteraction(size_t index_particle_i, Real dt = 0.0) override;
+			virtual void Update(size_t index_particle_i, Real dt = 0.0) override;
+		public:
+			RelaxRemappedFluidStates(FluidBody* fine_body, Real relaxation_factor = 0.5);
+			virtual ~RelaxRemappedFluidStates() {};
+		};
+	}
+}
@@ -1,3 +1,5 @@
 #pragma once
 
-#include "particle_generator_lattice.h"
\ No newline at end of file
+#include "particle_generator_lattice.h"
+#include "particle_generator_voxel.h"
+#include "particle_generator_poisson_disk.h"
\ No newline at end of file
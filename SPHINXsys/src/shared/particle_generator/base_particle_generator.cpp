@@ -7,6 +7,7 @@
 #include "base_particle_generator.h"
 #include "base_body.h"
 #include "base_particles.h"
+#include "base_kernel.h"
 
 namespace SPH {
 	//=================================================================================================//
@@ -15,6 +16,31 @@ namespace SPH {
 		: body_(body)
 	{
 
+	}
+	//=================================================================================================//
+	Real ParticleGenerator::ComputeReferenceNumberDensity(Real lattice_spacing)
+	{
+		int dimension = Vecd(0).size();
+		Real sigma(0);
+		Real cutoff_radius = body_.kernel_->GetCutOffRadius();
+		int search_range = int(cutoff_radius / lattice_spacing) + 1;
+		Veci lattice_index(-search_range);
+		while (true)
+		{
+			Vecd lattice_position;
+			for (int k = 0; k != dimension; ++k) lattice_position[k] = Real(lattice_index[k]) * lattice_spacing;
+			if (lattice_position.norm() < cutoff_radius)
+				sigma += body_.kernel_->W(lattice_position);
+			/** Next lattice point in the search cube. */
+			int k = 0;
+			for (; k != dimension; ++k)
+			{
+				if (lattice_index[k] < search_range) { lattice_index[k]++; break; }
+				lattice_index[k] = -search_range;
+			}
+			if (k == dimension) break;
+		}
+		return sigma;
 	}
 	//=================================================================================================//
 	ParticleGeneratorDirect
@@ -30,6 +30,8 @@ namespace SPH {
 
 		/** Create lattice particle for a body. */
 		virtual void CreateBaseParticles(BaseParticles* base_particles) = 0;
+		/** Reference number density of particles on a lattice, for any dimension. */
+		Real ComputeReferenceNumberDensity(Real lattice_spacing);
 	};
 	/**
 	 * @class ParticleGeneratorDirect
@@ -35,8 +35,9 @@ namespace SPH {
 		ParticleGeneratorLattice(SPHBody &sph_body);
 		virtual ~ParticleGeneratorLattice() {};
 
-		/** Compute reference number density*/
-		virtual Real ComputeReferenceNumberDensity();
+		using ParticleGenerator::ComputeReferenceNumberDensity;
+		/** Compute reference number density with the lattice spacing. */
+		virtual Real ComputeReferenceNumberDensity() { return ComputeReferenceNumberDensity(lattice_spacing_); };
 		/** Create lattice particle for a body. */
 		virtual void CreateBaseParticles(BaseParticles *base_particles) override;
 	};
@@ -0,0 +1,218 @@
+/**
+ * @file 	particle_generator_poisson_disk.cpp
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+#include "particle_generator_poisson_disk.h"
+#include "base_body.h"
+#include "base_particles.h"
+#include "base_mesh.h"
+
+#include <random>
+
+namespace SPH {
+	//=================================================================================================//
+	ParticleGeneratorPoissonDisk
+		::ParticleGeneratorPoissonDisk(SPHBody &sph_body)
+		: ParticleGenerator(sph_body), particle_spacing_(sph_body.particle_spacing_),
+		number_of_passes_(4), darts_per_cell_(8)
+	{
+		int dimension = Vecd(0).size();
+		/** The minimum distance giving about the lattice number density
+		  * for a maximal Poisson-disk sampling. */
+		minimum_distance_ = (dimension == 2 ? 0.83 : 0.90) * particle_spacing_;
+		cell_spacing_ = minimum_distance_ / sqrt(Real(dimension));
+
+		Vecd upper_bound;
+		sph_body.BodyBounds(lower_bound_, upper_bound);
+		for (int i = 0; i != dimension; ++i)
+			number_of_cells_[i] = size_t(ceil((upper_bound[i] - lower_bound_[i]) / cell_spacing_)) + 1;
+	}
+	//=================================================================================================//
+	size_t ParticleGeneratorPoissonDisk::transferCellIndexTo1D(Vecu cell_index)
+	{
+		size_t index_1d = 0;
+		for (int i = Vecd(0).size() - 1; i >= 0; --i)
+			index_1d = index_1d * number_of_cells_[i] + cell_index[i];
+		return index_1d;
+	}
+	//=================================================================================================//
+	Vecu ParticleGeneratorPoissonDisk::transfer1DtoCellIndex(size_t i)
+	{
+		Vecu cell_index;
+		for (int k = 0; k != Vecd(0).size(); ++k)
+		{
+			cell_index[k] = i % number_of_cells_[k];
+			i /= number_of_cells_[k];
+		}
+		return cell_index;
+	}
+	//=================================================================================================//
+	bool ParticleGeneratorPoissonDisk::isFarFromSamples(Vecd& position, Vecu cell_index)
+	{
+		int dimension = Vecd(0).size();
+		/** The minimum distance is less than two cell sizes up to 3d. */
+		Veci offset(-2);
+		while (true)
+		{
+			bool is_in_range = true;
+			Vecu neighbor_cell;
+			for (int k = 0; k != dimension; ++k)
+			{
+				int index = int(cell_index[k]) + offset[k];
+				if (index < 0 || index >= int(number_of_cells_[k])) is_in_range = false;
+				else neighbor_cell[k] = size_t(index);
+			}
+			if (is_in_range)
+			{
+				size_t neighbor_1d = transferCellIndexTo1D(neighbor_cell);
+				if (is_sampled_[neighbor_1d] && (samples_[neighbor_1d] - position).norm() < minimum_distance_)
+					return false;
+			}
+			int k = 0;
+			for (; k != dimension; ++k)
+			{
+				if (offset[k] < 2) { offset[k]++; break; }
+				offset[k] = -2;
+			}
+			if (k == dimension) break;
+		}
+		return true;
+	}
+	//=================================================================================================//
+	void ParticleGeneratorPoissonDisk::throwDarts(MeshBackground* mesh_background, bool is_surface_layer)
+	{
+		int dimension = Vecd(0).size();
+		size_t number_of_phases = powern(3, dimension);
+		Real surface_layer_phi = 0.5 * particle_spacing_;
+
+		for (size_t pass = 0; pass != number_of_passes_; ++pass)
+			for (size_t phase = 0; phase != number_of_phases; ++phase)
+			{
+				/** Cells of a phase group are three cells apart in each direction. */
+				Vecu phase_offset, number_of_phase_cells;
+				size_t phase_digits = phase;
+				size_t total_phase_cells = 1;
+				for (int k = 0; k != dimension; ++k)
+				{
+					phase_offset[k] = phase_digits % 3;
+					phase_digits /= 3;
+					number_of_phase_cells[k] = number_of_cells_[k] > phase_offset[k]
+						? (number_of_cells_[k] - phase_offset[k] + 2) / 3 : 0;
+					total_phase_cells *= number_of_phase_cells[k];
+				}
+
+				parallel_for(blocked_range<size_t>(0, total_phase_cells),
+					[&](const blocked_range<size_t>& r) {
+						for (size_t m = r.begin(); m != r.end(); ++m)
+						{
+							Vecu cell_index;
+							size_t phase_index = m;
+							for (int k = 0; k != dimension; ++k)
+							{
+								cell_index[k] = phase_offset[k] + 3 * (phase_index % number_of_phase_cells[k]);
+								phase_index /= number_of_phase_cells[k];
+							}
+							size_t cell_1d = transferCellIndexTo1D(cell_index);
+							if (is_sampled_[cell_1d]) continue;
+
+							Vecd cell_lower_bound;
+							for (int k = 0; k != dimension; ++k)
+								cell_lower_bound[k] = lower_bound_[k] + Real(cell_index[k]) * cell_spacing_;
+							/** Skip the cells far from the surface layer for its sampling. */
+							if (is_surface_layer)
+							{
+								Vecd cell_center = cell_lower_bound + Vecd(0.5 * cell_spacing_);
+								if (ABS(mesh_background->ProbeLevelSet(cell_center) - surface_layer_phi)
+									> particle_spacing_ + cell_spacing_) continue;
+							}
+
+							std::minstd_rand random_engine(unsigned((cell_1d * number_of_passes_ + pass) * 2 + is_surface_layer + 1));
+							std::uniform_real_distribution<Real> random_fraction(0.0, 1.0);
+							for (size_t dart = 0; dart != darts_per_cell_; ++dart)
+							{
+								Vecd position;
+								for (int k = 0; k != dimension; ++k)
+									position[k] = cell_lower_bound[k] + random_fraction(random_engine) * cell_spacing_;
+								Real phi = mesh_background->ProbeLevelSet(position);
+
+								if (is_surface_layer)
+								{
+									/** Project the dart onto the surface layer contour. */
+									if (phi <= 0.0) continue;
+									Vecd dist_2_face = mesh_background->ProbeNormalDirection(position);
+									position += (phi - surface_layer_phi) * dist_2_face / (dist_2_face.norm() + 1.0e-15);
+									if (ABS(mesh_background->ProbeLevelSet(position) - surface_layer_phi)
+										> 0.1 * particle_spacing_) continue;
+									bool is_in_cell = true;
+									for (int k = 0; k != dimension; ++k)
+										if (position[k] < cell_lower_bound[k]
+											|| position[k] >= cell_lower_bound[k] + cell_spacing_) is_in_cell = false;
+									if (!is_in_cell) continue;
+								}
+								else if (phi < surface_layer_phi) continue;
+
+								if (isFarFromSamples(position, cell_index))
+								{
+									samples_[cell_1d] = position;
+									is_sampled_[cell_1d] = 1;
+									break;
+								}
+							}
+						}
+					}, ap);
+			}
+	}
+	//=================================================================================================//
+	Real ParticleGeneratorPoissonDisk::estimateBodyVolume(MeshBackground* mesh_background)
+	{
+		size_t total_cells = is_sampled_.size();
+		size_t number_of_inner_cells = parallel_reduce(blocked_range<size_t>(0, total_cells),
+			size_t(0), [&](const blocked_range<size_t>& r, size_t count) -> size_t {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					Vecu cell_index = transfer1DtoCellIndex(i);
+					Vecd cell_center;
+					for (int k = 0; k != Vecd(0).size(); ++k)
+						cell_center[k] = lower_bound_[k] + (Real(cell_index[k]) + 0.5) * cell_spacing_;
+					if (mesh_background->ProbeLevelSet(cell_center) > 0.0) count++;
+				}
+				return count;
+			}, [](size_t x, size_t y) { return x + y; }, ap);
+		return Real(number_of_inner_cells) * powern(cell_spacing_, Vecd(0).size());
+	}
+	//=================================================================================================//
+	void ParticleGeneratorPoissonDisk::CreateBaseParticles(BaseParticles* base_particles)
+	{
+		if (body_.mesh_background_ == NULL) body_.addBackgroundMesh();
+		MeshBackground* mesh_background = body_.mesh_background_;
+
+		size_t total_cells = 1;
+		for (int k = 0; k != Vecd(0).size(); ++k) total_cells *= number_of_cells_[k];
+		samples_.resize(total_cells, Vecd(0));
+		is_sampled_.resize(total_cells, 0);
+
+		throwDarts(mesh_background, true);
+		throwDarts(mesh_background, false);
+
+		size_t number_of_samples = 0;
+		for (size_t i = 0; i != total_cells; ++i) number_of_samples += is_sampled_[i];
+		if (number_of_samples == 0)
+		{
+			std::cout << "\n Error: no Poisson-disk sample is found in the body " << body_.GetBodyName() << "!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
+		/** The particles share the body volume, so that the total mass is as that from a lattice. */
+		Real vol = estimateBodyVolume(mesh_background) / Real(number_of_samples);
+		Real sigma = ComputeReferenceNumberDensity(pow(vol, 1.0 / Real(Vecd(0).size())));
+		for (size_t i = 0; i != total_cells; ++i)
+			if (is_sampled_[i]) base_particles->InitializeABaseParticle(samples_[i], vol, sigma);
+
+		body_.number_of_particles_ = number_of_samples;
+		samples_.clear();
+		is_sampled_.clear();
+	}
+	//=================================================================================================//
+}
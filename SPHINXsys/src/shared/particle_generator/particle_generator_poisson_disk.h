@@ -0,0 +1,58 @@
+/**
+ * @file 	particle_generator_poisson_disk.h
+ * @brief 	The Poisson-disk generator samples the interior of the level set of a body
+ *			with blue-noise particle positions, which are much closer to the relaxed
+ *			particle distribution than a lattice cut by the body surface.
+ * @details The samples are thrown as darts in a background grid, whose cell diagonal is the
+ *			minimum distance, so that each cell holds one sample at most. The cells are processed
+ *			in parallel by phase groups, in which the cells are three cells apart,
+ *			so that the concurrent darts never check or write the same cells.
+ *			The first layer is sampled on the level set contour half a particle spacing
+ *			inside the surface, and then the interior is filled.
+ *			The random numbers depend only on the cell and the pass,
+ *			so that the result is independent of the thread scheduling.
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+#pragma once
+
+#include "base_particle_generator.h"
+
+namespace SPH {
+
+	class MeshBackground;
+
+	/**
+	 * @class ParticleGeneratorPoissonDisk
+	 * @brief Generate particles by parallel Poisson-disk sampling in the body level set.
+	 * A background mesh is added to the body if it has none.
+	 */
+	class ParticleGeneratorPoissonDisk : public ParticleGenerator
+	{
+	protected:
+		Real particle_spacing_;			/**< Reference particle spacing. */
+		Real minimum_distance_;			/**< Minimum distance between samples. */
+		Real cell_spacing_;				/**< Cell size of the sampling grid. */
+		Vecd lower_bound_;				/**< Lower bound of the sampling grid. */
+		Vecu number_of_cells_;			/**< Number of cells of the sampling grid. */
+		size_t number_of_passes_;		/**< Passes of dart throwing over all phase groups. */
+		size_t darts_per_cell_;			/**< Darts thrown in a cell in each pass. */
+		StdLargeVec<Vecd> samples_;		/**< Sample of each cell. */
+		StdLargeVec<unsigned char> is_sampled_;	/**< Whether a cell has a sample. */
+
+		size_t transferCellIndexTo1D(Vecu cell_index);
+		Vecu transfer1DtoCellIndex(size_t i);
+		/** Whether the sample is at least the minimum distance from all others. */
+		bool isFarFromSamples(Vecd& position, Vecu cell_index);
+		/** Throw darts in all cells, for the surface layer or for the interior. */
+		void throwDarts(MeshBackground* mesh_background, bool is_surface_layer);
+		/** Estimate the volume of the body from the sampling grid. */
+		Real estimateBodyVolume(MeshBackground* mesh_background);
+	public:
+		ParticleGeneratorPoissonDisk(SPHBody &sph_body);
+		virtual ~ParticleGeneratorPoissonDisk() {};
+
+		/** Create Poisson-disk particles for a body. */
+		virtual void CreateBaseParticles(BaseParticles *base_particles) override;
+	};
+}
@@ -0,0 +1,58 @@
+/**
+ * @file 	particle_generator_voxel.cpp
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+#include "particle_generator_voxel.h"
+#include "base_body.h"
+#include "base_particles.h"
+
+namespace SPH {
+	//=================================================================================================//
+	ParticleGeneratorVoxel
+		::ParticleGeneratorVoxel(SPHBody &sph_body)
+		: ParticleGenerator(sph_body), lattice_spacing_(sph_body.particle_spacing_)
+	{
+		sph_body.BodyBounds(lower_bound_, upper_bound_);
+		for (int i = 0; i != Vecd(0).size(); ++i)
+			number_of_lattices_[i] = size_t(ceil((upper_bound_[i] - lower_bound_[i]) / lattice_spacing_));
+	}
+	//=================================================================================================//
+	void ParticleGeneratorVoxel::CreateBaseParticles(BaseParticles* base_particles)
+	{
+		int dimension = Vecd(0).size();
+		size_t total_lattices = 1;
+		for (int i = 0; i != dimension; ++i) total_lattices *= number_of_lattices_[i];
+
+		/** The first index runs fastest. */
+		auto lattice_position = [&](size_t l) -> Vecd {
+			Vecd position;
+			for (int i = 0; i != dimension; ++i)
+			{
+				position[i] = lower_bound_[i] + (Real(l % number_of_lattices_[i]) + 0.5) * lattice_spacing_;
+				l /= number_of_lattices_[i];
+			}
+			return position;
+		};
+
+		StdVec<unsigned char> is_contained(total_lattices, 0);
+		parallel_for(blocked_range<size_t>(0, total_lattices),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t l = r.begin(); l != r.end(); ++l)
+					is_contained[l] = body_.BodyContain(lattice_position(l)) ? 1 : 0;
+			}, ap);
+
+		size_t number_of_particles = 0;
+		Real vol = powern(lattice_spacing_, dimension);
+		Real sigma = ComputeReferenceNumberDensity(lattice_spacing_);
+		for (size_t l = 0; l != total_lattices; ++l)
+			if (is_contained[l])
+			{
+				base_particles->InitializeABaseParticle(lattice_position(l), vol, sigma);
+				number_of_particles++;
+			}
+
+		body_.number_of_particles_ = number_of_particles;
+	}
+	//=================================================================================================//
+}
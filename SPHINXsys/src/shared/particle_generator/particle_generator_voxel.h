@@ -0,0 +1,33 @@
+/**
+ * @file 	particle_generator_voxel.h
+ * @brief 	The voxel generator generates particles at lattice positions in parallel
+ *			by checking whether the position is contained by the body shape,
+ *			e.g. a voxel shape given by the labels of a segmented image.
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+#pragma once
+
+#include "base_particle_generator.h"
+
+namespace SPH {
+	/**
+	 * @class ParticleGeneratorVoxel
+	 * @brief Generate particles from lattice positions in the body bounds.
+	 * The containment is checked in parallel, then the particles are
+	 * initialized in the lattice order, so that the result is deterministic.
+	 */
+	class ParticleGeneratorVoxel : public ParticleGenerator
+	{
+	protected:
+		Real lattice_spacing_;		/**< Lattice size. */
+		Vecd lower_bound_, upper_bound_;	/**< Domain bounds. */
+		Vecu number_of_lattices_;	/**< Number of lattice. */
+	public:
+		ParticleGeneratorVoxel(SPHBody &sph_body);
+		virtual ~ParticleGeneratorVoxel() {};
+
+		/** Create lattice particle for a body. */
+		virtual void CreateBaseParticles(BaseParticles *base_particles) override;
+	};
+}
@@ -4,4 +4,7 @@ different particle types used in SPHinXsys. **/
 
 #include "fluid_particles.h"
 #include "solid_particles.h"
-#include "diffusion_reaction_particles.h"
\ No newline at end of file
+#include "shell_particles.h"
+#include "diffusion_reaction_particles.h"
+#include "tracer_particles.h"
+#include "neighbor_gather.h"
\ No newline at end of file
@@ -16,6 +16,8 @@
 #include "all_particle_generators.h"
 #include "mesh_cell_linked_list.h"
 
+#include <limits>
+
 
 namespace SPH
 {
@@ -58,6 +60,16 @@ namespace SPH
 			break;
 		}
 
+		case ParticlesGeneratorOps::voxel: {
+			particle_generator = new ParticleGeneratorVoxel(*body);
+			break;
+		}
+
+		case ParticlesGeneratorOps::poisson_disk: {
+			particle_generator = new ParticleGeneratorPoissonDisk(*body);
+			break;
+		}
+
 		default: {
 			std::cout << "\n FAILURE: the type of particle generator is undefined!" << std::endl;
 			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
@@ -75,9 +87,22 @@ namespace SPH
 	BaseParticles::BaseParticles(SPHBody* body)
 		: BaseParticles(body, new BaseMaterial()) {}
 	//=================================================================================================//
+	void BaseParticles::checkParticleIndexRange(size_t particle_index)
+	{
+		if (particle_index >= size_t(std::numeric_limits<ParticleIndex>::max()))
+		{
+			std::cout << "\n Error: the number of particles in the body " << body_name_
+				<< " exceeds the range of the particle index type!" << std::endl;
+			std::cout << " Please reconfigure SPHinXsys without _32BIT_PARTICLE_INDEX_." << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+	}
+	//=================================================================================================//
 	void BaseParticles::InitializeABaseParticle(Vecd pnt, Real Vol_0, Real sigma_0)
 	{
 		size_t particle_index = base_particle_data_.size();
+		checkParticleIndexRange(particle_index);
 		base_particle_data_.push_back(BaseParticleData(pnt, Vol_0, sigma_0));
 		base_particle_data_[particle_index].particle_id_ = particle_index;
 	}
@@ -85,6 +110,7 @@ namespace SPH
 	void BaseParticles::AddABufferParticle()
 	{
 		size_t particle_index = base_particle_data_.size();
+		checkParticleIndexRange(particle_index);
 		base_particle_data_.push_back(BaseParticleData());
 		base_particle_data_[particle_index].particle_id_ = particle_index;
 	}
@@ -96,6 +122,25 @@ namespace SPH
 		base_particle_data_[this_particle_index].particle_id_ = particle_id;
 	}
 	//=================================================================================================//
+	void BaseParticles::copyParticleStates(BaseParticles* duplicated_particles)
+	{
+		base_particle_data_ = duplicated_particles->base_particle_data_;
+		speed_max_ = duplicated_particles->speed_max_;
+		real_particles_bound_ = duplicated_particles->real_particles_bound_;
+		number_of_ghost_particles_ = duplicated_particles->number_of_ghost_particles_;
+	}
+	//=================================================================================================//
+	void BaseParticles::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		memory_usages.push_back(vectorMemoryUsage("base particle data", base_particle_data_));
+		/** The particles beyond the real particles are buffer or ghost particles.
+		  * Their bytes are already in the base particle data, so that only their numbers are reported. */
+		size_t number_of_real_particles = body_->number_of_particles_;
+		size_t number_of_extra_particles = base_particle_data_.size() - number_of_real_particles;
+		memory_usages.push_back(MemoryUsage("buffer and ghost particles", number_of_ghost_particles_,
+			number_of_extra_particles, 0));
+	}
+	//=================================================================================================//
 	void BaseParticles::UpdateFromAnotherParticle(size_t this_particle_index, size_t another_particle_index)
 	{
 		base_particle_data_[this_particle_index].pos_n_ = base_particle_data_[another_particle_index].pos_n_;
@@ -71,6 +71,23 @@ namespace SPH {
 		/** The body in which the particles belongs to. */
 		SPHBody *body_;
 		string body_name_;
+
+		/** Check whether a new particle index can be represented by ParticleIndex. */
+		void checkParticleIndexRange(size_t particle_index);
+		/** Cast duplicated particles to a derived type, exit if they are not of this type. */
+		template<class ParticlesType>
+		ParticlesType* castDuplicatedParticles(BaseParticles* duplicated_particles)
+		{
+			ParticlesType* particles = dynamic_cast<ParticlesType*>(duplicated_particles->PointToThisObject());
+			if (particles == NULL)
+			{
+				std::cout << "\n Error: the duplicated particles of " << duplicated_particles->body_name_
+					<< " are not of the type of the particles of " << body_name_ << "!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+			return particles;
+		};
 	public:
 		/** Base material corresponding to base particles*/
 		BaseMaterial* base_material_;
@@ -99,6 +116,12 @@ namespace SPH {
 		virtual void AddABufferParticle();
 		/** Copy state, except particle id, from another particle */
 		virtual void CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index);
+		/** Duplicate the particles with all their states for in-memory snapshot. */
+		virtual BaseParticles* duplicateParticles() { return new BaseParticles(*this); };
+		/** Copy the states of all particles from a duplicate. */
+		virtual void copyParticleStates(BaseParticles* duplicated_particles);
+		/** Collect the memory usage of particle data. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages);
 		/** Update the state of a particle from another particle */
 		virtual void UpdateFromAnotherParticle(size_t this_particle_index, size_t another_particle_index);
 		/** Swapping particles. */
@@ -125,6 +148,11 @@ namespace SPH {
 		/** Reload particle position and volume from XML files. */
 		virtual void ReadFromXmlForReloadParticle(std::string &filefullpath);
 
+		/** Write the particle states fixed by the reference configuration in binary format. */
+		virtual void WriteReferenceStatesToBinary(ofstream& output_file) {};
+		/** Read the particle states fixed by the reference configuration in binary format. */
+		virtual void ReadReferenceStatesFromBinary(ifstream& input_file) {};
+
 		/** Pointer to this object. */
 		virtual BaseParticles* PointToThisObject();
 
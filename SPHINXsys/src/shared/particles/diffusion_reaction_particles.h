@@ -84,6 +84,23 @@ namespace SPH {
 			BaseParticlesType::CopyFromAnotherParticle(this_particle_index, another_particle_index);
 			diffusion_reaction_data_[this_particle_index] = diffusion_reaction_data_[another_particle_index];
 		};
+		/** Duplicate the particles with all their states for in-memory snapshot. */
+		virtual BaseParticles* duplicateParticles() override {
+			return new DiffusionReactionParticles<BaseParticlesType, BaseMaterialType>(*this);
+		};
+		/** Copy the states of all particles from a duplicate. */
+		virtual void copyParticleStates(BaseParticles* duplicated_particles) override
+		{
+			BaseParticlesType::copyParticleStates(duplicated_particles);
+			diffusion_reaction_data_ = this->template castDuplicatedParticles
+				<DiffusionReactionParticles<BaseParticlesType, BaseMaterialType>>(duplicated_particles)->diffusion_reaction_data_;
+		};
+		/** Collect the memory usage of particle data. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override
+		{
+			BaseParticlesType::collectMemoryUsage(memory_usages);
+			memory_usages.push_back(vectorMemoryUsage("diffusion reaction data", diffusion_reaction_data_));
+		};
 		/** Swapping particles. */
 		virtual void swapParticles(size_t this_particle_index, size_t that_particle_index) override {
 			BaseParticlesType::swapParticles(this_particle_index, that_particle_index);
@@ -148,10 +165,37 @@ namespace SPH {
 		};
 		/** Write particle data in XML format. */
 		virtual void WriteParticlesToXmlFile(std::string& filefullpath) override{};
-		/** Write particle data in XML format for restart. */
-		virtual void WriteParticlesToXmlForRestart(std::string& filefullpath) override {};
+		/** Write particle data in XML format for restart, with the species by their names. */
+		virtual void WriteParticlesToXmlForRestart(std::string& filefullpath) override
+		{
+			unique_ptr<XmlEngine> restart_xml(new XmlEngine("particles_xml", "particles"));
+
+			size_t number_of_particles = this->body_->number_of_particles_;
+			for (size_t i = 0; i != number_of_particles; ++i)
+			{
+				restart_xml->CreatXmlElement("particle");
+				restart_xml->AddAttributeToElement<Vecd>("Position", this->base_particle_data_[i].pos_n_);
+				for (auto& species : species_indexes_map_)
+					restart_xml->AddAttributeToElement<Real>(species.first, diffusion_reaction_data_[i].species_n_[species.second]);
+				restart_xml->AddElementToXmlDoc();
+			}
+			restart_xml->WriteToXmlFile(filefullpath);
+		};
 		/** Initialize particle data from restart xml file. */
-		virtual void ReadParticleFromXmlForRestart(std::string& filefullpath) override {};
+		virtual void ReadParticleFromXmlForRestart(std::string& filefullpath) override
+		{
+			size_t number_of_particles = 0;
+			unique_ptr<XmlEngine> read_xml(new XmlEngine());
+			read_xml->LoadXmlFile(filefullpath);
+			SimTK::Xml::element_iterator ele_ite_ = read_xml->root_element_.element_begin();
+			for (; ele_ite_ != read_xml->root_element_.element_end(); ++ele_ite_)
+			{
+				for (auto& species : species_indexes_map_)
+					diffusion_reaction_data_[number_of_particles].species_n_[species.second]
+						= read_xml->GetRequiredAttributeValue<Real>(ele_ite_, species.first);
+				number_of_particles++;
+			}
+		};
 		/** Pointer to this object. */
 		virtual DiffusionReactionParticles<BaseParticlesType, BaseMaterialType>* 
 			PointToThisObject() override { return this; };
@@ -171,6 +215,9 @@ namespace SPH {
 		/** Destructor. */
 		virtual ~ElectroPhysiologyParticles() {};
 
+		/** Duplicate the particles with all their states for in-memory snapshot. */
+		virtual BaseParticles* duplicateParticles() override { return new ElectroPhysiologyParticles(*this); };
+
 		/** Pointer to this object. */
 		virtual ElectroPhysiologyParticles* PointToThisObject() override { return this; };
 	};
@@ -55,6 +55,20 @@ namespace SPH
 		fluid_particle_data_[this_particle_index] = fluid_particle_data_[another_particle_index];
 	}
 	//=================================================================================================//
+	void FluidParticles::copyParticleStates(BaseParticles* duplicated_particles)
+	{
+		BaseParticles::copyParticleStates(duplicated_particles);
+		FluidParticles* fluid_particles = castDuplicatedParticles<FluidParticles>(duplicated_particles);
+		fluid_particle_data_ = fluid_particles->fluid_particle_data_;
+		signal_speed_max_ = fluid_particles->signal_speed_max_;
+	}
+	//=================================================================================================//
+	void FluidParticles::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		BaseParticles::collectMemoryUsage(memory_usages);
+		memory_usages.push_back(vectorMemoryUsage("fluid particle data", fluid_particle_data_));
+	}
+	//=================================================================================================//
 	void FluidParticles::UpdateFromAnotherParticle(size_t this_particle_index, size_t another_particle_index)
 	{
 		BaseParticles::UpdateFromAnotherParticle(this_particle_index, another_particle_index);
@@ -181,6 +195,19 @@ namespace SPH
 		viscoelastic_particle_data_[this_particle_index] = viscoelastic_particle_data_[another_particle_index];
 	}
 	//=================================================================================================//
+	void ViscoelasticFluidParticles::copyParticleStates(BaseParticles* duplicated_particles)
+	{
+		FluidParticles::copyParticleStates(duplicated_particles);
+		viscoelastic_particle_data_ = castDuplicatedParticles<ViscoelasticFluidParticles>
+			(duplicated_particles)->viscoelastic_particle_data_;
+	}
+	//=================================================================================================//
+	void ViscoelasticFluidParticles::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		FluidParticles::collectMemoryUsage(memory_usages);
+		memory_usages.push_back(vectorMemoryUsage("viscoelastic particle data", viscoelastic_particle_data_));
+	}
+	//=================================================================================================//
 	void ViscoelasticFluidParticles::swapParticles(size_t this_particle_index, size_t that_particle_index)
 	{
 		FluidParticles::swapParticles(this_particle_index, that_particle_index);
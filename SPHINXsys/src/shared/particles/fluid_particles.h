@@ -64,6 +64,12 @@ namespace SPH {
 		virtual void AddABufferParticle() override;
 		/** copy particle data from another particle */
 		virtual void CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index) override;
+		/** Duplicate the particles with all their states for in-memory snapshot. */
+		virtual BaseParticles* duplicateParticles() override { return new FluidParticles(*this); };
+		/** Copy the states of all particles from a duplicate. */
+		virtual void copyParticleStates(BaseParticles* duplicated_particles) override;
+		/** Collect the memory usage of particle data. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override;
 		/** Update the state of a particle from another particle */
 		virtual void UpdateFromAnotherParticle(size_t this_particle_index, size_t another_particle_index) override;
 		/** Swapping particles. */
@@ -122,6 +128,12 @@ namespace SPH {
 		virtual void AddABufferParticle() override;
 		/** copy particle data from another particle */
 		virtual void CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index) override;
+		/** Duplicate the particles with all their states for in-memory snapshot. */
+		virtual BaseParticles* duplicateParticles() override { return new ViscoelasticFluidParticles(*this); };
+		/** Copy the states of all particles from a duplicate. */
+		virtual void copyParticleStates(BaseParticles* duplicated_particles) override;
+		/** Collect the memory usage of particle data. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override;
 		/** Swapping particles. */
 		virtual void swapParticles(size_t this_particle_index, size_t that_particle_index) override;
 
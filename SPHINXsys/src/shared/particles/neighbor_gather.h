@@ -0,0 +1,116 @@
+/**
+ * @file 	neighbor_gather.h
+ * @brief 	Gather of neighbor relations and neighbor particle data
+ *			into small contiguous buffers before a pair interaction loop.
+ * @details The data of a neighbor particle is reached by first loading the
+ *			neighbor relation and then the particle data with the index in the relation.
+ *			These are dependent cache misses in memory-bound neighbor loops.
+ *			Here, the relations of a particle are gathered into contiguous buffers
+ *			with the upcoming relations and particle data prefetched, so that
+ *			the following loop only works on the gathered data.
+ * @author	Xiangyu Hu and Chi Zhang
+ * @version	0.1
+ */
+#pragma once
+
+#include "base_data_package.h"
+#include "sph_data_conainers.h"
+#include "neighbor_relation.h"
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+namespace SPH {
+	/** Number of neighbors by which the particle data is prefetched ahead. */
+	const size_t neighbor_prefetch_distance = 4;
+	/** Maximum number of scalar or vector fields gathered for one loop. */
+	const size_t max_gathered_fields = 4;
+
+	/** Software prefetch of a memory address for reading, no effect if not supported. */
+	inline void prefetchForRead(const void* address)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER)
+		_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#endif
+	}
+
+	/**
+	 * @class NeighborGather
+	 * @brief Contiguous buffers of the neighbor relations and neighbor particle data
+	 * of one particle. The buffers only grow, so that there is no allocation after
+	 * the first few particles. One gather is used by each thread,
+	 * see threadLocalNeighborGather().
+	 */
+	class NeighborGather
+	{
+	public:
+		NeighborGather() : number_of_neighbors_(0) {};
+		virtual ~NeighborGather() {};
+
+		/** Number of gathered neighbors. */
+		size_t number_of_neighbors_;
+		/** Gathered relations. */
+		StdVec<ParticleIndex> j_;
+		StdVec<Real> W_ij_;
+		StdVec<Real> dW_ij_;
+		StdVec<Vecd> e_ij_;
+		StdVec<Real> r_ij_;
+		/** Buffers for the gathered neighbor particle data. */
+		StdVec<Real> scalars_[max_gathered_fields];
+		StdVec<Vecd> vectors_[max_gathered_fields];
+
+		/** Gather the relations of a neighborhood with the upcoming relations prefetched. */
+		void gatherRelations(Neighborhood& neighborhood)
+		{
+			NeighborList& neighbors = std::get<0>(neighborhood);
+			number_of_neighbors_ = std::get<2>(neighborhood);
+			if (j_.size() < number_of_neighbors_)
+			{
+				j_.resize(number_of_neighbors_);
+				W_ij_.resize(number_of_neighbors_);
+				dW_ij_.resize(number_of_neighbors_);
+				e_ij_.resize(number_of_neighbors_);
+				r_ij_.resize(number_of_neighbors_);
+			}
+			for (size_t n = 0; n != number_of_neighbors_; ++n)
+			{
+				if (n + neighbor_prefetch_distance < number_of_neighbors_)
+					prefetchForRead(neighbors[n + neighbor_prefetch_distance]);
+				BaseNeighborRelation* neighboring_particle = neighbors[n];
+				j_[n] = neighboring_particle->j_;
+				W_ij_[n] = neighboring_particle->W_ij_;
+				dW_ij_[n] = neighboring_particle->dW_ij_;
+				e_ij_[n] = neighboring_particle->e_ij_;
+				r_ij_[n] = neighboring_particle->r_ij_;
+			}
+		}
+
+		/**
+		 * @brief Gather a member of the neighbor particle data, e.g.
+		 * gatherField(particles->fluid_particle_data_, &FluidParticleData::p_, scalars_[0]).
+		 * The relations should have been gathered before.
+		 */
+		template <class DataType, typename FieldType>
+		void gatherField(StdLargeVec<DataType>& particle_data,
+			FieldType DataType::* field, StdVec<FieldType>& buffer)
+		{
+			if (buffer.size() < number_of_neighbors_) buffer.resize(number_of_neighbors_);
+			for (size_t n = 0; n != number_of_neighbors_; ++n)
+			{
+				if (n + neighbor_prefetch_distance < number_of_neighbors_)
+					prefetchForRead(&particle_data[j_[n + neighbor_prefetch_distance]]);
+				buffer[n] = particle_data[j_[n]].*field;
+			}
+		}
+	};
+
+	/** The neighbor gather of the calling thread. */
+	inline NeighborGather& threadLocalNeighborGather()
+	{
+		static thread_local NeighborGather neighbor_gather;
+		return neighbor_gather;
+	}
+}
@@ -8,6 +8,7 @@
  */
 #pragma once
 #include "base_data_package.h"
+#include "sph_data_conainers.h"
 
 using namespace std;
 
@@ -26,7 +27,7 @@ namespace SPH {
 	{
 	public:
 		/** Index of the neighbor particle. */
-		size_t j_;
+		ParticleIndex j_;
 		/** kernel function value. */
 		Real W_ij_;
 		/** Derivative of kernel function. */
@@ -48,7 +49,11 @@ namespace SPH {
 		*/
 		BaseNeighborRelation(StdLargeVec<BaseParticleData>& base_particle_data,
 			Kernel& kernel, Vecd& vec_r_ij, size_t i_index, size_t j_index);
-		~BaseNeighborRelation() {};
+		virtual ~BaseNeighborRelation() {};
+		/** The relations are allocated from the huge page pool if the huge pages are switched on,
+		  * so that the relations of neighboring particles are close in memory. */
+		static void* operator new(size_t size) { return HugePagePool::pool().allocate(size); };
+		static void operator delete(void* relation, size_t size) { HugePagePool::pool().deallocate(relation, size); };
 		/**
 		 * @brief Reset the neighboring particles.
 		* @param[in] base_particles Particles with geometric informaiton.
@@ -61,6 +66,25 @@ namespace SPH {
 			Kernel& kernel, Vecd& vec_r_ij, size_t i_index, size_t j_index) = 0;
 		/** reset from a symmetric realtion. */
 		void resetSymmetricRelation(BaseNeighborRelation* symmetic_neigbor_relation, size_t i_index);
+		/** Duplicate the relation, used for in-memory snapshot. */
+		virtual BaseNeighborRelation* duplicateRelation() = 0;
+		/** Bytes allocated for the relation, used for memory reports. */
+		virtual size_t allocatedBytes() = 0;
+		/** Assign from a relation of the same type, used for restoring from in-memory snapshot. */
+		virtual void assignRelation(BaseNeighborRelation* neighbor_relation) = 0;
+		/** Cast a relation to a derived type, exit if it is not of this type. */
+		template<class NeighborRelationType>
+		NeighborRelationType* castRelation(BaseNeighborRelation* neighbor_relation)
+		{
+			NeighborRelationType* relation = dynamic_cast<NeighborRelationType*>(neighbor_relation);
+			if (relation == NULL)
+			{
+				std::cout << "\n Error: the neighbor relation to be assigned is of another type!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+			return relation;
+		};
 
 		/** compute gradient of the kernel function. */
 		virtual Vecd getNablaWij() { return dW_ij_ * e_ij_; };
@@ -73,6 +97,8 @@ namespace SPH {
 	class NeighborRelation : public BaseNeighborRelation
 	{
 	public:
+		/** Default constructor, used for the relations which are not stored, or reset or read later. */
+		NeighborRelation() : BaseNeighborRelation() {};
 		/** Constructor. */
 		NeighborRelation(StdLargeVec<BaseParticleData>& base_particle_data,
 			Kernel& kernel, Vecd& vec_r_ij, size_t i_index, size_t j_index);
@@ -80,6 +106,15 @@ namespace SPH {
 		NeighborRelation(BaseNeighborRelation* symmetic_neigbor_relation, size_t i_index);
 		~NeighborRelation() {};
 
+		/** Duplicate the relation, used for in-memory snapshot. */
+		virtual BaseNeighborRelation* duplicateRelation() override { return new NeighborRelation(*this); };
+		/** Bytes allocated for the relation. */
+		virtual size_t allocatedBytes() override { return HugePagePool::allocatedBytes(sizeof(NeighborRelation)); };
+		/** Assign from a relation of the same type. */
+		virtual void assignRelation(BaseNeighborRelation* neighbor_relation) override {
+			*this = *castRelation<NeighborRelation>(neighbor_relation);
+		};
+
 		/** Reset the neighboring particles. */
 		virtual void resetRelation(StdLargeVec<BaseParticleData>& base_particle_data,
 			Kernel& kernel, Vecd& vec_r_ij, size_t i_index, size_t j_index) override;
@@ -92,6 +127,8 @@ namespace SPH {
 	class NeighborRelationWithVariableSmoothingLength : public BaseNeighborRelation
 	{
 	public:
+		/** Default constructor, used for the relations which are reset or read later. */
+		NeighborRelationWithVariableSmoothingLength() : BaseNeighborRelation() {};
 		/** Constructor. */
 		NeighborRelationWithVariableSmoothingLength(StdLargeVec<BaseParticleData>& base_particle_data,
 			Kernel& kernel, Vecd& vec_r_ij, size_t i_index, size_t j_index);
@@ -99,8 +136,26 @@ namespace SPH {
 		NeighborRelationWithVariableSmoothingLength(BaseNeighborRelation* symmetic_neigbor_relation, size_t i_index);
 		~NeighborRelationWithVariableSmoothingLength() {};
 
+		/** Duplicate the relation, used for in-memory snapshot. */
+		virtual BaseNeighborRelation* duplicateRelation() override { return new NeighborRelationWithVariableSmoothingLength(*this); };
+		/** Bytes allocated for the relation. */
+		virtual size_t allocatedBytes() override {
+			return HugePagePool::allocatedBytes(sizeof(NeighborRelationWithVariableSmoothingLength));
+		};
+		/** Assign from a relation of the same type. */
+		virtual void assignRelation(BaseNeighborRelation* neighbor_relation) override {
+			*this = *castRelation<NeighborRelationWithVariableSmoothingLength>(neighbor_relation);
+		};
+
 		/** Reset the neighboring particles. */
 		virtual void resetRelation(StdLargeVec<BaseParticleData>& base_particle_data,
 			Kernel& kernel, Vecd& r_ij, size_t i_index, size_t j_index) override;
 	};
+
+	/** The index of a relation is padded to the alignment of Real with both index types,
+	  * and a relation takes a cache line, i.e. a 64-byte block of the huge page pool. */
+	static_assert(sizeof(BaseNeighborRelation) == sizeof(void*) + sizeof(Real)
+		+ 3 * sizeof(Real) + sizeof(Vecd), "Unexpected padding in a neighbor relation.");
+	static_assert(sizeof(NeighborRelation) <= 64 && sizeof(NeighborRelationWithVariableSmoothingLength) <= 64,
+		"A neighbor relation should fit in a cache line.");
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+/**
+ * @file 	shell_particles.cpp
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+#include "shell_particles.h"
+#include "base_body.h"
+#include "elastic_solid.h"
+
+namespace SPH {
+	//=================================================================================================//
+	ShellParticleData::ShellParticleData(Real thickness)
+		: thickness_(thickness), dn_dt_(0), dn_dt2_(0),
+		F_bending_(0), dF_bending_dt_(0), moment_(0)
+	{
+
+	}
+	//=================================================================================================//
+	ShellParticles::ShellParticles(SPHBody* body, ElasticSolid* elastic_solid, Real thickness)
+		: ElasticSolidParticles(body, elastic_solid)
+	{
+		Vecd initial_normal(0);
+		initial_normal[Vecd(0).size() - 1] = 1.0;
+		for (size_t i = 0; i < base_particle_data_.size(); ++i)
+		{
+			shell_data_.push_back(ShellParticleData(thickness));
+			solid_body_data_[i].n_0_ = initial_normal;
+			solid_body_data_[i].n_ = initial_normal;
+			/** The mass is that of the mid-surface area times the thickness. */
+			elastic_body_data_[i].mass_ = elastic_body_data_[i].rho_0_
+				* base_particle_data_[i].Vol_ * thickness / body->particle_spacing_;
+		}
+	}
+	//=================================================================================================//
+	void ShellParticles::AddABufferParticle()
+	{
+		ElasticSolidParticles::AddABufferParticle();
+		/** The thickness is copied when the buffer particle is realized. */
+		shell_data_.push_back(ShellParticleData(0.0));
+	}
+	//=================================================================================================//
+	void ShellParticles
+		::CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index)
+	{
+		ElasticSolidParticles::CopyFromAnotherParticle(this_particle_index, another_particle_index);
+		shell_data_[this_particle_index] = shell_data_[another_particle_index];
+	}
+	//=================================================================================================//
+	void ShellParticles::copyParticleStates(BaseParticles* duplicated_particles)
+	{
+		ElasticSolidParticles::copyParticleStates(duplicated_particles);
+		shell_data_ = castDuplicatedParticles<ShellParticles>(duplicated_particles)->shell_data_;
+	}
+	//=================================================================================================//
+	void ShellParticles::swapParticles(size_t this_particle_index, size_t that_particle_index)
+	{
+		ElasticSolidParticles::swapParticles(this_particle_index, that_particle_index);
+		std::swap(shell_data_[this_particle_index], shell_data_[that_particle_index]);
+	}
+	//=================================================================================================//
+	void ShellParticles::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		ElasticSolidParticles::collectMemoryUsage(memory_usages);
+		memory_usages.push_back(vectorMemoryUsage("shell data", shell_data_));
+	}
+	//=================================================================================================//
+	ShellParticles* ShellParticles::PointToThisObject()
+	{
+		return this;
+	}
+	//=================================================================================================//
+	void ShellParticles::WriteParticlesToVtuFile(ofstream& output_file)
+	{
+		ElasticSolidParticles::WriteParticlesToVtuFile(output_file);
+
+		size_t number_of_particles = body_->number_of_particles_;
+
+		output_file << "    <DataArray Name=\"Thickness\" type=\"Float32\" Format=\"ascii\">\n";
+		output_file << "    ";
+		for (size_t i = 0; i != number_of_particles; ++i) {
+			output_file << fixed << setprecision(9) << shell_data_[i].thickness_ << " ";
+		}
+		output_file << std::endl;
+		output_file << "    </DataArray>\n";
+	}
+	//=================================================================================================//
+	void ShellParticles::WriteParticlesToXmlForRestart(std::string& filefullpath)
+	{
+		unique_ptr<XmlEngine> restart_xml(new XmlEngine("particles_xml", "particles"));
+
+		size_t number_of_particles = body_->number_of_particles_;
+		for (size_t i = 0; i != number_of_particles; ++i)
+		{
+			restart_xml->CreatXmlElement("particle");
+			restart_xml->AddAttributeToElement<Vecd>("Position", base_particle_data_[i].pos_n_);
+			restart_xml->AddAttributeToElement<Vecd>("InitialPosition", base_particle_data_[i].pos_0_);
+			restart_xml->AddAttributeToElement<Real>("Volume", base_particle_data_[i].Vol_);
+			restart_xml->AddAttributeToElement<Real>("Density", elastic_body_data_[i].rho_n_);
+			restart_xml->AddAttributeToElement<Vecd>("Velocity", base_particle_data_[i].vel_n_);
+			restart_xml->AddAttributeToElement<Vecd>("Displacement", elastic_body_data_[i].pos_temp_);
+			restart_xml->AddAttributeToElement("DefTensor", elastic_body_data_[i].F_);
+			restart_xml->AddAttributeToElement<Vecd>("PseudoNormal", solid_body_data_[i].n_);
+			restart_xml->AddAttributeToElement<Vecd>("PseudoNormalChangeRate", shell_data_[i].dn_dt_);
+			restart_xml->AddAttributeToElement("BendingDefTensor", shell_data_[i].F_bending_);
+			restart_xml->AddElementToXmlDoc();
+		}
+		restart_xml->WriteToXmlFile(filefullpath);
+	}
+	//=================================================================================================//
+	void ShellParticles::ReadParticleFromXmlForRestart(std::string& filefullpath)
+	{
+		size_t number_of_particles = 0;
+		unique_ptr<XmlEngine> read_xml(new XmlEngine());
+		read_xml->LoadXmlFile(filefullpath);
+		SimTK::Xml::element_iterator ele_ite_ = read_xml->root_element_.element_begin();
+		for (; ele_ite_ != read_xml->root_element_.element_end(); ++ele_ite_)
+		{
+			base_particle_data_[number_of_particles].pos_n_
+				= read_xml->GetRequiredAttributeValue<Vecd>(ele_ite_, "Position");
+			base_particle_data_[number_of_particles].pos_0_
+				= read_xml->GetRequiredAttributeValue<Vecd>(ele_ite_, "InitialPosition");
+			base_particle_data_[number_of_particles].Vol_
+				= read_xml->GetRequiredAttributeValue<Real>(ele_ite_, "Volume");
+			base_particle_data_[number_of_particles].vel_n_
+				= read_xml->GetRequiredAttributeValue<Vecd>(ele_ite_, "Velocity");
+			elastic_body_data_[number_of_particles].rho_n_
+				= read_xml->GetRequiredAttributeValue<Real>(ele_ite_, "Density");
+			elastic_body_data_[number_of_particles].pos_temp_
+				= read_xml->GetRequiredAttributeValue<Vecd>(ele_ite_, "Displacement");
+			elastic_body_data_[number_of_particles].F_
+				= read_xml->GetRequiredAttributeMatrixValue(ele_ite_, "DefTensor");
+			solid_body_data_[number_of_particles].n_
+				= read_xml->GetRequiredAttributeValue<Vecd>(ele_ite_, "PseudoNormal");
+			shell_data_[number_of_particles].dn_dt_
+				= read_xml->GetRequiredAttributeValue<Vecd>(ele_ite_, "PseudoNormalChangeRate");
+			shell_data_[number_of_particles].F_bending_
+				= read_xml->GetRequiredAttributeMatrixValue(ele_ite_, "BendingDefTensor");
+			number_of_particles++;
+		}
+	}
+	//=================================================================================================//
+	void ShellParticles::WriteReferenceStatesToBinary(ofstream& output_file)
+	{
+		ElasticSolidParticles::WriteReferenceStatesToBinary(output_file);
+		/** The initial normals are set by the initial condition of a curved shell. */
+		for (size_t i = 0; i != body_->number_of_particles_; ++i)
+			output_file.write(reinterpret_cast<const char*>(&solid_body_data_[i].n_0_), sizeof(Vecd));
+	}
+	//=================================================================================================//
+	void ShellParticles::ReadReferenceStatesFromBinary(ifstream& input_file)
+	{
+		ElasticSolidParticles::ReadReferenceStatesFromBinary(input_file);
+		for (size_t i = 0; i != body_->number_of_particles_; ++i)
+			input_file.read(reinterpret_cast<char*>(&solid_body_data_[i].n_0_), sizeof(Vecd));
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,81 @@
+/**
+ * @file 	shell_particles.h
+ * @brief 	This is the derived class of elastic solid particles for thin structures,
+ *			such as plates, membranes and vessel walls, represented by a single layer of particles.
+ * @details The shell is given by its mid-surface particles with a pseudo-normal,
+ *			i.e. the deformed direction of the initial surface normal, and a thickness.
+ *			The volume of a particle is that of a lattice particle, so that the kernel corrections
+ *			are used as for other solids, while the mass is given by the thickness.
+ * @author	Chi Zhang and Xiangyu Hu
+ * @version	0.1
+ */
+#pragma once
+
+#include "solid_particles.h"
+
+namespace SPH {
+
+	/**
+	 * @class ShellParticleData
+	 * @brief Data for shell particles.
+	 * The pseudo-normal is the normal direction n_ of the solid particle data.
+	 */
+	class ShellParticleData
+	{
+	public:
+		ShellParticleData(Real thickness);
+		virtual ~ShellParticleData() {};
+
+		/** thickness of the shell. */
+		Real thickness_;
+		/** change rate and its rate of the pseudo-normal. */
+		Vecd dn_dt_, dn_dt2_;
+		/** gradient of the pseudo-normal on the mid-surface, and its change rate. */
+		Matd F_bending_, dF_bending_dt_;
+		/** bending moment resultant through the thickness. */
+		Matd moment_;
+	};
+
+	/**
+	 * @class ShellParticles
+	 * @brief A group of particles with shell particle data.
+	 * The initial normal direction is the last coordinate direction,
+	 * which is changed by a shell initial condition for a curved shell.
+	 */
+	class ShellParticles : public ElasticSolidParticles
+	{
+	public:
+		ShellParticles(SPHBody* body, ElasticSolid* elastic_solid, Real thickness);
+		virtual ~ShellParticles() {};
+
+		/** Vector of shell particle data. */
+		StdLargeVec<ShellParticleData> shell_data_;
+
+		/** add buffer particles which latter may be realized for particle dynamics*/
+		virtual void AddABufferParticle() override;
+		/** Copy state from another particle */
+		virtual void CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index) override;
+		/** Duplicate the particles with all their states for in-memory snapshot. */
+		virtual BaseParticles* duplicateParticles() override { return new ShellParticles(*this); };
+		/** Copy the states of all particles from a duplicate. */
+		virtual void copyParticleStates(BaseParticles* duplicated_particles) override;
+		/** Collect the memory usage of particle data. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override;
+		/** Swapping particles. */
+		virtual void swapParticles(size_t this_particle_index, size_t that_particle_index) override;
+
+		/** Write particle data in VTU format for Paraview. */
+		virtual void WriteParticlesToVtuFile(ofstream& output_file) override;
+		/** Write particle data in XML format for restart, including the pseudo-normal and its gradient. */
+		virtual void WriteParticlesToXmlForRestart(std::string& filefullpath) override;
+		/** Initialize particle data from restart xml file. */
+		virtual void ReadParticleFromXmlForRestart(std::string& filefullpath) override;
+		/** Write the correction matrices and the initial normals in binary format. */
+		virtual void WriteReferenceStatesToBinary(ofstream& output_file) override;
+		/** Read the correction matrices and the initial normals in binary format. */
+		virtual void ReadReferenceStatesFromBinary(ifstream& input_file) override;
+
+		/** Pointer to this object.  */
+		virtual ShellParticles* PointToThisObject() override;
+	};
+}
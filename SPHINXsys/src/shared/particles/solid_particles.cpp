@@ -14,7 +14,7 @@ namespace SPH {
 //=============================================================================================//
 	SolidParticleData::SolidParticleData(Vecd position)
 		: n_0_(0), n_(0), B_(1.0), vel_ave_(0), dvel_dt_ave_(0),
-		viscous_force_from_fluid_(0), force_from_fluid_(0)
+		viscous_force_from_fluid_(0), force_from_fluid_(0), fluid_force_scaling_(1.0)
 	{
 
 	}
@@ -110,6 +110,12 @@ namespace SPH {
 		solid_body_data_[this_particle_index] = solid_body_data_[another_particle_index];
 	}
 	//===============================================================//
+	void SolidParticles::copyParticleStates(BaseParticles* duplicated_particles)
+	{
+		BaseParticles::copyParticleStates(duplicated_particles);
+		solid_body_data_ = castDuplicatedParticles<SolidParticles>(duplicated_particles)->solid_body_data_;
+	}
+	//===============================================================//
 	void SolidParticles::swapParticles(size_t this_particle_index, size_t that_particle_index)
 	{
 		BaseParticles::swapParticles(this_particle_index, that_particle_index);
@@ -121,6 +127,12 @@ namespace SPH {
 		return this;
 	}
 	//=================================================================================================//
+	void SolidParticles::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		BaseParticles::collectMemoryUsage(memory_usages);
+		memory_usages.push_back(vectorMemoryUsage("solid body data", solid_body_data_));
+	}
+	//=================================================================================================//
 	void SolidParticles::WriteParticlesToXmlForRestart(std::string &filefullpath)
 	{
 		unique_ptr<XmlEngine> restart_xml(new XmlEngine("particles_xml", "particles"));
@@ -143,6 +155,18 @@ namespace SPH {
 		/** Nothing should be done for non-moving BCs. */
 	}
 	//=================================================================================================//	
+	void SolidParticles::WriteReferenceStatesToBinary(ofstream& output_file)
+	{
+		for (size_t i = 0; i != body_->number_of_particles_; ++i)
+			output_file.write(reinterpret_cast<const char*>(&solid_body_data_[i].B_), sizeof(Matd));
+	}
+	//=================================================================================================//
+	void SolidParticles::ReadReferenceStatesFromBinary(ifstream& input_file)
+	{
+		for (size_t i = 0; i != body_->number_of_particles_; ++i)
+			input_file.read(reinterpret_cast<char*>(&solid_body_data_[i].B_), sizeof(Matd));
+	}
+	//=================================================================================================//	
 	Vecd SolidParticles::normalizeGradient(size_t particle_index_i, Vecd& gradient) 
 	{
 		Matd&   B_i = solid_body_data_[particle_index_i].B_;
@@ -164,6 +188,13 @@ namespace SPH {
 			elastic_body_data_.push_back(ElasticSolidParticleData(base_particle_data_[i], elastic_solid));
 	}
 	//===============================================================//
+	void ElasticSolidParticles::AddABufferParticle()
+	{
+		SolidParticles::AddABufferParticle();
+		elastic_body_data_.push_back(ElasticSolidParticleData(base_particle_data_.back(),
+			static_cast<ElasticSolid*>(base_material_)));
+	}
+	//===============================================================//
 	void ElasticSolidParticles
 		::CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index)
 	{
@@ -171,6 +202,12 @@ namespace SPH {
 		elastic_body_data_[this_particle_index] = elastic_body_data_[another_particle_index];
 	}
 	//===============================================================//
+	void ElasticSolidParticles::copyParticleStates(BaseParticles* duplicated_particles)
+	{
+		SolidParticles::copyParticleStates(duplicated_particles);
+		elastic_body_data_ = castDuplicatedParticles<ElasticSolidParticles>(duplicated_particles)->elastic_body_data_;
+	}
+	//===============================================================//
 	void ElasticSolidParticles::swapParticles(size_t this_particle_index, size_t that_particle_index)
 	{
 		SolidParticles::swapParticles(this_particle_index, that_particle_index);
@@ -182,6 +219,12 @@ namespace SPH {
 		return this;
 	}
 	//=================================================================================================//
+	void ElasticSolidParticles::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		SolidParticles::collectMemoryUsage(memory_usages);
+		memory_usages.push_back(vectorMemoryUsage("elastic body data", elastic_body_data_));
+	}
+	//=================================================================================================//
 	void ElasticSolidParticles::WriteParticlesToVtuFile(ofstream& output_file)
 	{
 		SolidParticles::WriteParticlesToVtuFile(output_file);
@@ -266,6 +309,12 @@ namespace SPH {
 		active_muscle_data_[this_particle_index] = active_muscle_data_[another_particle_index];
 	}
 	//=============================================================================================//
+	void ActiveMuscleParticles::copyParticleStates(BaseParticles* duplicated_particles)
+	{
+		ElasticSolidParticles::copyParticleStates(duplicated_particles);
+		active_muscle_data_ = castDuplicatedParticles<ActiveMuscleParticles>(duplicated_particles)->active_muscle_data_;
+	}
+	//=============================================================================================//
 	void ActiveMuscleParticles::swapParticles(size_t this_particle_index, size_t that_particle_index)
 	{
 		ElasticSolidParticles::swapParticles(this_particle_index, that_particle_index);
@@ -292,6 +341,12 @@ namespace SPH {
 		output_file << "    </DataArray>\n";
 	}
 	//=================================================================================================//
+	void ActiveMuscleParticles::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		ElasticSolidParticles::collectMemoryUsage(memory_usages);
+		memory_usages.push_back(vectorMemoryUsage("active muscle data", active_muscle_data_));
+	}
+	//=================================================================================================//
 	void ActiveMuscleParticles::WriteParticlesToXmlForRestart(std::string& filefullpath)
 	{
 		unique_ptr<XmlEngine> restart_xml(new XmlEngine("particles_xml", "particles"));
@@ -41,6 +41,9 @@ namespace SPH {
 		Vecd vel_ave_, dvel_dt_ave_;	
 		/** Forces from fluid. */
 		Vecd force_from_fluid_, viscous_force_from_fluid_;	
+		/** Scaling of the fluid-solid interaction, which is not unity only
+		  * for a single layer of particles as a wall, i.e. a shell. */
+		Real fluid_force_scaling_;
 	};
 
 	/**
@@ -91,6 +94,12 @@ namespace SPH {
 		virtual void AddABufferParticle() override;
 		/** Copy state from another particle */
 		virtual void CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index) override;
+		/** Duplicate the particles with all their states for in-memory snapshot. */
+		virtual BaseParticles* duplicateParticles() override { return new SolidParticles(*this); };
+		/** Copy the states of all particles from a duplicate. */
+		virtual void copyParticleStates(BaseParticles* duplicated_particles) override;
+		/** Collect the memory usage of particle data. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override;
 		/** Swapping particles. */
 		virtual void swapParticles(size_t this_particle_index, size_t that_particle_index) override;
 
@@ -128,6 +137,10 @@ namespace SPH {
 		 * @param[inout] filefullpath Full path to file being write.
 		 */	
 		virtual void ReadFromXmlForReloadParticle(std::string &filefullpath) override;
+		/** Write the correction matrices in binary format. */
+		virtual void WriteReferenceStatesToBinary(ofstream& output_file) override;
+		/** Read the correction matrices in binary format. */
+		virtual void ReadReferenceStatesFromBinary(ifstream& input_file) override;
 		/** Pointer to this object. */
 		virtual SolidParticles* PointToThisObject() override;
 		/** Normalize a gradient. */
@@ -160,8 +173,16 @@ namespace SPH {
 		/** Vector of elastic solid particle data. */
 		StdLargeVec<ElasticSolidParticleData> elastic_body_data_;
 
+		/** add buffer particles which latter may be realized for particle dynamics*/
+		virtual void AddABufferParticle() override;
 		/** Copy state from another particle */
 		virtual void CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index) override;
+		/** Duplicate the particles with all their states for in-memory snapshot. */
+		virtual BaseParticles* duplicateParticles() override { return new ElasticSolidParticles(*this); };
+		/** Copy the states of all particles from a duplicate. */
+		virtual void copyParticleStates(BaseParticles* duplicated_particles) override;
+		/** Collect the memory usage of particle data. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override;
 		/** Swapping particles. */
 		virtual void swapParticles(size_t this_particle_index, size_t that_particle_index) override;
 
@@ -230,6 +251,12 @@ namespace SPH {
 
 		/** Copy state from another particle */
 		virtual void CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index) override;
+		/** Duplicate the particles with all their states for in-memory snapshot. */
+		virtual BaseParticles* duplicateParticles() override { return new ActiveMuscleParticles(*this); };
+		/** Copy the states of all particles from a duplicate. */
+		virtual void copyParticleStates(BaseParticles* duplicated_particles) override;
+		/** Collect the memory usage of particle data. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override;
 		/** Swapping particles. */
 		virtual void swapParticles(size_t this_particle_index, size_t that_particle_index) override;
 
@@ -0,0 +1,184 @@
+/**
+ * @file tracer_particles.cpp
+ * @author	Xiangyu Hu and Chi Zhang
+ * @version	0.1
+ */
+
+#include "tracer_particles.h"
+#include "base_body.h"
+
+namespace SPH
+{
+	//=================================================================================================//
+	TracerParticles::TracerParticles(SPHBody *body)
+		: BaseParticles(body)
+	{
+		tracer_particle_data_.reserve(base_particle_data_.size());
+		for (size_t i = 0; i != base_particle_data_.size(); ++i)
+			tracer_particle_data_.push_back(TracerParticleData(base_particle_data_[i].pos_n_));
+		/** the generated base particle data are not used any more */
+		StdLargeVec<BaseParticleData>().swap(base_particle_data_);
+	}
+	//=================================================================================================//
+	TracerParticles* TracerParticles::PointToThisObject()
+	{
+		return this;
+	}
+	//=================================================================================================//
+	void TracerParticles::AddABufferParticle()
+	{
+		checkParticleIndexRange(tracer_particle_data_.size());
+		tracer_particle_data_.push_back(TracerParticleData());
+	}
+	//=================================================================================================//
+	void TracerParticles::CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index)
+	{
+		tracer_particle_data_[this_particle_index] = tracer_particle_data_[another_particle_index];
+	}
+	//=================================================================================================//
+	void TracerParticles::copyParticleStates(BaseParticles* duplicated_particles)
+	{
+		BaseParticles::copyParticleStates(duplicated_particles);
+		TracerParticles* tracer_particles = castDuplicatedParticles<TracerParticles>(duplicated_particles);
+		tracer_particle_data_ = tracer_particles->tracer_particle_data_;
+	}
+	//=================================================================================================//
+	void TracerParticles::collectMemoryUsage(MemoryUsageList& memory_usages)
+	{
+		memory_usages.push_back(vectorMemoryUsage("tracer particle data", tracer_particle_data_));
+	}
+	//=================================================================================================//
+	void TracerParticles::UpdateFromAnotherParticle(size_t this_particle_index, size_t another_particle_index)
+	{
+		tracer_particle_data_[this_particle_index].pos_ = tracer_particle_data_[another_particle_index].pos_;
+		tracer_particle_data_[this_particle_index].vel_ = tracer_particle_data_[another_particle_index].vel_;
+	}
+	//=================================================================================================//
+	void TracerParticles::swapParticles(size_t this_particle_index, size_t that_particle_index)
+	{
+		std::swap(tracer_particle_data_[this_particle_index], tracer_particle_data_[that_particle_index]);
+	}
+	//=================================================================================================//
+	void TracerParticles::WriteParticlesToVtuFile(ofstream& output_file)
+	{
+		size_t number_of_particles = body_->number_of_particles_;
+
+		//write coordinates of particles
+		output_file << "   <Points>\n";
+		output_file << "    <DataArray Name=\"Position\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
+		output_file << "    ";
+		for (size_t i = 0; i != number_of_particles; ++i) {
+			Vec3d particle_position = upgradeToVector3D(tracer_particle_data_[i].pos_);
+			output_file << particle_position[0] << " " << particle_position[1] << " " << particle_position[2] << " ";
+		}
+		output_file << std::endl;
+		output_file << "    </DataArray>\n";
+		output_file << "   </Points>\n";
+
+		//write data of particles
+		output_file << "   <PointData  Vectors=\"vector\">\n";
+		output_file << "    <DataArray Name=\"Particle_ID\" type=\"Int32\" Format=\"ascii\">\n";
+		output_file << "    ";
+		for (size_t i = 0; i != number_of_particles; ++i) {
+			output_file << i << " ";
+		}
+		output_file << std::endl;
+		output_file << "    </DataArray>\n";
+
+		output_file << "    <DataArray Name=\"Velocity\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
+		output_file << "    ";
+		for (size_t i = 0; i != number_of_particles; ++i) {
+			Vec3d particle_velocity = upgradeToVector3D(tracer_particle_data_[i].vel_);
+			output_file << particle_velocity[0] << " " << particle_velocity[1] << " " << particle_velocity[2] << " ";
+		}
+		output_file << std::endl;
+		output_file << "    </DataArray>\n";
+
+		output_file << "    <DataArray Name=\"Residence Time\" type=\"Float32\" Format=\"ascii\">\n";
+		output_file << "    ";
+		for (size_t i = 0; i != number_of_particles; ++i) {
+			output_file << tracer_particle_data_[i].residence_time_ << " ";
+		}
+		output_file << std::endl;
+		output_file << "    </DataArray>\n";
+
+		output_file << "    <DataArray Name=\"In Host\" type=\"Int32\" Format=\"ascii\">\n";
+		output_file << "    ";
+		for (size_t i = 0; i != number_of_particles; ++i) {
+			output_file << tracer_particle_data_[i].is_in_host_ << " ";
+		}
+		output_file << std::endl;
+		output_file << "    </DataArray>\n";
+	}
+	//=================================================================================================//
+	void TracerParticles::WriteParticlesToXmlForRestart(std::string &filefullpath)
+	{
+		const SimTK::String xml_name("particles_xml"), ele_name("particles");
+		unique_ptr<XmlEngine> restart_xml(new XmlEngine(xml_name, ele_name));
+
+		size_t number_of_particles = body_->number_of_particles_;
+		for (size_t i = 0; i != number_of_particles; ++i)
+		{
+			restart_xml->CreatXmlElement("particle");
+			restart_xml->AddAttributeToElement<Vecd>("Position", tracer_particle_data_[i].pos_);
+			restart_xml->AddAttributeToElement<Vecd>("Velocity", tracer_particle_data_[i].vel_);
+			restart_xml->AddAttributeToElement<Real>("ResidenceTime", tracer_particle_data_[i].residence_time_);
+			restart_xml->AddAttributeToElement<int>("InHost", int(tracer_particle_data_[i].is_in_host_));
+			restart_xml->AddElementToXmlDoc();
+		}
+		restart_xml->WriteToXmlFile(filefullpath);
+	}
+	//=================================================================================================//
+	void TracerParticles::ReadParticleFromXmlForRestart(std::string &filefullpath)
+	{
+		size_t number_of_particles = 0;
+		unique_ptr<XmlEngine> read_xml(new XmlEngine());
+		read_xml->LoadXmlFile(filefullpath);
+		SimTK::Xml::element_iterator ele_ite_ = read_xml->root_element_.element_begin();
+		for (; ele_ite_ != read_xml->root_element_.element_end(); ++ele_ite_)
+		{
+			TracerParticleData& tracer_particle_data_i = tracer_particle_data_[number_of_particles];
+			tracer_particle_data_i.pos_ = read_xml->GetRequiredAttributeValue<Vecd>(ele_ite_, "Position");
+			tracer_particle_data_i.vel_ = read_xml->GetRequiredAttributeValue<Vecd>(ele_ite_, "Velocity");
+			tracer_particle_data_i.residence_time_ = read_xml->GetRequiredAttributeValue<Real>(ele_ite_, "ResidenceTime");
+			tracer_particle_data_i.is_in_host_ = read_xml->GetRequiredAttributeValue<int>(ele_ite_, "InHost") != 0;
+			number_of_particles++;
+		}
+	}
+	//=================================================================================================//
+	void TracerParticles::WriteToXmlForReloadParticle(std::string &filefullpath)
+	{
+		const SimTK::String xml_name("particles_xml"), ele_name("particles");
+		unique_ptr<XmlEngine> reload_xml(new XmlEngine(xml_name, ele_name));
+
+		for (size_t i = 0; i != body_->number_of_particles_; ++i)
+		{
+			reload_xml->CreatXmlElement("particle");
+			reload_xml->AddAttributeToElement<Vecd>("Position", tracer_particle_data_[i].pos_);
+			reload_xml->AddElementToXmlDoc();
+		}
+		reload_xml->WriteToXmlFile(filefullpath);
+	}
+	//=================================================================================================//
+	void TracerParticles::ReadFromXmlForReloadParticle(std::string &filefullpath)
+	{
+		size_t number_of_particles = 0;
+		unique_ptr<XmlEngine> read_xml(new XmlEngine());
+		read_xml->LoadXmlFile(filefullpath);
+		SimTK::Xml::element_iterator ele_ite_ = read_xml->root_element_.element_begin();
+		for (; ele_ite_ != read_xml->root_element_.element_end(); ++ele_ite_)
+		{
+			Vecd position = read_xml->GetRequiredAttributeValue<Vecd>(ele_ite_, "Position");
+			tracer_particle_data_[number_of_particles].pos_ = position;
+			number_of_particles++;
+		}
+
+		if (number_of_particles != tracer_particle_data_.size())
+		{
+			std::cout << "\n Error: reload particle number does not matrch" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,87 @@
+/**
+ * @file 	tracer_particles.h
+ * @brief 	This is the derived class of base particle for passive tracers.
+ * @author	Xiangyu Hu and Chi Zhang
+ * @version	0.1
+ */
+#pragma once
+
+#include "base_particles.h"
+#include "xml_engine.h"
+
+#include <fstream>
+using namespace std;
+
+namespace SPH {
+
+	/**
+	 * @class TracerParticleData
+	 * @brief Compact data for passive tracer particles.
+	 * Without virtual functions, only the position, the velocity and the scalars are stored.
+	 */
+	class TracerParticleData
+	{
+	public:
+		TracerParticleData() : pos_(0), vel_(0), residence_time_(0.0), is_in_host_(false) {};
+		explicit TracerParticleData(Vecd position)
+			: pos_(position), vel_(0), residence_time_(0.0), is_in_host_(false) {};
+
+		/** Position of the tracer. */
+		Vecd pos_;
+		/** Velocity interpolated from the host fluid. */
+		Vecd vel_;
+		/** Time the tracer has spent in the host fluid. */
+		Real residence_time_;
+		/** The tracer is in the host fluid if there are host particles around. */
+		bool is_in_host_;
+	};
+
+	/**
+	 * @class TracerParticles
+	 * @brief Passive tracer particles, which carry the position,
+	 * the velocity interpolated from the host and a few scalars only.
+	 * @details The tracers are generated as base particles, whose data are then moved
+	 * to the compact tracer particle data and released. Therefore, the base particle data are empty,
+	 * and the tracers have their own writers and are not used by the dynamics of other particles.
+	 * As the tracer body has neither cell linked list nor ghost particles, the tracers are not sorted.
+	 */
+	class TracerParticles : public BaseParticles
+	{
+	public:
+		explicit TracerParticles(SPHBody *body);
+		virtual ~TracerParticles() {};
+
+		/** vector of tracer particle data. */
+		StdLargeVec<TracerParticleData> tracer_particle_data_;
+
+		/** add buffer particles which latter may be realized for particle dynamics*/
+		virtual void AddABufferParticle() override;
+		/** copy particle data from another particle */
+		virtual void CopyFromAnotherParticle(size_t this_particle_index, size_t another_particle_index) override;
+		/** Duplicate the particles with all their states for in-memory snapshot. */
+		virtual BaseParticles* duplicateParticles() override { return new TracerParticles(*this); };
+		/** Copy the states of all particles from a duplicate. */
+		virtual void copyParticleStates(BaseParticles* duplicated_particles) override;
+		/** Collect the memory usage of particle data. */
+		virtual void collectMemoryUsage(MemoryUsageList& memory_usages) override;
+		/** Update the position and velocity from another particle. */
+		virtual void UpdateFromAnotherParticle(size_t this_particle_index, size_t another_particle_index) override;
+		/** Swapping particles. */
+		virtual void swapParticles(size_t this_particle_index, size_t that_particle_index) override;
+
+		/** Write particle data in VTU format for Paraview. */
+		virtual void WriteParticlesToVtuFile(ofstream &output_file) override;
+
+		/** Write particle data in XML format for restart. */
+		virtual void WriteParticlesToXmlForRestart(std::string &filefullpath) override;
+		/** Initialize particle data from restart xml file. */
+		virtual void ReadParticleFromXmlForRestart(std::string &filefullpath) override;
+		/** Write the tracer positions in XML format for reloading. */
+		virtual void WriteToXmlForReloadParticle(std::string &filefullpath) override;
+		/** Reload the tracer positions from XML format. */
+		virtual void ReadFromXmlForReloadParticle(std::string &filefullpath) override;
+
+		/** Pointer to this object. */
+		virtual TracerParticles* PointToThisObject() override;
+	};
+}
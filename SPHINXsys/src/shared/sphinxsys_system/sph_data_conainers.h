@@ -8,6 +8,8 @@
 
 #include "base_data_package.h"
 
+#include <cstdint>
+
 using namespace std;
 
 namespace SPH {
@@ -27,19 +29,24 @@ namespace SPH {
 	typedef pair<SPHBody*, SPHBodyVector> SPHBodyContactMap;
 	typedef vector<SPHBodyContactMap> SPHBodyTopology;
 	
-	/** Index containner with elements of size_t. */
-	using IndexVector = StdVec<size_t>;
+	/** Particle index used in particle, mesh and configuration containers.
+	  * 32-bit indexes reduce the memory of index vectors, neighbor counts and cell lists
+	  * for bodies with less than 4 billion particles. Note that the index in a neighbor relation
+	  * is padded to the alignment of Real, therefore, the relations are not reduced. */
+#ifdef _32BIT_PARTICLE_INDEX_
+	using ParticleIndex = uint32_t;
+#else
+	using ParticleIndex = size_t;
+#endif
+	/** Index containner with elements of ParticleIndex. */
+	using IndexVector = StdVec<ParticleIndex>;
 	/** Cell containner with elements of Vecu. */
 	using CellVector = StdVec<Vecu>;		
 
 	/** Concurrent particle indexes .*/
-	using ConcurrentIndexVector = LargeVec<size_t>;
+	using ConcurrentIndexVector = LargeVec<ParticleIndex>;
 	/** Concurrent cell indexes.*/
 	using ConcurrentCellVector = LargeVec<Vecu>;
-	/** List data pair*/
-	using ListData = pair<size_t, Vecd>;
-	/** Cell list concurrent vector data. */
-	using ConcurrentListDataVector = LargeVec<ListData>;
 	/** Concurrent vector .*/
 	template<class DataType>
 	using ConcurrentVector = LargeVec<DataType>;
@@ -48,14 +55,17 @@ namespace SPH {
 	using CellLists = StdLargeVec<CellList*>;
 	/** Split cell list for split algorithms. */
 	using SplitCellLists = StdVec<CellLists>;
+	/** Tiles of cells in each color for block split algorithms. */
+	using BlockSplitCellLists = StdVec<SplitCellLists>;
 	/** Pair of point and volume. */
 	using PositionsAndVolumes =vector<pair<Point, Real>> ; 
 
 	/** Neighboring particles list. 
-	  * Using pointer for overloading derived neighbor relations.*/
-	using NeighborList = StdVec<BaseNeighborRelation*>; 
+	  * Using pointer for overloading derived neighbor relations.
+	  * The lists are allocated from the huge page pool as the relations. */
+	using NeighborList = std::vector<BaseNeighborRelation*, HugePagePoolAllocator<BaseNeighborRelation*>>; 
 	/** Neighboring particle list, the current and the previous number of neighbors. */	
-	using Neighborhood = tuple<NeighborList, size_t, size_t>;
+	using Neighborhood = tuple<NeighborList, ParticleIndex, ParticleIndex>;
 	/** A neighborhoods for all particles in a body. */
 	using ParticleConfiguration = StdLargeVec<Neighborhood>;
 	/** All contact neighborhoods for all particles in a body. */
@@ -63,6 +73,31 @@ namespace SPH {
 	/** Interacting neighborhoods for all particles in a body. */
 	using InteractingParticleConfiguration = StdVec<ParticleConfiguration*>;
 
+	/**
+	 * @struct MemoryUsage
+	 * @brief Memory usage of a container for memory reports.
+	 */
+	struct MemoryUsage
+	{
+		string container_name_;
+		size_t number_of_elements_;	/**< Number of elements in use. */
+		size_t capacity_;			/**< Number of allocated elements. */
+		size_t bytes_;				/**< Allocated bytes. */
+
+		MemoryUsage(string container_name, size_t number_of_elements, size_t capacity, size_t bytes)
+			: container_name_(container_name), number_of_elements_(number_of_elements),
+			capacity_(capacity), bytes_(bytes) {};
+	};
+	/** Memory usages of all containers of a body. */
+	using MemoryUsageList = StdVec<MemoryUsage>;
+	/** Memory usage of a vector-like container. */
+	template <class ContainerType>
+	MemoryUsage vectorMemoryUsage(string container_name, ContainerType& container)
+	{
+		return MemoryUsage(container_name, container.size(), container.capacity(),
+			container.capacity() * sizeof(typename ContainerType::value_type));
+	}
+
 	/** List of partilces contact to another body. */
 	using ContactParticleList = ConcurrentIndexVector;
 	/** All contact particles lists. **/
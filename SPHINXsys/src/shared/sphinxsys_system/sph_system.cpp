@@ -6,23 +6,91 @@
 
 #include "sph_system.h"
 #include "base_body.h"
+#include "mesh_cell_linked_list.h"
 #include "particle_generator_lattice.h"
+#include "sph_system_snapshot.h"
+
+#include <iomanip>
 
 namespace SPH
 {
+	//===============================================================//
+	void ThreadPinningObserver::on_scheduler_entry(bool is_worker)
+	{
+#ifdef __linux__
+		cpu_set_t original_cpu_set;
+		if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &original_cpu_set) != 0) return;
+		/** The cores allowed for the process, which may be restricted by taskset or cgroups. */
+		cpu_set_t allowed_cpu_set;
+		if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed_cpu_set) != 0) return;
+		int number_of_cores = CPU_COUNT(&allowed_cpu_set);
+		if (number_of_cores <= 0) return;
+
+		int core_order = thread_count_++ % number_of_cores;
+		int core_index = 0;
+		for (int core = 0; core != CPU_SETSIZE; ++core)
+		{
+			if (!CPU_ISSET(core, &allowed_cpu_set)) continue;
+			if (core_order-- == 0)
+			{
+				core_index = core;
+				break;
+			}
+		}
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		CPU_SET(core_index, &cpu_set);
+		std::lock_guard<std::mutex> lock(pinned_threads_mutex_);
+		if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0)
+			pinned_threads_.push_back(std::make_pair(pthread_self(), original_cpu_set));
+#endif
+	}
+	//===============================================================//
+	void ThreadPinningObserver::on_scheduler_exit(bool is_worker)
+	{
+#ifdef __linux__
+		std::lock_guard<std::mutex> lock(pinned_threads_mutex_);
+		for (size_t i = 0; i != pinned_threads_.size(); ++i)
+		{
+			if (pthread_equal(pinned_threads_[i].first, pthread_self()))
+			{
+				pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &pinned_threads_[i].second);
+				pinned_threads_.erase(pinned_threads_.begin() + i);
+				break;
+			}
+		}
+#endif
+	}
+	//===============================================================//
+	void ThreadPinningObserver::restoreAffinities()
+	{
+#ifdef __linux__
+		std::lock_guard<std::mutex> lock(pinned_threads_mutex_);
+		for (size_t i = 0; i != pinned_threads_.size(); ++i)
+			pthread_setaffinity_np(pinned_threads_[i].first, sizeof(cpu_set_t), &pinned_threads_[i].second);
+		pinned_threads_.clear();
+		thread_count_ = 0;
+#endif
+	}
 	//===============================================================//
 	SPHSystem::SPHSystem(Vecd lower_bound, Vecd upper_bound,
 		Real particle_spacing_ref, int number_of_threads)
 		: lower_bound_(lower_bound), upper_bound_(upper_bound),
 		particle_spacing_ref_(particle_spacing_ref), tbb_init_(number_of_threads),
 		restart_step_(0), run_particle_relaxation_(false),
-		reload_particles_(false)
+		reload_particles_(false), physical_time_(0.0), shared_mesh_cell_linked_list_(NULL)
 	{
 	}
 	//===============================================================//
 	SPHSystem::~SPHSystem()
 	{
-
+		thread_pinning_.observe(false);
+		thread_pinning_.restoreAffinities();
+		delete shared_mesh_cell_linked_list_;
+		/** The bodies are owned by the system, their neighbor relations are released
+		  * and the chunks of the huge page pool are returned if no relation is left. */
+		for (size_t i = 0; i != bodies_.size(); ++i) delete bodies_[i];
+		HugePagePool::pool().releaseUnusedChunks();
 	}
 	//===============================================================//
 	void SPHSystem::AddBody(SPHBody* body)
@@ -40,43 +108,156 @@ namespace SPH
 		fictitious_bodies_.push_back(body);
 	}
 	//===============================================================//
+	void SPHSystem::setupBodiesInParallel(SPHBodyVector& bodies, std::function<void(SPHBody*)> setup_body)
+	{
+		/** A local partitioner, as the threads keep using their own for the loops inside. */
+		ParallelPartitioner body_partitioner;
+		parallel_for(blocked_range<size_t>(0, bodies.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					this_task_arena::isolate([&]() { setup_body(bodies[i]); });
+			}, body_partitioner);
+	}
+	//===============================================================//
 	void SPHSystem::SetBodyTopology(SPHBodyTopology* body_topology)
 	{
 		body_topology_ = body_topology;
+		SPHBodyVector topology_bodies;
 		for (size_t i = 0; i < body_topology_->size(); i++)
 		{
 			for (auto& body : bodies_) {
 				if (body == body_topology_->at(i).first) {
 					body->SetContactMap(body_topology_->at(i));
-					body->AllocateMeoemryCellLinkedList();
-					body->AllocateMemoriesForConfiguration();
+					topology_bodies.push_back(body);
 				}
 			}
 		}
+		setupBodiesInParallel(topology_bodies, [](SPHBody* body) {
+			body->AllocateMeoemryCellLinkedList();
+			body->AllocateMemoriesForConfiguration();
+		});
+	}
+	//===============================================================//
+	void SPHSystem::setSharedCellLinkedList(SPHBodyVector bodies)
+	{
+		delete shared_mesh_cell_linked_list_;
+		shared_mesh_cell_linked_list_ 
+			= new SharedMeshCellLinkedList(bodies, lower_bound_, upper_bound_);
+	}
+	//===============================================================//
+	void SPHSystem::UpdateSharedCellLinkedList()
+	{
+		shared_mesh_cell_linked_list_->UpdateCellLists();
+	}
+	//===============================================================//
+	void SPHSystem::UpdateSharedConfigurations()
+	{
+		shared_mesh_cell_linked_list_->UpdateConfigurations();
 	}
 	//===============================================================//
 	void SPHSystem::InitializeSystemCellLinkedLists()
 	{
-		for (auto &body : bodies_)
-		{
+		setupBodiesInParallel(bodies_, [](SPHBody* body) {
 			body->UpdateCellLinkedList();
-		}
+		});
+		if (shared_mesh_cell_linked_list_ != NULL) UpdateSharedCellLinkedList();
 	}
 	//===============================================================//
 	void SPHSystem::InitializeSystemConfigurations()
 	{
+		/** The contact configurations only read the cell linked lists of other bodies,
+		  * which are all built already. */
+		SPHBodyVector topology_bodies;
 		for (size_t i = 0; i < body_topology_->size(); i++)
 		{
-			SPHBody *body = body_topology_->at(i).first;
+			SPHBody* body = body_topology_->at(i).first;
+			if (shared_mesh_cell_linked_list_ == NULL || !shared_mesh_cell_linked_list_->hasBody(body))
+				topology_bodies.push_back(body);
+		}
+		setupBodiesInParallel(topology_bodies, [](SPHBody* body) {
 			body->BuildInnerConfiguration();
 			body->BuildContactConfiguration();
-		}
+		});
+		if (shared_mesh_cell_linked_list_ != NULL) UpdateSharedConfigurations();
 	}
 	//===============================================================//
 	void SPHSystem::SetupSPHSimulation()
 	{
 		InitializeSystemCellLinkedLists();
 		InitializeSystemConfigurations();
+		reportMemoryUsage();
+	}
+	//===============================================================//
+	SystemSnapshot* SPHSystem::takeSnapshot()
+	{
+		return new SystemSnapshot(*this);
+	}
+	//===============================================================//
+	void SPHSystem::restoreFromSnapshot(SystemSnapshot& snapshot)
+	{
+		snapshot.restoreSystem(*this);
+	}
+	//===============================================================//
+	void SPHSystem::reportMemoryUsage(ostream& out)
+	{
+		const Real mega_bytes = 1024.0 * 1024.0;
+		ios_base::fmtflags flags = out.flags();
+		streamsize precision = out.precision();
+		size_t system_bytes = 0;
+		out << "\n Memory usage of the SPH system:\n";
+		for (auto& body : bodies_)
+		{
+			MemoryUsageList memory_usages;
+			body->collectMemoryUsage(memory_usages);
+
+			size_t body_bytes = 0;
+			out << "  " << body->GetBodyName() << "\n";
+			out << "    " << left << setw(48) << "container" << right << setw(14) << "elements"
+				<< setw(14) << "capacity" << setw(12) << "MB" << "\n";
+			for (auto& memory_usage : memory_usages)
+			{
+				out << "    " << left << setw(48) << memory_usage.container_name_ << right
+					<< setw(14) << memory_usage.number_of_elements_ << setw(14) << memory_usage.capacity_
+					<< setw(12) << fixed << setprecision(3) << Real(memory_usage.bytes_) / mega_bytes << "\n";
+				body_bytes += memory_usage.bytes_;
+			}
+			out << "    " << left << setw(76) << "total" << right
+				<< setw(12) << fixed << setprecision(3) << Real(body_bytes) / mega_bytes << "\n";
+			system_bytes += body_bytes;
+		}
+		if (shared_mesh_cell_linked_list_ != NULL)
+		{
+			MemoryUsageList memory_usages;
+			shared_mesh_cell_linked_list_->collectMemoryUsage(memory_usages);
+			out << "  shared cell linked list\n";
+			for (auto& memory_usage : memory_usages)
+			{
+				out << "    " << left << setw(48) << memory_usage.container_name_ << right
+					<< setw(14) << memory_usage.number_of_elements_ << setw(14) << memory_usage.capacity_
+					<< setw(12) << fixed << setprecision(3) << Real(memory_usage.bytes_) / mega_bytes << "\n";
+				system_bytes += memory_usage.bytes_;
+			}
+		}
+		out << "  total of all bodies: " << fixed << setprecision(3)
+			<< Real(system_bytes) / mega_bytes << " MB\n" << endl;
+		out.flags(flags);
+		out.precision(precision);
+	}
+	//===============================================================//
+	void SPHSystem::setNumberOfThreads(int number_of_threads)
+	{
+		if (tbb_init_.is_active()) tbb_init_.terminate();
+		tbb_init_.initialize(number_of_threads);
+	}
+	//===============================================================//
+	void SPHSystem::setThreadPinning(bool is_pinned)
+	{
+#ifndef __linux__
+		if (is_pinned) cout << "Thread pinning is only supported on Linux, ignored.\n";
+#endif
+		thread_pinning_.observe(is_pinned);
+		/** The threads leaving the observation are not notified, so that their affinities are restored here. */
+		if (!is_pinned) thread_pinning_.restoreAffinities();
 	}
 	//===============================================================//
 	void SPHSystem::handleCommandlineOptions(int ac, char* av[])
@@ -88,6 +269,12 @@ namespace SPH
 				("help", "produce help message")
 				("r", po::value<bool>(), "Particle relaxation.")
 				("i", po::value<bool>(), "Particle reload from input file.")
+				("restart", po::value<int>(), "Restart step, 0 for not restarting.")
+				("hugepage", po::value<bool>(), "Transparent huge pages for large arrays.")
+				("threads", po::value<int>(), "Number of threads.")
+				("pin", po::value<bool>(), "Pin threads to cores.")
+				("partitioner", po::value<string>(), "Partitioner: affinity, auto, simple or static.")
+				("serial", po::value<bool>(), "Serial execution of all parallel loops.")
 				;
 
 			po::variables_map vm;
@@ -115,6 +302,43 @@ namespace SPH
 			else {
 				cout << "Particle reload from input file was set to default(false).\n";
 			}
+			if (vm.count("restart")) {
+				restart_step_ = vm["restart"].as<int>();
+				cout << "Restart step was set to "
+					<< vm["restart"].as<int>() << ".\n";
+			}
+			if (vm.count("hugepage")) {
+				setHugePageAllocation(vm["hugepage"].as<bool>());
+				cout << "Huge page allocation was set to "
+					<< vm["hugepage"].as<bool>() << ".\n";
+			}
+			if (vm.count("threads")) {
+				setNumberOfThreads(vm["threads"].as<int>());
+				cout << "Number of threads was set to "
+					<< vm["threads"].as<int>() << ".\n";
+			}
+			if (vm.count("pin")) {
+				setThreadPinning(vm["pin"].as<bool>());
+				cout << "Thread pinning was set to "
+					<< vm["pin"].as<bool>() << ".\n";
+			}
+			if (vm.count("partitioner")) {
+				string partitioner = vm["partitioner"].as<string>();
+				if (partitioner == "affinity") setPartitioner(PartitionerType::affinity);
+				else if (partitioner == "auto") setPartitioner(PartitionerType::automatic);
+				else if (partitioner == "simple") setPartitioner(PartitionerType::simple);
+				else if (partitioner == "static") setPartitioner(PartitionerType::static_partitioner);
+				else {
+					cerr << "error: unknown partitioner " << partitioner << "!\n";
+					exit(1);
+				}
+				cout << "Partitioner was set to " << partitioner << ".\n";
+			}
+			if (vm.count("serial")) {
+				setSerialExecution(vm["serial"].as<bool>());
+				cout << "Serial execution was set to "
+					<< vm["serial"].as<bool>() << ".\n";
+			}
 		}
 		catch (std::exception & e) {
 			cerr << "error: " << e.what() << "\n";
@@ -11,6 +11,15 @@ namespace po = boost::program_options;
 
 #include "base_data_package.h"
 #include "sph_data_conainers.h"
+#include "random_numbers.h"
+
+#include <functional>
+#include <mutex>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace SPH 
 {
@@ -18,6 +27,33 @@ namespace SPH
 	 * @brief Preclaimed classes.
 	 */
 	class SPHBody;
+	class SystemSnapshot;
+	class SharedMeshCellLinkedList;
+
+	/**
+	 * @class ThreadPinningObserver
+	 * @brief Pin each thread entering the task scheduler to a core, in a round-robin order
+	 * over the cores allowed for the process. The original affinity of a thread is restored
+	 * when it leaves the scheduler or when the pinning is switched off.
+	 * Only effective on Linux.
+	 */
+	class ThreadPinningObserver : public tbb::task_scheduler_observer
+	{
+		std::atomic<int> thread_count_;
+#ifdef __linux__
+		std::mutex pinned_threads_mutex_;
+		/** the pinned threads with their original affinities */
+		std::vector<std::pair<pthread_t, cpu_set_t>> pinned_threads_;
+#endif
+	public:
+		ThreadPinningObserver() : tbb::task_scheduler_observer(), thread_count_(0) {};
+		virtual ~ThreadPinningObserver() {};
+
+		virtual void on_scheduler_entry(bool is_worker) override;
+		virtual void on_scheduler_exit(bool is_worker) override;
+		/** Restore the original affinities of all pinned threads. */
+		void restoreAffinities();
+	};
 
 	/**
 	 * @class SPHSystem
@@ -25,7 +61,10 @@ namespace SPH
 	 */
 	class SPHSystem
 	{
-
+	protected:
+		/** Set up the bodies in parallel. Each body is set up in an isolated region,
+		  * so that the parallel loops inside are not interleaved with those of other bodies. */
+		void setupBodiesInParallel(SPHBodyVector& bodies, std::function<void(SPHBody*)> setup_body);
 	public:
 		/**
 		 * @brief Default constructor.
@@ -37,6 +76,8 @@ namespace SPH
 		 * @param[in] upper_bound Upper bound of the system computational domain.
 		 * @param[in] particle_spacing_ref Reference particle spacing.
 		 * @param[in] smoothinglength_ratio The Referncen ratio of smoothing length to particle spacing.
+		 * @param[in] number_of_threads Number of threads of the task scheduler, 
+		 * task_scheduler_init::deferred for a system running in the scheduler of a SPHSystemEnsemble.
 		 */
  		SPHSystem(Vecd lower_bound, Vecd upper_bound, Real particle_spacing_ref, 
 			int number_of_threads = tbb::task_scheduler_init::automatic);
@@ -50,13 +91,20 @@ namespace SPH
 		int restart_step_;
 		/** computing from roeload particles from files. */
 		bool run_particle_relaxation_;
+		/** the physical time of this system, shared by all its dynamics. */
+		Real physical_time_;
+		/** the random numbers of this system, shared by all its stochastic dynamics. */
+		CounterBasedRandomNumbers random_numbers_;
 
 		task_scheduler_init tbb_init_;		/**< TBB library. */
+		ThreadPinningObserver thread_pinning_;	/**< Pinning threads to cores. */
 
 		SPHBodyVector bodies_;			/**< All sph bodies. */
 		SPHBodyVector fictitious_bodies_;/**< The bodies without inner particle configuration. */
 		SPHBodyVector real_bodies_;		/**< The bodies with inner particle configuration. */
 		SPHBodyTopology* body_topology_;	/**< SPH body topology. */
+		/** Optional cell linked list shared by the bodies with the same cut-off radius, NULL if not used. */
+		SharedMeshCellLinkedList* shared_mesh_cell_linked_list_;
 
 		/** Add a new body to the SPH system. */
 		void AddBody(SPHBody* body);
@@ -67,12 +115,36 @@ namespace SPH
 		/** Set up the body topology and allocate memeries 
 		  * for mesh cell linked lists and particle configurations. */
 		void SetBodyTopology(SPHBodyTopology* body_topology);
-		/** Initialize cell linked lists. */
+		/** Share a cell linked list among bodies, called after setting the body topology.
+		  * Their inner and contact configurations within the group are then built in a single traversal. */
+		void setSharedCellLinkedList(SPHBodyVector bodies);
+		/** Update the shared cell linked list with the current particle positions. */
+		void UpdateSharedCellLinkedList();
+		/** Update the inner and contact configurations of the bodies sharing the cell linked list. */
+		void UpdateSharedConfigurations();
+		/** Initialize cell linked lists of all bodies in parallel. */
 		void InitializeSystemCellLinkedLists();
-		/** Initialize particle interacting configurations. */
+		/** Initialize particle interacting configurations of all bodies in parallel. */
 		void InitializeSystemConfigurations();
 		/** Set up cell-linked list and configuration for simulation. */
 		void SetupSPHSimulation();
+		/** Take an in-memory deep copy of all body states, configurations and the time. 
+		  * The caller owns the snapshot. */
+		SystemSnapshot* takeSnapshot();
+		/** Fork a branch by restoring this system from a snapshot. */
+		void restoreFromSnapshot(SystemSnapshot& snapshot);
+		/** Report the memory usage of all bodies by containers.
+		  * It is called at the end of the setup, and can be called at any point of a simulation. */
+		void reportMemoryUsage(ostream& out = cout);
+
+		/** Reset the number of threads of the task scheduler. */
+		void setNumberOfThreads(int number_of_threads);
+		/** Pin the threads to cores or release them, effective for threads entering the scheduler later. */
+		void setThreadPinning(bool is_pinned);
+		/** Choose the partitioner used by all parallel loops of this process. */
+		void setPartitioner(PartitionerType partitioner_type) { setPartitionerType(partitioner_type); };
+		/** Execute all parallel loops of this process sequentially. */
+		void setSerialExecution(bool is_serial) { SPH::setSerialExecution(is_serial); };
 
 		/** handle the commandline options*/
 		void handleCommandlineOptions(int ac, char* av[]);
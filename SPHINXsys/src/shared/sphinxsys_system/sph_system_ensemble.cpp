@@ -0,0 +1,122 @@
+/**
+ * @file sph_system_ensemble.cpp
+ * @brief 	Definatioin of all the functions decleared in sph_system_ensemble.h
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+
+#include "sph_system_ensemble.h"
+#include "base_body.h"
+#include "base_mesh.h"
+#include "base_particles.h"
+
+#include <thread>
+#include <condition_variable>
+
+namespace SPH
+{
+	//===============================================================//
+	SharedImmutableInputs::~SharedImmutableInputs()
+	{
+		for (auto& mesh : background_meshes_) delete mesh.second;
+	}
+	//===============================================================//
+	void SharedImmutableInputs::addBackgroundMesh(SPHBody &body, Real mesh_size_ratio)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto shared_mesh = background_meshes_.find(body.GetBodyName());
+		if (shared_mesh == background_meshes_.end())
+		{
+			Vecd body_lower_bound, body_upper_bound;
+			body.BodyBounds(body_lower_bound, body_upper_bound);
+			MeshBackground* mesh_background
+				= new MeshBackground(body_lower_bound,
+					body_upper_bound, mesh_size_ratio * body.particle_spacing_, 4);
+			mesh_background->AllocateMeshDataMatrix();
+			mesh_background->InitializeLevelSetData(body);
+			mesh_background->ComputeCurvatureFromLevelSet(body);
+			shared_mesh = background_meshes_.insert(
+				std::make_pair(body.GetBodyName(), mesh_background)).first;
+		}
+		body.useSharedBackgroundMesh(shared_mesh->second);
+	}
+	//===============================================================//
+	bool SharedImmutableInputs::loadGeneratedParticles(SPHBody &body)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto shared_particles = generated_particles_.find(body.GetBodyName());
+		if (shared_particles == generated_particles_.end()) return false;
+
+		body.body_input_points_volumes_ = shared_particles->second;
+		body.particle_generator_op_ = ParticlesGeneratorOps::direct;
+		return true;
+	}
+	//===============================================================//
+	void SharedImmutableInputs::recordGeneratedParticles(SPHBody &body)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (generated_particles_.find(body.GetBodyName()) != generated_particles_.end()) return;
+
+		PositionsAndVolumes& positions_volumes = generated_particles_[body.GetBodyName()];
+		for (size_t i = 0; i != body.number_of_particles_; ++i)
+		{
+			BaseParticleData& base_particle_data_i
+				= body.base_particles_->base_particle_data_[i];
+			positions_volumes.push_back(
+				std::make_pair(base_particle_data_i.pos_n_, base_particle_data_i.Vol_0_));
+		}
+	}
+	//===============================================================//
+	SPHSystemEnsemble::SPHSystemEnsemble(int number_of_threads)
+		: number_of_threads_(number_of_threads), tbb_init_(number_of_threads)
+	{
+	}
+	//===============================================================//
+	void SPHSystemEnsemble::addMember(EnsembleMember member, int number_of_threads)
+	{
+		if (number_of_threads < 1 || number_of_threads > number_of_threads_)
+		{
+			std::cout << "\n Error: the thread share " << number_of_threads
+				<< " of an ensemble member is not within [1, " << number_of_threads_ << "]!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		members_.push_back(member);
+		thread_shares_.push_back(number_of_threads);
+	}
+	//===============================================================//
+	void SPHSystemEnsemble::addMembers(EnsembleMember member, size_t number_of_members, int number_of_threads)
+	{
+		for (size_t i = 0; i != number_of_members; ++i) addMember(member, number_of_threads);
+	}
+	//===============================================================//
+	void SPHSystemEnsemble::runMembers()
+	{
+		std::mutex mutex;
+		std::condition_variable thread_released;
+		int available_threads = number_of_threads_;
+		StdVec<std::thread> member_threads;
+
+		for (size_t i = 0; i != members_.size(); ++i)
+		{
+			int thread_share = thread_shares_[i];
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				thread_released.wait(lock, [&]() { return available_threads >= thread_share; });
+				available_threads -= thread_share;
+			}
+			/** Each member is the master of its own arena. */
+			member_threads.push_back(std::thread([&, i, thread_share]() {
+				task_arena member_arena(thread_share);
+				member_arena.execute([&]() { members_[i](i, thread_share, shared_inputs_); });
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					available_threads += thread_share;
+				}
+				thread_released.notify_all();
+			}));
+		}
+
+		for (auto& member_thread : member_threads) member_thread.join();
+	}
+	//===============================================================//
+}
@@ -0,0 +1,85 @@
+/**
+ * @file sph_system_ensemble.h
+ * @brief Running several independent SPH systems concurrently in one process.
+ * @details Each member of the ensemble builds and runs its own SPHSystem
+ *			in a separated TBB task arena with a prescribed share of threads.
+ *			Immutable inputs, such as the level set of a body geometry and
+ *			the generated particles, are built once and shared by all members.
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#pragma once
+
+#include "base_data_package.h"
+#include "sph_data_conainers.h"
+
+#include <functional>
+#include <mutex>
+#include <map>
+
+namespace SPH
+{
+	/**
+	 * @brief Preclaimed classes.
+	 */
+	class SPHBody;
+	class MeshBackground;
+
+	/**
+	 * @class SharedImmutableInputs
+	 * @brief Thread-safe storage of inputs which do not change during the simulation.
+	 * The inputs are identified by the body name.
+	 * Note that the shared background mesh is only probed but never modified by the dynamics.
+	 */
+	class SharedImmutableInputs
+	{
+		std::mutex mutex_;
+		std::map<string, MeshBackground*> background_meshes_;
+		std::map<string, PositionsAndVolumes> generated_particles_;
+	public:
+		SharedImmutableInputs() {};
+		virtual ~SharedImmutableInputs();
+
+		/** Add the background mesh to a body.
+		  * It is built by the first caller and shared by the others. */
+		void addBackgroundMesh(SPHBody &body, Real mesh_size_ratio = 0.5);
+		/** Set the body to generate particles directly from the shared positions and volumes.
+		  * Call before creating particles. Return false if nothing is shared yet. */
+		bool loadGeneratedParticles(SPHBody &body);
+		/** Record the particle positions and volumes of a body just created.
+		  * Only the first record is kept. */
+		void recordGeneratedParticles(SPHBody &body);
+	};
+
+	/** Functor for a ensemble member: building and running a simulation.
+	  * The arguments are the member index, the number of threads assigned to it and the shared inputs.
+	  * The member builds its SPHSystem with task_scheduler_init::deferred as the number of threads,
+	  * so that it runs in its arena of the scheduler owned by the ensemble. */
+	typedef std::function<void(size_t, int, SharedImmutableInputs&)> EnsembleMember;
+
+	/**
+	 * @class SPHSystemEnsemble
+	 * @brief Run independent simulations concurrently, each in its own task arena.
+	 * The members are started in the added order as long as the sum of their
+	 * thread shares does not exceed the total number of threads.
+	 * There is only one task scheduler, initialized by the ensemble and shared by all members.
+	 */
+	class SPHSystemEnsemble
+	{
+		int number_of_threads_;
+		task_scheduler_init tbb_init_;
+		StdVec<EnsembleMember> members_;
+		StdVec<int> thread_shares_;
+	public:
+		SharedImmutableInputs shared_inputs_;
+
+		explicit SPHSystemEnsemble(int number_of_threads = task_scheduler_init::default_num_threads());
+		virtual ~SPHSystemEnsemble() {};
+
+		/** Add a member with the number of threads it will use. */
+		void addMember(EnsembleMember member, int number_of_threads = 1);
+		/** Add several copies of the same member, each with the given number of threads. */
+		void addMembers(EnsembleMember member, size_t number_of_members, int number_of_threads = 1);
+		/** Run all members and return when all of them are finished. */
+		void runMembers();
+	};
+}
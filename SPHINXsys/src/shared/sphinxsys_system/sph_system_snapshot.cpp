@@ -0,0 +1,143 @@
+/**
+ * @file sph_system_snapshot.cpp
+ * @brief 	Definatioin of all the functions decleared in sph_system_snapshot.h
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+
+#include "sph_system_snapshot.h"
+#include "sph_system.h"
+#include "base_body.h"
+#include "base_particles.h"
+
+namespace SPH
+{
+	//===============================================================//
+	BodySnapshot::BodySnapshot(SPHBody* body)
+		: body_name_(body->GetBodyName()), number_of_particles_(body->number_of_particles_),
+		particles_(body->base_particles_->duplicateParticles()),
+		indexes_contact_particles_(body->indexes_contact_particles_)
+	{
+		duplicateConfiguration(body->inner_configuration_, inner_configuration_);
+		contact_configuration_.resize(body->contact_configuration_.size());
+		for (size_t k = 0; k != body->contact_configuration_.size(); ++k)
+			duplicateConfiguration(body->contact_configuration_[k], contact_configuration_[k]);
+	}
+	//===============================================================//
+	BodySnapshot::~BodySnapshot()
+	{
+		delete particles_;
+		deleteConfiguration(inner_configuration_);
+		for (size_t k = 0; k != contact_configuration_.size(); ++k)
+			deleteConfiguration(contact_configuration_[k]);
+	}
+	//===============================================================//
+	void BodySnapshot::duplicateConfiguration(ParticleConfiguration& configuration,
+		ParticleConfiguration& duplicated_configuration)
+	{
+		duplicated_configuration.resize(configuration.size(),
+			make_tuple<NeighborList, ParticleIndex, ParticleIndex>(NeighborList(0), 0, 0));
+		for (size_t i = 0; i != configuration.size(); ++i)
+		{
+			NeighborList& neighbors = std::get<0>(configuration[i]);
+			size_t number_of_neighbors = std::get<2>(configuration[i]);
+			NeighborList& duplicated_neighbors = std::get<0>(duplicated_configuration[i]);
+			for (size_t n = 0; n != number_of_neighbors; ++n)
+				duplicated_neighbors.push_back(neighbors[n]->duplicateRelation());
+			std::get<1>(duplicated_configuration[i]) = std::get<1>(configuration[i]);
+			std::get<2>(duplicated_configuration[i]) = number_of_neighbors;
+		}
+	}
+	//===============================================================//
+	void BodySnapshot::restoreConfiguration(ParticleConfiguration& duplicated_configuration,
+		ParticleConfiguration& configuration)
+	{
+		if (configuration.size() < duplicated_configuration.size())
+			configuration.resize(duplicated_configuration.size(),
+				make_tuple<NeighborList, ParticleIndex, ParticleIndex>(NeighborList(0), 0, 0));
+
+		parallel_for(blocked_range<size_t>(0, duplicated_configuration.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i < r.end(); ++i) {
+					NeighborList& duplicated_neighbors = std::get<0>(duplicated_configuration[i]);
+					NeighborList& neighbors = std::get<0>(configuration[i]);
+					for (size_t n = 0; n != duplicated_neighbors.size(); ++n)
+					{
+						if (n >= neighbors.size())
+							neighbors.push_back(duplicated_neighbors[n]->duplicateRelation());
+						else neighbors[n]->assignRelation(duplicated_neighbors[n]);
+					}
+					std::get<1>(configuration[i]) = std::get<1>(duplicated_configuration[i]);
+					std::get<2>(configuration[i]) = std::get<2>(duplicated_configuration[i]);
+				}
+			}, ap);
+	}
+	//===============================================================//
+	void BodySnapshot::deleteConfiguration(ParticleConfiguration& duplicated_configuration)
+	{
+		for (size_t i = 0; i != duplicated_configuration.size(); ++i)
+		{
+			NeighborList& duplicated_neighbors = std::get<0>(duplicated_configuration[i]);
+			for (size_t n = 0; n != duplicated_neighbors.size(); ++n)
+				delete duplicated_neighbors[n];
+		}
+	}
+	//===============================================================//
+	void BodySnapshot::restoreBody(SPHBody* body)
+	{
+		if (body->contact_configuration_.size() != contact_configuration_.size())
+		{
+			std::cout << "\n Error: the body " << body_name_
+				<< " has a different topology from its snapshot!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
+		body->number_of_particles_ = number_of_particles_;
+		body->base_particles_->copyParticleStates(particles_);
+		body->indexes_contact_particles_ = indexes_contact_particles_;
+		restoreConfiguration(inner_configuration_, body->inner_configuration_);
+		for (size_t k = 0; k != contact_configuration_.size(); ++k)
+			restoreConfiguration(contact_configuration_[k], body->contact_configuration_[k]);
+	}
+	//===============================================================//
+	SystemSnapshot::SystemSnapshot(SPHSystem& system)
+		: physical_time_(system.physical_time_), random_numbers_(system.random_numbers_)
+	{
+		for (auto& body : system.bodies_)
+		{
+			body_snapshots_.push_back(new BodySnapshot(body));
+		}
+	}
+	//===============================================================//
+	SystemSnapshot::~SystemSnapshot()
+	{
+		for (auto& body_snapshot : body_snapshots_) delete body_snapshot;
+	}
+	//===============================================================//
+	void SystemSnapshot::restoreSystem(SPHSystem& system)
+	{
+		for (auto& body : system.bodies_)
+		{
+			bool is_restored = false;
+			for (auto& body_snapshot : body_snapshots_)
+			{
+				if (body_snapshot->body_name_ == body->GetBodyName())
+				{
+					body_snapshot->restoreBody(body);
+					is_restored = true;
+				}
+			}
+			if (!is_restored)
+			{
+				std::cout << "\n Error: no snapshot found for the body " << body->GetBodyName() << "!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+		}
+		system.physical_time_ = physical_time_;
+		system.random_numbers_ = random_numbers_;
+		/** cell linked lists are rebuilt from the restored positions. */
+		system.InitializeSystemCellLinkedLists();
+	}
+	//===============================================================//
+}
@@ -0,0 +1,76 @@
+/**
+ * @file sph_system_snapshot.h
+ * @brief In-memory snapshot of a SPH system for forking simulations.
+ * @details A snapshot is a deep copy of the particle states, the particle configurations
+ *			of all bodies, the physical time and the state of the random numbers. After a common part of simulation,
+ *			several branches with modified parameters can be continued from the snapshot,
+ *			either sequentially in the same system or concurrently in identically built systems.
+ *			Note that the states kept outside of the particles, such as those of Simbody,
+ *			are not included.
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#pragma once
+
+#include "base_data_package.h"
+#include "sph_data_conainers.h"
+#include "random_numbers.h"
+
+namespace SPH
+{
+	/**
+	 * @brief Preclaimed classes.
+	 */
+	class SPHSystem;
+	class SPHBody;
+	class BaseParticles;
+
+	/**
+	 * @class BodySnapshot
+	 * @brief Deep copy of the particle states and configurations of a body.
+	 */
+	class BodySnapshot
+	{
+		/** Duplicate a configuration including its neighbor relations. */
+		void duplicateConfiguration(ParticleConfiguration& configuration,
+			ParticleConfiguration& duplicated_configuration);
+		/** Copy a duplicated configuration back, reusing the neighbor relations already there. */
+		void restoreConfiguration(ParticleConfiguration& duplicated_configuration,
+			ParticleConfiguration& configuration);
+		/** Delete the neighbor relations of a duplicated configuration. */
+		void deleteConfiguration(ParticleConfiguration& duplicated_configuration);
+	public:
+		explicit BodySnapshot(SPHBody* body);
+		virtual ~BodySnapshot();
+
+		string body_name_;
+		size_t number_of_particles_;
+		BaseParticles* particles_;
+		ParticleConfiguration inner_configuration_;
+		ContactParticles indexes_contact_particles_;
+		ContatcParticleConfiguration contact_configuration_;
+
+		/** Copy the snapshot to a body with the same name and type of particles. */
+		void restoreBody(SPHBody* body);
+	};
+
+	/**
+	 * @class SystemSnapshot
+	 * @brief Deep copy of all bodies, the physical time and the random numbers of a SPH system.
+	 * The snapshot is not changed by restoring, so that it can be used for several branches,
+	 * even concurrently.
+	 */
+	class SystemSnapshot
+	{
+	public:
+		explicit SystemSnapshot(SPHSystem& system);
+		virtual ~SystemSnapshot();
+
+		Real physical_time_;
+		/** the state of the random numbers */
+		CounterBasedRandomNumbers random_numbers_;
+		StdVec<BodySnapshot*> body_snapshots_;
+
+		/** Copy the snapshot to a system, whose bodies are matched by name. */
+		void restoreSystem(SPHSystem& system);
+	};
+}
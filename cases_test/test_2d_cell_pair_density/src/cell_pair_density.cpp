@@ -0,0 +1,130 @@
+/**
+ * @file 	cell_pair_density.cpp
+ * @brief 	Test of the density summation in the cell pair interaction mode.
+ * @details Two fluid blocks with the same perturbed particle positions are given,
+ *			one with the inner configuration and the other in the cell pair interaction mode,
+ *			in which the neighbors are searched from the cell linked list directly.
+ *			The densities by summation of the two blocks should be the same.
+ * @author 	Xiangyu Hu and Chi Zhang
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DL = 1.0; 							/**< Block size. */
+Real particle_spacing_ref = 1.0 / 50;	/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width of the domain. */
+Real perturbation = 0.2;				/**< Amplitude of the position perturbation relative to the particle spacing. */
+/**
+ * @brief Material properties of the fluid.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real U_f = 1.0;							/**< Characteristic velocity. */
+Real c_f = 10.0 * U_f;					/**< Reference sound speed. */
+/**
+ * @brief 	Fluid body definition.
+ */
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: FluidBody(sph_system, body_name, refinement_level, op)
+	{
+		std::vector<Point> water_block_shape;
+		water_block_shape.push_back(Point(0.0, 0.0));
+		water_block_shape.push_back(Point(0.0, DL));
+		water_block_shape.push_back(Point(DL, DL));
+		water_block_shape.push_back(Point(DL, 0.0));
+		water_block_shape.push_back(Point(0.0, 0.0));
+		body_region_.add_geometry(new Geometry(water_block_shape), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+		assignDerivedMaterialParameters();
+	}
+};
+/** Perturb the particle positions by a smooth displacement field, the same for both blocks. */
+void perturbParticlePositions(FluidBody* body, FluidParticles& particles)
+{
+	for (size_t i = 0; i != body->number_of_particles_; ++i)
+	{
+		Vecd& position = particles.base_particle_data_[i].pos_n_;
+		Vecd displacement(sin(17.0 * position[0] + 5.0 * position[1]), cos(11.0 * position[0] - 13.0 * position[1]));
+		position += perturbation * particle_spacing_ref * displacement;
+	}
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	/**
+	 * @brief Build up -- a SPHSystem --
+	 */
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(DL + BW, DL + BW), particle_spacing_ref);
+	/**
+	 * @brief The fluid blocks with and without the inner configuration.
+	 */
+	WaterMaterial 	*water_material = new WaterMaterial();
+	WaterBlock *water_block
+		= new WaterBlock(sph_system, "WaterBody", 0, ParticlesGeneratorOps::lattice);
+	FluidParticles 	fluid_particles(water_block, water_material);
+	WaterBlock *cell_pair_water_block
+		= new WaterBlock(sph_system, "CellPairWaterBody", 0, ParticlesGeneratorOps::lattice);
+	cell_pair_water_block->setCellPairInnerInteraction();
+	FluidParticles 	cell_pair_fluid_particles(cell_pair_water_block, water_material);
+	/**
+	 * @brief 	Body contact map.
+	 */
+	SPHBodyTopology 	body_topology = { { water_block, {} }, { cell_pair_water_block, {} } };
+	sph_system.SetBodyTopology(&body_topology);
+	/**
+	 * @brief 	The density summations.
+	 */
+	fluid_dynamics::DensityBySummation 	update_density_by_summation(water_block, {});
+	fluid_dynamics::DensityBySummationCellPairInner 	update_density_by_cell_pairs(cell_pair_water_block);
+
+	perturbParticlePositions(water_block, fluid_particles);
+	perturbParticlePositions(cell_pair_water_block, cell_pair_fluid_particles);
+	/** Pre-simulation*/
+	sph_system.InitializeSystemCellLinkedLists();
+	sph_system.InitializeSystemConfigurations();
+
+	update_density_by_summation.parallel_exec();
+	update_density_by_cell_pairs.parallel_exec();
+
+	Real density_difference(0), density_deviation(0);
+	for (size_t i = 0; i != water_block->number_of_particles_; ++i)
+	{
+		Real density = fluid_particles.fluid_particle_data_[i].rho_n_;
+		density_difference = SMAX(density_difference,
+			ABS(density - cell_pair_fluid_particles.fluid_particle_data_[i].rho_n_));
+		density_deviation = SMAX(density_deviation, ABS(density - rho0_f));
+	}
+	cout << "Maximum density deviation from the reference: " << density_deviation << "\n";
+	cout << "Maximum density difference of the cell pair summation: " << density_difference << "\n";
+	/** The perturbation should change the density, so that the comparison is not trivial. */
+	bool is_passed = density_deviation > 1.0e-3 * rho0_f && density_difference < 1.0e-12 * rho0_f;
+	cout << (is_passed ? "Passed.\n" : "Failed!\n");
+
+	return is_passed ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file 	dambreak_ensemble.cpp
+ * @brief 	2D dambreak ensemble exaple.
+ * @details Several dambreaks with different gravities run concurrently in one process
+ *			by a SPHSystemEnsemble. The generated particles of the water block and the wall
+ *			are shared by the members, which run in the same task scheduler.
+ * @author 	Luhui Han, Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DL = 5.366; 						/**< Tank length. */
+Real DH = 5.366; 						/**< Tank height. */
+Real LL = 2.0; 							/**< Liquid colume length. */
+Real LH = 1.0; 							/**< Liquid colume height. */
+Real particle_spacing_ref = 0.05; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width for BCs. */
+/**
+ * @brief Material properties of the fluid.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+/**
+ * @brief Parameters of the ensemble.
+ */
+size_t number_of_members = 4;			/**< Number of dambreaks. */
+int threads_per_member = 1;				/**< Number of threads of each member. */
+Real gravity_min = 0.5;					/**< Gravity of the first member. */
+Real gravity_increment = 0.5;			/**< Gravity increment between members. */
+/**
+ * @brief 	Fluid body definition.
+ */
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: FluidBody(sph_system, body_name, refinement_level, op)
+	{
+		/** Geomerty definition. */
+		std::vector<Point> water_block_shape;
+		water_block_shape.push_back(Point(0.0, 0.0));
+		water_block_shape.push_back(Point(0.0, LH));
+		water_block_shape.push_back(Point(LL, LH));
+		water_block_shape.push_back(Point(LL, 0.0));
+		water_block_shape.push_back(Point(0.0, 0.0));
+		Geometry *water_block_geometry = new Geometry(water_block_shape);
+		body_region_.add_geometry(water_block_geometry, RegionBooleanOps::add);
+
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial(Real c_f) : WeaklyCompressibleFluid()
+	{
+		/** Basic material parameters*/
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+
+		/** Compute the derived material parameters*/
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Wall boundary body definition.
+ */
+class WallBoundary : public SolidBody
+{
+public:
+	WallBoundary(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		/** Geomerty definition. */
+		std::vector<Point> outer_wall_shape;
+		outer_wall_shape.push_back(Point(-BW, -BW));
+		outer_wall_shape.push_back(Point(-BW, DH + BW));
+		outer_wall_shape.push_back(Point(DL + BW, DH + BW));
+		outer_wall_shape.push_back(Point(DL + BW, -BW));
+		outer_wall_shape.push_back(Point(-BW, -BW));
+		Geometry *outer_wall_geometry = new Geometry(outer_wall_shape);
+		body_region_.add_geometry(outer_wall_geometry, RegionBooleanOps::add);
+
+		std::vector<Point> inner_wall_shape;
+		inner_wall_shape.push_back(Point(0.0, 0.0));
+		inner_wall_shape.push_back(Point(0.0, DH));
+		inner_wall_shape.push_back(Point(DL, DH));
+		inner_wall_shape.push_back(Point(DL, 0.0));
+		inner_wall_shape.push_back(Point(0.0, 0.0));
+		Geometry *inner_wall_geometry = new Geometry(inner_wall_shape);
+		body_region_.add_geometry(inner_wall_geometry, RegionBooleanOps::sub);
+
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	A member of the ensemble: a dambreak with the gravity given by the member index.
+ * @details The mechanical energy of the water is reported instead of body states output,
+ *			as all members share the same output folder.
+ */
+void runDambreak(size_t member_index, int number_of_threads, SharedImmutableInputs& shared_inputs)
+{
+	Real gravity_g = gravity_min + Real(member_index) * gravity_increment;
+	Real U_f = 2.0*sqrt(gravity_g*LH);		/**< Characteristic velocity. */
+	Real c_f = 10.0*U_f;					/**< Reference sound speed. */
+	/**
+	 * @brief Build up -- a SPHSystem -- running in the scheduler of the ensemble.
+	 */
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW), particle_spacing_ref,
+		task_scheduler_init::deferred);
+	/**
+	 * @brief Material property, partilces and body creation of fluid.
+	 * The particles generated by the first member are used by the others.
+	 */
+	WaterBlock *water_block
+		= new WaterBlock(sph_system, "WaterBody", 0, ParticlesGeneratorOps::lattice);
+	WaterMaterial 	*water_material = new WaterMaterial(c_f);
+	shared_inputs.loadGeneratedParticles(*water_block);
+	FluidParticles 	fluid_particles(water_block, water_material);
+	shared_inputs.recordGeneratedParticles(*water_block);
+	/**
+	 * @brief 	Particle and body creation of wall boundary.
+	 */
+	WallBoundary *wall_boundary
+		= new WallBoundary(sph_system, "Wall", 0, ParticlesGeneratorOps::lattice);
+	shared_inputs.loadGeneratedParticles(*wall_boundary);
+	SolidParticles 	solid_particles(wall_boundary);
+	shared_inputs.recordGeneratedParticles(*wall_boundary);
+	/**
+	 * @brief 	Body contact map.
+	 */
+	SPHBodyTopology 	body_topology = { { water_block, { wall_boundary } }, { wall_boundary, {} } };
+	sph_system.SetBodyTopology(&body_topology);
+	/**
+	 * @brief 	Define all numerical methods which are used in this case.
+	 */
+	Gravity 	gravity(Vecd(0.0, -gravity_g));
+	solid_dynamics::NormalDirectionSummation 	get_wall_normal(wall_boundary, {});
+	InitializeATimeStep 	initialize_a_fluid_step(water_block, &gravity);
+	fluid_dynamics::DensityBySummationFreeSurface 	update_fluid_density(water_block, { wall_boundary });
+	fluid_dynamics::GetAdvectionTimeStepSize 	get_fluid_adevction_time_step_size(water_block, U_f);
+	fluid_dynamics::GetAcousticTimeStepSize 	get_fluid_time_step_size(water_block);
+	fluid_dynamics::PressureRelaxationFirstHalfRiemann
+		pressure_relaxation_first_half(water_block, { wall_boundary });
+	fluid_dynamics::PressureRelaxationSecondHalfRiemann
+		pressure_relaxation_second_half(water_block, { wall_boundary });
+	ParticleDynamicsCellLinkedList		update_cell_linked_list(water_block);
+	ParticleDynamicsConfiguration 		update_particle_configuration(water_block);
+	fluid_dynamics::TotalMechanicalEnergy 	compute_mechanical_energy(water_block, &gravity);
+
+	/** Pre-simulation*/
+	sph_system.InitializeSystemCellLinkedLists();
+	sph_system.InitializeSystemConfigurations();
+	get_wall_normal.exec();
+	Real initial_energy = compute_mechanical_energy.parallel_exec();
+
+	/** The members run to the same non-dimensional time. */
+	Real End_Time = 5.0 * sqrt(LH / gravity_g);
+	Real Dt = 0.0;			/**< Default advection time step sizes. */
+	Real dt = 0.0; 			/**< Default accoustic time step sizes. */
+	tick_count t1 = tick_count::now();
+	while (sph_system.physical_time_ < End_Time)
+	{
+		initialize_a_fluid_step.parallel_exec();
+		Dt = get_fluid_adevction_time_step_size.parallel_exec();
+		update_fluid_density.parallel_exec();
+
+		Real relaxation_time = 0.0;
+		while (relaxation_time < Dt)
+		{
+			pressure_relaxation_first_half.parallel_exec(dt);
+			pressure_relaxation_second_half.parallel_exec(dt);
+			dt = get_fluid_time_step_size.parallel_exec();
+			relaxation_time += dt;
+			sph_system.physical_time_ += dt;
+		}
+
+		update_cell_linked_list.parallel_exec();
+		update_particle_configuration.parallel_exec();
+	}
+	tick_count t2 = tick_count::now();
+
+	Real final_energy = compute_mechanical_energy.parallel_exec();
+	std::ostringstream member_report;
+	member_report << fixed << setprecision(6) << "Member " << member_index
+		<< " with gravity " << gravity_g << " on " << number_of_threads << " threads: "
+		<< "relative mechanical energy " << final_energy / initial_energy
+		<< " at time " << sph_system.physical_time_
+		<< ", wall time " << (t2 - t1).seconds() << " seconds.\n";
+	cout << member_report.str();
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	SPHSystemEnsemble ensemble(int(number_of_members) * threads_per_member);
+	ensemble.addMembers(runDambreak, number_of_members, threads_per_member);
+
+	tick_count t1 = tick_count::now();
+	ensemble.runMembers();
+	tick_count t2 = tick_count::now();
+	cout << "Total wall time for the ensemble: " << (t2 - t1).seconds() << " seconds." << endl;
+
+	return 0;
+}
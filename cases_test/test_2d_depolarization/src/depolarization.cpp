@@ -144,7 +144,7 @@ int main()
 	 * Build up context -- a SPHSystem. 
 	 */
 	SPHSystem system(Vec2d(0.0, 0.0), Vec2d(L, H), particle_spacing_ref);
-		GlobalStaticVariables::physical_time_ = 0.0;
+		system.physical_time_ = 0.0;
 	/** 
 	 * Configuration of materials, crate particle container and muscle body. 
 	 */
@@ -206,8 +206,8 @@ int main()
 	/** 
 	 * Output global basic parameters. 
 	 */
-	write_states.WriteToFile(GlobalStaticVariables::physical_time_);
-	write_recorded_voltage.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_states.WriteToFile(system.physical_time_);
+	write_recorded_voltage.WriteToFile(system.physical_time_);
 
 	int ite 		= 0;
 	Real T0 		= 16.0;
@@ -219,7 +219,7 @@ int main()
 	tick_count t1 = tick_count::now();
 	tick_count::interval_t interval;
 	/** Main loop starts here. */ 
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		while (integeral_time < D_Time) 
@@ -230,7 +230,7 @@ int main()
 				if (ite % 1000 == 0) 
 				{
 					cout << "N=" << ite << " Time: "
-						<< GlobalStaticVariables::physical_time_ << "	dt: "
+						<< system.physical_time_ << "	dt: "
 						<< dt << "\n";
 				}
 				/**Strang's splitting method. */
@@ -242,13 +242,13 @@ int main()
 				dt = get_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 			}
-			write_recorded_voltage.WriteToFile(GlobalStaticVariables::physical_time_);
+			write_recorded_voltage.WriteToFile(system.physical_time_);
 		}
 
 		tick_count t2 = tick_count::now();
-		write_states.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_states.WriteToFile(system.physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -258,5 +258,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
@@ -117,7 +117,7 @@ int main()
 {
 	/** Build up context -- a SPHSystem. */
 	SPHSystem system(Vec2d(0.0, 0.0), Vec2d(L, H), particle_spacing_ref, 4);
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	/** Configuration of materials, crate particle container and diffusion body. */
 	DiffusionBody *diffusion_body  =  new DiffusionBody(system, "DiffusionBody", 0, ParticlesGeneratorOps::lattice);
 	DiffusionBodyMaterial *diffusion_body_material = new DiffusionBodyMaterial();
@@ -153,7 +153,7 @@ int main()
 	diffusion_body->BuildInnerConfiguration();
 	correct_configuration.parallel_exec();
 	/** Output global basic parameters. */
-	write_states.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_states.WriteToFile(system.physical_time_);
 
 	int ite 				= 0;
 	Real T0 				= 1.0;
@@ -165,7 +165,7 @@ int main()
 	tick_count t1 = tick_count::now();
 	tick_count::interval_t interval;
 	/** Main loop starts here. */ 
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		while (integeral_time < Output_Time) 
@@ -176,7 +176,7 @@ int main()
 				if (ite % 1 == 0)
 				{
 					cout << "N=" << ite << " Time: "
-						<< GlobalStaticVariables::physical_time_ << "	dt: "
+						<< system.physical_time_ << "	dt: "
 						<< dt << "\n";
 				}
 
@@ -186,13 +186,13 @@ int main()
 				dt = get_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
-				write_states.WriteToFile(GlobalStaticVariables::physical_time_);
+				system.physical_time_ += dt;
+				write_states.WriteToFile(system.physical_time_);
 			}
 		}
 
 		tick_count t2 = tick_count::now();
-		write_states.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_states.WriteToFile(system.physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -202,5 +202,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
@@ -285,7 +285,7 @@ int main()
 	/** Define the external force. */
 	Gravity gravity(Vecd(0.0, -gravity_g));
 	/** Set the starting time to zero. */
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	/**
 	 * @brief Material property, partilces and body creation of fluid.
 	 */
@@ -420,8 +420,8 @@ int main()
 	get_gate_normal.parallel_exec();
 	gate_corrected_configuration_in_strong_form.parallel_exec();
 
-	write_real_body_states_to_plt.WriteToFile(GlobalStaticVariables::physical_time_);
-	write_beam_tip_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_real_body_states_to_plt.WriteToFile(system.physical_time_);
+	write_beam_tip_displacement.WriteToFile(system.physical_time_);
 
 	int number_of_iterations = 0;
 	int screen_output_interval = 100;
@@ -436,7 +436,7 @@ int main()
 	/**
 	 * @brief Main loop starts here.
 	 */
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		/** Integrate time (loop) until the next output time. */
@@ -471,13 +471,13 @@ int main()
 				dt = get_fluid_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 			}
 
 			if (number_of_iterations % screen_output_interval == 0)
 			{
 				cout << fixed << setprecision(9) << "N=" << number_of_iterations << "	Time = "
-					<< GlobalStaticVariables::physical_time_
+					<< system.physical_time_
 					<< "	Dt = " << Dt << "	dt = " << dt << "	dt_s = " << dt_s << "\n";
 			}
 			number_of_iterations++;
@@ -488,10 +488,10 @@ int main()
 			update_gate_cell_linked_list.parallel_exec();
 			update_gate_interaction_configuration.parallel_exec();
 			/** Output the observed data. */
-			write_beam_tip_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+			write_beam_tip_displacement.WriteToFile(system.physical_time_);
 		}
 		tick_count t2 = tick_count::now();
-		write_real_body_states_to_vtu.WriteToFile(GlobalStaticVariables::physical_time_  * 0.001);
+		write_real_body_states_to_vtu.WriteToFile(system.physical_time_  * 0.001);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -500,5 +500,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
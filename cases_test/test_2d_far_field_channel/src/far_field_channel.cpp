@@ -0,0 +1,345 @@
+/**
+ * @file 	far_field_channel.cpp
+ * @brief 	2D flow around a cylinder in a channel with a SPH window.
+ * @details The flow in the channel is solved on the grid of a mesh system,
+ *			and by particles only in a window around the cylinder.
+ *			The particles enter the window from a buffer at its inflow face,
+ *			and are removed after leaving the window at its outflow face.
+ *			The test checks that the number of particles in the window stays balanced,
+ *			the flow stays bounded, the grid is synchronized with the particles,
+ *			and the pressure of the particles in the overlap zone follows that of the grid.
+ * @author 	Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DL = 20.0; 						/**< Channel length. */
+Real DH = 4.1; 							/**< Channel height. */
+Real WL = 6.0;							/**< Lower bound of the window in x direction. */
+Real WU = 12.0;							/**< Upper bound of the window in x direction. */
+Real particle_spacing_ref = 0.1; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width for BCs. */
+Real grid_spacing = particle_spacing_ref * 2.0;	/**< Grid spacing of the mesh system. */
+Real overlap_width = grid_spacing * 3.0;		/**< Width of the overlap zone. */
+Vec2d insert_circle_center(8.0, 2.05);	/**< Location of the cylinder center. */
+Real insert_circle_radius = 0.5;		/**< Radius of the cylinder. */
+/**
+ * @brief Material properties of the fluid.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real U_f = 1.0;							/**< Far-field velocity. */
+Real c_f = 10.0 * U_f;					/**< Reference sound speed. */
+Real Re = 100.0;						/**< Reynolds number. */
+Real mu_f = rho0_f * U_f * (2.0 * insert_circle_radius) / Re;	/**< Dynamics visocisty. */
+/**
+ * @brief 	Fluid body definition, only in the window.
+ */
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: FluidBody(sph_system, body_name, refinement_level, op)
+	{
+		/** Geomerty definition. */
+		std::vector<Point> water_block_shape;
+		water_block_shape.push_back(Point(WL, 0.0));
+		water_block_shape.push_back(Point(WL, DH));
+		water_block_shape.push_back(Point(WU, DH));
+		water_block_shape.push_back(Point(WU, 0.0));
+		water_block_shape.push_back(Point(WL, 0.0));
+		body_region_.add_geometry(new Geometry(water_block_shape), RegionBooleanOps::add);
+		body_region_.add_geometry(new Geometry(insert_circle_center, insert_circle_radius, 100), RegionBooleanOps::sub);
+
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		/** Basic material parameters*/
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+		mu_ = mu_f;
+
+		/** Compute the derived material parameters*/
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Wall boundary body definition, the channel walls in the window.
+ */
+class WallBoundary : public SolidBody
+{
+public:
+	WallBoundary(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		/** Geomerty definition. */
+		std::vector<Point> outer_wall_shape;
+		outer_wall_shape.push_back(Point(WL - BW, -BW));
+		outer_wall_shape.push_back(Point(WL - BW, DH + BW));
+		outer_wall_shape.push_back(Point(WU + BW, DH + BW));
+		outer_wall_shape.push_back(Point(WU + BW, -BW));
+		outer_wall_shape.push_back(Point(WL - BW, -BW));
+		body_region_.add_geometry(new Geometry(outer_wall_shape), RegionBooleanOps::add);
+
+		std::vector<Point> inner_wall_shape;
+		inner_wall_shape.push_back(Point(WL - 2.0 * BW, 0.0));
+		inner_wall_shape.push_back(Point(WL - 2.0 * BW, DH));
+		inner_wall_shape.push_back(Point(WU + 2.0 * BW, DH));
+		inner_wall_shape.push_back(Point(WU + 2.0 * BW, 0.0));
+		inner_wall_shape.push_back(Point(WL - 2.0 * BW, 0.0));
+		body_region_.add_geometry(new Geometry(inner_wall_shape), RegionBooleanOps::sub);
+
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Cylinder body definition.
+ */
+class Cylinder : public SolidBody
+{
+public:
+	Cylinder(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		/** Geomerty definition. */
+		body_region_.add_geometry(new Geometry(insert_circle_center, insert_circle_radius, 100), RegionBooleanOps::add);
+
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	The buffer at the inflow face of the window.
+ */
+class InflowBuffer : public BodyPartByParticle
+{
+public:
+	InflowBuffer(FluidBody* fluid_body, string constrianed_region_name)
+		: BodyPartByParticle(fluid_body, constrianed_region_name)
+	{
+		/** Geomerty definition. */
+		std::vector<Point> inflow_buffer_shape;
+		inflow_buffer_shape.push_back(Point(WL, 0.0));
+		inflow_buffer_shape.push_back(Point(WL, DH));
+		inflow_buffer_shape.push_back(Point(WL + BW, DH));
+		inflow_buffer_shape.push_back(Point(WL + BW, 0.0));
+		inflow_buffer_shape.push_back(Point(WL, 0.0));
+		body_part_region_.add_geometry(new Geometry(inflow_buffer_shape), RegionBooleanOps::add);
+		body_part_region_.done_modeling();
+		/**  Tag the buffer particles. */
+		TagBodyPartParticles();
+	}
+};
+/**
+ * @brief 	The particles start with the far-field velocity.
+ */
+class FarFieldInitialCondition
+	: public fluid_dynamics::WeaklyCompressibleFluidInitialCondition
+{
+public:
+	FarFieldInitialCondition(FluidBody *water)
+		: fluid_dynamics::WeaklyCompressibleFluidInitialCondition(water) {};
+protected:
+	void Update(size_t index_particle_i, Real dt) override
+	{
+		particles_->base_particle_data_[index_particle_i].vel_n_ = Vec2d(U_f, 0.0);
+	}
+};
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	/**
+	 * @brief Build up -- a SPHSystem -- covering the window only.
+	 */
+	SPHSystem system(Vec2d(WL - BW, -BW), Vec2d(WU + BW, DH + BW), particle_spacing_ref);
+	/**
+	 * @brief Material property, partilces and body creation of fluid.
+	 */
+	WaterBlock *water_block
+		= new WaterBlock(system, "WaterBody", 0, ParticlesGeneratorOps::lattice);
+	WaterMaterial 	*water_material = new WaterMaterial();
+	FluidParticles 	fluid_particles(water_block, water_material);
+	/**
+	 * @brief 	Particle and body creation of the channel walls and the cylinder.
+	 */
+	WallBoundary *wall_boundary
+		= new WallBoundary(system, "Wall", 0, ParticlesGeneratorOps::lattice);
+	SolidParticles 	wall_particles(wall_boundary);
+	Cylinder *cylinder
+		= new Cylinder(system, "Cylinder", 0, ParticlesGeneratorOps::lattice);
+	SolidParticles 	cylinder_particles(cylinder);
+	/**
+	 * @brief 	The mesh system covering the whole channel, and the window of particles.
+	 * The window extends beyond the channel walls, so that the overlap zone is only
+	 * along the inflow and outflow faces.
+	 */
+	MeshSystem mesh_system(Vec2d(0.0, 0.0), Vec2d(DL, DH), grid_spacing, water_material, Vec2d(U_f, 0.0));
+	mesh_system.setParticleRegion(Vec2d(WL, -DH), Vec2d(WU, 2.0 * DH), overlap_width);
+	/**
+	 * @brief 	Body contact map.
+	 */
+	SPHBodyTopology body_topology = { { water_block, { wall_boundary, cylinder } },
+		{ wall_boundary, { } }, { cylinder, { } } };
+	system.SetBodyTopology(&body_topology);
+	/**
+	 * @brief 	Define all numerical methods which are used in this case.
+	 */
+	FarFieldInitialCondition	set_far_field_velocity(water_block);
+	solid_dynamics::NormalDirectionSummation 	get_wall_normal(wall_boundary, {});
+	solid_dynamics::NormalDirectionSummation 	get_cylinder_normal(cylinder, {});
+	InitializeATimeStep 	initialize_a_fluid_step(water_block);
+	fluid_dynamics::DensityBySummationFreeSurface 	update_fluid_density(water_block, { wall_boundary, cylinder });
+	fluid_dynamics::GetAdvectionTimeStepSize 	get_fluid_adevction_time_step_size(water_block, U_f);
+	fluid_dynamics::GetAcousticTimeStepSize 	get_fluid_time_step_size(water_block);
+	fluid_dynamics::PressureRelaxationFirstHalf
+		pressure_relaxation_first_half(water_block, { wall_boundary, cylinder });
+	fluid_dynamics::PressureRelaxationSecondHalf
+		pressure_relaxation_second_half(water_block, { wall_boundary, cylinder });
+	fluid_dynamics::ComputingViscousAcceleration 	viscous_acceleration(water_block, { wall_boundary, cylinder });
+	ParticleDynamicsCellLinkedList		update_cell_linked_list(water_block);
+	ParticleDynamicsConfiguration 		update_particle_configuration(water_block);
+	/**
+	 * @brief 	Coupling with the mesh system.
+	 */
+	InflowBuffer *inflow_buffer = new InflowBuffer(water_block, "InflowBuffer");
+	fluid_dynamics::FarFieldBufferCondition		far_field_buffer(water_block, inflow_buffer, mesh_system);
+	fluid_dynamics::FarFieldBufferInjecting		buffer_injecting(water_block, inflow_buffer, 5, 0, true);
+	fluid_dynamics::FarFieldOutflowRemoving		outflow_removing(water_block, mesh_system);
+	fluid_dynamics::FarFieldOverlapCondition	far_field_overlap(water_block, mesh_system);
+	/**
+	 * @brief Output.
+	 */
+	In_Output in_output(system);
+	WriteBodyStatesToVtu 	write_real_body_states(in_output, system.real_bodies_);
+	WriteMeshSystemToPlt 	write_mesh_system(in_output, mesh_system, "ChannelGrid");
+
+	/** Pre-simulation*/
+	set_far_field_velocity.exec();
+	system.InitializeSystemCellLinkedLists();
+	system.InitializeSystemConfigurations();
+	get_wall_normal.exec();
+	get_cylinder_normal.exec();
+	mesh_system.UpdateCoveredCellsFromParticles(water_block);
+	size_t initial_number_of_particles = water_block->number_of_particles_;
+
+	write_real_body_states.WriteToFile(system.physical_time_);
+	write_mesh_system.WriteToFile(system.physical_time_);
+
+	int number_of_iterations = 0;
+	int screen_output_interval = 100;
+	Real End_Time = 10.0;			/**< The flow passes the window more than once. */
+	Real D_Time = 1.0;				/**< Time stamps for output. */
+	Real Dt = 0.0;					/**< Default advection time step sizes. */
+	Real dt = 0.0; 					/**< Default accoustic time step sizes. */
+	/** The pressure difference between the particles in the outer half of the overlap zone and the grid,
+	  * averaged over the second half of the simulation. */
+	Real overlap_pressure_difference = 0.0;
+	size_t number_of_overlap_samples = 0;
+	tick_count t1 = tick_count::now();
+	tick_count::interval_t interval;
+
+	while (system.physical_time_ < End_Time)
+	{
+		Real integeral_time = 0.0;
+		while (integeral_time < D_Time)
+		{
+			initialize_a_fluid_step.parallel_exec();
+			Dt = get_fluid_adevction_time_step_size.parallel_exec();
+			update_fluid_density.parallel_exec();
+			/** After the density summation, which otherwise overwrites the density from the grid. */
+			far_field_overlap.parallel_exec();
+			viscous_acceleration.parallel_exec();
+
+			Real relaxation_time = 0.0;
+			while (relaxation_time < Dt)
+			{
+				pressure_relaxation_first_half.parallel_exec(dt);
+				pressure_relaxation_second_half.parallel_exec(dt);
+				dt = get_fluid_time_step_size.parallel_exec();
+				relaxation_time += dt;
+				integeral_time += dt;
+				system.physical_time_ += dt;
+				far_field_buffer.parallel_exec();
+			}
+
+			if (number_of_iterations % screen_output_interval == 0)
+			{
+				cout << fixed << setprecision(9) << "N=" << number_of_iterations << "	Time = "
+					<< system.physical_time_ << "	Dt = " << Dt << "	dt = " << dt
+					<< "	Particles = " << water_block->number_of_particles_ << "\n";
+			}
+			number_of_iterations++;
+
+			/** The grid is advanced to the time of the particles before the states are exchanged. */
+			mesh_system.IntegrateToTime(system.physical_time_);
+			if (system.physical_time_ > 0.5 * End_Time)
+			{
+				for (size_t i = 0; i != water_block->number_of_particles_; ++i)
+				{
+					Vecd& position = fluid_particles.base_particle_data_[i].pos_n_;
+					if (mesh_system.getOverlapWeight(position) < 0.5) continue;
+					Real grid_rho;
+					Vecd grid_velocity;
+					mesh_system.InterpolateState(position, grid_rho, grid_velocity);
+					overlap_pressure_difference 
+						+= fabs(fluid_particles.fluid_particle_data_[i].p_ - water_material->GetPressure(grid_rho));
+					number_of_overlap_samples++;
+				}
+			}
+			buffer_injecting.exec();
+			outflow_removing.exec();
+
+			update_cell_linked_list.parallel_exec();
+			update_particle_configuration.parallel_exec();
+			mesh_system.UpdateCoveredCellsFromParticles(water_block);
+		}
+
+		tick_count t2 = tick_count::now();
+		write_real_body_states.WriteToFile(system.physical_time_);
+		write_mesh_system.WriteToFile(system.physical_time_);
+		tick_count t3 = tick_count::now();
+		interval += t3 - t2;
+	}
+	tick_count t4 = tick_count::now();
+
+	tick_count::interval_t tt;
+	tt = t4 - t1 - interval;
+	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
+
+	/** The particles entering and leaving the window are balanced, and the flow is bounded. */
+	Real particle_ratio = Real(water_block->number_of_particles_) / Real(initial_number_of_particles);
+	Real max_speed = 0.0;
+	for (size_t i = 0; i != water_block->number_of_particles_; ++i)
+		max_speed = SMAX(max_speed, fluid_particles.base_particle_data_[i].vel_n_.norm());
+	bool is_synchronized = fabs(mesh_system.getPhysicalTime() - system.physical_time_) < 1.0e-12;
+	/** scaled by the dynamic pressure */
+	Real overlap_pressure_error = overlap_pressure_difference / Real(SMAX(number_of_overlap_samples, size_t(1)))
+		/ (0.5 * rho0_f * U_f * U_f);
+	bool is_passed = particle_ratio > 0.9 && particle_ratio < 1.1 && max_speed < 3.0 * U_f && is_synchronized
+		&& number_of_overlap_samples != 0 && overlap_pressure_error < 0.05;
+	cout << "Particle number ratio " << particle_ratio << ", maximum speed " << max_speed
+		<< ", grid time " << mesh_system.getPhysicalTime() 
+		<< ", overlap pressure error " << overlap_pressure_error << (is_passed ? ", passed.\n" : ", failed!\n");
+
+	return is_passed ? 0 : 1;
+}
@@ -249,7 +249,7 @@ int main(int ac, char* av[])
 	 * @brief The time stepping starts here.
 	 */
 	if (system.restart_step_ != 0) {
-		GlobalStaticVariables::physical_time_ = read_restart_files.ReadRestartFiles(system.restart_step_);
+		system.physical_time_ = read_restart_files.ReadRestartFiles(system.restart_step_);
 		update_inserted_body_cell_linked_list.parallel_exec();
 		update_water_block_cell_linked_list.parallel_exec();
 		periodic_condition.parallel_exec();
@@ -259,8 +259,8 @@ int main(int ac, char* av[])
 		inserted_body_update_normal.parallel_exec();
 	}
 	/** first output*/
-	write_real_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
-	write_beam_tip_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_real_body_states.WriteToFile(system.physical_time_);
+	write_beam_tip_displacement.WriteToFile(system.physical_time_);
 
 	int number_of_iterations = system.restart_step_;
 	int screen_output_interval = 100;
@@ -278,7 +278,7 @@ int main(int ac, char* av[])
 	/**
 	 * @brief Main loop starts here.
 	 */
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		/** Integrate time (loop) until the next output time. */
@@ -322,7 +322,7 @@ int main(int ac, char* av[])
 				dt = get_fluid_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 				parabolic_inflow.parallel_exec();
 				inner_ite_dt++;
 			}
@@ -330,7 +330,7 @@ int main(int ac, char* av[])
 			if (number_of_iterations % screen_output_interval == 0)
 			{
 				cout << fixed << setprecision(9) << "N=" << number_of_iterations << "	Time = "
-					<< GlobalStaticVariables::physical_time_
+					<< system.physical_time_
 					<< "	Dt = " << Dt << "	Dt / dt = " << inner_ite_dt << "	dt / dt_s = " << inner_ite_dt_s << "\n";
 
 				if (number_of_iterations % restart_output_interval == 0 && number_of_iterations != system.restart_step_)
@@ -347,16 +347,16 @@ int main(int ac, char* av[])
 			update_inserted_body_cell_linked_list.parallel_exec();
 			update_inserted_body_contact_configuration.parallel_exec();
 			/** write run-time observation into file */
-			write_beam_tip_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+			write_beam_tip_displacement.WriteToFile(system.physical_time_);
 		}
 
 		tick_count t2 = tick_count::now();
 		/** write run-time observation into file */
 		compute_vorticity.parallel_exec();
-		write_real_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
-		write_total_viscous_force_on_inserted_body.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_real_body_states.WriteToFile(system.physical_time_);
+		write_total_viscous_force_on_inserted_body.WriteToFile(system.physical_time_);
 		update_fluid_observer_body_contact_configuration.parallel_exec();
-		write_fluid_velocity.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_fluid_velocity.WriteToFile(system.physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -366,6 +366,8 @@ int main(int ac, char* av[])
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
 
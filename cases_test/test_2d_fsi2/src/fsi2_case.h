@@ -181,9 +181,10 @@ public:
 class InsertBodyMaterial : public LinearElasticSolid
 {
 public:
-	InsertBodyMaterial() : LinearElasticSolid()
+	/** The density can be given, e.g. for a beam lighter than the fluid. */
+	explicit InsertBodyMaterial(Real rho_0 = rho0_s) : LinearElasticSolid()
 	{
-		rho_0_ = rho0_s;
+		rho_0_ = rho_0;
 		E_0_ = Youngs_modulus;
 		nu_ = poisson;
 
@@ -249,7 +250,7 @@ public:
 	}
 	void PrepareConstraint() override
 	{
-		Real run_time = GlobalStaticVariables::physical_time_;
+		Real run_time = body_->getSPHSystem().physical_time_;
 		u_ave_ = run_time < t_ref ? 0.5 * u_ref_ * (1.0 - cos(pi * run_time / t_ref)) : u_ref_;
 	}
 };
@@ -0,0 +1,211 @@
+/**
+ * @file 	fsi2_light_beam.cpp
+ * @brief 	This is the test of strong fliud-structure interaction with a light structure.
+ * @details We consider a flow-induced vibration of an elastic beam behind a cylinder in 2D,
+ *			as in the case fsi2, but the beam is lighter than the fluid. Due to the added-mass effect,
+ *			the explicit coupling is unstable, and the coupling is sub-iterated by Aitken relaxation.
+ *			The beam is checked to stay bounded, the interface velocity to converge to the average 
+ *			velocity of the beam in every fluid acoustic time step, and the fluid load 
+ *			to depend on the interface velocity, so that more than two sub-iterations are needed.
+ * @author 	Xiangyu Hu, Chi Zhang and Luhui Han
+ * @version 0.1
+ */
+#include "sphinxsys.h"
+
+/** case file of fsi2 to setup the test case */
+#include "../../test_2d_fsi2/src/fsi2_case.h"
+
+using namespace SPH;
+
+Real rho0_s_light = 0.1; 		/**< Reference density of the beam, much smaller than that of the fluid.*/
+Real tolerance = 1.0e-3;		/**< Relative tolerance of the sub-iterations. */
+size_t max_sub_iterations = 10;	/**< Maximum number of sub-iterations. */
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	Real End_Time = 10.0;			/**< End time. */
+	/** Build up -- a SPHSystem -- */
+	SPHSystem system(Vec2d(-DLsponge - BW, -BW), Vec2d(DL + BW, DH + BW), particle_spacing_ref);
+	/**
+	 * @brief Creating body, materials and particles for a water block.
+	 */
+	WaterBlock* water_block
+		= new WaterBlock(system, "WaterBody", 0, ParticlesGeneratorOps::lattice);
+	WaterMaterial* water_material = new WaterMaterial();
+	FluidParticles 	fluid_particles(water_block, water_material);
+	/**
+	 * @brief 	Creating body and particles for the wall boundary.
+	 */
+	WallBoundary* wall_boundary
+		= new WallBoundary(system, "Wall", 0, ParticlesGeneratorOps::lattice);
+	SolidParticles 	solid_particles(wall_boundary);
+	/**
+	 * @brief 	Creating body, materials and particles for the elastic beam (inserted body).
+	 */
+	InsertedBody* inserted_body = new InsertedBody(system, "InsertedBody", 1, ParticlesGeneratorOps::lattice);
+	InsertBodyMaterial* insert_body_material = new InsertBodyMaterial(rho0_s_light);
+	ElasticSolidParticles 	inserted_body_particles(inserted_body, insert_body_material);
+	/**
+	 * @brief 	Body contact map.
+	 */
+	SPHBodyTopology body_topology = { { water_block, { wall_boundary, inserted_body } },
+									  { wall_boundary, { } }, { inserted_body, { water_block } } };
+	system.SetBodyTopology(&body_topology);
+	/**
+	 * @brief 	Methods used for general methods.
+	 */
+	ParticleDynamicsCellLinkedList 			update_water_block_cell_linked_list(water_block);
+	ParticleDynamicsCellLinkedList 			update_inserted_body_cell_linked_list(inserted_body);
+	ParticleDynamicsConfiguration 			update_water_block_configuration(water_block);
+	ParticleDynamicsContactConfiguration 	update_inserted_body_contact_configuration(inserted_body);
+	PeriodicBoundingInAxisDirection 	periodic_bounding(water_block, 0);
+	PeriodicConditionInAxisDirection 	periodic_condition(water_block, 0);
+	/**
+	 * @brief 	Define all numerical methods which are used in FSI.
+	 */
+	solid_dynamics::NormalDirectionSummation 	get_wall_normal(wall_boundary, {});
+	solid_dynamics::NormalDirectionSummation 	get_inserted_body_normal(inserted_body, {});
+	solid_dynamics::CorrectConfiguration 		inserted_body_corrected_configuration_in_strong_form(inserted_body);
+	/**
+	 * @brief 	Methods used for time stepping.
+	 */
+	InitializeATimeStep 	initialize_a_fluid_step(water_block);
+	fluid_dynamics::DensityBySummation 			update_fluid_desnity(water_block, { wall_boundary, inserted_body });
+	fluid_dynamics::GetAdvectionTimeStepSize 	get_fluid_adevction_time_step_size(water_block, U_f);
+	fluid_dynamics::GetAcousticTimeStepSize		get_fluid_time_step_size(water_block);
+	fluid_dynamics::PressureRelaxationFirstHalf
+		pressure_relaxation_first_half(water_block, { wall_boundary, inserted_body });
+	fluid_dynamics::PressureRelaxationSecondHalf
+		pressure_relaxation_second_half(water_block, { wall_boundary, inserted_body });
+	fluid_dynamics::ComputingViscousAcceleration 	viscous_acceleration(water_block, { wall_boundary, inserted_body });
+	fluid_dynamics::TransportVelocityCorrection 	transport_velocity_correction(water_block, { wall_boundary, inserted_body });
+	ParabolicInflow		parabolic_inflow(water_block, new InflowBuffer(water_block, "Buffer"));
+	/**
+	 * @brief Algorithms of FSI.
+	 */
+	/** The fluid load depends on the interface velocity by the Riemann pressure. */
+	solid_dynamics::FluidPressureForceOnSolidRiemann 	fluid_pressure_force_on_insrted_body(inserted_body, { water_block });
+	solid_dynamics::FluidViscousForceOnSolid 	fluid_viscous_force_on_insrted_body(inserted_body, { water_block });
+	solid_dynamics::InitializeDisplacement 			inserted_body_initialize_displacement(inserted_body);
+	solid_dynamics::UpdateAverageVelocity 			inserted_body_average_velocity(inserted_body);
+	/** Sub-iterated coupling within a fluid acoustic time step. */
+	solid_dynamics::StrongFSICouplingByAitkenRelaxation
+		strong_coupling(inserted_body, { water_block }, tolerance, max_sub_iterations);
+	/**
+	 * @brief Algorithms of solid dynamics.
+	 */
+	solid_dynamics::GetAcousticTimeStepSize 	inserted_body_computing_time_step_size(inserted_body);
+	solid_dynamics::StressRelaxationFirstHalf 	inserted_body_stress_relaxation_first_half(inserted_body);
+	solid_dynamics::StressRelaxationSecondHalf 	inserted_body_stress_relaxation_second_half(inserted_body);
+	solid_dynamics::ConstrainSolidBodyRegion
+		constrain_beam_base(inserted_body, new BeamBase(inserted_body, "BeamBase"));
+	solid_dynamics::UpdateElasticNormalDirection 	inserted_body_update_normal(inserted_body);
+	/**
+	 * @brief Pre-simulation.
+	 */
+	system.InitializeSystemCellLinkedLists();
+	periodic_condition.parallel_exec();
+	system.InitializeSystemConfigurations();
+	get_wall_normal.parallel_exec();
+	get_inserted_body_normal.parallel_exec();
+	inserted_body_corrected_configuration_in_strong_form.parallel_exec();
+
+	/** The beam is unstable if its states are not finite, too fast or too far from its initial position. */
+	auto isBeamStable = [&]() {
+		for (size_t i = 0; i != inserted_body->number_of_particles_; ++i)
+		{
+			BaseParticleData& base_particle_data_i = inserted_body_particles.base_particle_data_[i];
+			Real speed = base_particle_data_i.vel_n_.norm();
+			Real displacement = (base_particle_data_i.pos_n_ - base_particle_data_i.pos_0_).norm();
+			if (!std::isfinite(speed) || !std::isfinite(displacement) || speed > 10.0 * U_f || displacement > bl)
+				return false;
+		}
+		return true;
+	};
+
+	Real Dt = 0.0;					/**< Default advection time step sizes for fluid. */
+	Real dt = 0.0; 					/**< Default acoustic time step sizes for fluid. */
+	Real dt_s = 0.0;				/**< Default acoustic time step sizes for solid. */
+	size_t number_of_acoustic_steps = 0;
+	size_t number_of_sub_iterations = 0;
+	size_t max_number_of_sub_iterations = 0;
+	size_t number_of_unconverged_steps = 0;
+	bool is_stable = true;
+	/**
+	 * @brief Main loop starts here.
+	 */
+	while (system.physical_time_ < End_Time && is_stable)
+	{
+		initialize_a_fluid_step.parallel_exec();
+		Dt = get_fluid_adevction_time_step_size.parallel_exec();
+		update_fluid_desnity.parallel_exec();
+		viscous_acceleration.parallel_exec();
+		transport_velocity_correction.parallel_exec(Dt);
+
+		fluid_viscous_force_on_insrted_body.parallel_exec();
+		inserted_body_update_normal.parallel_exec();
+		Real relaxation_time = 0.0;
+		while (relaxation_time < Dt) {
+			strong_coupling.InitializeSubIterations();
+			do {
+				strong_coupling.PrepareSubIteration();
+				/** The repeated sub-iterations are carried out only for the fluid in the interface neighborhood,
+				  * with the first half also for its halo. */
+				if (strong_coupling.getNumberOfSubIterations() == 0)
+				{
+					pressure_relaxation_first_half.parallel_exec(dt);
+					fluid_pressure_force_on_insrted_body.parallel_exec();
+					pressure_relaxation_second_half.parallel_exec(dt);
+				}
+				else
+				{
+					pressure_relaxation_first_half
+						.parallel_exec_by_particles(strong_coupling.getInterfaceNeighborhoodWithHalo(0), dt);
+					fluid_pressure_force_on_insrted_body.parallel_exec();
+					pressure_relaxation_second_half
+						.parallel_exec_by_particles(strong_coupling.getInterfaceNeighborhood(0), dt);
+				}
+
+				Real dt_s_sum = 0.0;
+				inserted_body_initialize_displacement.parallel_exec();
+				while (dt_s_sum < dt) {
+					dt_s = inserted_body_computing_time_step_size.parallel_exec();
+					if (dt - dt_s_sum < dt_s) dt_s = dt - dt_s_sum;
+					inserted_body_stress_relaxation_first_half.parallel_exec(dt_s);
+					constrain_beam_base.parallel_exec();
+					inserted_body_stress_relaxation_second_half.parallel_exec(dt_s);
+					dt_s_sum += dt_s;
+				}
+				inserted_body_average_velocity.parallel_exec(dt);
+				strong_coupling.parallel_exec(dt);
+			} while (!strong_coupling.isConverged());
+			number_of_sub_iterations += strong_coupling.getNumberOfSubIterations();
+			max_number_of_sub_iterations = SMAX(max_number_of_sub_iterations, strong_coupling.getNumberOfSubIterations());
+			if (strong_coupling.getRelativeResidual() > tolerance) number_of_unconverged_steps++;
+			number_of_acoustic_steps++;
+
+			dt = get_fluid_time_step_size.parallel_exec();
+			relaxation_time += dt;
+			system.physical_time_ += dt;
+			parabolic_inflow.parallel_exec();
+		}
+		is_stable = isBeamStable();
+
+		periodic_bounding.parallel_exec();
+		update_water_block_cell_linked_list.parallel_exec();
+		periodic_condition.parallel_exec();
+		update_water_block_configuration.parallel_exec();
+		update_inserted_body_cell_linked_list.parallel_exec();
+		update_inserted_body_contact_configuration.parallel_exec();
+	}
+
+	bool is_passed = is_stable && number_of_unconverged_steps == 0 && max_number_of_sub_iterations > 2;
+	cout << fixed << setprecision(6) << "Light beam " << (is_stable ? "stable" : "unstable")
+		<< " at time " << system.physical_time_ << ", averaged sub-iterations " 
+		<< Real(number_of_sub_iterations) / Real(number_of_acoustic_steps) << ", maximum sub-iterations " 
+		<< max_number_of_sub_iterations << ", " << number_of_unconverged_steps << " unconverged steps"
+		<< (is_passed ? ", passed.\n" : ", failed!\n");
+	return is_passed ? 0 : 1;
+}
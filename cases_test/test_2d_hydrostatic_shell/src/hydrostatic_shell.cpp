@@ -0,0 +1,364 @@
+/**
+ * @file 	hydrostatic_shell.cpp
+ * @brief 	Test of a shell as the fluid wall.
+ * @details A water column is at rest under gravity on an elastic plate, which is modeled by
+ *			a single layer of shell particles clamped at both ends under the side walls.
+ *			The time-averaged force from the fluid on the plate should be the weight of the water,
+ *			and the fluid particles should not penetrate the plate.
+ * @author 	Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DH = 1.4; 							/**< Tank height. */
+Real LL = 2.0; 							/**< Liquid colume length. */
+Real LH = 1.0; 							/**< Liquid colume height. */
+Real particle_spacing_ref = 0.05; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width for BCs. */
+Real PH = 0.05;							/**< Plate thickness. */
+Real plate_y = -0.5 * particle_spacing_ref;	/**< Plate mid-surface, where the first layer of wall particles is. */
+/**
+ * @brief Material properties of the fluid and the plate.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real gravity_g = 1.0;					/**< Gravity force of fluid. */
+Real U_f = 2.0*sqrt(gravity_g*LH);		/**< Characteristic velocity. */
+Real c_f = 10.0*U_f;					/**< Reference sound speed. */
+Real rho0_s = 10.0;						/**< Reference density of the plate. */
+Real Youngs_modulus = 1.0e6;			/**< Youngs modulus of the plate. */
+Real poisson = 0.3;						/**< Poisson ratio of the plate. */
+/**
+ * @brief 	Fluid body definition.
+ */
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: FluidBody(sph_system, body_name, refinement_level, op)
+	{
+		/** Geomerty definition. */
+		std::vector<Point> water_block_shape;
+		water_block_shape.push_back(Point(0.0, 0.0));
+		water_block_shape.push_back(Point(0.0, LH));
+		water_block_shape.push_back(Point(LL, LH));
+		water_block_shape.push_back(Point(LL, 0.0));
+		water_block_shape.push_back(Point(0.0, 0.0));
+		Geometry *water_block_geometry = new Geometry(water_block_shape);
+		body_region_.add_geometry(water_block_geometry, RegionBooleanOps::add);
+
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		/** Basic material parameters*/
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+
+		/** Compute the derived material parameters*/
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Side walls definition.
+ */
+class SideWalls : public SolidBody
+{
+public:
+	SideWalls(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		/** Geomerty definition. */
+		std::vector<Point> left_wall_shape;
+		left_wall_shape.push_back(Point(-BW, 0.0));
+		left_wall_shape.push_back(Point(-BW, DH));
+		left_wall_shape.push_back(Point(0.0, DH));
+		left_wall_shape.push_back(Point(0.0, 0.0));
+		left_wall_shape.push_back(Point(-BW, 0.0));
+		body_region_.add_geometry(new Geometry(left_wall_shape), RegionBooleanOps::add);
+
+		std::vector<Point> right_wall_shape;
+		right_wall_shape.push_back(Point(LL, 0.0));
+		right_wall_shape.push_back(Point(LL, DH));
+		right_wall_shape.push_back(Point(LL + BW, DH));
+		right_wall_shape.push_back(Point(LL + BW, 0.0));
+		right_wall_shape.push_back(Point(LL, 0.0));
+		body_region_.add_geometry(new Geometry(right_wall_shape), RegionBooleanOps::add);
+
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	The plate under the water and the side walls, defined by the particles on its mid-line.
+ */
+class Plate : public SolidBody
+{
+public:
+	Plate(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		/** the volume is that of a lattice particle */
+		Real volume = particle_spacing_ref * particle_spacing_ref;
+		for (Real x = -BW + 0.5 * particle_spacing_ref; x < LL + BW; x += particle_spacing_ref)
+			body_input_points_volumes_.push_back(make_pair(Point(x, plate_y), volume));
+	}
+};
+/**
+ * @brief Define plate material.
+ */
+class PlateMaterial : public LinearElasticSolid
+{
+public:
+	PlateMaterial() : LinearElasticSolid()
+	{
+		rho_0_ = rho0_s;
+		E_0_ = Youngs_modulus;
+		nu_ = poisson;
+
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief define the plate ends under the side walls, which are clamped.
+ */
+class PlateEnds : public BodyPartByParticle
+{
+public:
+	PlateEnds(SolidBody *solid_body, string constrianed_region_name)
+		: BodyPartByParticle(solid_body, constrianed_region_name)
+	{
+		std::vector<Point> left_end_shape;
+		left_end_shape.push_back(Point(-BW, plate_y - BW));
+		left_end_shape.push_back(Point(-BW, plate_y + BW));
+		left_end_shape.push_back(Point(0.0, plate_y + BW));
+		left_end_shape.push_back(Point(0.0, plate_y - BW));
+		left_end_shape.push_back(Point(-BW, plate_y - BW));
+		body_part_region_.add_geometry(new Geometry(left_end_shape), RegionBooleanOps::add);
+
+		std::vector<Point> right_end_shape;
+		right_end_shape.push_back(Point(LL, plate_y - BW));
+		right_end_shape.push_back(Point(LL, plate_y + BW));
+		right_end_shape.push_back(Point(LL + BW, plate_y + BW));
+		right_end_shape.push_back(Point(LL + BW, plate_y - BW));
+		right_end_shape.push_back(Point(LL, plate_y - BW));
+		body_part_region_.add_geometry(new Geometry(right_end_shape), RegionBooleanOps::add);
+
+		/** Finish the region modeling. */
+		body_part_region_.done_modeling();
+
+		//tag the constrained particle
+		TagBodyPartParticles();
+	}
+};
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	/**
+	 * @brief Build up -- a SPHSystem --
+	 */
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(LL + BW, DH + BW), particle_spacing_ref);
+	/** Set the starting time. */
+	sph_system.physical_time_ = 0.0;
+	/**
+	 * @brief Material property, partilces and body creation of fluid.
+	 */
+	WaterBlock *water_block
+		= new WaterBlock(sph_system, "WaterBody", 0, ParticlesGeneratorOps::lattice);
+	WaterMaterial 	*water_material = new WaterMaterial();
+	FluidParticles 	fluid_particles(water_block, water_material);
+	/**
+	 * @brief 	Particle and body creation of side walls.
+	 */
+	SideWalls *side_walls
+		= new SideWalls(sph_system, "SideWalls", 0, ParticlesGeneratorOps::lattice);
+	SolidParticles 	side_wall_particles(side_walls);
+	/**
+	 * @brief 	Shell particle and body creation of the plate.
+	 */
+	Plate *plate = new Plate(sph_system, "Plate", 0, ParticlesGeneratorOps::direct);
+	PlateMaterial 	*plate_material = new PlateMaterial();
+	ShellParticles 	plate_particles(plate, plate_material, PH);
+	/**
+	 * @brief 	Body contact map.
+	 */
+	SPHBodyTopology 	body_topology = { { water_block, { side_walls, plate } },
+										  { side_walls, {} }, { plate, { water_block } } };
+	sph_system.SetBodyTopology(&body_topology);
+
+	/**
+	 * @brief 	Define all numerical methods which are used in this case.
+	 */
+	 /** Define external force. */
+	Gravity 							gravity(Vecd(0.0, -gravity_g));
+	/** Initialize normal direction of the side walls, the normal of the plate is given by the shell particles. */
+	solid_dynamics::NormalDirectionSummation 	get_wall_normal(side_walls, {});
+	/** Corrected configuration of the plate, with the scaling of the fluid force on the single layer. */
+	thin_structure_dynamics::ShellCorrectConfiguration 	plate_corrected_configuration_in_strong_form(plate);
+	/** Initialize particle acceleration. */
+	InitializeATimeStep 	initialize_a_fluid_step(water_block, &gravity);
+	/**
+	 * @brief 	Algorithms of fluid dynamics.
+	 */
+	fluid_dynamics::DensityBySummationFreeSurface 		update_fluid_density(water_block, { side_walls, plate });
+	fluid_dynamics::GetAdvectionTimeStepSize 			get_fluid_adevction_time_step_size(water_block, U_f);
+	fluid_dynamics::GetAcousticTimeStepSize 			get_fluid_time_step_size(water_block);
+	fluid_dynamics::PressureRelaxationFirstHalfRiemann
+		pressure_relaxation_first_half(water_block, { side_walls, plate });
+	fluid_dynamics::PressureRelaxationSecondHalfRiemann
+		pressure_relaxation_second_half(water_block, { side_walls, plate });
+	/**
+	 * @brief 	Algorithms of the plate and of the fluid-structure interaction.
+	 */
+	thin_structure_dynamics::ShellAcousticTimeStepSize 	plate_computing_time_step_size(plate);
+	thin_structure_dynamics::ShellStressRelaxationFirstHalf 	plate_stress_relaxation_first_half(plate);
+	thin_structure_dynamics::ShellStressRelaxationSecondHalf 	plate_stress_relaxation_second_half(plate);
+	thin_structure_dynamics::ConstrainShellBodyRegion 	constrain_plate_ends(plate, new PlateEnds(plate, "PlateEnds"));
+	solid_dynamics::FluidPressureForceOnSolid 	fluid_pressure_force_on_plate(plate, { water_block });
+	solid_dynamics::InitializeDisplacement 		plate_initialize_displacement(plate);
+	solid_dynamics::UpdateAverageVelocity 		plate_average_velocity(plate);
+	solid_dynamics::TotalForceOnSolid 			compute_total_force_on_plate(plate);
+	/**
+	 * @brief 	Methods used for updating data structure.
+	 */
+	ParticleDynamicsCellLinkedList			update_water_block_cell_linked_list(water_block);
+	ParticleDynamicsConfiguration 			update_water_block_configuration(water_block);
+	ParticleDynamicsCellLinkedList			update_plate_cell_linked_list(plate);
+	ParticleDynamicsContactConfiguration 	update_plate_contact_configuration(plate);
+	/**
+	 * @brief Output.
+	 */
+	In_Output in_output(sph_system);
+	WriteBodyStatesToVtu 		write_body_states(in_output, sph_system.real_bodies_);
+
+	/** Pre-simulation*/
+	sph_system.InitializeSystemCellLinkedLists();
+	sph_system.InitializeSystemConfigurations();
+	get_wall_normal.exec();
+	plate_corrected_configuration_in_strong_form.parallel_exec();
+
+	write_body_states.WriteToFile(sph_system.physical_time_);
+	/**
+	 * @brief 	Basic parameters.
+	 */
+	int number_of_iterations = 0;
+	int screen_output_interval = 100;
+	Real End_Time = 10.0; 	/**< End time. */
+	Real Average_Time = 5.0;	/**< The force on the plate is averaged after this time. */
+	Real D_Time = 0.5;		/**< Time stamps for output of body states. */
+	Real Dt = 0.0;			/**< Default advection time step sizes. */
+	Real dt = 0.0; 			/**< Default accoustic time step sizes. */
+	Real dt_s = 0.0;		/**< Default acoustic time step sizes for the plate. */
+	/** The time integral of the force on the plate and the lowest fluid particle. */
+	Vecd force_integral(0);
+	Real averaging_time = 0.0;
+	Real lowest_fluid_position = LH;
+	/** statistics for computing CPU time. */
+	tick_count t1 = tick_count::now();
+	tick_count::interval_t interval;
+	/**
+	 * @brief 	Main loop starts here.
+	 */
+	while (sph_system.physical_time_ < End_Time)
+	{
+		Real integeral_time = 0.0;
+		/** Integrate time (loop) until the next output time. */
+		while (integeral_time < D_Time)
+		{
+			initialize_a_fluid_step.parallel_exec();
+			Dt = get_fluid_adevction_time_step_size.parallel_exec();
+			update_fluid_density.parallel_exec();
+
+			Real relaxation_time = 0.0;
+			while (relaxation_time < Dt)
+			{
+				pressure_relaxation_first_half.parallel_exec(dt);
+				fluid_pressure_force_on_plate.parallel_exec();
+				pressure_relaxation_second_half.parallel_exec(dt);
+
+				/** The plate dynamics. */
+				Real dt_s_sum = 0.0;
+				plate_initialize_displacement.parallel_exec();
+				while (dt_s_sum < dt) {
+					dt_s = plate_computing_time_step_size.parallel_exec();
+					if (dt - dt_s_sum < dt_s) dt_s = dt - dt_s_sum;
+					plate_stress_relaxation_first_half.parallel_exec(dt_s);
+					constrain_plate_ends.parallel_exec();
+					plate_stress_relaxation_second_half.parallel_exec(dt_s);
+					dt_s_sum += dt_s;
+				}
+				plate_average_velocity.parallel_exec(dt);
+
+				if (sph_system.physical_time_ > Average_Time)
+				{
+					force_integral += compute_total_force_on_plate.parallel_exec() * dt;
+					averaging_time += dt;
+				}
+
+				dt = get_fluid_time_step_size.parallel_exec();
+				relaxation_time += dt;
+				integeral_time += dt;
+				sph_system.physical_time_ += dt;
+			}
+
+			if (number_of_iterations % screen_output_interval == 0)
+			{
+				cout << fixed << setprecision(9) << "N=" << number_of_iterations << "	Time = "
+					<< sph_system.physical_time_
+					<< "	Dt = " << Dt << "	dt = " << dt << "	dt_s = " << dt_s << "\n";
+			}
+			number_of_iterations++;
+
+			for (size_t i = 0; i != water_block->number_of_particles_; ++i)
+				lowest_fluid_position = SMIN(lowest_fluid_position, fluid_particles.base_particle_data_[i].pos_n_[1]);
+
+			/** Update cell linked list and configuration. */
+			update_water_block_cell_linked_list.parallel_exec();
+			update_water_block_configuration.parallel_exec();
+			update_plate_cell_linked_list.parallel_exec();
+			update_plate_contact_configuration.parallel_exec();
+		}
+
+		tick_count t2 = tick_count::now();
+		write_body_states.WriteToFile(sph_system.physical_time_);
+		tick_count t3 = tick_count::now();
+		interval += t3 - t2;
+	}
+	tick_count t4 = tick_count::now();
+
+	tick_count::interval_t tt;
+	tt = t4 - t1 - interval;
+	cout << "Total wall time for computation: " << tt.seconds()
+		<< " seconds." << endl;
+
+	/** The force on the plate is the weight of the water above. */
+	Real water_weight = rho0_f * gravity_g * LH * LL;
+	Real averaged_force = -force_integral[1] / averaging_time;
+	bool is_force_passed = ABS(averaged_force - water_weight) <= 0.05 * water_weight;
+	bool is_penetration_free = lowest_fluid_position > plate_y;
+	cout << "Averaged force on the plate: " << averaged_force << ", water weight " << water_weight
+		<< (is_force_passed ? ", passed.\n" : ", failed!\n");
+	cout << "Lowest fluid particle position: " << lowest_fluid_position << ", plate at " << plate_y
+		<< (is_penetration_free ? ", passed.\n" : ", failed!\n");
+
+	return is_force_passed && is_penetration_free ? 0 : 1;
+}
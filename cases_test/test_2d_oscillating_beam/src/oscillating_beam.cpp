@@ -245,9 +245,9 @@ int main()
 	//from here the time stepping begines
 	//-----------------------------------------------------------------------------
 	//starting time zero
-	GlobalStaticVariables::physical_time_ = 0.0;
-	write_beam_states.WriteToFile(GlobalStaticVariables::physical_time_);
-	write_beam_tip_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+	system.physical_time_ = 0.0;
+	write_beam_states.WriteToFile(system.physical_time_);
+	write_beam_tip_displacement.WriteToFile(system.physical_time_);
 
 	int ite = 0;
 	Real T0 = 1.0;
@@ -262,7 +262,7 @@ int main()
 	tick_count::interval_t interval;
 
 	//computation loop starts 
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		//integrate time (loop) until the next output time
@@ -273,7 +273,7 @@ int main()
 
 				if (ite % 100 == 0) {
 					cout << "N=" << ite << " Time: "
-						<< GlobalStaticVariables::physical_time_ << "	dt: "
+						<< system.physical_time_ << "	dt: "
 						<< dt << "\n";
 				}
 
@@ -285,14 +285,14 @@ int main()
 				dt = computing_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 			}
 		}
 
-		write_beam_tip_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_beam_tip_displacement.WriteToFile(system.physical_time_);
 
 		tick_count t2 = tick_count::now();
-		write_beam_states.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_beam_states.WriteToFile(system.physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -302,5 +302,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
@@ -0,0 +1,305 @@
+/* ---------------------------------------------------------------------------*
+*            SPHinXsys: 2D oscilation beam example-shell version              *
+* ----------------------------------------------------------------------------*
+* This is the oscillating beam case with the beam represented by              *
+* a single layer of shell particles on its mid-line,                          *
+* instead of several particles through the thickness.                         *
+* The time step size is given by the particle spacing along the beam.        *
+* The oscillation period of the tip is checked against the analytical one    *
+* of the first bending mode of a cantilever.                                  *
+* ----------------------------------------------------------------------------*/
+/**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+/**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+
+//------------------------------------------------------------------------------
+//global parameters for the case
+//------------------------------------------------------------------------------
+
+//for geometry
+Real PL = 0.2; 	//beam lenght
+Real PH = 0.02; //beam thickness
+Real SL = 0.06; //depth of the insert
+//particle spacing along the beam, independent of the thickness
+Real particle_spacing_ref = PL / 100.0;
+Real BW = particle_spacing_ref * 4; 	//boundary width
+
+//for material properties of the beam
+Real rho0_s = 1.0e3; 			//reference density
+Real Youngs_modulus = 2.0e6;	//reference Youngs modulus
+Real poisson = 0.3975; 			//Poisson ratio
+
+//for initial condition on velocity
+Real kl = 1.875;
+Real M = sin(kl) + sinh(kl);
+Real N = cos(kl) + cosh(kl);
+Real Q = 2.0 * (cos(kl)*sinh(kl) - sin(kl)*cosh(kl));
+Real vf = 0.05;
+
+//analytical period of the first bending mode, with the plane strain modulus of the 2D beam
+Real bending_stiffness = Youngs_modulus / (1.0 - poisson * poisson) * PH * PH * PH / 12.0;
+Real analytical_period = 2.0 * Pi * PL * PL / (kl * kl) / sqrt(bending_stiffness / (rho0_s * PH));
+
+/**
+* @brief create a beam base shape
+*/
+std::vector<Point> CreatBeamBaseShape()
+{
+	//geometry
+	std::vector<Point> beam_base_shape;
+	beam_base_shape.push_back(Point(-SL - BW, -PH / 2 - BW));
+	beam_base_shape.push_back(Point(-SL - BW, PH / 2 + BW));
+	beam_base_shape.push_back(Point(0.0, PH / 2 + BW));
+	beam_base_shape.push_back(Point(0.0, -PH / 2 - BW));
+	beam_base_shape.push_back(Point(-SL - BW, -PH / 2 - BW));
+
+	return beam_base_shape;
+}
+/**
+* @brief define the beam body by the particles on its mid-line
+*/
+class Beam : public SolidBody
+{
+public:
+	Beam(SPHSystem &system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(system, body_name, refinement_level, op)
+	{
+		/** the volume is that of a lattice particle */
+		Real volume = particle_spacing_ref * particle_spacing_ref;
+		for (Real x = -SL + 0.5 * particle_spacing_ref; x < PL; x += particle_spacing_ref)
+			body_input_points_volumes_.push_back(make_pair(Point(x, 0.0), volume));
+	}
+};
+/**
+ * @brief Define beam material.
+ */
+class BeamMaterial : public LinearElasticSolid
+{
+public:
+	BeamMaterial()	: LinearElasticSolid()
+	{
+		rho_0_ = rho0_s;
+		E_0_ = Youngs_modulus;
+		nu_ = poisson;
+
+		assignDerivedMaterialParameters();
+	}
+};
+
+/**
+ * application dependent initial condition
+ */
+class BeamInitialCondition
+	: public thin_structure_dynamics::ShellDynamicsInitialCondition
+{
+public:
+	BeamInitialCondition(SolidBody *beam)
+		: thin_structure_dynamics::ShellDynamicsInitialCondition(beam) {};
+protected:
+	void Update(size_t index_particle_i, Real dt) override {
+		/** initial velocity profile */
+		BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
+
+		Real x = base_particle_data_i.pos_0_[0] / PL;
+		if (x > 0.0) {
+			base_particle_data_i.vel_n_[1]
+				= vf * material_->getReferenceSoundSpeed()*(M*(cos(kl*x) - cosh(kl*x)) - N * (sin(kl*x) - sinh(kl*x))) / Q;
+		}
+	};
+};
+/**
+* @brief define the beam base which will be constrained.
+*/
+class BeamBase : public BodyPartByParticle
+{
+public:
+	BeamBase(SolidBody *solid_body, string constrianed_region_name)
+		: BodyPartByParticle(solid_body, constrianed_region_name)
+	{
+		/* Geometry defination */
+		std::vector<Point> beam_base_shape = CreatBeamBaseShape();
+		Geometry * beam_base_gemetry = new Geometry(beam_base_shape);
+		body_part_region_.add_geometry(beam_base_gemetry, RegionBooleanOps::add);
+
+		/** Finish the region modeling. */
+		body_part_region_.done_modeling();
+
+		//tag the constrained particle
+		TagBodyPartParticles();
+	}
+};
+
+//define an observer body
+class BeamObserver : public FictitiousBody
+{
+public:
+	BeamObserver(SPHSystem &system, string body_name, int refinement_level, ParticlesGeneratorOps op)
+		: FictitiousBody(system, body_name, refinement_level, 1.3, op)
+	{
+		body_input_points_volumes_.push_back(make_pair(Point(PL - 0.5 * particle_spacing_ref, 0.0), 0.0));
+	}
+};
+//------------------------------------------------------------------------------
+//the main program
+//------------------------------------------------------------------------------
+
+int main()
+{
+
+	//build up context -- a SPHSystem
+	SPHSystem system(Vec2d(-SL - BW, -PL / 2.0),
+		Vec2d(PL + 3.0*BW, PL / 2.0), particle_spacing_ref);
+
+	//the osillating beam
+	Beam *beam_body =
+		new Beam(system, "BeamBody", 0, ParticlesGeneratorOps::direct);
+	//Configuration of soild materials
+	BeamMaterial *beam_material = new BeamMaterial();
+	//creat shell particles for the beam
+	ShellParticles beam_particles(beam_body, beam_material, PH);
+
+	BeamObserver *beam_observer
+		= new BeamObserver(system, "BeamObserver", 0, ParticlesGeneratorOps::direct);
+	//create observer particles
+	BaseParticles observer_particles(beam_observer);
+
+	//set body contact map
+	SPHBodyTopology body_topology
+		= { { beam_body, {} }, { beam_observer,{ beam_body} } };
+	system.SetBodyTopology(&body_topology);
+
+	//-----------------------------------------------------------------------------
+	//this section define all numerical methods will be used in this case
+	//-----------------------------------------------------------------------------
+	/** initial condition */
+	BeamInitialCondition beam_initial_velocity(beam_body);
+	//corrected strong configuration of the mid-line
+	thin_structure_dynamics::ShellCorrectConfiguration
+		beam_corrected_configuration_in_strong_form(beam_body);
+
+	//time step size caclutation
+	thin_structure_dynamics::ShellAcousticTimeStepSize computing_time_step_size(beam_body);
+
+	//stress relaxation for the beam
+	thin_structure_dynamics::ShellStressRelaxationFirstHalf
+		stress_relaxation_first_half(beam_body);
+	thin_structure_dynamics::ShellStressRelaxationSecondHalf
+		stress_relaxation_second_half(beam_body);
+
+	/**
+	 * @brief Clamp the beam base
+	 */
+	thin_structure_dynamics::ConstrainShellBodyRegion
+		constrain_beam_base(beam_body, new BeamBase(beam_body, "BeamBase"));
+
+	//-----------------------------------------------------------------------------
+	//outputs
+	//-----------------------------------------------------------------------------
+	In_Output in_output(system);
+	WriteBodyStatesToVtu write_beam_states(in_output, system.real_bodies_);
+	WriteAnObservedQuantity<Vecd, BaseParticles,
+		BaseParticleData, &BaseParticles::base_particle_data_, &BaseParticleData::pos_n_>
+		write_beam_tip_displacement("Displacement", in_output, beam_observer, beam_body);
+	/**
+	 * @brief Setup goematrics and initial conditions
+	 */
+	system.InitializeSystemCellLinkedLists();
+	system.InitializeSystemConfigurations();
+	beam_initial_velocity.exec();
+	beam_corrected_configuration_in_strong_form.parallel_exec();
+
+	//-----------------------------------------------------------------------------
+	//from here the time stepping begines
+	//-----------------------------------------------------------------------------
+	//starting time zero
+	system.physical_time_ = 0.0;
+	write_beam_states.WriteToFile(system.physical_time_);
+	write_beam_tip_displacement.WriteToFile(system.physical_time_);
+
+	int ite = 0;
+	Real T0 = 1.0;
+	Real End_Time = T0;
+	//time step size for oupt file
+	Real D_Time = 0.01*T0;
+	Real Dt = 0.1*D_Time;			/**< Time period for data observing */
+	Real dt = 0.0; 					//default accoustic time step sizes
+
+	//the tip is the particle at the free end
+	size_t tip_index = 0;
+	for (size_t i = 0; i != beam_body->number_of_particles_; ++i)
+		if (beam_particles.base_particle_data_[i].pos_0_[0] > beam_particles.base_particle_data_[tip_index].pos_0_[0])
+			tip_index = i;
+	//the times of the tip crossing the mid-line downwards
+	StdVec<Real> crossing_times;
+	Real previous_tip_deflection = 0.0;
+
+	//statistics for computing time
+	tick_count t1 = tick_count::now();
+	tick_count::interval_t interval;
+
+	//computation loop starts
+	while (system.physical_time_ < End_Time)
+	{
+		Real integeral_time = 0.0;
+		//integrate time (loop) until the next output time
+		while (integeral_time < D_Time) {
+
+			Real relaxation_time = 0.0;
+			while (relaxation_time < Dt) {
+
+				if (ite % 100 == 0) {
+					cout << "N=" << ite << " Time: "
+						<< system.physical_time_ << "	dt: "
+						<< dt << "\n";
+				}
+
+				stress_relaxation_first_half.parallel_exec(dt);
+				constrain_beam_base.parallel_exec(dt);
+				stress_relaxation_second_half.parallel_exec(dt);
+
+				ite++;
+				dt = computing_time_step_size.parallel_exec();
+				relaxation_time += dt;
+				integeral_time += dt;
+				system.physical_time_ += dt;
+			}
+
+			Real tip_deflection = beam_particles.base_particle_data_[tip_index].pos_n_[1];
+			if (previous_tip_deflection > 0.0 && tip_deflection <= 0.0)
+				crossing_times.push_back(system.physical_time_ - relaxation_time
+					* tip_deflection / (tip_deflection - previous_tip_deflection));
+			previous_tip_deflection = tip_deflection;
+		}
+
+		write_beam_tip_displacement.WriteToFile(system.physical_time_);
+
+		tick_count t2 = tick_count::now();
+		write_beam_states.WriteToFile(system.physical_time_);
+		tick_count t3 = tick_count::now();
+		interval += t3 - t2;
+	}
+	tick_count t4 = tick_count::now();
+
+	tick_count::interval_t tt;
+	tt = t4 - t1 - interval;
+	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
+
+	system.reportMemoryUsage();
+
+	if (crossing_times.size() < 2)
+	{
+		cout << "The beam tip has not oscillated, failed!\n";
+		return 1;
+	}
+	Real period = (crossing_times.back() - crossing_times.front()) / Real(crossing_times.size() - 1);
+	bool is_passed = ABS(period - analytical_period) <= 0.1 * analytical_period;
+	cout << "Oscillation period: " << period << ", analytical " << analytical_period
+		<< (is_passed ? ", passed.\n" : ", failed!\n");
+	return is_passed ? 0 : 1;
+}
@@ -108,7 +108,7 @@ int main()
 	 */
 	SPHSystem system(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW), particle_spacing_ref);
 	/** Set the starting time. */
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	/** Tag for computation from restart files. 0: not from restart files. */
 	system.restart_step_ = 0;
 	/**
@@ -203,7 +203,7 @@ int main()
 	 /** If the starting time is not zero, please setup the restart time step ro read in restart states. */
 	if (system.restart_step_ != 0)
 	{
-		GlobalStaticVariables::physical_time_ = read_restart_files.ReadRestartFiles(system.restart_step_);
+		system.physical_time_ = read_restart_files.ReadRestartFiles(system.restart_step_);
 		periodic_condition.parallel_exec();
 		update_cell_linked_list.parallel_exec();
 		update_particle_configuration.parallel_exec();
@@ -211,7 +211,7 @@ int main()
 	/** Pre-simulation*/
 	periodic_condition.parallel_exec();
 	/** Output the start states of bodies. */
-	write_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_body_states.WriteToFile(system.physical_time_);
 	/**
 	 * @brief 	Basic parameters.
 	 */
@@ -232,7 +232,7 @@ int main()
 	/**
 	 * @brief 	Main loop starts here.
 	 */
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		/** Integrate time (loop) until the next output time. */
@@ -257,14 +257,14 @@ int main()
 				dt = get_fluid_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 
 			}
 			interval_computing_pressure_relaxation += tick_count::now() - time_instance;
 			if (number_of_iterations % screen_output_interval == 0)
 			{
 				cout << fixed << setprecision(9) << "N=" << number_of_iterations << "	Time = "
-					<< GlobalStaticVariables::physical_time_
+					<< system.physical_time_
 					<< "	Dt = " << Dt << "	dt = " << dt << "\n";
 
 				if (number_of_iterations % restart_output_interval == 0)
@@ -281,7 +281,7 @@ int main()
 			interval_updating_configuration += tick_count::now() - time_instance;
 		}
 		tick_count t2 = tick_count::now();
-		write_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_body_states.WriteToFile(system.physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 
@@ -299,5 +299,7 @@ int main()
 	cout << fixed << setprecision(9) << "interval_updating_configuration = "
 		<< interval_updating_configuration.seconds() << "\n";
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
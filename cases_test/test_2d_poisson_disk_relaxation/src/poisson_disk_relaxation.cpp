@@ -0,0 +1,130 @@
+/**
+ * @file 	poisson_disk_relaxation.cpp
+ * @brief 	Test of the particle relaxation starting from Poisson-disk samples.
+ * @details The particles of a disc are relaxed by the physics relaxation with surface bounding,
+ *			starting from a randomized lattice as usual, or from the Poisson-disk samples.
+ *			The relaxation residual is the averaged particle acceleration away from the surface.
+ *			The relaxation from the Poisson-disk samples should converge in fewer iterations.
+ * @author 	Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real disc_radius = 1.0;					/**< Radius of the disc. */
+Vec2d disc_center(0.0, 0.0);			/**< Center of the disc. */
+Real particle_spacing_ref = 0.05; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width of the domain. */
+int resolution(100);					/**< Number of segments of the disc polygon. */
+size_t max_iterations = 2000;			/**< Maximum number of relaxation iterations. */
+Real residual_reduction = 0.1;			/**< The relaxation is converged if the residual is reduced by this factor. */
+/**
+ * @brief 	Disc body definition.
+ */
+class Disc : public SolidBody
+{
+public:
+	Disc(SPHSystem &sph_system, string body_name, int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		body_region_.add_geometry(new Geometry(disc_center, disc_radius, resolution), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Relax the disc particles from the given generator until the residual
+ *			is reduced below the reference residual, and return the number of iterations.
+ * @details The reference residual is that of the first iteration from the randomized lattice,
+ *			it is set by the first run if it is not given.
+ */
+size_t relaxDisc(ParticlesGeneratorOps op, Real& reference_residual)
+{
+	/** Build up -- a SPHSystem -- */
+	SPHSystem sph_system(Vec2d(-disc_radius - BW, -disc_radius - BW),
+		Vec2d(disc_radius + BW, disc_radius + BW), particle_spacing_ref);
+	Disc *disc = new Disc(sph_system, "Disc", 0, op);
+	SolidParticles 	disc_particles(disc);
+	/** The Poisson-disk generator has added the background mesh already. */
+	if (disc->mesh_background_ == NULL) disc->addBackgroundMesh();
+	/** Body contact map. */
+	SPHBodyTopology 	body_topology = { { disc, {} } };
+	sph_system.SetBodyTopology(&body_topology);
+	/**
+	 * @brief 	Methods used for particle relaxation.
+	 */
+	ParticleDynamicsCellLinkedList 		update_cell_linked_list(disc);
+	ParticleDynamicsConfiguration 		update_inner_configuration(disc);
+	RandomizePartilePosition  			random_disc_particles(disc);
+	relax_dynamics::BodySurfaceBounding
+		body_surface_bounding(disc, new NearBodySurface(disc));
+	relax_dynamics::GetTimeStepSize 	get_relax_timestep(disc);
+	relax_dynamics::PhysicsRelaxationInner 	relax_process(disc);
+
+	sph_system.InitializeSystemCellLinkedLists();
+	sph_system.InitializeSystemConfigurations();
+	if (op == ParticlesGeneratorOps::lattice)
+	{
+		random_disc_particles.parallel_exec(0.25);
+		update_cell_linked_list.parallel_exec();
+		update_inner_configuration.parallel_exec();
+	}
+	body_surface_bounding.parallel_exec();
+
+	/** The averaged acceleration, scaled by the smoothing length, of the particles
+	  * beyond a cutoff radius from the surface, where the kernel support is complete. */
+	Real smoothing_length = disc->kernel_->GetSmoothingLength();
+	Real inner_radius = disc_radius - disc->kernel_->GetCutOffRadius();
+	auto getResidual = [&]() {
+		Real residual(0);
+		size_t number_of_inner_particles = 0;
+		for (size_t i = 0; i != disc->number_of_particles_; ++i)
+		{
+			BaseParticleData& base_particle_data_i = disc_particles.base_particle_data_[i];
+			if ((base_particle_data_i.pos_n_ - disc_center).norm() > inner_radius) continue;
+			residual += base_particle_data_i.dvel_dt_.norm() * smoothing_length;
+			number_of_inner_particles++;
+		}
+		return residual / Real(number_of_inner_particles);
+	};
+
+	size_t ite_p = 0;
+	while (ite_p < max_iterations)
+	{
+		Real dt_p = get_relax_timestep.parallel_exec();
+		relax_process.parallel_exec(dt_p);
+		body_surface_bounding.parallel_exec();
+		ite_p += 1;
+
+		update_cell_linked_list.parallel_exec();
+		update_inner_configuration.parallel_exec();
+
+		Real residual = getResidual();
+		if (reference_residual < 0.0) reference_residual = residual;
+		if (residual < residual_reduction * reference_residual) break;
+	}
+	cout << "Relaxation from the " << (op == ParticlesGeneratorOps::lattice ? "randomized lattice" : "Poisson-disk samples")
+		<< ": " << disc->number_of_particles_ << " particles, " << ite_p << " iterations.\n";
+	return ite_p;
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	Real reference_residual = -1.0;
+	size_t lattice_iterations = relaxDisc(ParticlesGeneratorOps::lattice, reference_residual);
+	size_t poisson_disk_iterations = relaxDisc(ParticlesGeneratorOps::poisson_disk, reference_residual);
+
+	bool is_passed = lattice_iterations < max_iterations && poisson_disk_iterations < lattice_iterations;
+	cout << "Relaxation iterations from Poisson-disk samples are " << Real(poisson_disk_iterations) / Real(lattice_iterations)
+		<< " of those from the randomized lattice" << (is_passed ? ", passed.\n" : ", failed!\n");
+	return is_passed ? 0 : 1;
+}
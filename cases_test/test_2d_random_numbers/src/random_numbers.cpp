@@ -0,0 +1,114 @@
+/**
+ * @file 	random_numbers.cpp
+ * @brief 	Test of the counter-based random numbers.
+ * @details The random integers are checked with the known-answer vectors
+ *			of the Philox4x32-10 generator in Random123.
+ *			The particles of a disc are then randomized several times with different numbers of threads,
+ *			which should give identical positions.
+ * @author 	Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real disc_radius = 1.0;					/**< Radius of the disc. */
+Vec2d disc_center(0.0, 0.0);			/**< Center of the disc. */
+int resolution(100);					/**< Number of segments of the disc polygon. */
+Real particle_spacing_ref = 0.02; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width of the domain. */
+size_t number_of_randomizations = 10;	/**< Number of times the particles are randomized. */
+/**
+ * @brief 	Disc body definition.
+ */
+class Disc : public SolidBody
+{
+public:
+	Disc(SPHSystem &sph_system, string body_name, int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		body_region_.add_geometry(new Geometry(disc_center, disc_radius, resolution), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	The number of the Random123 known-answer vectors of Philox4x32-10 not reproduced.
+ * @details The counter is given by the particle id and the step, and the key by the seed,
+ *			all with their lower 32 bits first.
+ */
+size_t countWrongKnownAnswers()
+{
+	struct KnownAnswer { uint64_t seed, particle_id, step; uint32_t answer[4]; };
+	StdVec<KnownAnswer> known_answers = {
+		{ 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+			{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+		{ 0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff,
+			{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+		{ 0x299f31d0a4093822, 0x85a308d3243f6a88, 0x0370734413198a2e,
+			{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } } };
+
+	size_t wrong_answers = 0;
+	for (auto& known_answer : known_answers)
+	{
+		CounterBasedRandomNumbers random_numbers(size_t(known_answer.seed));
+		uint32_t random_integers[4];
+		random_numbers.RandomIntegers(size_t(known_answer.particle_id), size_t(known_answer.step), random_integers);
+		for (int i = 0; i != 4; ++i)
+			if (random_integers[i] != known_answer.answer[i])
+			{
+				wrong_answers++;
+				break;
+			}
+	}
+	return wrong_answers;
+}
+/**
+ * @brief 	Randomize the disc particles with a number of threads and return the positions.
+ */
+StdVec<Vecd> randomizeDisc(int number_of_threads)
+{
+	/** Build up -- a SPHSystem -- */
+	SPHSystem sph_system(Vec2d(-disc_radius - BW, -disc_radius - BW),
+		Vec2d(disc_radius + BW, disc_radius + BW), particle_spacing_ref, number_of_threads);
+	Disc *disc = new Disc(sph_system, "Disc", 0, ParticlesGeneratorOps::lattice);
+	SolidParticles 	disc_particles(disc);
+
+	RandomizePartilePosition  random_disc_particles(disc);
+	for (size_t n = 0; n != number_of_randomizations; ++n)
+		random_disc_particles.parallel_exec(0.1);
+
+	StdVec<Vecd> positions;
+	for (size_t i = 0; i != disc->number_of_particles_; ++i)
+		positions.push_back(disc_particles.base_particle_data_[i].pos_n_);
+	return positions;
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	size_t wrong_answers = countWrongKnownAnswers();
+
+	StdVec<Vecd> reference_positions = randomizeDisc(1);
+	StdVec<int> numbers_of_threads = { 2, 4, tbb::task_scheduler_init::automatic };
+	size_t different_positions = 0;
+	for (auto& number_of_threads : numbers_of_threads)
+	{
+		StdVec<Vecd> positions = randomizeDisc(number_of_threads);
+		for (size_t i = 0; i != positions.size(); ++i)
+			if ((positions[i] - reference_positions[i]).norm() != 0.0) different_positions++;
+	}
+
+	bool is_passed = wrong_answers == 0 && different_positions == 0;
+	cout << "Wrong known answers: " << wrong_answers
+		<< ", positions different from those by a single thread: " << different_positions
+		<< (is_passed ? ", passed.\n" : ", failed!\n");
+	return is_passed ? 0 : 1;
+}
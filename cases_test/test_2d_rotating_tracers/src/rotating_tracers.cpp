@@ -0,0 +1,173 @@
+/**
+ * @file 	rotating_tracers.cpp
+ * @brief 	Test of the passive tracers advected by a host fluid in rigid rotation.
+ * @details The velocity of a water disc is set to a rigid rotation,
+ *			and the tracers seeded in the disc are advected by the interpolated velocity.
+ *			After one period, the tracers should be back at their initial positions,
+ *			with the residence time of one period. At the end, the tracers
+ *			are written to and read back from the restart files, which should give the same states.
+ * @author 	Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real disc_radius = 1.0;					/**< Radius of the water disc. */
+Vec2d disc_center(0.0, 0.0);			/**< Center of the water disc. */
+int resolution(100);					/**< Number of segments of the disc polygon. */
+Real tracer_width = 1.0;				/**< Width of the square of seeded tracers. */
+Real particle_spacing_ref = 0.05; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width of the domain. */
+Real omega = 1.0;						/**< Angular velocity of the rotation. */
+Real period = 2.0 * Pi / omega;			/**< Period of the rotation. */
+size_t number_of_steps = 200;			/**< Number of advection steps in one period. */
+/**
+ * @brief Material properties of the fluid.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real c_f = 10.0 * omega * disc_radius;	/**< Reference sound speed. */
+/**
+ * @brief 	Fluid body definition.
+ */
+class WaterDisc : public FluidBody
+{
+public:
+	WaterDisc(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: FluidBody(sph_system, body_name, refinement_level, op)
+	{
+		body_region_.add_geometry(new Geometry(disc_center, disc_radius, resolution), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Tracer body definition, seeded in a square inside the water disc.
+ */
+class WaterTracers : public TracerBody
+{
+public:
+	WaterTracers(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: TracerBody(sph_system, body_name, refinement_level, op)
+	{
+		Real half_width = 0.5 * tracer_width;
+		std::vector<Point> tracer_shape;
+		tracer_shape.push_back(Point(-half_width, -half_width));
+		tracer_shape.push_back(Point(-half_width, half_width));
+		tracer_shape.push_back(Point(half_width, half_width));
+		tracer_shape.push_back(Point(half_width, -half_width));
+		tracer_shape.push_back(Point(-half_width, -half_width));
+		body_region_.add_geometry(new Geometry(tracer_shape), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	/** Build up -- a SPHSystem -- */
+	SPHSystem sph_system(Vec2d(-disc_radius - BW, -disc_radius - BW),
+		Vec2d(disc_radius + BW, disc_radius + BW), particle_spacing_ref);
+	WaterDisc *water_disc = new WaterDisc(sph_system, "WaterDisc", 0, ParticlesGeneratorOps::lattice);
+	WaterMaterial 	*water_material = new WaterMaterial();
+	FluidParticles 	fluid_particles(water_disc, water_material);
+	/** The tracers are not in the body topology. */
+	WaterTracers *water_tracers = new WaterTracers(sph_system, "WaterTracers", 0, ParticlesGeneratorOps::lattice);
+	TracerParticles 	tracer_particles(water_tracers);
+	/** Body contact map. */
+	SPHBodyTopology 	body_topology = { { water_disc, {} } };
+	sph_system.SetBodyTopology(&body_topology);
+	/** Advect the tracers by the water, after the water cell linked list is updated. */
+	observer_dynamics::AdvectingTracers 	advect_tracers(water_tracers, water_disc);
+	/** Output. */
+	In_Output in_output(sph_system);
+	WriteBodyStatesToVtu 	write_body_states(in_output, { water_disc, water_tracers });
+	WriteRestart	write_tracer_restart(in_output, { water_tracers });
+	ReadRestart		read_tracer_restart(in_output, { water_tracers });
+
+	/** The water stays in place with the velocity of the rigid rotation. */
+	sph_system.InitializeSystemCellLinkedLists();
+	sph_system.InitializeSystemConfigurations();
+	for (size_t i = 0; i != water_disc->number_of_particles_; ++i)
+	{
+		BaseParticleData& base_particle_data_i = fluid_particles.base_particle_data_[i];
+		Vecd radial = base_particle_data_i.pos_n_ - disc_center;
+		base_particle_data_i.vel_n_ = omega * Vecd(-radial[1], radial[0]);
+	}
+	StdLargeVec<TracerParticleData> initial_tracer_particle_data = tracer_particles.tracer_particle_data_;
+	write_body_states.WriteToFile(sph_system.physical_time_);
+
+	Real dt = period / Real(number_of_steps);
+	for (size_t n = 0; n != number_of_steps; ++n)
+	{
+		advect_tracers.parallel_exec(dt);
+		sph_system.physical_time_ += dt;
+	}
+	write_body_states.WriteToFile(sph_system.physical_time_);
+
+	/** The tracers are back after one period, and have stayed in the water. */
+	size_t number_of_tracers = water_tracers->number_of_particles_;
+	Real max_position_error = 0.0, max_time_error = 0.0;
+	size_t number_out_of_host = 0;
+	for (size_t i = 0; i != number_of_tracers; ++i)
+	{
+		TracerParticleData& tracer_particle_data_i = tracer_particles.tracer_particle_data_[i];
+		max_position_error = SMAX(max_position_error,
+			(tracer_particle_data_i.pos_ - initial_tracer_particle_data[i].pos_).norm() / disc_radius);
+		max_time_error = SMAX(max_time_error, ABS(tracer_particle_data_i.residence_time_ - period) / period);
+		if (!tracer_particle_data_i.is_in_host_) number_out_of_host++;
+	}
+	/** The tracers keep only the compact data. */
+	bool is_compact = tracer_particles.base_particle_data_.capacity() == 0
+		&& sizeof(TracerParticleData) < sizeof(BaseParticleData) / 2;
+	cout << fixed << setprecision(6) << number_of_tracers << " tracers of " << sizeof(TracerParticleData)
+		<< " bytes, maximum position error " << max_position_error << ", maximum residence time error "
+		<< max_time_error << ", " << number_out_of_host << " out of the water\n";
+	bool is_advected = is_compact && number_of_tracers != 0 && number_out_of_host == 0
+		&& max_position_error < 0.01 && max_time_error < 1.0e-6;
+
+	/** The tracer states read back from the restart files should be those written. */
+	write_tracer_restart.WriteToFile(Real(number_of_steps));
+	StdLargeVec<TracerParticleData> tracer_particle_data = tracer_particles.tracer_particle_data_;
+	for (size_t i = 0; i != number_of_tracers; ++i)
+		tracer_particles.tracer_particle_data_[i] = TracerParticleData();
+	read_tracer_restart.ReadFromFile(number_of_steps);
+	bool is_restarted = water_tracers->number_of_particles_ == number_of_tracers;
+	for (size_t i = 0; is_restarted && i != number_of_tracers; ++i)
+	{
+		/** The states are written in text, so they are compared within a tolerance. */
+		TracerParticleData& tracer_particle_data_i = tracer_particles.tracer_particle_data_[i];
+		Real position_error = (tracer_particle_data_i.pos_ - tracer_particle_data[i].pos_).norm();
+		Real velocity_error = (tracer_particle_data_i.vel_ - tracer_particle_data[i].vel_).norm();
+		Real time_error = ABS(tracer_particle_data_i.residence_time_ - tracer_particle_data[i].residence_time_);
+		is_restarted = position_error < 1.0e-4 * disc_radius && velocity_error < 1.0e-4 * omega * disc_radius
+			&& time_error < 1.0e-4 * period && tracer_particle_data_i.is_in_host_ == tracer_particle_data[i].is_in_host_;
+	}
+	cout << "Restarted tracers" << (is_restarted ? ": identical.\n" : ": different!\n");
+
+	bool is_passed = is_advected && is_restarted;
+	cout << "Tracers in rigid rotation" << (is_passed ? ", passed.\n" : ", failed!\n");
+	return is_passed ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file 	shared_cell_linked_list.cpp
+ * @brief 	Test of the configurations built by the shared cell linked list.
+ * @details A water block in a tank with a refined solid disc in it.
+ *			The particles are randomized, and the inner and contact configurations
+ *			are built first by the cell linked lists of the bodies and then by
+ *			the cell linked list shared by all bodies.
+ *			Both should give the same neighbors with the same kernel values.
+ * @author 	Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DL = 2.0; 							/**< Tank length. */
+Real DH = 1.0; 							/**< Tank height. */
+Real LL = 1.2; 							/**< Liquid colume length. */
+Real LH = 0.8; 							/**< Liquid colume height. */
+Vec2d disc_center(0.6, 0.4);			/**< Center of the disc. */
+Real disc_radius = 0.2;					/**< Radius of the disc. */
+int resolution(100);					/**< Number of segments of the disc polygon. */
+Real particle_spacing_ref = 0.05; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width for BCs. */
+/**
+ * @brief 	Fluid body definition.
+ */
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: FluidBody(sph_system, body_name, refinement_level, op)
+	{
+		std::vector<Point> water_block_shape;
+		water_block_shape.push_back(Point(0.0, 0.0));
+		water_block_shape.push_back(Point(0.0, LH));
+		water_block_shape.push_back(Point(LL, LH));
+		water_block_shape.push_back(Point(LL, 0.0));
+		water_block_shape.push_back(Point(0.0, 0.0));
+		body_region_.add_geometry(new Geometry(water_block_shape), RegionBooleanOps::add);
+		body_region_.add_geometry(new Geometry(disc_center, disc_radius, resolution), RegionBooleanOps::sub);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		rho_0_ = 1.0;
+		c_0_ = 10.0;
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Wall boundary body definition.
+ */
+class WallBoundary : public SolidBody
+{
+public:
+	WallBoundary(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		std::vector<Point> outer_wall_shape;
+		outer_wall_shape.push_back(Point(-BW, -BW));
+		outer_wall_shape.push_back(Point(-BW, DH + BW));
+		outer_wall_shape.push_back(Point(DL + BW, DH + BW));
+		outer_wall_shape.push_back(Point(DL + BW, -BW));
+		outer_wall_shape.push_back(Point(-BW, -BW));
+		body_region_.add_geometry(new Geometry(outer_wall_shape), RegionBooleanOps::add);
+
+		std::vector<Point> inner_wall_shape;
+		inner_wall_shape.push_back(Point(0.0, 0.0));
+		inner_wall_shape.push_back(Point(0.0, DH));
+		inner_wall_shape.push_back(Point(DL, DH));
+		inner_wall_shape.push_back(Point(DL, 0.0));
+		inner_wall_shape.push_back(Point(0.0, 0.0));
+		body_region_.add_geometry(new Geometry(inner_wall_shape), RegionBooleanOps::sub);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Disc body definition, refined so that it has a smaller cut-off radius.
+ */
+class Disc : public SolidBody
+{
+public:
+	Disc(SPHSystem &sph_system, string body_name, int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		body_region_.add_geometry(new Geometry(disc_center, disc_radius, resolution), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/** The neighbors of each particle, as sorted indexes and kernel values. */
+using NeighborSets = StdVec<StdVec<std::tuple<size_t, Real, Real>>>;
+/**
+ * @brief 	Get the neighbor sets of a configuration, independent of the order of the neighbors.
+ */
+NeighborSets getNeighborSets(ParticleConfiguration& configuration, size_t number_of_particles)
+{
+	NeighborSets neighbor_sets(number_of_particles);
+	for (size_t i = 0; i != number_of_particles; ++i)
+	{
+		NeighborList& neighbors = std::get<0>(configuration[i]);
+		for (size_t n = 0; n != std::get<2>(configuration[i]); ++n)
+			neighbor_sets[i].push_back(make_tuple(size_t(neighbors[n]->j_), neighbors[n]->W_ij_, neighbors[n]->dW_ij_));
+		std::sort(neighbor_sets[i].begin(), neighbor_sets[i].end());
+	}
+	return neighbor_sets;
+}
+/**
+ * @brief 	Get the neighbor sets of the inner configuration followed by those of the contact configurations.
+ */
+StdVec<NeighborSets> getBodyNeighborSets(SPHBody* body)
+{
+	StdVec<NeighborSets> body_neighbor_sets;
+	body_neighbor_sets.push_back(getNeighborSets(body->inner_configuration_, body->number_of_particles_));
+	for (auto& contact_configuration : body->contact_configuration_)
+		body_neighbor_sets.push_back(getNeighborSets(contact_configuration, body->number_of_particles_));
+	return body_neighbor_sets;
+}
+/**
+ * @brief 	The number of particles with different neighbors or kernel values.
+ */
+size_t countDifferentParticles(StdVec<NeighborSets>& reference, StdVec<NeighborSets>& result)
+{
+	size_t number_of_different_particles = 0;
+	for (size_t k = 0; k != reference.size(); ++k)
+		for (size_t i = 0; i != reference[k].size(); ++i)
+		{
+			StdVec<std::tuple<size_t, Real, Real>>& reference_neighbors = reference[k][i];
+			StdVec<std::tuple<size_t, Real, Real>>& neighbors = result[k][i];
+			bool is_different = reference_neighbors.size() != neighbors.size();
+			for (size_t n = 0; !is_different && n != neighbors.size(); ++n)
+			{
+				is_different = std::get<0>(reference_neighbors[n]) != std::get<0>(neighbors[n])
+					|| ABS(std::get<1>(reference_neighbors[n]) - std::get<1>(neighbors[n]))
+						> 1.0e-10 * ABS(std::get<1>(reference_neighbors[n]))
+					|| ABS(std::get<2>(reference_neighbors[n]) - std::get<2>(neighbors[n]))
+						> 1.0e-10 * ABS(std::get<2>(reference_neighbors[n]));
+			}
+			if (is_different) number_of_different_particles++;
+		}
+	return number_of_different_particles;
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	/** Build up -- a SPHSystem -- */
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW), particle_spacing_ref);
+	WaterBlock *water_block = new WaterBlock(sph_system, "WaterBody", 0, ParticlesGeneratorOps::lattice);
+	WaterMaterial 	*water_material = new WaterMaterial();
+	FluidParticles 	fluid_particles(water_block, water_material);
+	WallBoundary *wall_boundary = new WallBoundary(sph_system, "Wall", 0, ParticlesGeneratorOps::lattice);
+	SolidParticles 	wall_particles(wall_boundary);
+	Disc *disc = new Disc(sph_system, "Disc", 1, ParticlesGeneratorOps::lattice);
+	SolidParticles 	disc_particles(disc);
+	/** Body contact map. */
+	SPHBodyTopology 	body_topology = { { water_block, { wall_boundary, disc } },
+		{ wall_boundary, { water_block } }, { disc, { water_block } } };
+	sph_system.SetBodyTopology(&body_topology);
+	SPHBodyVector bodies = { water_block, wall_boundary, disc };
+
+	/** The particles are randomized, so that the neighbors are not decided by ties of lattice distances. */
+	for (auto& body : bodies)
+	{
+		RandomizePartilePosition random_particles(body);
+		random_particles.parallel_exec(0.25);
+	}
+
+	/** The configurations by the cell linked lists of the bodies. */
+	sph_system.InitializeSystemCellLinkedLists();
+	sph_system.InitializeSystemConfigurations();
+	StdVec<StdVec<NeighborSets>> reference_neighbor_sets;
+	for (auto& body : bodies) reference_neighbor_sets.push_back(getBodyNeighborSets(body));
+
+	/** The configurations by the shared cell linked list, which also counts as an update of the cell lists. */
+	StdVec<size_t> number_of_cell_list_updates;
+	for (auto& body : bodies) number_of_cell_list_updates.push_back(body->number_of_cell_list_updates_);
+	sph_system.setSharedCellLinkedList(bodies);
+	sph_system.UpdateSharedCellLinkedList();
+	sph_system.UpdateSharedConfigurations();
+
+	bool is_passed = true;
+	for (size_t b = 0; b != bodies.size(); ++b)
+	{
+		StdVec<NeighborSets> neighbor_sets = getBodyNeighborSets(bodies[b]);
+		size_t number_of_different_particles = countDifferentParticles(reference_neighbor_sets[b], neighbor_sets);
+		bool is_counted = bodies[b]->number_of_cell_list_updates_ == number_of_cell_list_updates[b] + 1;
+		is_passed = is_passed && number_of_different_particles == 0 && is_counted;
+		cout << bodies[b]->GetBodyName() << ": " << bodies[b]->number_of_particles_ << " particles, "
+			<< number_of_different_particles << " with different neighbors, cell list update "
+			<< (is_counted ? "counted" : "not counted") << ".\n";
+	}
+	cout << "Configurations by the shared cell linked list" << (is_passed ? ", passed.\n" : ", failed!\n");
+	return is_passed ? 0 : 1;
+}
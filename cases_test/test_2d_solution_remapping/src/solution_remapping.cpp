@@ -0,0 +1,229 @@
+/**
+ * @file 	solution_remapping.cpp
+ * @brief 	Test of the coarse-to-fine solution remapping.
+ * @details A coarse fluid block and a coarse elastic block carry given smooth states,
+ *			which are remapped onto fine blocks with twice the resolution. The remapped fields
+ *			are checked against the given ones away from the block boundaries, where the kernel
+ *			support is not complete, and the remapped pressure should be given by the equation of state.
+ * @author 	Xiangyu Hu and Chi Zhang
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DL = 1.0; 							/**< Block size. */
+Real particle_spacing_ref = 0.1; 		/**< Particle spacing of the coarse blocks. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width of the domain. */
+Real boundary_distance = 0.3;			/**< The fields are checked beyond this distance to the block boundaries. */
+/**
+ * @brief Material properties and the given states.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real U_f = 1.0;							/**< Characteristic velocity. */
+Real c_f = 10.0 * U_f;					/**< Reference sound speed. */
+Real density_variation = 0.01;			/**< Amplitude of the given density variation. */
+Real rho0_s = 1.0;						/**< Reference density of solid. */
+Real Youngs_modulus = 1.0e3;			/**< Youngs modulus of solid. */
+Real poisson = 0.3;						/**< Poisson ratio of solid. */
+Mat2d deformation_tensor(1.1, 0.05, 0.0, 0.95);	/**< The given uniform deformation tensor. */
+/** The given velocity of the fluid. */
+Vecd givenFluidVelocity(Vecd& position)
+{
+	return U_f * Vecd(sin(pi * position[0]) * cos(pi * position[1]),
+		-cos(pi * position[0]) * sin(pi * position[1]));
+}
+/** The given density of the fluid. */
+Real givenFluidDensity(Vecd& position)
+{
+	return rho0_f * (1.0 + density_variation * sin(pi * position[0]) * sin(pi * position[1]));
+}
+/** Whether a position is away from the block boundaries. */
+bool isInBulk(Vecd& position)
+{
+	return position[0] > boundary_distance && position[0] < DL - boundary_distance
+		&& position[1] > boundary_distance && position[1] < DL - boundary_distance;
+}
+/** The block shape. */
+std::vector<Point> CreatBlockShape()
+{
+	std::vector<Point> block_shape;
+	block_shape.push_back(Point(0.0, 0.0));
+	block_shape.push_back(Point(0.0, DL));
+	block_shape.push_back(Point(DL, DL));
+	block_shape.push_back(Point(DL, 0.0));
+	block_shape.push_back(Point(0.0, 0.0));
+	return block_shape;
+}
+/**
+ * @brief 	Fluid block definition.
+ */
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: FluidBody(sph_system, body_name, refinement_level, op)
+	{
+		std::vector<Point> block_shape = CreatBlockShape();
+		body_region_.add_geometry(new Geometry(block_shape), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Elastic block definition.
+ */
+class ElasticBlock : public SolidBody
+{
+public:
+	ElasticBlock(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		std::vector<Point> block_shape = CreatBlockShape();
+		body_region_.add_geometry(new Geometry(block_shape), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class BlockMaterial : public LinearElasticSolid
+{
+public:
+	BlockMaterial() : LinearElasticSolid()
+	{
+		rho_0_ = rho0_s;
+		E_0_ = Youngs_modulus;
+		nu_ = poisson;
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Check a value against the expected one with a tolerance.
+ */
+bool checkValue(string name, Real value, Real expected_value, Real tolerance)
+{
+	bool is_passed = ABS(value - expected_value) <= tolerance;
+	cout << name << ": " << value << ", expected " << expected_value
+		<< (is_passed ? ", passed.\n" : ", failed!\n");
+	return is_passed;
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	/**
+	 * @brief Build up -- a SPHSystem --
+	 */
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(DL + BW, DL + BW), particle_spacing_ref);
+	/**
+	 * @brief Coarse and fine bodies, the fine ones with refinement level 1.
+	 */
+	WaterMaterial 	*water_material = new WaterMaterial();
+	WaterBlock *coarse_water
+		= new WaterBlock(sph_system, "CoarseWater", 0, ParticlesGeneratorOps::lattice);
+	FluidParticles 	coarse_fluid_particles(coarse_water, water_material);
+	WaterBlock *fine_water
+		= new WaterBlock(sph_system, "FineWater", 1, ParticlesGeneratorOps::lattice);
+	FluidParticles 	fine_fluid_particles(fine_water, water_material);
+
+	BlockMaterial 	*block_material = new BlockMaterial();
+	ElasticBlock *coarse_block
+		= new ElasticBlock(sph_system, "CoarseBlock", 0, ParticlesGeneratorOps::lattice);
+	ElasticSolidParticles 	coarse_block_particles(coarse_block, block_material);
+	ElasticBlock *fine_block
+		= new ElasticBlock(sph_system, "FineBlock", 1, ParticlesGeneratorOps::lattice);
+	ElasticSolidParticles 	fine_block_particles(fine_block, block_material);
+	/**
+	 * @brief 	Body contact map. The coarse bodies are not in contact with the fine bodies.
+	 */
+	SPHBodyTopology 	body_topology = { { coarse_water, {} }, { fine_water, {} },
+										  { coarse_block, {} }, { fine_block, {} } };
+	sph_system.SetBodyTopology(&body_topology);
+	/**
+	 * @brief 	The remapping methods.
+	 */
+	solution_remapping::RemapFluidStates 	remap_fluid_states(fine_water, coarse_water);
+	solution_remapping::RelaxRemappedFluidStates 	relax_remapped_fluid_states(fine_water);
+	solution_remapping::RemapElasticSolidStates 	remap_solid_states(fine_block, coarse_block);
+
+	/** The given states of the coarse bodies, as if from a coarse run. */
+	for (size_t i = 0; i != coarse_water->number_of_particles_; ++i)
+	{
+		BaseParticleData& base_particle_data_i = coarse_fluid_particles.base_particle_data_[i];
+		FluidParticleData& fluid_data_i = coarse_fluid_particles.fluid_particle_data_[i];
+		base_particle_data_i.vel_n_ = givenFluidVelocity(base_particle_data_i.pos_n_);
+		fluid_data_i.rho_n_ = givenFluidDensity(base_particle_data_i.pos_n_);
+		fluid_data_i.p_ = water_material->GetPressure(fluid_data_i.rho_n_);
+	}
+	for (size_t i = 0; i != coarse_block->number_of_particles_; ++i)
+	{
+		BaseParticleData& base_particle_data_i = coarse_block_particles.base_particle_data_[i];
+		base_particle_data_i.pos_n_ = deformation_tensor * base_particle_data_i.pos_0_;
+		base_particle_data_i.vel_n_ = Vecd(0.1 * base_particle_data_i.pos_0_[1], 0.0);
+		coarse_block_particles.elastic_body_data_[i].F_ = deformation_tensor;
+	}
+
+	/** Pre-simulation*/
+	sph_system.InitializeSystemCellLinkedLists();
+	sph_system.InitializeSystemConfigurations();
+
+	/** Remapping and a short relaxation of the fluid states. */
+	remap_fluid_states.parallel_exec();
+	for (size_t k = 0; k != 3; ++k) relax_remapped_fluid_states.parallel_exec();
+	remap_solid_states.parallel_exec();
+
+	/** The remapping errors in the bulk, where the kernel interpolation is of second order. */
+	Real velocity_error(0), density_error(0), pressure_error(0);
+	for (size_t i = 0; i != fine_water->number_of_particles_; ++i)
+	{
+		BaseParticleData& base_particle_data_i = fine_fluid_particles.base_particle_data_[i];
+		FluidParticleData& fluid_data_i = fine_fluid_particles.fluid_particle_data_[i];
+		pressure_error = SMAX(pressure_error, ABS(fluid_data_i.p_ - water_material->GetPressure(fluid_data_i.rho_n_)));
+		if (!isInBulk(base_particle_data_i.pos_n_)) continue;
+		velocity_error = SMAX(velocity_error,
+			(base_particle_data_i.vel_n_ - givenFluidVelocity(base_particle_data_i.pos_n_)).norm());
+		density_error = SMAX(density_error, ABS(fluid_data_i.rho_n_ - givenFluidDensity(base_particle_data_i.pos_n_)));
+	}
+	Real displacement_error(0), deformation_error(0);
+	for (size_t i = 0; i != fine_block->number_of_particles_; ++i)
+	{
+		BaseParticleData& base_particle_data_i = fine_block_particles.base_particle_data_[i];
+		if (!isInBulk(base_particle_data_i.pos_0_)) continue;
+		Vecd given_displacement = deformation_tensor * base_particle_data_i.pos_0_ - base_particle_data_i.pos_0_;
+		displacement_error = SMAX(displacement_error,
+			(base_particle_data_i.pos_n_ - base_particle_data_i.pos_0_ - given_displacement).norm());
+		Matd deformation_difference = fine_block_particles.elastic_body_data_[i].F_ - deformation_tensor;
+		deformation_error = SMAX(deformation_error, deformation_difference.norm());
+	}
+
+	bool is_passed = checkValue("Velocity error", velocity_error, 0.0, 0.05 * U_f);
+	is_passed = checkValue("Density error", density_error, 0.0, 0.1 * density_variation * rho0_f) && is_passed;
+	is_passed = checkValue("Pressure error from the equation of state", pressure_error, 0.0, 1.0e-10 * c_f * c_f) && is_passed;
+	is_passed = checkValue("Displacement error", displacement_error, 0.0, 0.05 * 0.1 * DL) && is_passed;
+	is_passed = checkValue("Deformation tensor error", deformation_error, 0.0, 1.0e-10) && is_passed;
+
+	return is_passed ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file 	split_damping.cpp
+ * @brief 	Test of the split dynamics by the 9-color and the block splitting.
+ * @details A shear wave in an elastic block is damped by the splitting algorithm,
+ *			iterating the cells by 9 colors, or by the tiles of 4 colors with block splitting.
+ *			Both should damp the wave to the same velocity field, as the results of
+ *			the splitting only depend weakly on the order of the particles.
+ *			The sequential and parallel block splitting should give identical results,
+ *			as the tiles of the same color have no neighbors in common.
+ * @author 	Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real LL = 1.0; 							/**< Length of the block. */
+Real LH = 0.5; 							/**< Height of the block. */
+Real particle_spacing_ref = 0.025; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width of the domain. */
+Real U_0 = 1.0;							/**< Amplitude of the shear wave. */
+Real eta = 1.0;							/**< Damping viscosity. */
+size_t number_of_steps = 100;			/**< Number of damping steps. */
+/**
+ * @brief Material properties of the block.
+ */
+Real rho0_s = 1.0;
+Real Youngs_modulus = 1.0e3;
+Real poisson = 0.3;
+/**
+ * @brief 	Block body definition.
+ */
+class Block : public SolidBody
+{
+public:
+	Block(SPHSystem &sph_system, string body_name, int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		std::vector<Point> block_shape;
+		block_shape.push_back(Point(0.0, 0.0));
+		block_shape.push_back(Point(0.0, LH));
+		block_shape.push_back(Point(LL, LH));
+		block_shape.push_back(Point(LL, 0.0));
+		block_shape.push_back(Point(0.0, 0.0));
+		body_region_.add_geometry(new Geometry(block_shape), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief Define block material.
+ */
+class BlockMaterial : public LinearElasticSolid
+{
+public:
+	BlockMaterial() : LinearElasticSolid()
+	{
+		rho_0_ = rho0_s;
+		E_0_ = Youngs_modulus;
+		nu_ = poisson;
+
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Damp the shear wave and return the velocities.
+ * @param[in] use_block_splitting Iterate the tiles of the block split cell lists.
+ * @param[in] is_parallel Run the damping in parallel.
+ */
+StdVec<Vecd> dampShearWave(bool use_block_splitting, bool is_parallel)
+{
+	/** Build up -- a SPHSystem -- */
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(LL + BW, LH + BW), particle_spacing_ref);
+	Block *block = new Block(sph_system, "Block", 0, ParticlesGeneratorOps::lattice);
+	BlockMaterial *block_material = new BlockMaterial();
+	ElasticSolidParticles 	block_particles(block, block_material);
+	if (use_block_splitting) block->setBlockSplitting();
+	/** Body contact map. */
+	SPHBodyTopology 	body_topology = { { block, {} } };
+	sph_system.SetBodyTopology(&body_topology);
+
+	solid_dynamics::DampingBySplittingAlgorithm damping(block, eta);
+
+	sph_system.InitializeSystemCellLinkedLists();
+	sph_system.InitializeSystemConfigurations();
+	for (size_t i = 0; i != block->number_of_particles_; ++i)
+	{
+		BaseParticleData& base_particle_data_i = block_particles.base_particle_data_[i];
+		base_particle_data_i.vel_n_ = Vec2d(0.0, U_0 * sin(2.0 * Pi * base_particle_data_i.pos_n_[0] / LL));
+	}
+
+	/** The time step size is limited by the viscous diffusion. */
+	Real smoothing_length = block->kernel_->GetSmoothingLength();
+	Real dt = 0.1 * rho0_s * smoothing_length * smoothing_length / eta;
+	for (size_t n = 0; n != number_of_steps; ++n)
+		is_parallel ? damping.parallel_exec(dt) : damping.exec(dt);
+
+	StdVec<Vecd> velocities;
+	for (size_t i = 0; i != block->number_of_particles_; ++i)
+		velocities.push_back(block_particles.base_particle_data_[i].vel_n_);
+	return velocities;
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	StdVec<Vecd> color_velocities = dampShearWave(false, true);
+	StdVec<Vecd> block_velocities = dampShearWave(true, true);
+	StdVec<Vecd> sequential_block_velocities = dampShearWave(true, false);
+
+	/** The maximum speed shows the damping, and the differences are scaled by the initial amplitude. */
+	Real max_speed = 0.0, max_difference = 0.0, max_parallel_difference = 0.0;
+	for (size_t i = 0; i != color_velocities.size(); ++i)
+	{
+		max_speed = SMAX(max_speed, color_velocities[i].norm());
+		max_difference = SMAX(max_difference, (block_velocities[i] - color_velocities[i]).norm() / U_0);
+		max_parallel_difference
+			= SMAX(max_parallel_difference, (sequential_block_velocities[i] - block_velocities[i]).norm() / U_0);
+	}
+
+	bool is_passed = max_speed < 0.9 * U_0 && max_difference < 0.02 && max_parallel_difference == 0.0;
+	cout << "Maximum speed after damping " << max_speed << ", difference between 9-color and block splitting "
+		<< max_difference << ", between sequential and parallel block splitting " << max_parallel_difference
+		<< (is_passed ? ", passed.\n" : ", failed!\n");
+	return is_passed ? 0 : 1;
+}
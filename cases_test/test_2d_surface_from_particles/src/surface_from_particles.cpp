@@ -0,0 +1,123 @@
+/**
+ * @file 	surface_from_particles.cpp
+ * @brief 	Test of the surface particles and normals identified from the inner configuration only.
+ * @details The surface of a lattice rectangle should be exactly its outermost layer of particles,
+ *			with the normals pointing out of the nearest edges.
+ *			The surface of a lattice disc should be found along the whole circle,
+ *			with the normals pointing radially outwards.
+ * @author 	Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real LL = 1.0; 							/**< Length of the rectangle. */
+Real LH = 0.5; 							/**< Height of the rectangle. */
+Real disc_radius = 0.5;					/**< Radius of the disc. */
+Vec2d disc_center(2.0, 0.5);			/**< Center of the disc. */
+int resolution(100);					/**< Number of segments of the disc polygon. */
+Real particle_spacing_ref = 0.05; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width of the domain. */
+/**
+ * @brief 	Rectangle body definition.
+ */
+class Rectangle : public SolidBody
+{
+public:
+	Rectangle(SPHSystem &sph_system, string body_name, int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		std::vector<Point> rectangle_shape;
+		rectangle_shape.push_back(Point(0.0, 0.0));
+		rectangle_shape.push_back(Point(0.0, LH));
+		rectangle_shape.push_back(Point(LL, LH));
+		rectangle_shape.push_back(Point(LL, 0.0));
+		rectangle_shape.push_back(Point(0.0, 0.0));
+		body_region_.add_geometry(new Geometry(rectangle_shape), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Disc body definition.
+ */
+class Disc : public SolidBody
+{
+public:
+	Disc(SPHSystem &sph_system, string body_name, int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		body_region_.add_geometry(new Geometry(disc_center, disc_radius, resolution), RegionBooleanOps::add);
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	/** Build up -- a SPHSystem -- */
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(disc_center[0] + disc_radius + BW, LH + disc_radius + BW),
+		particle_spacing_ref);
+	Rectangle *rectangle = new Rectangle(sph_system, "Rectangle", 0, ParticlesGeneratorOps::lattice);
+	SolidParticles 	rectangle_particles(rectangle);
+	Disc *disc = new Disc(sph_system, "Disc", 0, ParticlesGeneratorOps::lattice);
+	SolidParticles 	disc_particles(disc);
+	/** Body contact map. */
+	SPHBodyTopology 	body_topology = { { rectangle, {} }, { disc, {} } };
+	sph_system.SetBodyTopology(&body_topology);
+
+	/** The surfaces are identified from the inner configurations. */
+	sph_system.InitializeSystemCellLinkedLists();
+	sph_system.InitializeSystemConfigurations();
+	BodySurfaceFromParticles rectangle_surface(rectangle);
+	BodySurfaceFromParticles disc_surface(disc);
+
+	/** The rectangle surface is the outermost layer of particles. */
+	StdVec<int> is_rectangle_surface(rectangle->number_of_particles_, 0);
+	size_t wrong_normals = 0;
+	for (size_t n = 0; n != rectangle_surface.body_part_particles_.size(); ++n)
+	{
+		size_t i = rectangle_surface.body_part_particles_[n];
+		is_rectangle_surface[i] = 1;
+		Vecd& position = rectangle_particles.base_particle_data_[i].pos_n_;
+		StdVec<Real> edge_distances = { position[0], LL - position[0], position[1], LH - position[1] };
+		StdVec<Vecd> edge_normals = { Vecd(-1.0, 0.0), Vecd(1.0, 0.0), Vecd(0.0, -1.0), Vecd(0.0, 1.0) };
+		size_t nearest_edge = std::min_element(edge_distances.begin(), edge_distances.end()) - edge_distances.begin();
+		if (dot(rectangle_surface.surface_normals_[n], edge_normals[nearest_edge]) < 0.5) wrong_normals++;
+	}
+	size_t wrong_rectangle_particles = 0;
+	for (size_t i = 0; i != rectangle->number_of_particles_; ++i)
+	{
+		Vecd& position = rectangle_particles.base_particle_data_[i].pos_n_;
+		Real edge_distance = SMIN(SMIN(position[0], LL - position[0]), SMIN(position[1], LH - position[1]));
+		int is_outermost = edge_distance < particle_spacing_ref ? 1 : 0;
+		if (is_outermost != is_rectangle_surface[i]) wrong_rectangle_particles++;
+	}
+
+	/** The disc surface is found around the circle, near to it. */
+	size_t misplaced_disc_particles = 0;
+	for (size_t n = 0; n != disc_surface.body_part_particles_.size(); ++n)
+	{
+		size_t i = disc_surface.body_part_particles_[n];
+		Vecd radial = disc_particles.base_particle_data_[i].pos_n_ - disc_center;
+		if (radial.norm() < disc_radius - 2.0 * particle_spacing_ref) misplaced_disc_particles++;
+		if (dot(disc_surface.surface_normals_[n], radial / radial.norm()) < 0.7) wrong_normals++;
+	}
+	size_t expected_disc_particles = size_t(0.8 * 2.0 * Pi * disc_radius / particle_spacing_ref);
+
+	bool is_passed = wrong_rectangle_particles == 0 && misplaced_disc_particles == 0 && wrong_normals == 0
+		&& disc_surface.body_part_particles_.size() >= expected_disc_particles;
+	cout << "Wrongly identified rectangle particles: " << wrong_rectangle_particles
+		<< ", misplaced disc surface particles: " << misplaced_disc_particles
+		<< ", disc surface particles: " << disc_surface.body_part_particles_.size()
+		<< ", wrong normals: " << wrong_normals << (is_passed ? ", passed.\n" : ", failed!\n");
+	return is_passed ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+/**
+ * @file 	system_snapshot.cpp
+ * @brief 	Test of the in-memory snapshot of a SPH system.
+ * @details A dambreak is run to the time of the snapshot and then to an end time.
+ *			After restoring from the snapshot, the states should be those at the snapshot,
+ *			and running to the end time again should give the same states.
+ *			All parallel loops are executed sequentially, so that the results are reproducible.
+ * @author 	Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DL = 5.366; 						/**< Tank length. */
+Real DH = 5.366; 						/**< Tank height. */
+Real LL = 2.0; 							/**< Liquid colume length. */
+Real LH = 1.0; 							/**< Liquid colume height. */
+Real particle_spacing_ref = 0.05; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width for BCs. */
+/**
+ * @brief Material properties of the fluid.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real gravity_g = 1.0;					/**< Gravity force of fluid. */
+Real U_f = 2.0*sqrt(gravity_g*LH);		/**< Characteristic velocity. */
+Real c_f = 10.0*U_f;					/**< Reference sound speed. */
+/**
+ * @brief 	Fluid body definition.
+ */
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: FluidBody(sph_system, body_name, refinement_level, op)
+	{
+		/** Geomerty definition. */
+		std::vector<Point> water_block_shape;
+		water_block_shape.push_back(Point(0.0, 0.0));
+		water_block_shape.push_back(Point(0.0, LH));
+		water_block_shape.push_back(Point(LL, LH));
+		water_block_shape.push_back(Point(LL, 0.0));
+		water_block_shape.push_back(Point(0.0, 0.0));
+		Geometry *water_block_geometry = new Geometry(water_block_shape);
+		body_region_.add_geometry(water_block_geometry, RegionBooleanOps::add);
+
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		/** Basic material parameters*/
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+
+		/** Compute the derived material parameters*/
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Wall boundary body definition.
+ */
+class WallBoundary : public SolidBody
+{
+public:
+	WallBoundary(SPHSystem &sph_system, string body_name,
+		int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		/** Geomerty definition. */
+		std::vector<Point> outer_wall_shape;
+		outer_wall_shape.push_back(Point(-BW, -BW));
+		outer_wall_shape.push_back(Point(-BW, DH + BW));
+		outer_wall_shape.push_back(Point(DL + BW, DH + BW));
+		outer_wall_shape.push_back(Point(DL + BW, -BW));
+		outer_wall_shape.push_back(Point(-BW, -BW));
+		Geometry *outer_wall_geometry = new Geometry(outer_wall_shape);
+		body_region_.add_geometry(outer_wall_geometry, RegionBooleanOps::add);
+
+		std::vector<Point> inner_wall_shape;
+		inner_wall_shape.push_back(Point(0.0, 0.0));
+		inner_wall_shape.push_back(Point(0.0, DH));
+		inner_wall_shape.push_back(Point(DL, DH));
+		inner_wall_shape.push_back(Point(DL, 0.0));
+		inner_wall_shape.push_back(Point(0.0, 0.0));
+		Geometry *inner_wall_geometry = new Geometry(inner_wall_shape);
+		body_region_.add_geometry(inner_wall_geometry, RegionBooleanOps::sub);
+
+		body_region_.done_modeling();
+	}
+};
+/**
+ * @brief 	The fluid states compared between the branches.
+ */
+struct FluidStates
+{
+	Real physical_time_;
+	StdVec<Vecd> positions_, velocities_;
+	StdVec<Real> densities_;
+	StdVec<size_t> numbers_of_neighbors_;
+};
+/**
+ * @brief 	Record the fluid states.
+ */
+FluidStates recordFluidStates(SPHSystem &sph_system, FluidBody *water_block, FluidParticles &fluid_particles)
+{
+	FluidStates states;
+	states.physical_time_ = sph_system.physical_time_;
+	for (size_t i = 0; i != water_block->number_of_particles_; ++i)
+	{
+		states.positions_.push_back(fluid_particles.base_particle_data_[i].pos_n_);
+		states.velocities_.push_back(fluid_particles.base_particle_data_[i].vel_n_);
+		states.densities_.push_back(fluid_particles.fluid_particle_data_[i].rho_n_);
+		states.numbers_of_neighbors_.push_back(std::get<2>(water_block->inner_configuration_[i]));
+	}
+	return states;
+}
+/**
+ * @brief 	Compare the fluid states, which should be identical.
+ */
+bool compareFluidStates(FluidStates &states, FluidStates &reference_states, string comparison)
+{
+	bool is_identical = states.physical_time_ == reference_states.physical_time_
+		&& states.positions_.size() == reference_states.positions_.size();
+	for (size_t i = 0; is_identical && i != states.positions_.size(); ++i)
+	{
+		is_identical = states.positions_[i] == reference_states.positions_[i]
+			&& states.velocities_[i] == reference_states.velocities_[i]
+			&& states.densities_[i] == reference_states.densities_[i]
+			&& states.numbers_of_neighbors_[i] == reference_states.numbers_of_neighbors_[i];
+	}
+	cout << comparison << (is_identical ? ": identical.\n" : ": different!\n");
+	return is_identical;
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	/**
+	 * @brief Build up -- a SPHSystem --
+	 */
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW), particle_spacing_ref);
+	/** The branches are compared exactly, so the loops are executed sequentially. */
+	sph_system.setSerialExecution(true);
+	/**
+	 * @brief Material property, partilces and body creation of fluid.
+	 */
+	WaterBlock *water_block
+		= new WaterBlock(sph_system, "WaterBody", 0, ParticlesGeneratorOps::lattice);
+	WaterMaterial 	*water_material = new WaterMaterial();
+	FluidParticles 	fluid_particles(water_block, water_material);
+	/**
+	 * @brief 	Particle and body creation of wall boundary.
+	 */
+	WallBoundary *wall_boundary
+		= new WallBoundary(sph_system, "Wall", 0, ParticlesGeneratorOps::lattice);
+	SolidParticles 	solid_particles(wall_boundary);
+	/**
+	 * @brief 	Body contact map.
+	 */
+	SPHBodyTopology 	body_topology = { { water_block, { wall_boundary } }, { wall_boundary, {} } };
+	sph_system.SetBodyTopology(&body_topology);
+	/**
+	 * @brief 	Define all numerical methods which are used in this case.
+	 */
+	Gravity 	gravity(Vecd(0.0, -gravity_g));
+	solid_dynamics::NormalDirectionSummation 	get_wall_normal(wall_boundary, {});
+	InitializeATimeStep 	initialize_a_fluid_step(water_block, &gravity);
+	fluid_dynamics::DensityBySummationFreeSurface 	update_fluid_density(water_block, { wall_boundary });
+	fluid_dynamics::GetAdvectionTimeStepSize 	get_fluid_adevction_time_step_size(water_block, U_f);
+	fluid_dynamics::GetAcousticTimeStepSize 	get_fluid_time_step_size(water_block);
+	fluid_dynamics::PressureRelaxationFirstHalfRiemann
+		pressure_relaxation_first_half(water_block, { wall_boundary });
+	fluid_dynamics::PressureRelaxationSecondHalfRiemann
+		pressure_relaxation_second_half(water_block, { wall_boundary });
+	ParticleDynamicsCellLinkedList		update_cell_linked_list(water_block);
+	ParticleDynamicsConfiguration 		update_particle_configuration(water_block);
+
+	/** Pre-simulation*/
+	sph_system.InitializeSystemCellLinkedLists();
+	sph_system.InitializeSystemConfigurations();
+	get_wall_normal.exec();
+
+	Real dt = 0.0; 			/**< Default accoustic time step sizes. */
+	/** Advance the system to a given time. */
+	auto advanceTo = [&](Real end_time) {
+		while (sph_system.physical_time_ < end_time)
+		{
+			initialize_a_fluid_step.parallel_exec();
+			Real Dt = get_fluid_adevction_time_step_size.parallel_exec();
+			update_fluid_density.parallel_exec();
+
+			Real relaxation_time = 0.0;
+			while (relaxation_time < Dt)
+			{
+				pressure_relaxation_first_half.parallel_exec(dt);
+				pressure_relaxation_second_half.parallel_exec(dt);
+				dt = get_fluid_time_step_size.parallel_exec();
+				relaxation_time += dt;
+				sph_system.physical_time_ += dt;
+			}
+
+			update_cell_linked_list.parallel_exec();
+			update_particle_configuration.parallel_exec();
+		}
+	};
+
+	Real snapshot_time = 0.5;
+	Real end_time = 1.0;
+	/** The first branch. */
+	advanceTo(snapshot_time);
+	SystemSnapshot* snapshot = sph_system.takeSnapshot();
+	Real dt_at_snapshot = dt;
+	FluidStates states_at_snapshot = recordFluidStates(sph_system, water_block, fluid_particles);
+	advanceTo(end_time);
+	FluidStates states_of_first_branch = recordFluidStates(sph_system, water_block, fluid_particles);
+
+	/** The second branch from the snapshot. */
+	sph_system.restoreFromSnapshot(*snapshot);
+	dt = dt_at_snapshot;
+	FluidStates restored_states = recordFluidStates(sph_system, water_block, fluid_particles);
+	bool is_restored = compareFluidStates(restored_states, states_at_snapshot, "Restored states");
+	advanceTo(end_time);
+	FluidStates states_of_second_branch = recordFluidStates(sph_system, water_block, fluid_particles);
+	bool is_reproduced = compareFluidStates(states_of_second_branch, states_of_first_branch, "Second branch");
+	delete snapshot;
+
+	return is_restored && is_reproduced ? 0 : 1;
+}
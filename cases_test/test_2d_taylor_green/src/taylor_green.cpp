@@ -100,7 +100,7 @@ int main()
 	 */
 	SPHSystem system(Vec2d(0), Vec2d(DL, DH), particle_spacing_ref);
 	/** Set the starting time. */
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	/** Tag for computation from restart files. 0: not from restart files. */
 	system.restart_step_ = 0;
 	/**
@@ -204,16 +204,16 @@ int main()
 	 /** If the starting time is not zero, please setup the restart time step ro read in restart states. */
 	if (system.restart_step_ != 0)
 	{
-		GlobalStaticVariables::physical_time_ = read_restart_files.ReadRestartFiles(system.restart_step_);
+		system.physical_time_ = read_restart_files.ReadRestartFiles(system.restart_step_);
 		update_cell_linked_list.parallel_exec();
 		periodic_condition_x.parallel_exec();
 		periodic_condition_y.parallel_exec();
 		update_particle_configuration.parallel_exec();
 	}
 	/** Output the start states of bodies. */
-	write_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_body_states.WriteToFile(system.physical_time_);
 	/** Output the mechanical energy of fluid. */
-	write_totoal_mechanical_energy.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_totoal_mechanical_energy.WriteToFile(system.physical_time_);
 	/**
 	 * @brief 	Basic parameters.
 	 */
@@ -230,7 +230,7 @@ int main()
 	/**
 	 * @brief 	Main loop starts here.
 	 */
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		/** Integrate time (loop) until the next output time. */
@@ -252,14 +252,14 @@ int main()
 				dt = get_fluid_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 
 			}
 
 			if (number_of_iterations % screen_output_interval == 0)
 			{
 				cout << fixed << setprecision(9) << "N=" << number_of_iterations << "	Time = "
-					<< GlobalStaticVariables::physical_time_
+					<< system.physical_time_
 					<< "	Dt = " << Dt << "	dt = " << dt << "\n";
 
 				if (number_of_iterations % restart_output_interval == 0)
@@ -277,8 +277,8 @@ int main()
 		}
 
 		tick_count t2 = tick_count::now();
-		write_totoal_mechanical_energy.WriteToFile(GlobalStaticVariables::physical_time_);
-		write_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_totoal_mechanical_energy.WriteToFile(system.physical_time_);
+		write_body_states.WriteToFile(system.physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -289,5 +289,7 @@ int main()
 	cout << "Total wall time for computation: " << tt.seconds()
 		<< " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
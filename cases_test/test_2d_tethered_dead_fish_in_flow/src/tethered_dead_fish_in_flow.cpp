@@ -284,7 +284,7 @@ public:
 
 	void PrepareConstraint() override
 	{
-		Real run_time = GlobalStaticVariables::physical_time_;
+		Real run_time = body_->getSPHSystem().physical_time_;
 		u_ave_ = run_time < t_ref ? 0.5 * u_ref_ * (1.0 - cos(pi * run_time / t_ref)) : u_ref_;
 	}
 };
@@ -558,7 +558,7 @@ int main()
 	/**
 	* Time steeping starts here.
 	*/
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	/** Using relaxed particle distribution if needed. */
 	if (system.reload_particles_) {
 		ReadReloadParticle		reload_insert_body_particles(in_output, { fish_body }, { "FishBody" });
@@ -580,8 +580,8 @@ int main()
 	get_fish_body_normal.parallel_exec();
 	fish_body_corrected_configuration_in_strong_form.parallel_exec();
 	/** Output for initial condition. */
-	write_real_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
-	write_fish_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_real_body_states.WriteToFile(system.physical_time_);
+	write_fish_displacement.WriteToFile(system.physical_time_);
 	/**
 	* Time parameters
 	*/
@@ -598,7 +598,7 @@ int main()
 	/**
 	* Main loop starts here.
 	*/
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		while (integeral_time < D_Time)
@@ -639,19 +639,19 @@ int main()
 					dt_s_sum += dt_s;
 				}
 				fish_body_average_velocity.parallel_exec(dt);
-				write_total_force_on_fish.WriteToFile(GlobalStaticVariables::physical_time_);
+				write_total_force_on_fish.WriteToFile(system.physical_time_);
 
 				dt = get_fluid_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 				parabolic_inflow.parallel_exec();
 
 			}
 			if (number_of_iterations % screen_output_interval == 0)
 			{
 				cout << fixed << setprecision(9) << "N=" << number_of_iterations << "	Time = "
-					<< GlobalStaticVariables::physical_time_
+					<< system.physical_time_
 					<< "	Dt = " << Dt << "	dt = " << dt << "	dt_s = " << dt_s << "\n";
 			}
 			number_of_iterations++;
@@ -666,11 +666,11 @@ int main()
 			/** Fish body contact configuration. */
 			update_fish_body_cell_linked_list.parallel_exec();
 			update_fish_body_contact_configuration.parallel_exec();
-			write_fish_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+			write_fish_displacement.WriteToFile(system.physical_time_);
 		}
 		tick_count t2 = tick_count::now();
 		compute_vorticity.parallel_exec();
-		write_real_body_states.WriteToFile(GlobalStaticVariables::physical_time_ * 0.001);
+		write_real_body_states.WriteToFile(system.physical_time_ * 0.001);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -680,5 +680,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
\ No newline at end of file
@@ -218,7 +218,7 @@ int main()
 	//from here the time stepping begines
 	//-------------------------------------------------------------------
 	//starting time zero
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	
 	//initial periodic boundary condition
 	//which copies the particle identifies
@@ -236,7 +236,7 @@ int main()
 	get_wall_normal.parallel_exec();
 
 	//initial output
-	write_real_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_real_body_states.WriteToFile(system.physical_time_);
 
 	int number_of_iterations = 0;
 	int screen_output_interval = 100;
@@ -251,7 +251,7 @@ int main()
 	tick_count::interval_t interval;
 
 	//computation loop starts 
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		//integrate time (loop) until the next output time
@@ -273,13 +273,13 @@ int main()
 				if ((relaxation_time + dt) >= Dt) dt = Dt - relaxation_time;
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 			}
 
 			if (number_of_iterations % screen_output_interval == 0)
 			{
 				cout << fixed << setprecision(9) << "N=" << number_of_iterations << "	Time = "
-					<< GlobalStaticVariables::physical_time_
+					<< system.physical_time_
 					<< "	Dt = " << Dt << "	dt = " << dt << "\n";
 			}
 			number_of_iterations++;
@@ -293,7 +293,7 @@ int main()
 
 		tick_count t2 = tick_count::now();
 		compute_vorticity.parallel_exec();
-		write_real_body_states.WriteToFile(GlobalStaticVariables::physical_time_  * 0.001);
+		write_real_body_states.WriteToFile(system.physical_time_  * 0.001);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -303,5 +303,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
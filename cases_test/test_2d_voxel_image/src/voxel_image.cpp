@@ -0,0 +1,136 @@
+/**
+ * @file 	voxel_image.cpp
+ * @brief 	Test of a body generated from a segmented voxel image.
+ * @details A labelled image of a disc with a core and a ring is written as a MetaImage
+ *			with local 16-bit data, and read back. The body is the union of both labels,
+ *			its particles are generated by the voxel generator, and the core is
+ *			a body part by the voxel label. The volumes of the body and the core,
+ *			and the level set of the body, are checked against the exact disc.
+ * @author 	Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+ /**
+  * @brief 	SPHinXsys Library.
+  */
+#include "sphinxsys.h"
+  /**
+ * @brief Namespace cite here.
+ */
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+size_t number_of_voxels = 64;			/**< Number of voxels in each direction. */
+Real voxel_spacing = 0.05;				/**< Voxel size. */
+Real DL = Real(number_of_voxels) * voxel_spacing; 	/**< Image size. */
+Vec2d disc_center(0.5 * DL, 0.5 * DL);	/**< Center of the disc. */
+Real core_radius = 0.6;					/**< Radius of the core with label 1. */
+Real disc_radius = 1.0;					/**< Radius of the disc, the ring has label 2. */
+Real particle_spacing_ref = 0.025; 		/**< Initial reference particle spacing. */
+/**
+ * @brief 	Write the labelled image of the disc as a MetaImage with local data.
+ */
+void writeDiscImage(string header_file)
+{
+	ofstream image(header_file.c_str(), ios::binary);
+	image << "ObjectType = Image\n";
+	image << "NDims = 2\n";
+	image << "BinaryData = True\n";
+	image << "BinaryDataByteOrderMSB = True\n";
+	image << "ElementSpacing = " << voxel_spacing << " " << voxel_spacing << "\n";
+	image << "Offset = " << 0.5 * voxel_spacing << " " << 0.5 * voxel_spacing << "\n";
+	image << "DimSize = " << number_of_voxels << " " << number_of_voxels << "\n";
+	image << "ElementType = MET_USHORT\n";
+	image << "ElementDataFile = LOCAL\n";
+	for (size_t j = 0; j != number_of_voxels; ++j)
+		for (size_t i = 0; i != number_of_voxels; ++i)
+		{
+			Vec2d voxel_center((Real(i) + 0.5) * voxel_spacing, (Real(j) + 0.5) * voxel_spacing);
+			Real distance = (voxel_center - disc_center).norm();
+			unsigned short label = distance < core_radius ? 1 : (distance < disc_radius ? 2 : 0);
+			image.put(char(label >> 8));
+			image.put(char(label & 0xff));
+		}
+	image.close();
+}
+/**
+ * @brief 	Body given by the voxel shape.
+ */
+class VoxelDisc : public SolidBody
+{
+public:
+	VoxelDisc(SPHSystem &sph_system, string body_name, VoxelShape &voxel_shape,
+		int refinement_level, ParticlesGeneratorOps op)
+		: SolidBody(sph_system, body_name, refinement_level, op)
+	{
+		setBodyShape(&voxel_shape);
+	}
+};
+/**
+ * @brief 	Check a value against the expected one with a tolerance.
+ */
+bool checkValue(string name, Real value, Real expected_value, Real tolerance)
+{
+	bool is_passed = ABS(value - expected_value) <= tolerance;
+	cout << name << ": " << value << ", expected " << expected_value
+		<< (is_passed ? ", passed.\n" : ", failed!\n");
+	return is_passed;
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	/**
+	 * @brief Build up -- a SPHSystem --
+	 */
+	SPHSystem sph_system(Vec2d(0.0, 0.0), Vec2d(DL, DL), particle_spacing_ref);
+	/**
+	 * @brief The segmented image and the shape of the labels.
+	 */
+	string image_file = "./voxel_disc.mhd";
+	writeDiscImage(image_file);
+	VoxelImage voxel_image(image_file);
+	VoxelShape disc_shape(voxel_image, { 1, 2 }, "VoxelDisc");
+	/**
+	 * @brief 	Particle and body creation from the voxel shape.
+	 */
+	VoxelDisc *voxel_disc
+		= new VoxelDisc(sph_system, "VoxelDisc", disc_shape, 0, ParticlesGeneratorOps::voxel);
+	SolidParticles 	disc_particles(voxel_disc);
+	BodyPartByVoxelLabels disc_core(voxel_disc, "DiscCore", voxel_image, { 1 });
+	voxel_disc->addBackgroundMesh(1.0);
+	/**
+	 * @brief 	Body contact map.
+	 */
+	SPHBodyTopology 	body_topology = { { voxel_disc, {} } };
+	sph_system.SetBodyTopology(&body_topology);
+	/**
+	 * @brief simple input and outputs.
+	 */
+	In_Output 							in_output(sph_system);
+	WriteBodyStatesToVtu 				write_states(in_output, sph_system.real_bodies_);
+	write_states.WriteToFile(0.0);
+
+	/** The voxel staircase of the circles gives errors of the order of a voxel size,
+	  * which is about 5 percent of the volumes. */
+	Real disc_volume = 0.0;
+	for (size_t i = 0; i != voxel_disc->number_of_particles_; ++i)
+		disc_volume += disc_particles.base_particle_data_[i].Vol_0_;
+	Real core_volume = Real(disc_core.body_part_particles_.size()) * particle_spacing_ref * particle_spacing_ref;
+	Real exact_disc_volume = Pi * disc_radius * disc_radius;
+	Real exact_core_volume = Pi * core_radius * core_radius;
+	bool is_passed = checkValue("Disc volume", disc_volume, exact_disc_volume, 0.05 * exact_disc_volume);
+	is_passed = checkValue("Core volume", core_volume, exact_core_volume, 0.05 * exact_core_volume) && is_passed;
+
+	/** The level set is positive inside the body. The surface points are the voxel face centers,
+	  * which are within half a voxel size from the circle. The point outside is in the mesh buffer. */
+	MeshBackground *mesh_background = voxel_disc->mesh_background_;
+	Real outer_distance = 2.0 * particle_spacing_ref;
+	Real center_level_set = mesh_background->ProbeLevelSet(disc_center);
+	Real outer_level_set = mesh_background->ProbeLevelSet(disc_center + Vec2d(disc_radius + outer_distance, 0.0));
+	is_passed = checkValue("Level set at the center", center_level_set, disc_radius, 0.5 * voxel_spacing) && is_passed;
+	is_passed = checkValue("Level set outside", outer_level_set, -outer_distance, 0.5 * voxel_spacing) && is_passed;
+
+	return is_passed ? 0 : 1;
+}
@@ -331,7 +331,7 @@ class WaveMaking : public solid_dynamics::ConstrainSolidBodyRegion
 
 	virtual void PrepareConstraint() override 
 	{
-		time_ = GlobalStaticVariables::physical_time_;
+		time_ = body_->getSPHSystem().physical_time_;
 	}
 
 public:
@@ -468,7 +468,7 @@ int main()
 	//from here the time stepping begines
 	//-------------------------------------------------------------------
 	//starting time zero
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 
 	/**
 	 * @brief Prepare quantities will be used once only and initial condition.
@@ -480,7 +480,7 @@ int main()
 	gate_corrected_configuration_in_strong_form.parallel_exec();
 
 	//initial output
-	write_real_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_real_body_states.WriteToFile(system.physical_time_);
 
 	int number_of_iterations = system.restart_step_;
 	int screen_output_interval = 100;
@@ -495,7 +495,7 @@ int main()
 	tick_count t1 = tick_count::now();
 	tick_count::interval_t interval;
 
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		while (integeral_time < D_Time) {
@@ -532,13 +532,13 @@ int main()
 				dt = get_fluid_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 			}
 			
 			if (number_of_iterations % screen_output_interval == 0)
 			{
 				cout << fixed << setprecision(9) << "N=" << number_of_iterations << "	Time = "
-					<< GlobalStaticVariables::physical_time_
+					<< system.physical_time_
 					<< "	Dt = " << Dt << "	dt = " << dt << "	dt_s = " << dt_s << "\n";
 			}
 			number_of_iterations++;
@@ -555,7 +555,7 @@ int main()
 		}
 
 		tick_count t2 = tick_count::now();
-		write_real_body_states.WriteToFile(GlobalStaticVariables::physical_time_  * 0.001);
+		write_real_body_states.WriteToFile(system.physical_time_  * 0.001);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -565,5 +565,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 	
+	system.reportMemoryUsage();
+
 	return 0;
 }
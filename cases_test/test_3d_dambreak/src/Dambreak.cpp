@@ -109,7 +109,7 @@ int main()
 	SPHSystem system(Vecd(-BW, -BW, -BW), 
 		Vecd(DL + BW, DH + BW, DW + BW), particle_spacing_ref);
 	/** Set the starting time. */
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	/** Tag for computation from restart files. 0: not from restart files. */
 	system.restart_step_ = 0;
 
@@ -213,15 +213,15 @@ int main()
 	/** If the starting time is not zero, please setup the restart time step ro read in restart states. */
 	if (system.restart_step_ != 0)
 	{
-		GlobalStaticVariables::physical_time_ = read_restart_files.ReadRestartFiles(system.restart_step_);
+		system.physical_time_ = read_restart_files.ReadRestartFiles(system.restart_step_);
 		update_cell_linked_list.parallel_exec();
 		update_particle_configuration.parallel_exec();
 	}
 	
 	/** Output the start states of bodies. */
-	write_water_block_states.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_water_block_states.WriteToFile(system.physical_time_);
 	/** Output the Hydrostatic mechanical energy of fluid. */
-	write_water_mechanical_energy.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_water_mechanical_energy.WriteToFile(system.physical_time_);
 
 	int number_of_iterations = system.restart_step_;
 	int screen_output_interval = 100;
@@ -233,7 +233,7 @@ int main()
 	Real dt = 0.0; //default accoustic time step sizes
 
 	//output for initial particles, global data
-	write_water_block_states.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_water_block_states.WriteToFile(system.physical_time_);
 
 	//statistics for computing time
 	tick_count t1 = tick_count::now();
@@ -241,7 +241,7 @@ int main()
 	
 	int count_sorting = 0;
 	//computation loop starts 
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		//integrate time (loop) until the next output time
@@ -262,13 +262,13 @@ int main()
 				dt = get_fluid_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 			}
 			
 			if (number_of_iterations % screen_output_interval == 0)
 			{
 				cout << fixed << setprecision(9) << "N=" << number_of_iterations << "	Time = "
-					<< GlobalStaticVariables::physical_time_
+					<< system.physical_time_
 					<< "	Dt = " << Dt << "	dt = " << dt << "\n";
 
 				if (number_of_iterations % restart_output_interval == 0)
@@ -279,14 +279,14 @@ int main()
 			update_cell_linked_list.parallel_exec();
 			update_particle_configuration.parallel_exec();
 			update_observer_contact_configuration.parallel_exec();
-			write_recorded_water_pressure.WriteToFile(GlobalStaticVariables::physical_time_);
+			write_recorded_water_pressure.WriteToFile(system.physical_time_);
 
 		}
 
-		write_water_mechanical_energy.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_water_mechanical_energy.WriteToFile(system.physical_time_);
 
 		tick_count t2 = tick_count::now();
-		write_water_block_states.WriteToFile(GlobalStaticVariables::physical_time_ * 0.001);
+		write_water_block_states.WriteToFile(system.physical_time_ * 0.001);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -296,5 +296,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
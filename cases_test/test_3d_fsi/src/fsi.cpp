@@ -276,7 +276,7 @@ public:
 
 	void PrepareConstraint() override
 	{
-		Real run_time = GlobalStaticVariables::physical_time_;
+		Real run_time = body_->getSPHSystem().physical_time_;
 		u_ave_ = run_time < t_ref 
 			? 0.5*u_ref_*(1.0 - cos(pi*run_time/ t_ref)) : u_ref_;
 	}
@@ -413,7 +413,7 @@ int main()
 	//from here the time stepping begines
 	//-------------------------------------------------------------------
 	//starting time zero
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 
 	/** Pre-simultion*/
 
@@ -441,8 +441,8 @@ int main()
 		write_flag_free_end("Displacement", in_output, flag_observer, inserted_body);
 
 	//initial output
-	write_real_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
-	write_flag_free_end.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_real_body_states.WriteToFile(system.physical_time_);
+	write_flag_free_end.WriteToFile(system.physical_time_);
 
 	int ite = 0;
 	Real End_Time = 200.0;
@@ -456,7 +456,7 @@ int main()
 	tick_count::interval_t interval;
 
 	//computation loop starts 
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		//integrate time (loop) until the next output time
@@ -476,7 +476,7 @@ int main()
 
 				if (ite % 100 == 0) {
 					cout << "N=" << ite << " Time: "
-						<< GlobalStaticVariables::physical_time_ << "	dt: "
+						<< system.physical_time_ << "	dt: "
 						<< dt << "\n";
 				}
 
@@ -496,7 +496,7 @@ int main()
 
 					if (ite % 100 == 0) {
 						cout << "N=" << ite << " Time: "
-							<< GlobalStaticVariables::physical_time_ << "	dt_s: "
+							<< system.physical_time_ << "	dt_s: "
 							<< dt_s << "\n";
 					}
 
@@ -511,7 +511,7 @@ int main()
 				dt = get_fluid_time_step_size.parallel_exec();
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 				parabolic_inflow.parallel_exec();
 
 			}
@@ -526,11 +526,11 @@ int main()
 			update_inserted_body_cell_linked_list.parallel_exec();
 			update_inserted_body_contact_configuration.parallel_exec();
 
-			write_flag_free_end.WriteToFile(GlobalStaticVariables::physical_time_);
+			write_flag_free_end.WriteToFile(system.physical_time_);
 		}
 
 		tick_count t2 = tick_count::now();
-		write_real_body_states.WriteToFile(GlobalStaticVariables::physical_time_  * 0.001);
+		write_real_body_states.WriteToFile(system.physical_time_  * 0.001);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -540,5 +540,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
@@ -160,68 +160,84 @@ public:
 	}
 };
  /**
- * application dependent initial condition 
+ * The region of stimulus SI, tagged once from the particle positions.
  */
-class ApplyStimulusCurrentSI
-	: public electro_physiology::ElectroPhysiologyInitialCondition
+class StimulusRegionSI : public BodyPartByParticle
 {
 protected:
-	size_t voltage_;
-
-	void Update(size_t index_particle_i, Real dt) override
+	void TagBodyPartParticles() override
 	{
-		BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
-		DiffusionReactionData& electro_physiology_data_i = particles_->diffusion_reaction_data_[index_particle_i];
-
-		if( -30.0  * length_scale <= base_particle_data_i.pos_n_[0] && base_particle_data_i.pos_n_[0] <= -15.0  * length_scale)
+		for (size_t i = 0; i < body_->number_of_particles_; ++i)
 		{
-			if( -2.0  * length_scale <= base_particle_data_i.pos_n_[1] && base_particle_data_i.pos_n_[1] <= 0.0)
-			{
-				if( -3.0  * length_scale <= base_particle_data_i.pos_n_[2] && base_particle_data_i.pos_n_[2] <= 3.0  * length_scale)
-				{
-					electro_physiology_data_i.species_n_[voltage_] = 0.92;
-				}
-			}
+			Vecd& pos_n = body_->base_particles_->base_particle_data_[i].pos_n_;
+			if (-30.0 * length_scale <= pos_n[0] && pos_n[0] <= -15.0 * length_scale
+				&& -2.0 * length_scale <= pos_n[1] && pos_n[1] <= 0.0
+				&& -3.0 * length_scale <= pos_n[2] && pos_n[2] <= 3.0 * length_scale)
+				tagAParticle(i);
 		}
 	};
 public:
-	ApplyStimulusCurrentSI(SolidBody* muscle)
-		: electro_physiology::ElectroPhysiologyInitialCondition(muscle) 
+	StimulusRegionSI(SolidBody* muscle, string body_part_name)
+		: BodyPartByParticle(muscle, body_part_name)
 	{
-		voltage_ = material_->getSpeciesIndexMap()["Voltage"];
+		TagBodyPartParticles();
 	};
 };
  /**
- * application dependent initial condition 
+ * The region of stimulus SII, tagged once from the particle positions.
  */
-class ApplyStimulusCurrentSII
-	: public electro_physiology::ElectroPhysiologyInitialCondition
+class StimulusRegionSII : public BodyPartByParticle
 {
 protected:
-	size_t voltage_;
-
-	void Update(size_t index_particle_i, Real dt) override
+	void TagBodyPartParticles() override
 	{
-		BaseParticleData &base_particle_data_i = particles_->base_particle_data_[index_particle_i];
-		DiffusionReactionData& electro_physiology_data_i = particles_->diffusion_reaction_data_[index_particle_i];
-
-		if( 0.0 <= base_particle_data_i.pos_n_[0] && base_particle_data_i.pos_n_[0] <= 6.0 * length_scale) 
+		for (size_t i = 0; i < body_->number_of_particles_; ++i)
 		{
-			if( -6.0 * length_scale <= base_particle_data_i.pos_n_[1])
-			{
-				if( 12.0 * length_scale <= base_particle_data_i.pos_n_[2])
-				{
-					electro_physiology_data_i.species_n_[voltage_] = 0.95;
-				}
-			}
+			Vecd& pos_n = body_->base_particles_->base_particle_data_[i].pos_n_;
+			if (0.0 <= pos_n[0] && pos_n[0] <= 6.0 * length_scale
+				&& -6.0 * length_scale <= pos_n[1]
+				&& 12.0 * length_scale <= pos_n[2])
+				tagAParticle(i);
 		}
 	};
 public:
-	ApplyStimulusCurrentSII(SolidBody* muscle)
-		: electro_physiology::ElectroPhysiologyInitialCondition(muscle) 
+	StimulusRegionSII(SolidBody* muscle, string body_part_name)
+		: BodyPartByParticle(muscle, body_part_name)
+	{
+		TagBodyPartParticles();
+	};
+};
+ /**
+ * application dependent stimulus 
+ */
+class ApplyStimulusCurrentSI
+	: public electro_physiology::ApplyStimulusCurrentsToBodyPart
+{
+protected:
+	void ConstraintAParticle(size_t index_particle_i, Real dt) override
+	{
+		particles_->diffusion_reaction_data_[index_particle_i].species_n_[voltage_] = 0.92;
+	};
+public:
+	ApplyStimulusCurrentSI(SolidBody* muscle)
+		: electro_physiology::ApplyStimulusCurrentsToBodyPart(muscle, 
+			new StimulusRegionSI(muscle, "StimulusRegionSI")) {};
+};
+ /**
+ * application dependent stimulus 
+ */
+class ApplyStimulusCurrentSII
+	: public electro_physiology::ApplyStimulusCurrentsToBodyPart
+{
+protected:
+	void ConstraintAParticle(size_t index_particle_i, Real dt) override
 	{
-		voltage_ = material_->getSpeciesIndexMap()["Voltage"];
+		particles_->diffusion_reaction_data_[index_particle_i].species_n_[voltage_] = 0.95;
 	};
+public:
+	ApplyStimulusCurrentSII(SolidBody* muscle)
+		: electro_physiology::ApplyStimulusCurrentsToBodyPart(muscle, 
+			new StimulusRegionSII(muscle, "StimulusRegionSII")) {};
 };
 /**
  * Voltage observer body definition.
@@ -261,18 +277,21 @@ public:
 /** 
  * The main program. 
  */
-int main()
+int main(int ac, char* av[])
 {
 	/** 
 	 * Build up context -- a SPHSystem. 
 	 */
 	SPHSystem system(domain_lower_bound, domain_upper_bound, dp_0, 6);
 	/** Set the starting time. */
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	/** Tag for computation from restart files. 0: not from restart files. */
 	system.restart_step_ = 0;
 	/** Tag for reload initially repaxed particles. */
 	system.reload_particles_ = true;
+
+	//handle command line arguments, e.g. --restart=1000
+	system.handleCommandlineOptions(ac, av);
 	/** Configuration of materials, crate particle container and electrophysiology body. */
 	HeartBody *physiology_body  					
 		=  new HeartBody(system, "ExcitationHeart", 0, ParticlesGeneratorOps::lattice);
@@ -305,6 +324,12 @@ int main()
 	ReadReloadParticle			contraction_reload_particles(in_output, {mechanics_body}, { "ContractionHeart" });;
 	/** Read material property, e.g., sheet and fiber, from xml file. */
 	ReadReloadMaterialProperty  read_material_property(in_output, myocardium_muscle);
+	/** Reference configurations of the bodies in total Lagrangian formulation, kept for restart. */
+	WriteReferenceConfiguration write_reference_configuration(in_output, system.bodies_);
+	ReadReferenceConfiguration	read_reference_configuration(in_output, system.bodies_);
+	/** Output the body states for restart simulation. */
+	ReadRestart					read_restart_files(in_output, system.real_bodies_);
+	WriteRestart				write_restart_files(in_output, system.real_bodies_);
 	/** Set body contact map. */
 	SPHBodyTopology body_topology = {{physiology_body, {mechanics_body}}, {mechanics_body, {physiology_body}},
 									 {voltage_observer, {physiology_body}}, {myocardium_observer, {mechanics_body}} };
@@ -320,7 +345,18 @@ int main()
 		read_material_property.ReadFromFile();
 		myocardium_excitation->assignFiberProperties(myocardium_muscle->local_f0_);
 	}
-	system.SetupSPHSimulation();
+	/** On restart, the configurations and correction matrices are read instead of built. */
+	bool reload_reference_configuration = system.restart_step_ != 0 
+		&& read_reference_configuration.CheckReferenceConfigurationFiles();
+	if (reload_reference_configuration)
+	{
+		system.InitializeSystemCellLinkedLists();
+		read_reference_configuration.ReadFromFile();
+	}
+	else
+	{
+		system.SetupSPHSimulation();
+	}
 	/** 
 	 * Corrected strong configuration. 
 	 */	
@@ -362,46 +398,66 @@ int main()
 	 * Active mechanics. */
 	solid_dynamics::CorrectConfiguration 
 		correct_configuration_contraction(mechanics_body);
-	/** */
-	observer_dynamics::CorrectKenelWeightsForInterpolation
-		correct_kernel_weights_for_interpolation(mechanics_body, {physiology_body});
+	/** Transfer operators between the two bodies, built once as both are in total Lagrangian formulation. */
+	observer_dynamics::TransferOperator
+		transfer_from_physiology(mechanics_body, { physiology_body });
+	observer_dynamics::TransferOperator
+		transfer_from_mechanics(physiology_body, { mechanics_body }, false);
 	/** Interpolate the active contract stress from eletrophyisology body. */
-	observer_dynamics::InterpolatingADiffusionReactionQuantity<ActiveMuscleParticles, ActiveMuscleData,
+	observer_dynamics::TransferringADiffusionReactionQuantity<ActiveMuscleParticles, ActiveMuscleData,
 		ElectroPhysiologyParticles, &ActiveMuscleParticles::active_muscle_data_, &ActiveMuscleData::active_contraction_stress_>
-		active_stress_interpolation("ActiveContractionStress", mechanics_body, { physiology_body });
+		active_stress_interpolation("ActiveContractionStress", transfer_from_physiology);
 	/** Interpolate the particle position in physiology_body  from mechanics_body. */
-	observer_dynamics::InterpolatingAQuantity<Vecd, BaseParticles, BaseParticleData, BaseParticles, BaseParticleData, 
+	observer_dynamics::TransferringAQuantity<Vecd, BaseParticles, BaseParticleData, BaseParticles, BaseParticleData, 
 		&BaseParticles::base_particle_data_, &BaseParticles::base_particle_data_,
 		&BaseParticleData::pos_n_, &BaseParticleData::pos_n_>
-		interpolation_particle_position(physiology_body, { mechanics_body });
-	/** Time step size caclutation. */
-	solid_dynamics::GetAcousticTimeStepSize 
-		get_mechanics_time_step(mechanics_body);
-	/** active-pative stress relaxation. */
-	solid_dynamics::StressRelaxationFirstHalf
-		stress_relaxation_first_half(mechanics_body);
-	solid_dynamics::StressRelaxationSecondHalf
-		stress_relaxation_second_half(mechanics_body);
+		interpolation_particle_position(transfer_from_mechanics);
+	/** The weights of the transfer operators are kept for restart with the reference configurations. */
+	WriteTransferOperators		write_transfer_operators(in_output, { &transfer_from_physiology, &transfer_from_mechanics });
+	ReadTransferOperators		read_transfer_operators(in_output, { &transfer_from_physiology, &transfer_from_mechanics });
 	/** Constrain region of the inserted body. */
 	solid_dynamics::ConstrainSolidBodyRegion
 		constrain_holder(mechanics_body, new MuscleBase(mechanics_body, "Holder"));
+	/** active-pative stress relaxation sub-cycled within the physiology time step. */
+	active_muscle_dynamics::ElectroMechanicsSubCycling
+		mechanics_sub_cycling(mechanics_body, &constrain_holder);
 	/** 
 	 * Pre-simultion. 
 	 */
-	correct_configuration_excitation.parallel_exec();
-	correct_configuration_contraction.parallel_exec();
-	correct_kernel_weights_for_interpolation.parallel_exec();
+	if (!reload_reference_configuration)
+	{
+		correct_configuration_excitation.parallel_exec();
+		correct_configuration_contraction.parallel_exec();
+		write_reference_configuration.WriteToFile();
+	}
+	if (reload_reference_configuration && read_transfer_operators.CheckTransferOperatorFiles())
+	{
+		read_transfer_operators.ReadFromFile();
+	}
+	else
+	{
+		transfer_from_physiology.parallel_exec();
+		transfer_from_mechanics.parallel_exec();
+		write_transfer_operators.WriteToFile();
+	}
+	/** If the starting time is not zero, please setup the restart time step ro read in restart states. */
+	if (system.restart_step_ != 0)
+	{
+		system.physical_time_ = read_restart_files.ReadRestartFiles(system.restart_step_);
+		interpolation_particle_position.parallel_exec();
+	}
 	/** 
 	 * Output global basic parameters. 
 	 */
-	write_states.WriteToFile(GlobalStaticVariables::physical_time_);
-	write_voltage.WriteToFile(GlobalStaticVariables::physical_time_);
-	write_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_states.WriteToFile(system.physical_time_);
+	write_voltage.WriteToFile(system.physical_time_);
+	write_displacement.WriteToFile(system.physical_time_);
 	/**
 	 * Physical parameters for main loop. 
 	 */
 	int screen_output_interval 	= 10;
-	int ite 					= 0;
+	int restart_output_interval = screen_output_interval * 100;
+	int ite 					= system.restart_step_;
 	int reaction_step 			= 2;
 	Real End_Time 				= 100;
 	Real Ouput_T 				= End_Time / 200.0;
@@ -413,7 +469,7 @@ int main()
 	tick_count::interval_t interval;
 	cout << "Main Loop Starts Here : " << "\n";
 	/** Main loop starts here. */ 
-	while (GlobalStaticVariables::physical_time_ < End_Time)
+	while (system.physical_time_ < End_Time)
 	{
 		Real integeral_time = 0.0;
 		while (integeral_time < Ouput_T) 
@@ -424,19 +480,22 @@ int main()
 				if (ite % screen_output_interval == 0) 
 				{
 					cout << fixed << setprecision(9) << "N=" << ite << "	Time = "
-						<< GlobalStaticVariables::physical_time_
+						<< system.physical_time_
 						<< "	dt = " << dt 
 						<< "	dt_s = " << dt_s << "\n";
+
+					if (ite % restart_output_interval == 0 && ite != system.restart_step_)
+						write_restart_files.WriteToFile(Real(ite));
 				}
 				/** Apply stimulus excitation. */
-				if( 0 <= GlobalStaticVariables::physical_time_ 
-					&&  GlobalStaticVariables::physical_time_ <= 0.5)
+				if( 0 <= system.physical_time_ 
+					&&  system.physical_time_ <= 0.5)
 				{
 					apply_stimulus_s1.parallel_exec(dt);
 				}
 				/** Single spiral wave. */
-				// if( 105 <= GlobalStaticVariables::physical_time_ 
-				// 	&&  GlobalStaticVariables::physical_time_ <= 105.2)	
+				// if( 105 <= system.physical_time_ 
+				// 	&&  system.physical_time_ <= 105.2)	
 				// {
 				// 	apply_stimulus_s2.parallel_exec(dt);
 				// }
@@ -461,30 +520,22 @@ int main()
 
 				active_stress_interpolation.parallel_exec();
 
-				Real dt_s_sum = 0.0;
-				while (dt_s_sum < dt) 
-				{
-					dt_s = get_mechanics_time_step.parallel_exec();
-					if (dt - dt_s_sum < dt_s) dt_s = dt - dt_s_sum;
-					stress_relaxation_first_half.parallel_exec(dt_s);
-					constrain_holder.parallel_exec(dt_s);
-					stress_relaxation_second_half.parallel_exec(dt_s);
-					dt_s_sum += dt_s;
-				}
+				mechanics_sub_cycling.parallel_exec(dt);
+				dt_s = mechanics_sub_cycling.getSubStepSize();
 
 				ite++;
 				dt = get_physiology_time_step.parallel_exec();
 
 				relaxation_time += dt;
 				integeral_time += dt;
-				GlobalStaticVariables::physical_time_ += dt;
+				system.physical_time_ += dt;
 			}
-			write_voltage.WriteToFile(GlobalStaticVariables::physical_time_);
-			write_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+			write_voltage.WriteToFile(system.physical_time_);
+			write_displacement.WriteToFile(system.physical_time_);
 		}
 		tick_count t2 = tick_count::now();
 		interpolation_particle_position.parallel_exec();
-		write_states.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_states.WriteToFile(system.physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -494,5 +545,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
\ No newline at end of file
@@ -95,7 +95,7 @@ protected:
 		BaseParticleData& base_particle_data_i	= particles_->base_particle_data_[index_particle_i];
 
 		Real voltage = base_particle_data_i.pos_0_[0] <= 0 ? 0.0 : reference_voltage * base_particle_data_i.pos_0_[0] / PL;
-		active_muscle_data_i.active_contraction_stress_ += GlobalStaticVariables::physical_time_ <= 1.0
+		active_muscle_data_i.active_contraction_stress_ += body_->getSPHSystem().physical_time_ <= 1.0
 			? linear_active_stress_factor * voltage * dt : 0.0;
 	};
 };
@@ -167,11 +167,11 @@ int main()
 	 * From here the time stepping begines.
 	 * Set the starting time.
 	 */
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	system.InitializeSystemCellLinkedLists();
 	system.InitializeSystemConfigurations();
 	corrected_configuration_in_strong_form.parallel_exec();
-	write_states.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_states.WriteToFile(system.physical_time_);
 	/** Setup physical parameters. */
 	int ite = 0;
 	Real end_time = 1.2;
@@ -183,7 +183,7 @@ int main()
 	/**
 	 * Main loop
 	 */
-	while (GlobalStaticVariables::physical_time_ < end_time)
+	while (system.physical_time_ < end_time)
 	{
 		Real integeral_time = 0.0;
 		while (integeral_time < output_period) 
@@ -191,7 +191,7 @@ int main()
 			if (ite % 100 == 0) 
 			{
 				cout << "N=" << ite << " Time: "
-					<< GlobalStaticVariables::physical_time_ << "	dt: "
+					<< system.physical_time_ << "	dt: "
 					<< dt << "\n";
 			}
 			muscle_activation.parallel_exec(dt);
@@ -202,11 +202,11 @@ int main()
 			ite++;
 			dt = computing_time_step_size.parallel_exec();
 			integeral_time += dt;
-			GlobalStaticVariables::physical_time_ += dt;
+			system.physical_time_ += dt;
 		}
 
 		tick_count t2 = tick_count::now();
-		write_states.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_states.WriteToFile(system.physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -216,5 +216,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
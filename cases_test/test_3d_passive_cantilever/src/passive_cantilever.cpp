@@ -184,14 +184,14 @@ int main()
 	 * From here the time stepping begines.
 	 * Set the starting time.
 	 */
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	system.InitializeSystemCellLinkedLists();
 	system.InitializeSystemConfigurations();
 	/** apply initial condition */
 	initialization.parallel_exec();
 	corrected_configuration_in_strong_form.parallel_exec();
-	write_states.WriteToFile(GlobalStaticVariables::physical_time_);
-	write_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_states.WriteToFile(system.physical_time_);
+	write_displacement.WriteToFile(system.physical_time_);
 	/** Setup physical parameters. */
 	int ite = 0;
 	Real end_time = 3.0;
@@ -203,14 +203,14 @@ int main()
 	/**
 	 * Main loop
 	 */
-	while (GlobalStaticVariables::physical_time_ < end_time)
+	while (system.physical_time_ < end_time)
 	{
 		Real integeral_time = 0.0;
 		while (integeral_time < output_period) 
 		{
 			if (ite % 100 == 0) {
 				cout << "N=" << ite << " Time: "
-					<< GlobalStaticVariables::physical_time_ << "	dt: "
+					<< system.physical_time_ << "	dt: "
 					<< dt << "\n";
 			}
 			stress_relaxation_first_half.parallel_exec(dt);
@@ -220,11 +220,11 @@ int main()
 			ite++;
 			dt = computing_time_step_size.parallel_exec();
 			integeral_time += dt;
-			GlobalStaticVariables::physical_time_ += dt;
+			system.physical_time_ += dt;
 		}
-		write_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_displacement.WriteToFile(system.physical_time_);
 		tick_count t2 = tick_count::now();
-		write_states.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_states.WriteToFile(system.physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -234,5 +234,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
@@ -98,12 +98,13 @@ public:
  */
 class TimeDependentGravity : public Gravity
 {
+	SPHSystem& system_;
 public:
-	TimeDependentGravity(Vecd gravity_vector) 
-		: Gravity(gravity_vector) {}
+	TimeDependentGravity(SPHSystem& system, Vecd gravity_vector) 
+		: Gravity(gravity_vector), system_(system) {}
 	virtual Vecd InducedAcceleration(Vecd& position) override
 	{
-		Real current_time = GlobalStaticVariables::physical_time_;
+		Real current_time = system_.physical_time_;
 		return current_time < time_to_full_gravity ?
 			current_time * global_acceleration_ / time_to_full_gravity : global_acceleration_;
 	}
@@ -128,7 +129,7 @@ int main()
 		Vecd(PL + BW, PH + BW, PH + BW), particle_spacing_ref, 6);
 
 	/** Define the external force. */
-	TimeDependentGravity gravity(Vec3d(0.0, -gravity_g, 0.0));
+	TimeDependentGravity gravity(system, Vec3d(0.0, -gravity_g, 0.0));
 
 	/** Creat a Myocardium body, corresponding material, particles and reaction model. */
 	Myocardium *myocardium_body =
@@ -179,12 +180,12 @@ int main()
 	 * From here the time stepping begines.
 	 * Set the starting time.
 	 */
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system.physical_time_ = 0.0;
 	system.InitializeSystemCellLinkedLists();
 	system.InitializeSystemConfigurations();
 	corrected_configuration_in_strong_form.parallel_exec();
-	write_states.WriteToFile(GlobalStaticVariables::physical_time_);
-	write_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+	write_states.WriteToFile(system.physical_time_);
+	write_displacement.WriteToFile(system.physical_time_);
 	/** Setup physical parameters. */
 	int ite = 0;
 	Real end_time = 8.0;
@@ -196,14 +197,14 @@ int main()
 	/**
 	 * Main loop
 	 */
-	while (GlobalStaticVariables::physical_time_ < end_time)
+	while (system.physical_time_ < end_time)
 	{
 		Real integeral_time = 0.0;
 		while (integeral_time < output_period) 
 		{
 			if (ite % 100 == 0) {
 				cout << "N=" << ite << " Time: "
-					<< GlobalStaticVariables::physical_time_ << "	dt: "
+					<< system.physical_time_ << "	dt: "
 					<< dt << "\n";
 			}
 
@@ -215,11 +216,11 @@ int main()
 			ite++;
 			dt = computing_time_step_size.parallel_exec();
 			integeral_time += dt;
-			GlobalStaticVariables::physical_time_ += dt;
+			system.physical_time_ += dt;
 		}
-		write_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_displacement.WriteToFile(system.physical_time_);
 		tick_count t2 = tick_count::now();
-		write_states.WriteToFile(GlobalStaticVariables::physical_time_);
+		write_states.WriteToFile(system.physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -229,5 +230,7 @@ int main()
 	tt = t4 - t1 - interval;
 	cout << "Total wall time for computation: " << tt.seconds() << " seconds." << endl;
 
+	system.reportMemoryUsage();
+
 	return 0;
 }
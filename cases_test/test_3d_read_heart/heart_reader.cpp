@@ -278,5 +278,7 @@ int main()
 	write_material_property.WriteToFile(0);
 	write_particle_reload_files.WriteToFile(0);
 
+	system.reportMemoryUsage();
+
 	return 0;
 }